@@ -234,3 +234,15 @@ ENDMACRO()
 
 
 CONFIGURE_FEATURE(THREADS)
+
+#
+# Without the tbb library, deal.II runs tasks, parallel loops and WorkStream
+# on a thread pool of its own that is based on std::thread (see
+# include/deal.II/base/thread_pool.h). This only needs the system thread
+# library:
+#
+IF(NOT DEAL_II_WITH_THREADS)
+  SETUP_THREADING()
+  SET(DEAL_II_USE_THREAD_POOL TRUE)
+  ADD_FLAGS(DEAL_II_LINKER_FLAGS "${THREADS_LINKER_FLAGS}")
+ENDIF()
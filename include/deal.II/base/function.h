@@ -19,12 +19,14 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/function_time.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/subscriptor.h>
 #include <deal.II/base/symmetric_tensor.h>
 #include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
 
 #include <functional>
 #include <vector>
@@ -101,6 +103,24 @@ class TensorFunction;
  * returning a whole array), since the cost of evaluation of a point value is
  * often less than the virtual function call itself.
  *
+ * For this purpose, the virtual function value_batch() evaluates one
+ * component at an array of points, just as value_list() does, but without
+ * requiring the points and values to be stored in <tt>std::vector</tt>
+ * objects. value_list() calls it by default, so it is the single place to
+ * implement efficient evaluation at many points. The function
+ * vectorized_value() uses it to evaluate the function at the points stored
+ * in the lanes of a <tt>Point<dim,VectorizedArray<Number>></tt>, as they
+ * appear in the quadrature loops of FEEvaluation, with one virtual function
+ * call per batch of points instead of one per lane:
+ * @code
+ * for (unsigned int q = 0; q < phi.n_q_points; ++q)
+ *   {
+ *     const VectorizedArray<double> coefficient =
+ *       function.vectorized_value(phi.quadrature_point(q));
+ *     phi.submit_gradient(coefficient * phi.get_gradient(q), q);
+ *   }
+ * @endcode
+ *
  * Support for time dependent functions can be found in the base class
  * FunctionTime.
  *
@@ -232,14 +252,43 @@ public:
    * already has the right size, i.e.  the same size as the <tt>points</tt>
    * array.
    *
-   * By default, this function repeatedly calls value() for each point
-   * separately, to fill the output array.
+   * By default, this function calls value_batch().
    */
   virtual void
   value_list(const std::vector<Point<dim>> &points,
              std::vector<RangeNumberType> & values,
              const unsigned int             component = 0) const;
 
+  /**
+   * Set <tt>values</tt> to the point values of the specified component of the
+   * function at the <tt>points</tt>, like value_list() does, but for
+   * arbitrary arrays of points and values. The two arrays need to have the
+   * same size.
+   *
+   * By default, this function repeatedly calls value() for each point
+   * separately, to fill the output array. Derived classes should overload
+   * it if the function can be evaluated more efficiently for many points at
+   * once.
+   */
+  virtual void
+  value_batch(const ArrayView<const Point<dim>> &points,
+              const ArrayView<RangeNumberType> & values,
+              const unsigned int                 component = 0) const;
+
+  /**
+   * Return the values of the specified component of the function at the
+   * points stored in the lanes of @p p, i.e., at the points whose coordinates
+   * are given by <tt>p[d][v]</tt> for lane <tt>v</tt>. This is the format in
+   * which FEEvaluation returns the quadrature points.
+   *
+   * This function calls value_batch() once for all lanes. It is only
+   * available for functions whose values can be converted to @p Number.
+   */
+  template <typename Number>
+  VectorizedArray<Number>
+  vectorized_value(const Point<dim, VectorizedArray<Number>> &p,
+                   const unsigned int component = 0) const;
+
   /**
    * Set <tt>values</tt> to the point values of the function at the
    * <tt>points</tt>.  It is assumed that <tt>values</tt> already has the
@@ -444,6 +493,11 @@ namespace Functions
                std::vector<RangeNumberType> & return_values,
                const unsigned int             component = 0) const override;
 
+    virtual void
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<RangeNumberType> & return_values,
+                const unsigned int component = 0) const override;
+
     virtual void
     vector_value_list(
       const std::vector<Point<dim>> &       points,
@@ -935,6 +989,33 @@ private:
 };
 
 
+template <int dim, typename RangeNumberType>
+template <typename Number>
+inline VectorizedArray<Number>
+Function<dim, RangeNumberType>::vectorized_value(
+  const Point<dim, VectorizedArray<Number>> &p,
+  const unsigned int                         component) const
+{
+  const unsigned int n_lanes = VectorizedArray<Number>::n_array_elements;
+
+  Point<dim>      points[n_lanes];
+  RangeNumberType values[n_lanes];
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    for (unsigned int d = 0; d < dim; ++d)
+      points[v][d] = p[d][v];
+
+  value_batch(make_array_view(&points[0], &points[0] + n_lanes),
+              make_array_view(&values[0], &values[0] + n_lanes),
+              component);
+
+  VectorizedArray<Number> result;
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    result[v] = values[v];
+  return result;
+}
+
+
+
 #ifndef DOXYGEN
 // icc 2018 complains about an undefined reference
 // if we put this in the templates.h file
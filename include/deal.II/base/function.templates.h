@@ -91,6 +91,24 @@ Function<dim, RangeNumberType>::value_list(
   Assert(values.size() == points.size(),
          ExcDimensionMismatch(values.size(), points.size()));
 
+  this->value_batch(make_array_view(points),
+                    make_array_view(values),
+                    component);
+}
+
+
+template <int dim, typename RangeNumberType>
+void
+Function<dim, RangeNumberType>::value_batch(
+  const ArrayView<const Point<dim>> &points,
+  const ArrayView<RangeNumberType> & values,
+  const unsigned int                 component) const
+{
+  // check whether component is in the valid range is up to the derived
+  // class
+  Assert(values.size() == points.size(),
+         ExcDimensionMismatch(values.size(), points.size()));
+
   for (unsigned int i = 0; i < points.size(); ++i)
     values[i] = this->value(points[i], component);
 }
@@ -424,6 +442,24 @@ namespace Functions
 
 
 
+  template <int dim, typename RangeNumberType>
+  void
+  ConstantFunction<dim, RangeNumberType>::value_batch(
+    const ArrayView<const Point<dim>> &points,
+    const ArrayView<RangeNumberType> & return_values,
+    const unsigned int                 component) const
+  {
+    (void)points;
+    AssertIndexRange(component, this->n_components);
+    AssertDimension(return_values.size(), points.size());
+
+    std::fill(return_values.begin(),
+              return_values.end(),
+              function_value_vector[component]);
+  }
+
+
+
   template <int dim, typename RangeNumberType>
   void
   ConstantFunction<dim, RangeNumberType>::vector_value_list(
@@ -48,9 +48,9 @@ namespace Functions
           const unsigned int component = 0) const override;
 
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     virtual Tensor<1, dim>
     gradient(const Point<dim> & p,
@@ -56,9 +56,9 @@ namespace Functions
     virtual void
     vector_value(const Point<dim> &p, Vector<double> &values) const override;
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
     virtual Tensor<1, dim>
     gradient(const Point<dim> & p,
              const unsigned int component = 0) const override;
@@ -95,9 +95,9 @@ namespace Functions
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     virtual void
     vector_value_list(const std::vector<Point<dim>> &points,
@@ -170,9 +170,9 @@ namespace Functions
      * Values at multiple points.
      */
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     /**
      * Gradient at a single point.
@@ -232,9 +232,9 @@ namespace Functions
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     virtual void
     vector_value_list(const std::vector<Point<dim>> &points,
@@ -301,9 +301,9 @@ namespace Functions
     virtual void
     vector_value(const Point<dim> &p, Vector<double> &values) const override;
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int                 component) const override;
 
     virtual void
     vector_value_list(const std::vector<Point<dim>> &points,
@@ -348,9 +348,9 @@ namespace Functions
      * Values at multiple points.
      */
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     /**
      * Gradient at a single point.
@@ -403,9 +403,9 @@ namespace Functions
     value(const Point<2> &p, const unsigned int component = 0) const override;
 
     virtual void
-    value_list(const std::vector<Point<2>> &points,
-               std::vector<double> &        values,
-               const unsigned int           component = 0) const override;
+    value_batch(const ArrayView<const Point<2>> &points,
+                const ArrayView<double> &        values,
+                const unsigned int               component = 0) const override;
 
     virtual void
     vector_value_list(const std::vector<Point<2>> &points,
@@ -457,9 +457,9 @@ namespace Functions
     value(const Point<2> &p, const unsigned int component) const override;
 
     virtual void
-    value_list(const std::vector<Point<2>> &points,
-               std::vector<double> &        values,
-               const unsigned int           component) const override;
+    value_batch(const ArrayView<const Point<2>> &points,
+                const ArrayView<double> &        values,
+                const unsigned int               component) const override;
 
     virtual void
     vector_value_list(const std::vector<Point<2>> &points,
@@ -503,9 +503,9 @@ namespace Functions
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     virtual void
     vector_value_list(const std::vector<Point<dim>> &points,
@@ -549,9 +549,9 @@ namespace Functions
     value(const Point<2> &p, const unsigned int component = 0) const override;
 
     virtual void
-    value_list(const std::vector<Point<2>> &points,
-               std::vector<double> &        values,
-               const unsigned int           component = 0) const override;
+    value_batch(const ArrayView<const Point<2>> &points,
+                const ArrayView<double> &        values,
+                const unsigned int               component = 0) const override;
 
     virtual void
     vector_value_list(const std::vector<Point<2>> &points,
@@ -618,9 +618,9 @@ namespace Functions
      * Function values at multiple points.
      */
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     /**
      * Gradient at one point.
@@ -1004,9 +1004,9 @@ namespace Functions
      * Function values at multiple points.
      */
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     /**
      * Function values at multiple points.
@@ -1052,9 +1052,9 @@ namespace Functions
      * Function values at multiple points.
      */
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     /**
      * Function values at multiple points.
@@ -1101,9 +1101,9 @@ namespace Functions
      * Function values at multiple points.
      */
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     /**
      * Function values at multiple points.
@@ -1167,9 +1167,9 @@ namespace Functions
      * Function values at multiple points.
      */
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     /**
      * Function gradient at one point.
@@ -1415,9 +1415,9 @@ namespace Functions
      * Function values at multiple points.
      */
     virtual void
-    value_list(const std::vector<Point<dim>> &points,
-               std::vector<double> &          values,
-               const unsigned int             component = 0) const override;
+    value_batch(const ArrayView<const Point<dim>> &points,
+                const ArrayView<double> &          values,
+                const unsigned int component = 0) const override;
 
     /**
      * Function gradient at one point.
@@ -150,11 +150,22 @@ class Vector;
  *         << " is " << result << std::endl;
  * @endcode
  *
- * This class overloads the virtual methods value() and vector_value() of the
- * Function base class with the byte compiled versions of the expressions
- * given to the initialize() methods. Note that the class will not work unless
- * you first call the initialize() method that accepts the text description of
- * the function as an argument (among other things).
+ * This class overloads the virtual methods value(), vector_value(),
+ * value_batch(), and vector_value_list() of the Function base class with the
+ * byte compiled versions of the expressions given to the initialize()
+ * methods. Note that the class will not work unless you first call the
+ * initialize() method that accepts the text description of the function as
+ * an argument (among other things).
+ *
+ * The functions that evaluate the expressions at many points at once, i.e.,
+ * value_batch(), vector_value_list(), and through them value_list() and
+ * Function::vectorized_value(), make use of the bulk mode of muparser: The
+ * coordinates of a block of points are stored in one array per variable, and
+ * the byte code of an expression is run over the whole block in a single
+ * call into the parser. Since muparser recreates the byte code at the start
+ * of each such call, which costs about as much as evaluating the expression
+ * at a few hundred points, batches of fewer than min_bulk_size points are
+ * evaluated point by point.
  *
  * The syntax to describe a function follows usual programming practice, and
  * is explained in detail at the homepage of the underlying muparser library
@@ -341,6 +352,39 @@ public:
   virtual void
   vector_value(const Point<dim> &p, Vector<double> &values) const override;
 
+  /**
+   * Set <tt>values[i]</tt> to the value of the given component of the
+   * function at <tt>points[i]</tt>, evaluating the expression in blocks of
+   * up to max_bulk_size points with the bulk mode of muparser.
+   */
+  virtual void
+  value_batch(const ArrayView<const Point<dim>> &points,
+              const ArrayView<double> &          values,
+              const unsigned int                 component = 0) const override;
+
+  /**
+   * Return all components of the function at all the given points, using
+   * the bulk mode of muparser like value_batch().
+   *
+   * <code>values</code> shall have the right size beforehand, i.e., the
+   * number of points, and each element shall have #n_components entries.
+   */
+  virtual void
+  vector_value_list(const std::vector<Point<dim>> &points,
+                    std::vector<Vector<double>> &  values) const override;
+
+  /**
+   * The maximal number of points whose coordinates are stored at once for
+   * the bulk evaluation in value_batch() and vector_value_list().
+   */
+  static const unsigned int max_bulk_size = 2048;
+
+  /**
+   * The minimal number of points for which value_batch() and
+   * vector_value_list() use the bulk mode of muparser.
+   */
+  static const unsigned int min_bulk_size = 512;
+
   /**
    * Return an array of function expressions (one per component), used to
    * initialize this function.
@@ -370,7 +414,10 @@ public:
 private:
 #ifdef DEAL_II_WITH_MUPARSER
   /**
-   * Place for the variables for each thread
+   * Place for the variables for each thread. The values of each variable
+   * are stored in a separate array of max_bulk_size entries for the bulk
+   * evaluation, i.e., the value of variable <tt>iv</tt> for the <tt>j</tt>th
+   * point of a block is stored at index <tt>iv*max_bulk_size+j</tt>.
    */
   mutable Threads::ThreadLocalStorage<std::vector<double>> vars;
 
@@ -402,6 +449,17 @@ private:
    */
   void
   init_muparser() const;
+
+  /**
+   * Store the coordinates of the @p n_points points starting at index
+   * @p begin of @p points, and the current time if this function is time
+   * dependent, in the variable arrays of the current thread for a bulk
+   * evaluation.
+   */
+  void
+  set_bulk_variables(const ArrayView<const Point<dim>> &points,
+                     const unsigned int                 begin,
+                     const unsigned int                 n_points) const;
 #endif
 
   /**
@@ -25,6 +25,9 @@
 #include <boost/serialization/vector.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cstdint>
 #include <iterator>
 #include <vector>
 
@@ -66,6 +69,25 @@ DEAL_II_NAMESPACE_OPEN
  * in the
  * @ref distributed_paper "Distributed Computing paper".
  *
+ * <h3>Fragmented index sets</h3>
+ *
+ * Index sets that consist of many short ranges close to each other, such as
+ * the sets of locally relevant degrees of freedom of unstructured meshes,
+ * make the binary searches in is_element(), index_within_set(), and
+ * nth_index_in_set() expensive. For such sets, compress() additionally
+ * builds a bitmap of the elements, together with the number of elements
+ * before each block of the bitmap. The first two functions then run in
+ * constant time and nth_index_in_set() searches over the blocks instead of
+ * the ranges. The bitmap is only built if it does not need more memory than
+ * the ranges themselves.
+ *
+ * The set operations operator&(), add_indices() and subtract_set() split
+ * the index space into pieces that are processed in parallel if the two
+ * sets contain many ranges. Once an index set is compressed, compress()
+ * returns without acquiring a lock, so that the 'const' functions of this
+ * class can be called from several threads at the same time without
+ * contention.
+ *
  * @author Wolfgang Bangerth, 2009
  */
 class IndexSet
@@ -114,13 +136,13 @@ public:
   /**
    * Copy constructor.
    */
-  IndexSet(const IndexSet &) = default;
+  IndexSet(const IndexSet &is);
 
   /**
    * Copy assignment operator.
    */
   IndexSet &
-  operator=(const IndexSet &) = default;
+  operator=(const IndexSet &is);
 
   /**
    * Move constructor. Create a new IndexSet by transferring the internal data
@@ -913,9 +935,10 @@ private:
    *
    * The variable is marked "mutable" so that it can be changed by compress(),
    * though this of course doesn't change anything about the external
-   * representation of this index set.
+   * representation of this index set. It is atomic so that compress() can
+   * check it without acquiring @p compress_mutex.
    */
-  mutable bool is_compressed;
+  mutable std::atomic<bool> is_compressed;
 
   /**
    * The overall size of the index range. Elements of this index set have to
@@ -934,6 +957,31 @@ private:
    */
   mutable size_type largest_range;
 
+  /**
+   * The number of 64-bit words of @p bitmap for which @p bitmap_rank stores
+   * the number of preceding elements.
+   */
+  static const unsigned int bitmap_block_size = 8;
+
+  /**
+   * For fragmented index sets, a bitmap of the elements, starting at index
+   * @p bitmap_offset, that is built by compress() in addition to the ranges.
+   * Empty if the ranges are used for all lookups. See the general
+   * documentation of this class.
+   */
+  mutable std::vector<std::uint64_t> bitmap;
+
+  /**
+   * The number of elements stored in the blocks of @p bitmap_block_size
+   * words of @p bitmap before the respective block.
+   */
+  mutable std::vector<size_type> bitmap_rank;
+
+  /**
+   * The index represented by the first bit of @p bitmap.
+   */
+  mutable size_type bitmap_offset;
+
   /**
    * A mutex that is used to synchronize operations of the do_compress()
    * function that is called from many 'const' functions via compress().
@@ -945,6 +993,64 @@ private:
    */
   void
   do_compress() const;
+
+  /**
+   * Build or clear @p bitmap and @p bitmap_rank, depending on how
+   * fragmented the index set is. Called by do_compress().
+   */
+  void
+  build_bitmap() const;
+
+  /**
+   * Implementation of index_within_set() for index sets that store a
+   * bitmap.
+   */
+  size_type
+  bitmap_index_within_set(const size_type global_index) const;
+
+  /**
+   * Implementation of nth_index_in_set() for index sets that store a
+   * bitmap.
+   */
+  size_type
+  bitmap_nth_index_in_set(const size_type local_index) const;
+
+  /**
+   * The set operations implemented by combine_ranges().
+   */
+  enum class SetOperation
+  {
+    intersection,
+    set_union,
+    difference
+  };
+
+  /**
+   * Compute the intersection, union, or difference of two sorted lists of
+   * non-overlapping ranges, where the second list is shifted by
+   * @p offset_2. The result may contain adjacent ranges and needs to be
+   * compressed. If the two lists are long, the index space is split into
+   * pieces that are processed in parallel.
+   */
+  static std::vector<Range>
+  combine_ranges(const std::vector<Range> &ranges_1,
+                 const std::vector<Range> &ranges_2,
+                 const size_type           offset_2,
+                 const SetOperation        operation);
+
+  /**
+   * Perform the work of combine_ranges() for the part of the two lists that
+   * lies within <code>[window_begin,window_end)</code>, appending the result
+   * to @p result.
+   */
+  static void
+  combine_ranges_in_window(const std::vector<Range> &ranges_1,
+                           const std::vector<Range> &ranges_2,
+                           const size_type           offset_2,
+                           const SetOperation        operation,
+                           const size_type           window_begin,
+                           const size_type           window_end,
+                           std::vector<Range> &      result);
 };
 
 
@@ -1422,6 +1528,7 @@ inline IndexSet::IndexSet()
   : is_compressed(true)
   , index_space_size(0)
   , largest_range(numbers::invalid_unsigned_int)
+  , bitmap_offset(0)
 {}
 
 
@@ -1430,20 +1537,50 @@ inline IndexSet::IndexSet(const size_type size)
   : is_compressed(true)
   , index_space_size(size)
   , largest_range(numbers::invalid_unsigned_int)
+  , bitmap_offset(0)
+{}
+
+
+
+inline IndexSet::IndexSet(const IndexSet &is)
+  : ranges(is.ranges)
+  , is_compressed(is.is_compressed.load())
+  , index_space_size(is.index_space_size)
+  , largest_range(is.largest_range)
+  , bitmap(is.bitmap)
+  , bitmap_rank(is.bitmap_rank)
+  , bitmap_offset(is.bitmap_offset)
 {}
 
 
 
+inline IndexSet &
+IndexSet::operator=(const IndexSet &is)
+{
+  ranges           = is.ranges;
+  is_compressed    = is.is_compressed.load();
+  index_space_size = is.index_space_size;
+  largest_range    = is.largest_range;
+  bitmap           = is.bitmap;
+  bitmap_rank      = is.bitmap_rank;
+  bitmap_offset    = is.bitmap_offset;
+
+  return *this;
+}
+
+
+
 inline IndexSet::IndexSet(IndexSet &&is) noexcept
   : ranges(std::move(is.ranges))
-  , is_compressed(is.is_compressed)
+  , is_compressed(is.is_compressed.load())
   , index_space_size(is.index_space_size)
   , largest_range(is.largest_range)
+  , bitmap(std::move(is.bitmap))
+  , bitmap_rank(std::move(is.bitmap_rank))
+  , bitmap_offset(is.bitmap_offset)
 {
-  is.ranges.clear();
-  is.is_compressed    = true;
+  is.clear();
   is.index_space_size = 0;
-  is.largest_range    = numbers::invalid_unsigned_int;
 
   compress();
 }
@@ -1454,14 +1591,15 @@ inline IndexSet &
 IndexSet::operator=(IndexSet &&is) noexcept
 {
   ranges           = std::move(is.ranges);
-  is_compressed    = is.is_compressed;
+  is_compressed    = is.is_compressed.load();
   index_space_size = is.index_space_size;
   largest_range    = is.largest_range;
+  bitmap           = std::move(is.bitmap);
+  bitmap_rank      = std::move(is.bitmap_rank);
+  bitmap_offset    = is.bitmap_offset;
 
-  is.ranges.clear();
-  is.is_compressed    = true;
+  is.clear();
   is.index_space_size = 0;
-  is.largest_range    = numbers::invalid_unsigned_int;
 
   compress();
 
@@ -1569,6 +1707,8 @@ IndexSet::clear()
   // reset so that there are no indices in the set any more; however,
   // as documented, the index set retains its size
   ranges.clear();
+  bitmap.clear();
+  bitmap_rank.clear();
   is_compressed = true;
   largest_range = numbers::invalid_unsigned_int;
 }
@@ -1598,7 +1738,7 @@ IndexSet::size() const
 inline void
 IndexSet::compress() const
 {
-  if (is_compressed == true)
+  if (is_compressed.load(std::memory_order_acquire) == true)
     return;
 
   do_compress();
@@ -1631,23 +1771,47 @@ template <typename ForwardIterator>
 inline void
 IndexSet::add_indices(const ForwardIterator &begin, const ForwardIterator &end)
 {
-  // insert each element of the range. if some of them happen to be
-  // consecutive, merge them to a range
+  if (begin == end)
+    return;
+
+  // append each element of the range to the list of ranges. if some of them
+  // happen to be consecutive, merge them to a range
+  const std::size_t n_old_ranges = ranges.size();
+  bool              sorted       = true;
   for (ForwardIterator p = begin; p != end;)
     {
       const size_type begin_index = *p;
       size_type       end_index   = begin_index + 1;
-      ForwardIterator q           = p;
+      Assert(begin_index < index_space_size,
+             ExcIndexRangeType<size_type>(begin_index, 0, index_space_size));
+      ForwardIterator q = p;
       ++q;
       while ((q != end) && (*q == end_index))
         {
           ++end_index;
           ++q;
         }
+      Assert(end_index <= index_space_size,
+             ExcIndexRangeType<size_type>(end_index - 1, 0, index_space_size));
 
-      add_range(begin_index, end_index);
+      if (ranges.size() > n_old_ranges &&
+          begin_index < ranges.back().begin)
+        sorted = false;
+      ranges.emplace_back(begin_index, end_index);
       p = q;
     }
+
+  // rather than inserting the ranges one by one into the sorted list, which
+  // is quadratic in the number of ranges if the new indices are interleaved
+  // with the existing ones, sort the new ranges and merge the two lists
+  if (sorted == false)
+    std::sort(ranges.begin() + n_old_ranges, ranges.end());
+  if (n_old_ranges > 0 &&
+      ranges[n_old_ranges].begin < ranges[n_old_ranges - 1].end)
+    std::inplace_merge(ranges.begin(),
+                       ranges.begin() + n_old_ranges,
+                       ranges.end());
+  is_compressed = false;
 }
 
 
@@ -1665,6 +1829,16 @@ IndexSet::is_element(const size_type index) const
           index < ranges[largest_range].end)
         return true;
 
+      // for fragmented sets, look up the bit of the index
+      if (bitmap.empty() == false)
+        {
+          if (index < bitmap_offset ||
+              index - bitmap_offset >= 64 * bitmap.size())
+            return false;
+          const size_type bit = index - bitmap_offset;
+          return (bitmap[bit / 64] >> (bit % 64)) & 1;
+        }
+
       // get the element after which we would have to insert a range that
       // consists of all elements from this element to the end of the index
       // range plus one. after this call we know that if p!=end() then
@@ -1782,6 +1956,9 @@ IndexSet::nth_index_in_set(const unsigned int n) const
       n < main_range->nth_index_in_set + (main_range->end - main_range->begin))
     return main_range->begin + (n - main_range->nth_index_in_set);
 
+  if (bitmap.empty() == false)
+    return bitmap_nth_index_in_set(n);
+
   // find out which chunk the local index n belongs to by using a binary
   // search. the comparator is based on the end of the ranges. Use the
   // position relative to main_range to subdivide the ranges
@@ -1808,6 +1985,72 @@ IndexSet::nth_index_in_set(const unsigned int n) const
 
 
 
+inline IndexSet::size_type
+IndexSet::bitmap_index_within_set(const size_type global_index) const
+{
+  if (global_index < bitmap_offset ||
+      global_index - bitmap_offset >= 64 * bitmap.size())
+    return numbers::invalid_dof_index;
+
+  const size_type     bit  = global_index - bitmap_offset;
+  const std::size_t   word = bit / 64;
+  const std::uint64_t mask = (std::uint64_t(1) << (bit % 64));
+  if ((bitmap[word] & mask) == 0)
+    return numbers::invalid_dof_index;
+
+  // count the elements before the index: the ones before the block, the
+  // ones in the preceding words of the block, and the ones in the word
+  size_type index = bitmap_rank[word / bitmap_block_size];
+  for (std::size_t w = word - word % bitmap_block_size; w < word; ++w)
+    index += std::bitset<64>(bitmap[w]).count();
+  return index + std::bitset<64>(bitmap[word] & (mask - 1)).count();
+}
+
+
+
+inline IndexSet::size_type
+IndexSet::bitmap_nth_index_in_set(const size_type n) const
+{
+  // find the last block that starts at or before the n-th element
+  const std::size_t block =
+    std::upper_bound(bitmap_rank.begin(), bitmap_rank.end(), n) -
+    bitmap_rank.begin() - 1;
+
+  // then the word that contains the element
+  size_type   remaining = n - bitmap_rank[block];
+  std::size_t word      = block * bitmap_block_size;
+  for (;; ++word)
+    {
+      Assert(word < bitmap.size(), ExcInternalError());
+      const size_type n_bits = std::bitset<64>(bitmap[word]).count();
+      if (remaining < n_bits)
+        break;
+      remaining -= n_bits;
+    }
+
+  // and finally the bit within the word, skipping whole bytes first
+  std::uint64_t bits = bitmap[word];
+  unsigned int  bit  = 0;
+  for (;; bit += 8, bits >>= 8)
+    {
+      const size_type n_bits = std::bitset<8>(bits & 0xff).count();
+      if (remaining < n_bits)
+        break;
+      remaining -= n_bits;
+    }
+  for (;; ++bit, bits >>= 1)
+    if ((bits & 1) != 0)
+      {
+        if (remaining == 0)
+          break;
+        --remaining;
+      }
+
+  return bitmap_offset + 64 * word + bit;
+}
+
+
+
 inline IndexSet::size_type
 IndexSet::index_within_set(const size_type n) const
 {
@@ -1828,6 +2071,9 @@ IndexSet::index_within_set(const size_type n) const
   if (n >= main_range->begin && n < main_range->end)
     return (n - main_range->begin) + main_range->nth_index_in_set;
 
+  if (bitmap.empty() == false)
+    return bitmap_index_within_set(n);
+
   Range                              r(n, n);
   std::vector<Range>::const_iterator range_begin, range_end;
   if (n < main_range->begin)
@@ -1936,7 +2182,15 @@ template <class Archive>
 inline void
 IndexSet::serialize(Archive &ar, const unsigned int)
 {
-  ar &ranges &is_compressed &index_space_size &largest_range;
+  bool compressed = is_compressed;
+  ar &ranges &compressed &index_space_size &largest_range;
+
+  // the bitmap is not stored, so let compress() recompute it after loading
+  if (Archive::is_loading::value)
+    {
+      is_compressed = false;
+      compress();
+    }
 }
 
 DEAL_II_NAMESPACE_CLOSE
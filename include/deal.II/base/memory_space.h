@@ -22,6 +22,7 @@
 #include <deal.II/base/cuda.h>
 #include <deal.II/base/exceptions.h>
 
+#include <functional>
 #include <memory>
 
 DEAL_II_NAMESPACE_OPEN
@@ -83,9 +84,11 @@ namespace MemorySpace
     }
 
     /**
-     * Pointer to data on the host.
+     * Pointer to data on the host. The deleter is usually free(), but might
+     * also release an MPI-3 shared-memory window in which the data has been
+     * allocated.
      */
-    std::unique_ptr<Number[], decltype(&free)> values;
+    std::unique_ptr<Number[], std::function<void(Number *)>> values;
 
     /**
      * Pointer to data on the device.
@@ -129,7 +132,7 @@ namespace MemorySpace
       std::copy(begin, begin + n_elements, values.get());
     }
 
-    std::unique_ptr<Number[], decltype(&free)> values;
+    std::unique_ptr<Number[], std::function<void(Number *)>> values;
 
     // This is not used but it allows to simplify the code until we start using
     // CUDA-aware MPI.
@@ -179,8 +182,8 @@ namespace MemorySpace
       AssertCuda(cuda_error_code);
     }
 
-    std::unique_ptr<Number[], decltype(&free)>    values;
-    std::unique_ptr<Number[], void (*)(Number *)> values_dev;
+    std::unique_ptr<Number[], std::function<void(Number *)>> values;
+    std::unique_ptr<Number[], void (*)(Number *)>            values_dev;
   };
 
 
@@ -21,6 +21,7 @@
 #include <deal.II/base/array_view.h>
 
 #include <map>
+#include <type_traits>
 #include <vector>
 
 #if !defined(DEAL_II_WITH_MPI) && !defined(DEAL_II_WITH_PETSC)
@@ -90,6 +91,7 @@ template <int rank, int dim, typename Number>
 class SymmetricTensor;
 template <typename Number>
 class SparseMatrix;
+class IndexSet;
 
 namespace Utilities
 {
@@ -174,6 +176,78 @@ namespace Utilities
       const MPI_Comm &                 mpi_comm,
       const std::vector<unsigned int> &destinations);
 
+    /**
+     * Exchange arrays of data between processes in a sparse, data-dependent
+     * pattern: every process knows to which processes it wants to send data,
+     * but not from which processes it will receive data. The keys of the
+     * argument @p data_to_send are the ranks the data is to be sent to, and
+     * the keys of the returned map are the ranks of the processes that have
+     * sent data to the current process. Data the current process sends to
+     * itself is copied without going through MPI.
+     *
+     * If MPI version 3.0 or later is available, this function implements the
+     * non-blocking consensus (NBX) algorithm of T. Hoefler, C. Siebert,
+     * A. Lumsdaine, "Scalable communication protocols for dynamic sparse data
+     * exchange", PPoPP 2010: All messages are posted as synchronous sends,
+     * while the process keeps receiving incoming messages. Once all of its
+     * own messages have been matched by the receivers, a process enters a
+     * non-blocking barrier, and the exchange is finished when the barrier
+     * completes. In contrast to MPI_Alltoall() on the message sizes, the
+     * cost of this algorithm only scales with the number of processes the
+     * current process actually communicates with (plus the logarithmic cost
+     * of the barrier), rather than with the number of processes in the
+     * communicator. Otherwise, the function falls back to
+     * compute_point_to_point_communication_pattern().
+     *
+     * @param mpi_comm A
+     * @ref GlossMPICommunicator "communicator"
+     * that describes the processors that are going to communicate with each
+     * other.
+     *
+     * @param data_to_send A map from the rank of the receiving process to the
+     * data to be sent to that process. The type @p T must be trivially
+     * copyable, as the data is sent as a sequence of bytes.
+     *
+     * @param tag The MPI tag used for the messages. Since the receivers
+     * accept messages from any source, two subsequent calls to this function
+     * on the same communicator that are not separated by some other
+     * synchronizing communication should use different tags.
+     *
+     * @return A map from the rank of the sending process to the data received
+     * from that process.
+     */
+    template <typename T>
+    std::map<unsigned int, std::vector<T>>
+    consensus_exchange(
+      const MPI_Comm &                              mpi_comm,
+      const std::map<unsigned int, std::vector<T>> &data_to_send,
+      const int                                     tag = 32765);
+
+    /**
+     * Given a set of indices owned by the current process, where the owned
+     * sets of all processes in @p mpi_comm form a partition of the index
+     * space, determine the owners of the entries in @p indices_to_look_up.
+     *
+     * Rather than making the owned sets of all processes known everywhere,
+     * which needs O(P) memory and time per process for P processes, this
+     * function distributes the ownership information in a dictionary: the
+     * index space is split into one contiguous chunk per process, and every
+     * process registers its owned ranges with the processes managing the
+     * respective chunks. The owners of the requested indices are then looked
+     * up from these processes. Both steps use consensus_exchange(), such
+     * that the cost only scales with the number of processes that actually
+     * need to communicate.
+     *
+     * @return A vector with the rank of the owning process for each element
+     * of @p indices_to_look_up, in the order of the elements in the set.
+     *
+     * @note This is a collective operation over @p mpi_comm.
+     */
+    std::vector<unsigned int>
+    compute_index_owner(const IndexSet &owned_indices,
+                        const IndexSet &indices_to_look_up,
+                        const MPI_Comm &mpi_comm);
+
     /**
      * Given a
      * @ref GlossMPICommunicator "communicator",
@@ -612,6 +686,12 @@ namespace Utilities
      * (the class T should be serializable using boost::serialize) between
      * processors.
      *
+     * The objects are packed with Utilities::pack() and exchanged by the
+     * function below that works on arrays of bytes. Consequently, the
+     * processes do not need to know from which processes they will receive
+     * data, and the cost of the communication only scales with the number of
+     * processes the current process exchanges data with.
+     *
      * @param[in] comm MPI communicator.
      *
      * @param[in] objects_to_send A map from the rank (unsigned int) of the
@@ -628,6 +708,34 @@ namespace Utilities
     some_to_some(const MPI_Comm &                 comm,
                  const std::map<unsigned int, T> &objects_to_send);
 
+    /**
+     * Exchange packed data between processes in a sparse, data-dependent
+     * pattern. This is the variant of the function above for data that has
+     * already been serialized into arrays of bytes, e.g., particles or the
+     * results of Utilities::pack(), which avoids a second serialization of
+     * the arrays.
+     *
+     * The data is exchanged with consensus_exchange(), i.e., with the
+     * non-blocking consensus algorithm if MPI 3.0 is available. In contrast
+     * to consensus_exchange(), this function finishes with a barrier over
+     * @p comm, such that it can be called several times in a row on the same
+     * communicator without the messages of subsequent calls getting mixed
+     * up. The cost of the barrier only grows logarithmically with the number
+     * of processes.
+     *
+     * @param[in] comm MPI communicator.
+     *
+     * @param[in] buffers_to_send A map from the rank of the process meant to
+     *  receive the data to the data to send.
+     *
+     * @return A map from the rank of the process which sent the data to the
+     *  data received.
+     */
+    std::map<unsigned int, std::vector<char>>
+    some_to_some(
+      const MPI_Comm &                                 comm,
+      const std::map<unsigned int, std::vector<char>> &buffers_to_send);
+
     /**
      * A generalization of the classic MPI_Allgather function, that accepts
      * arbitrary data types T, as long as boost::serialize accepts T as an
@@ -713,6 +821,140 @@ namespace Utilities
                            ArrayView<T>(minima, N));
     }
 
+    template <typename T>
+    std::map<unsigned int, std::vector<T>>
+    consensus_exchange(
+      const MPI_Comm &                              mpi_comm,
+      const std::map<unsigned int, std::vector<T>> &data_to_send,
+      const int                                     tag)
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+                    "The data to be exchanged must be trivially copyable.");
+
+      std::map<unsigned int, std::vector<T>> received_data;
+#  ifndef DEAL_II_WITH_MPI
+      (void)mpi_comm;
+      (void)tag;
+      Assert(data_to_send.size() == 0 || (data_to_send.size() == 1 &&
+                                          data_to_send.begin()->first == 0),
+             ExcMessage("Can only send to myself or to nobody."));
+      received_data = data_to_send;
+#  else
+      const unsigned int my_pid = this_mpi_process(mpi_comm);
+
+      // post the sends. Synchronous sends are needed for NBX, since the
+      // completion of such a send implies that the receiver has matched it.
+      std::vector<MPI_Request> send_requests;
+      send_requests.reserve(data_to_send.size());
+      for (const auto &rank_data : data_to_send)
+        if (rank_data.first == my_pid)
+          received_data[my_pid] = rank_data.second;
+        else
+          {
+            send_requests.emplace_back();
+            const int ierr =
+              MPI_Issend(DEAL_II_MPI_CONST_CAST(rank_data.second.data()),
+                         rank_data.second.size() * sizeof(T),
+                         MPI_BYTE,
+                         rank_data.first,
+                         tag,
+                         mpi_comm,
+                         &send_requests.back());
+            AssertThrowMPI(ierr);
+          }
+
+      const auto receive_message = [&](const MPI_Status &status) {
+        int       n_bytes = 0;
+        const int ierr    = MPI_Get_count(&status, MPI_BYTE, &n_bytes);
+        AssertThrowMPI(ierr);
+        AssertDimension(n_bytes % sizeof(T), 0);
+
+        const unsigned int source = status.MPI_SOURCE;
+        Assert(received_data.find(source) == received_data.end(),
+               ExcMessage("The same process sent data twice in one "
+                          "exchange. Two subsequent exchanges probably use "
+                          "the same tag."));
+        std::vector<T> &buffer = received_data[source];
+        buffer.resize(n_bytes / sizeof(T));
+        const int ierr_recv = MPI_Recv(buffer.data(),
+                                       n_bytes,
+                                       MPI_BYTE,
+                                       source,
+                                       tag,
+                                       mpi_comm,
+                                       MPI_STATUS_IGNORE);
+        AssertThrowMPI(ierr_recv);
+      };
+
+#    if DEAL_II_MPI_VERSION_GTE(3, 0)
+      MPI_Request barrier_request;
+      bool        barrier_posted = false;
+      while (true)
+        {
+          // receive whatever message has arrived
+          MPI_Status status;
+          int        message_arrived = 0;
+          int ierr = MPI_Iprobe(
+            MPI_ANY_SOURCE, tag, mpi_comm, &message_arrived, &status);
+          AssertThrowMPI(ierr);
+          if (message_arrived)
+            receive_message(status);
+
+          if (barrier_posted)
+            {
+              // all processes have their messages matched, so no more
+              // messages can arrive
+              int barrier_done = 0;
+              ierr             = MPI_Test(&barrier_request,
+                              &barrier_done,
+                              MPI_STATUS_IGNORE);
+              AssertThrowMPI(ierr);
+              if (barrier_done)
+                break;
+            }
+          else
+            {
+              int all_sent = 0;
+              ierr         = MPI_Testall(send_requests.size(),
+                                 send_requests.data(),
+                                 &all_sent,
+                                 MPI_STATUSES_IGNORE);
+              AssertThrowMPI(ierr);
+              if (all_sent)
+                {
+                  ierr = MPI_Ibarrier(mpi_comm, &barrier_request);
+                  AssertThrowMPI(ierr);
+                  barrier_posted = true;
+                }
+            }
+        }
+#    else
+      std::vector<unsigned int> send_to;
+      for (const auto &rank_data : data_to_send)
+        if (rank_data.first != my_pid)
+          send_to.push_back(rank_data.first);
+      const unsigned int n_messages =
+        compute_n_point_to_point_communications(mpi_comm, send_to);
+      for (unsigned int i = 0; i < n_messages; ++i)
+        {
+          MPI_Status status;
+          const int  ierr = MPI_Probe(MPI_ANY_SOURCE, tag, mpi_comm, &status);
+          AssertThrowMPI(ierr);
+          receive_message(status);
+        }
+      if (send_requests.size() > 0)
+        {
+          const int ierr = MPI_Waitall(send_requests.size(),
+                                       send_requests.data(),
+                                       MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+#    endif
+#  endif // deal.II with MPI
+
+      return received_data;
+    }
+
     template <typename T>
     std::map<unsigned int, T>
     some_to_some(const MPI_Comm &                 comm,
@@ -727,76 +969,17 @@ namespace Utilities
              ExcMessage("Can only send to myself or to nobody."));
       return objects_to_send;
 #  else
+      std::map<unsigned int, std::vector<char>> buffers_to_send;
+      for (const auto &rank_obj : objects_to_send)
+        buffers_to_send[rank_obj.first] = Utilities::pack(rank_obj.second);
 
-      std::vector<unsigned int> send_to(objects_to_send.size());
-      {
-        unsigned int i = 0;
-        for (const auto &m : objects_to_send)
-          send_to[i++] = m.first;
-      }
-      AssertDimension(send_to.size(), objects_to_send.size());
-
-      const auto receive_from =
-        Utilities::MPI::compute_point_to_point_communication_pattern(comm,
-                                                                     send_to);
-
-      // Sending buffers
-      std::vector<std::vector<char>> buffers_to_send(send_to.size());
-      std::vector<MPI_Request>       buffer_send_requests(send_to.size());
-      {
-        unsigned int i = 0;
-        for (const auto &rank_obj : objects_to_send)
-          {
-            const auto &rank   = rank_obj.first;
-            buffers_to_send[i] = Utilities::pack(rank_obj.second);
-            const int ierr     = MPI_Isend(buffers_to_send[i].data(),
-                                       buffers_to_send[i].size(),
-                                       MPI_CHAR,
-                                       rank,
-                                       21,
-                                       comm,
-                                       &buffer_send_requests[i]);
-            AssertThrowMPI(ierr);
-            ++i;
-          }
-      }
+      const std::map<unsigned int, std::vector<char>> received_buffers =
+        some_to_some(comm, buffers_to_send);
 
-      // Receiving buffers
       std::map<unsigned int, T> received_objects;
-      {
-        std::vector<char> buffer;
-        // We do this on a first come/first served basis
-        for (unsigned int i = 0; i < receive_from.size(); ++i)
-          {
-            // Probe what's going on. Take data from the first available sender
-            MPI_Status status;
-            int        ierr = MPI_Probe(MPI_ANY_SOURCE, 21, comm, &status);
-            AssertThrowMPI(ierr);
-
-            // Length of the message
-            int len;
-            ierr = MPI_Get_count(&status, MPI_CHAR, &len);
-            AssertThrowMPI(ierr);
-            buffer.resize(len);
-
-            // Source rank
-            const unsigned int rank = status.MPI_SOURCE;
-
-            // Actually receive the message
-            ierr = MPI_Recv(
-              buffer.data(), len, MPI_CHAR, rank, 21, comm, MPI_STATUS_IGNORE);
-            AssertThrowMPI(ierr);
-            Assert(received_objects.find(rank) == received_objects.end(),
-                   ExcInternalError(
-                     "I should not receive again from this rank"));
-            received_objects[rank] = Utilities::unpack<T>(buffer);
-          }
-      }
-
-      // Wait to have sent all objects.
-      MPI_Waitall(send_to.size(),
-                  buffer_send_requests.data(),
-                  MPI_STATUSES_IGNORE);
+      for (const auto &rank_buffer : received_buffers)
+        received_objects[rank_buffer.first] =
+          Utilities::unpack<T>(rank_buffer.second);
 
       return received_objects;
 #  endif // deal.II with MPI
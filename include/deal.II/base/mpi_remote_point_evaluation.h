@@ -0,0 +1,492 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_base_mpi_remote_point_evaluation_h
+#define dealii_base_mpi_remote_point_evaluation_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/fe/mapping.h>
+
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include <boost/signals2.hpp>
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    /**
+     * A class to repeatedly evaluate quantities at a fixed set of points on
+     * a (possibly distributed) triangulation, where the points may lie on
+     * the part of the mesh owned by another process.
+     *
+     * GridTools::distributed_compute_point_locations() determines which
+     * process owns the cell around each point, and the reference
+     * coordinates of the point within that cell. It has to compute the
+     * bounding boxes of the locally owned parts of the mesh of all
+     * processes and sets up the communication from scratch on every call,
+     * which is expensive if the same points, e.g., probes or the quadrature
+     * points of an immersed interface, are to be evaluated in every time
+     * step. This class does that work once in reinit() and stores
+     * - the locally owned cells around the points of all processes together
+     *   with the reference coordinates of the points, and
+     * - the pattern of the point-to-point communication that sends the
+     *   values computed at these points to the processes that asked for
+     *   them.
+     *
+     * Each subsequent call of evaluate_and_process() then only evaluates
+     * the values on the local cells through a user-provided function and
+     * exchanges them with the neighboring processes in a single round of
+     * point-to-point messages. VectorTools::point_values() builds on this
+     * function to evaluate finite element fields.
+     *
+     * If the points move a bit, e.g., in a fluid-structure interaction
+     * problem, update() sends the new coordinates along the existing
+     * communication pattern and searches them in the previous cell and the
+     * cells sharing a vertex with it. Only if a point has left the part of
+     * the mesh owned by the processes that evaluated it before, or if a
+     * point was not found at all, the full search of reinit() is repeated.
+     *
+     * A point on the boundary between cells may be found on several cells,
+     * possibly on different processes. In that case, all of these cells
+     * contribute a value, see get_point_ptrs().
+     *
+     * The global bounding boxes of the mesh are kept between calls of
+     * reinit() and update() until the triangulation changes. After a change
+     * of the triangulation, reinit() has to be called before the object
+     * can be used again.
+     */
+    template <int dim, int spacedim = dim>
+    class RemotePointEvaluation
+    {
+    public:
+      /**
+       * The locally owned cells around the points evaluated on the current
+       * process and the reference coordinates of these points.
+       */
+      struct CellData
+      {
+        /**
+         * The level and index of the cells.
+         */
+        std::vector<std::pair<int, int>> cells;
+
+        /**
+         * The points in cell <tt>cells[c]</tt> are
+         * <tt>reference_point_values[reference_point_ptrs[c]]</tt> to
+         * <tt>reference_point_values[reference_point_ptrs[c+1]-1]</tt>.
+         */
+        std::vector<unsigned int> reference_point_ptrs;
+
+        /**
+         * The coordinates of the points on the reference cell.
+         */
+        std::vector<Point<dim>> reference_point_values;
+      };
+
+      /**
+       * Constructor. Points whose reference coordinates are inside the unit
+       * cell up to @p tolerance are considered to lie in a cell when
+       * relocating them in update().
+       */
+      RemotePointEvaluation(const double tolerance = 1e-10);
+
+      /**
+       * Destructor.
+       */
+      ~RemotePointEvaluation();
+
+      /**
+       * Find the cells around the @p points of the current process on
+       * @p tria, as seen through @p mapping, and set up the communication
+       * pattern. The communicator is the one of @p tria if it is a
+       * parallel::Triangulation, and MPI_COMM_SELF otherwise.
+       *
+       * @note This is a collective operation.
+       */
+      void
+      reinit(const std::vector<Point<spacedim>> &points,
+             const Triangulation<dim, spacedim> &tria,
+             const Mapping<dim, spacedim> &      mapping);
+
+      /**
+       * Move the points of the current process to the new locations
+       * @p points, which must have as many entries as the points passed to
+       * reinit(). Points that are still found on the cells they were
+       * evaluated on before, or on the locally owned cells sharing a vertex
+       * with these cells, are relocated without a global search. Otherwise,
+       * reinit() is called on all processes.
+       *
+       * @return Whether the cheap relocation succeeded on all processes,
+       * i.e., false if reinit() had to be called.
+       *
+       * @note This is a collective operation.
+       */
+      bool
+      update(const std::vector<Point<spacedim>> &points);
+
+      /**
+       * Evaluate quantities at the points and send the results to the
+       * processes that own the points. The function @p evaluation_function
+       * is called once with the CellData of the current process and an array
+       * of the same size as CellData::reference_point_values that it has to
+       * fill with the values at the respective points. The values arriving
+       * for the points of the current process are written to @p output,
+       * which is resized to the last element of get_point_ptrs(). The
+       * values of point @p i are stored in the entries
+       * <tt>[get_point_ptrs()[i], get_point_ptrs()[i+1])</tt>.
+       *
+       * The type @p T must be trivially copyable, since the values are
+       * sent as arrays of bytes.
+       *
+       * @note This is a collective operation over the processes that
+       * exchange points with the current process.
+       */
+      template <typename T>
+      void
+      evaluate_and_process(
+        std::vector<T> &output,
+        const std::function<void(const ArrayView<T> &, const CellData &)>
+          &evaluation_function) const;
+
+      /**
+       * Return the offsets of the values of the points of the current process
+       * in the output of evaluate_and_process(). The size of the vector is
+       * the number of points plus one. A point that was not found on any
+       * cell has no values.
+       */
+      const std::vector<unsigned int> &
+      get_point_ptrs() const;
+
+      /**
+       * Return the cells and reference coordinates of the points evaluated
+       * on the current process.
+       */
+      const CellData &
+      get_cell_data() const;
+
+      /**
+       * Return whether each point of the current process has been found on
+       * exactly one cell.
+       */
+      bool
+      is_map_unique() const;
+
+      /**
+       * Return whether all points of the current process have been found.
+       */
+      bool
+      all_points_found() const;
+
+      /**
+       * Return whether the point with index @p i of the current process has
+       * been found.
+       */
+      bool
+      point_found(const unsigned int i) const;
+
+      /**
+       * Return the triangulation passed to reinit().
+       */
+      const Triangulation<dim, spacedim> &
+      get_triangulation() const;
+
+      /**
+       * Return the mapping passed to reinit().
+       */
+      const Mapping<dim, spacedim> &
+      get_mapping() const;
+
+      /**
+       * Return whether reinit() has been called and the triangulation has
+       * not changed since.
+       */
+      bool
+      is_ready() const;
+
+    private:
+      /**
+       * Send the parts <tt>[send_ptrs[i], send_ptrs[i+1])</tt> of
+       * @p send_buffer to the processes <tt>send_ranks[i]</tt> and receive
+       * the parts <tt>[recv_ptrs[i], recv_ptrs[i+1])</tt> of @p recv_buffer
+       * from the processes <tt>recv_ranks[i]</tt>. The data the current
+       * process sends to itself is copied.
+       */
+      template <typename T>
+      void
+      exchange(const std::vector<T> &           send_buffer,
+               const std::vector<unsigned int> &send_ranks,
+               const std::vector<unsigned int> &send_ptrs,
+               std::vector<T> &                 recv_buffer,
+               const std::vector<unsigned int> &recv_ranks,
+               const std::vector<unsigned int> &recv_ptrs,
+               const int                        channel) const;
+
+      /**
+       * Compute the offsets of the values of the @p n_points points of the
+       * current process in the output and the position of each received
+       * value in the output from @p recv_point_indices.
+       */
+      void
+      setup_output_pattern(const unsigned int n_points);
+
+      /**
+       * Tolerance for the relocation of points in update().
+       */
+      const double tolerance;
+
+      /**
+       * The communicator of the triangulation.
+       */
+      MPI_Comm communicator;
+
+      /**
+       * The triangulation and mapping passed to reinit().
+       */
+      SmartPointer<const Triangulation<dim, spacedim>> tria;
+      SmartPointer<const Mapping<dim, spacedim>>       mapping;
+
+      /**
+       * A cache for the triangulation and mapping, used for the vertex to
+       * cell map in update().
+       */
+      std::unique_ptr<GridTools::Cache<dim, spacedim>> cache;
+
+      /**
+       * The bounding boxes of the locally owned parts of the mesh of all
+       * processes. Empty if they have not been computed yet.
+       */
+      std::vector<std::vector<BoundingBox<spacedim>>> global_bboxes;
+
+      /**
+       * Connection to the signal of the triangulation that invalidates the
+       * data of this object.
+       */
+      boost::signals2::connection tria_signal;
+
+      /**
+       * Whether reinit() has been called and the triangulation has not
+       * changed since.
+       */
+      bool ready;
+
+      /**
+       * The cells and reference points evaluated on the current process.
+       */
+      CellData cell_data;
+
+      /**
+       * The ranks of the processes the values evaluated on the current
+       * process are sent to, the offsets of their parts in the send buffer,
+       * and the position in the send buffer of each evaluated point.
+       */
+      std::vector<unsigned int> send_ranks;
+      std::vector<unsigned int> send_ptrs;
+      std::vector<unsigned int> send_permutation;
+
+      /**
+       * The ranks of the processes that evaluate points of the current
+       * process, the offsets of their parts in the receive buffer, the
+       * index of the point each received value belongs to, and the position
+       * of each received value in the output.
+       */
+      std::vector<unsigned int> recv_ranks;
+      std::vector<unsigned int> recv_ptrs;
+      std::vector<unsigned int> recv_point_indices;
+      std::vector<unsigned int> recv_permutation;
+
+      /**
+       * The offsets of the values of each point in the output.
+       */
+      std::vector<unsigned int> point_ptrs;
+    };
+
+
+
+    /* ------------------------- inline functions ----------------------- */
+
+
+    template <int dim, int spacedim>
+    template <typename T>
+    void
+    RemotePointEvaluation<dim, spacedim>::evaluate_and_process(
+      std::vector<T> &output,
+      const std::function<void(const ArrayView<T> &, const CellData &)>
+        &evaluation_function) const
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+                    "The values must be trivially copyable.");
+      Assert(ready,
+             ExcMessage("RemotePointEvaluation::reinit() has to be called "
+                        "after creation or a change of the triangulation."));
+
+      // evaluate the values on the local cells and sort them by the
+      // receiving process
+      std::vector<T> evaluated_values(cell_data.reference_point_values.size());
+      evaluation_function(make_array_view(evaluated_values), cell_data);
+      std::vector<T> send_buffer(evaluated_values.size());
+      for (unsigned int i = 0; i < evaluated_values.size(); ++i)
+        send_buffer[send_permutation[i]] = evaluated_values[i];
+
+      std::vector<T> recv_buffer(recv_point_indices.size());
+      exchange(send_buffer,
+               send_ranks,
+               send_ptrs,
+               recv_buffer,
+               recv_ranks,
+               recv_ptrs,
+               32754);
+
+      output.resize(point_ptrs.back());
+      for (unsigned int i = 0; i < recv_buffer.size(); ++i)
+        output[recv_permutation[i]] = recv_buffer[i];
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <typename T>
+    void
+    RemotePointEvaluation<dim, spacedim>::exchange(
+      const std::vector<T> &           send_buffer,
+      const std::vector<unsigned int> &send_ranks,
+      const std::vector<unsigned int> &send_ptrs,
+      std::vector<T> &                 recv_buffer,
+      const std::vector<unsigned int> &recv_ranks,
+      const std::vector<unsigned int> &recv_ptrs,
+      const int                        channel) const
+    {
+      const unsigned int my_rank = this_mpi_process(communicator);
+
+#ifdef DEAL_II_WITH_MPI
+      std::vector<MPI_Request> requests;
+      requests.reserve(recv_ranks.size() + send_ranks.size());
+      for (unsigned int i = 0; i < recv_ranks.size(); ++i)
+        if (recv_ranks[i] != my_rank)
+          {
+            requests.emplace_back();
+            const int ierr =
+              MPI_Irecv(recv_buffer.data() + recv_ptrs[i],
+                        (recv_ptrs[i + 1] - recv_ptrs[i]) * sizeof(T),
+                        MPI_BYTE,
+                        recv_ranks[i],
+                        channel,
+                        communicator,
+                        &requests.back());
+            AssertThrowMPI(ierr);
+          }
+      for (unsigned int i = 0; i < send_ranks.size(); ++i)
+        if (send_ranks[i] != my_rank)
+          {
+            requests.emplace_back();
+            const int ierr =
+              MPI_Isend(send_buffer.data() + send_ptrs[i],
+                        (send_ptrs[i + 1] - send_ptrs[i]) * sizeof(T),
+                        MPI_BYTE,
+                        send_ranks[i],
+                        channel,
+                        communicator,
+                        &requests.back());
+            AssertThrowMPI(ierr);
+          }
+#else
+      (void)channel;
+#endif
+
+      for (unsigned int i = 0; i < send_ranks.size(); ++i)
+        if (send_ranks[i] == my_rank)
+          for (unsigned int j = 0; j < recv_ranks.size(); ++j)
+            if (recv_ranks[j] == my_rank)
+              {
+                AssertDimension(send_ptrs[i + 1] - send_ptrs[i],
+                                recv_ptrs[j + 1] - recv_ptrs[j]);
+                std::copy(send_buffer.begin() + send_ptrs[i],
+                          send_buffer.begin() + send_ptrs[i + 1],
+                          recv_buffer.begin() + recv_ptrs[j]);
+              }
+
+#ifdef DEAL_II_WITH_MPI
+      if (requests.size() > 0)
+        {
+          const int ierr = MPI_Waitall(requests.size(),
+                                       requests.data(),
+                                       MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+#endif
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline const std::vector<unsigned int> &
+    RemotePointEvaluation<dim, spacedim>::get_point_ptrs() const
+    {
+      return point_ptrs;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline const typename RemotePointEvaluation<dim, spacedim>::CellData &
+    RemotePointEvaluation<dim, spacedim>::get_cell_data() const
+    {
+      return cell_data;
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline bool
+    RemotePointEvaluation<dim, spacedim>::point_found(
+      const unsigned int i) const
+    {
+      AssertIndexRange(i + 1, point_ptrs.size());
+      return point_ptrs[i + 1] > point_ptrs[i];
+    }
+
+
+
+    template <int dim, int spacedim>
+    inline bool
+    RemotePointEvaluation<dim, spacedim>::is_ready() const
+    {
+      return ready;
+    }
+  } // namespace MPI
+} // namespace Utilities
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -42,6 +42,11 @@ DEAL_II_NAMESPACE_OPEN
  * threads can be queried using MultithreadInfo::n_threads(), while the number
  * of cores in the system is returned by MultithreadInfo::n_cores().
  *
+ * If deal.II was configured without the Threading Building Blocks, tasks and
+ * parallel loops are run on a thread pool built on std::thread instead, whose
+ * number of threads and placement on the cores of the system are controlled
+ * by set_thread_limit() and set_thread_affinity().
+ *
  * @ingroup threads
  * @author Thomas Richter, Wolfgang Bangerth, 2000
  */
@@ -99,6 +104,29 @@ public:
   set_thread_limit(
     const unsigned int max_threads = numbers::invalid_unsigned_int);
 
+  /**
+   * Set whether the threads that work on tasks are pinned to individual
+   * cores, which avoids the migration of threads between cores and thus
+   * keeps their data in the caches and, on NUMA systems, in the local
+   * memory. If set, the thread calling this function is pinned to a core as
+   * well.
+   *
+   * The threads are only placed on the cores the process may run on when
+   * this function is first called with @p pin_threads set, as returned by
+   * <code>sched_getaffinity</code>. If several MPI processes share a node,
+   * they should therefore be bound to disjoint sets of cores through the
+   * binding options of the MPI launcher; the threads of each process are
+   * then spread over the cores of its own set. Calling this function with
+   * @p pin_threads unset lets the calling thread run on all of these cores
+   * again.
+   *
+   * This function only has an effect if deal.II was configured without the
+   * Threading Building Blocks and uses its own thread pool; the placement of
+   * the threads of the TBB is left to the TBB.
+   */
+  static void
+  set_thread_affinity(const bool pin_threads);
+
   /**
    * Return if the TBB is running using a single thread either because of
    * thread affinity or because it is set via a call to set_thread_limit. This
@@ -26,8 +26,10 @@
 
 #include <cstddef>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <tuple>
+#include <vector>
 
 #ifdef DEAL_II_WITH_THREADS
 #  include <tbb/blocked_range.h>
@@ -36,6 +38,10 @@
 #  include <tbb/partitioner.h>
 #endif
 
+#ifdef DEAL_II_USE_THREAD_POOL
+#  include <deal.II/base/thread_pool.h>
+#endif
+
 
 // TODO[WB]: allow calling functions to pass along a tbb::affinity_partitioner
 // object to ensure that subsequent calls use the same cache lines
@@ -46,6 +52,31 @@ namespace parallel
 {
   namespace internal
   {
+#ifdef DEAL_II_USE_THREAD_POOL
+    /**
+     * Split the range of @p n elements into chunks of at least
+     * @p grainsize elements and call <code>f(begin, end)</code> for the
+     * index range <code>[begin,end)</code> of each chunk, in parallel on
+     * the thread pool of deal.II. This is the replacement of
+     * tbb::parallel_for used if deal.II is configured without the Threading
+     * Building Blocks.
+     */
+    template <typename Function>
+    void
+    parallel_for_on_thread_pool(const std::size_t  n,
+                                const Function &   f,
+                                const unsigned int grainsize)
+    {
+      using Threads::internal::ThreadPool;
+      ThreadPool &       pool     = ThreadPool::instance();
+      const unsigned int n_chunks = pool.n_chunks(n, grainsize);
+      pool.run_chunks(n_chunks, [&](const unsigned int chunk) {
+        f(ThreadPool::chunk_begin(n, n_chunks, chunk),
+          ThreadPool::chunk_begin(n, n_chunks, chunk + 1));
+      });
+    }
+#endif
+
     /**
      * Helper struct to tell us if we can use SIMD instructions for the given
      * @p Number type.
@@ -176,7 +207,17 @@ namespace parallel
             Predicate &          predicate,
             const unsigned int   grainsize)
   {
-#ifndef DEAL_II_WITH_THREADS
+#if defined(DEAL_II_USE_THREAD_POOL)
+    internal::parallel_for_on_thread_pool(
+      std::distance(begin_in, end_in),
+      [&](const std::size_t begin, const std::size_t end) {
+        InputIterator  in     = std::next(begin_in, begin);
+        OutputIterator out_it = std::next(out, begin);
+        for (std::size_t i = begin; i < end; ++i)
+          *out_it++ = predicate(*in++);
+      },
+      grainsize);
+#elif !defined(DEAL_II_WITH_THREADS)
     // make sure we don't get compiler
     // warnings about unused arguments
     (void)grainsize;
@@ -233,7 +274,18 @@ namespace parallel
             Predicate &           predicate,
             const unsigned int    grainsize)
   {
-#ifndef DEAL_II_WITH_THREADS
+#if defined(DEAL_II_USE_THREAD_POOL)
+    internal::parallel_for_on_thread_pool(
+      std::distance(begin_in1, end_in1),
+      [&](const std::size_t begin, const std::size_t end) {
+        InputIterator1 in1    = std::next(begin_in1, begin);
+        InputIterator2 in2_it = std::next(in2, begin);
+        OutputIterator out_it = std::next(out, begin);
+        for (std::size_t i = begin; i < end; ++i)
+          *out_it++ = predicate(*in1++, *in2_it++);
+      },
+      grainsize);
+#elif !defined(DEAL_II_WITH_THREADS)
     // make sure we don't get compiler
     // warnings about unused arguments
     (void)grainsize;
@@ -293,7 +345,19 @@ namespace parallel
             Predicate &           predicate,
             const unsigned int    grainsize)
   {
-#ifndef DEAL_II_WITH_THREADS
+#if defined(DEAL_II_USE_THREAD_POOL)
+    internal::parallel_for_on_thread_pool(
+      std::distance(begin_in1, end_in1),
+      [&](const std::size_t begin, const std::size_t end) {
+        InputIterator1 in1    = std::next(begin_in1, begin);
+        InputIterator2 in2_it = std::next(in2, begin);
+        InputIterator3 in3_it = std::next(in3, begin);
+        OutputIterator out_it = std::next(out, begin);
+        for (std::size_t i = begin; i < end; ++i)
+          *out_it++ = predicate(*in1++, *in2_it++, *in3_it++);
+      },
+      grainsize);
+#elif !defined(DEAL_II_WITH_THREADS)
     // make sure we don't get compiler
     // warnings about unused arguments
     (void)grainsize;
@@ -414,7 +478,14 @@ namespace parallel
                      const Function &                          f,
                      const unsigned int                        grainsize)
   {
-#ifndef DEAL_II_WITH_THREADS
+#if defined(DEAL_II_USE_THREAD_POOL)
+    internal::parallel_for_on_thread_pool(
+      end - begin,
+      [&](const std::size_t sub_begin, const std::size_t sub_end) {
+        f(begin + sub_begin, begin + sub_end);
+      },
+      grainsize);
+#elif !defined(DEAL_II_WITH_THREADS)
     // make sure we don't get compiler
     // warnings about unused arguments
     (void)grainsize;
@@ -654,7 +725,24 @@ namespace parallel
                             const typename identity<RangeType>::type &end,
                             const unsigned int                        grainsize)
   {
-#ifndef DEAL_II_WITH_THREADS
+#if defined(DEAL_II_USE_THREAD_POOL)
+    // sum up the results of the chunks in a fixed order, which makes the
+    // result reproducible for a given number of threads
+    using Threads::internal::ThreadPool;
+    ThreadPool &            pool     = ThreadPool::instance();
+    const std::size_t       n        = end - begin;
+    const unsigned int      n_chunks = pool.n_chunks(n, grainsize);
+    std::vector<ResultType> results(n_chunks);
+    pool.run_chunks(n_chunks, [&](const unsigned int chunk) {
+      results[chunk] =
+        f(begin + ThreadPool::chunk_begin(n, n_chunks, chunk),
+          begin + ThreadPool::chunk_begin(n, n_chunks, chunk + 1));
+    });
+    ResultType result = results[0];
+    for (unsigned int chunk = 1; chunk < n_chunks; ++chunk)
+      result += results[chunk];
+    return result;
+#elif !defined(DEAL_II_WITH_THREADS)
     // make sure we don't get compiler
     // warnings about unused arguments
     (void)grainsize;
@@ -818,7 +906,14 @@ namespace parallel
     const std::size_t end,
     const std::size_t minimum_parallel_grain_size) const
   {
-#ifndef DEAL_II_WITH_THREADS
+#if defined(DEAL_II_USE_THREAD_POOL)
+    internal::parallel_for_on_thread_pool(
+      end - begin,
+      [&](const std::size_t sub_begin, const std::size_t sub_end) {
+        apply_to_subrange(begin + sub_begin, begin + sub_end);
+      },
+      minimum_parallel_grain_size);
+#elif !defined(DEAL_II_WITH_THREADS)
     // make sure we don't get compiler
     // warnings about unused arguments
     (void)minimum_parallel_grain_size;
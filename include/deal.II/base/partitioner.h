@@ -30,6 +30,7 @@
 #include <deal.II/lac/vector.h>
 #include <deal.II/lac/vector_operation.h>
 
+#include <complex>
 #include <limits>
 
 
@@ -39,6 +40,36 @@ namespace Utilities
 {
   namespace MPI
   {
+    namespace internal
+    {
+      /**
+       * The number type in which ghost values of type @p Number are
+       * transmitted by
+       * Partitioner::export_to_ghosted_array_reduced_precision_start():
+       * double precision values are sent in single precision, all other
+       * types are sent unchanged.
+       */
+      template <typename Number>
+      struct ReducedPrecision
+      {
+        using type = Number;
+      };
+
+      template <>
+      struct ReducedPrecision<double>
+      {
+        using type = float;
+      };
+
+      template <>
+      struct ReducedPrecision<std::complex<double>>
+      {
+        using type = std::complex<float>;
+      };
+    } // namespace internal
+
+
+
     /**
      * This class defines a model for the partitioning of a vector (or, in
      * fact, any linear data structure) among processors using MPI.
@@ -54,7 +85,12 @@ namespace Utilities
      * from. In a sense, these import indices form the dual of the ghost
      * indices. This information is gathered once when constructing the
      * partitioner, which obviates subsequent global communication steps when
-     * exchanging data.
+     * exchanging data. The owners of the ghost indices are found by a lookup
+     * in a distributed dictionary (see Utilities::MPI::compute_index_owner())
+     * rather than by making the locally owned ranges of all processors known
+     * everywhere, such that the setup cost scales with the number of
+     * processors that actually exchange data, not with the total number of
+     * processors.
      *
      * The figure below gives an example of index space $[0,74)$ being split
      * into four processes.
@@ -104,6 +140,12 @@ namespace Utilities
      * </ul>
      *
      * The MPI communication routines are point-to-point communication patterns.
+     * Since the pattern is the same in every exchange, callers that exchange
+     * data on the same arrays repeatedly, such as
+     * LinearAlgebra::distributed::Vector, can set up persistent requests
+     * once with initialize_persistent_export_requests() and
+     * initialize_persistent_import_requests(), such that each exchange only
+     * needs to start these requests.
      *
      * <h4>Sending only selected ghost data</h4>
      *
@@ -122,6 +164,27 @@ namespace Utilities
      * detect this case and only send the selected indices, taken from the
      * full array of ghost entries.
      *
+     * <h4>Exchange through shared memory</h4>
+     *
+     * When several MPI processes run on the same compute node, sending ghost
+     * data through MPI_Isend() and MPI_Irecv() copies the data through the
+     * MPI library even though all processes could directly access the
+     * memory of their neighbors. After calling
+     * enable_shared_memory_communication() before the ghost indices are set,
+     * this class splits the communication pattern into a part for processes
+     * on the same node and a part for remote processes. Only the latter uses
+     * point-to-point messages carrying data. For the former, the
+     * export_to_ghosted_array_finish() and import_from_ghosted_array_finish()
+     * functions directly read from the arrays of the neighbors, which must
+     * have been allocated in an MPI-3 shared-memory window and are passed to
+     * these functions as a list of array views, one for each process in
+     * get_shared_memory_communicator(). The processes synchronize with their
+     * neighbors on the same node through zero-byte messages, so the
+     * operations still only involve processes that actually exchange data.
+     * LinearAlgebra::distributed::Vector sets up its memory in a shared
+     * window automatically if its partitioner has shared memory
+     * communication enabled.
+     *
      * @author Katharina Kormann, Martin Kronbichler, 2010, 2011, 2017
      */
     class Partitioner : public ::dealii::LinearAlgebra::CommunicationPatternBase
@@ -159,6 +222,23 @@ namespace Utilities
       Partitioner(const IndexSet &locally_owned_indices,
                   const MPI_Comm  communicator_in);
 
+      /**
+       * Copy constructor. Deleted, since the destructor frees the
+       * shared-memory communicator, which copies would free a second time.
+       */
+      Partitioner(const Partitioner &) = delete;
+
+      /**
+       * Copy assignment. Deleted for the same reason as the copy constructor.
+       */
+      Partitioner &
+      operator=(const Partitioner &) = delete;
+
+      /**
+       * Destructor.
+       */
+      virtual ~Partitioner() override;
+
       /**
        * Reinitialize the communication pattern. The first argument @p
        * vector_space_vector_index_set is the index set associated to a
@@ -385,6 +465,57 @@ namespace Utilities
       bool
       ghost_indices_initialized() const;
 
+      /**
+       * Enable the exchange of ghost data with processes on the same compute
+       * node through MPI-3 shared memory instead of MPI messages, see the
+       * general documentation of this class. This function creates a
+       * communicator of all processes in get_mpi_communicator() that can
+       * access each other's memory and needs to be called by all processes
+       * of the communicator before set_ghost_indices(). The setting is kept
+       * for subsequent calls to reinit().
+       *
+       * @note This option requires an MPI library supporting the MPI-3.0
+       * standard and is not supported for data in MemorySpace::CUDA.
+       */
+      void
+      enable_shared_memory_communication();
+
+      /**
+       * Return whether enable_shared_memory_communication() has been called
+       * on this object.
+       */
+      bool
+      shared_memory_communication_enabled() const;
+
+      /**
+       * Return the MPI communicator containing all processes of
+       * get_mpi_communicator() on the same compute node as the calling
+       * process. Ghost data is exchanged through shared memory among the
+       * processes of this communicator. If
+       * enable_shared_memory_communication() has not been called, this is
+       * MPI_COMM_SELF.
+       */
+      const MPI_Comm &
+      get_shared_memory_communicator() const;
+
+      /**
+       * Return the rank within get_shared_memory_communicator() for each of
+       * the processes in ghost_targets(), or numbers::invalid_unsigned_int
+       * in case the data of the respective process is exchanged through MPI
+       * messages.
+       */
+      const std::vector<unsigned int> &
+      ghost_targets_shared_memory_ranks() const;
+
+      /**
+       * Return the rank within get_shared_memory_communicator() for each of
+       * the processes in import_targets(), or numbers::invalid_unsigned_int
+       * in case the data of the respective process is exchanged through MPI
+       * messages.
+       */
+      const std::vector<unsigned int> &
+      import_targets_shared_memory_ranks() const;
+
 #ifdef DEAL_II_WITH_MPI
       /**
        * Start the exports of the data in a locally owned array to the range
@@ -417,6 +548,18 @@ namespace Utilities
        * communication that will be finalized in the
        * export_to_ghosted_array_finish() call.
        *
+       * @param persistent_requests If not empty, the persistent requests set
+       * up by initialize_persistent_export_requests() for the same
+       * communication channel and the same arrays. Rather than posting new
+       * messages, these requests are then started with MPI_Startall(), and
+       * @p requests is filled with copies of their handles.
+       *
+       * @param shared_window In case shared memory communication is enabled,
+       * the MPI-3 shared-memory window that holds @p locally_owned_array. It
+       * is synchronized with MPI_Win_sync() before the processes on the same
+       * node are told that the data can be read. The window must be in a
+       * passive target epoch on all processes, see MPI_Win_lock_all().
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::update_ghost_values().
        */
@@ -427,7 +570,10 @@ namespace Utilities
         const ArrayView<const Number, MemorySpaceType> &locally_owned_array,
         const ArrayView<Number, MemorySpaceType> &      temporary_storage,
         const ArrayView<Number, MemorySpaceType> &      ghost_array,
-        std::vector<MPI_Request> &                      requests) const;
+        std::vector<MPI_Request> &                      requests,
+        const std::vector<MPI_Request> &                persistent_requests =
+          std::vector<MPI_Request>(),
+        const MPI_Win shared_window = MPI_WIN_NULL) const;
 
       /**
        * Finish the exports of the data in a locally owned array to the range
@@ -443,14 +589,35 @@ namespace Utilities
        * export_to_ghosted_array_start() call. This must be the same array as
        * passed to that function, otherwise MPI will likely throw an error.
        *
+       * @param shared_arrays In case shared memory communication is enabled,
+       * views to the arrays (both locally owned and ghost entries) of all
+       * processes in get_shared_memory_communicator(), indexed by the rank in
+       * that communicator. The ghost data of processes on the same node is
+       * directly read from these arrays. Unused otherwise.
+       *
+       * @param communication_channel The same channel as passed to
+       * export_to_ghosted_array_start(). In case shared memory communication
+       * is enabled, it determines the tag of the messages that signal to the
+       * processes on the same node that their data has been read, such that
+       * concurrent exchanges on different channels do not interfere.
+       *
+       * @param shared_window The shared-memory window that holds the arrays
+       * in @p shared_arrays, see export_to_ghosted_array_start(). It is
+       * synchronized with MPI_Win_sync() before the data of the neighbors is
+       * read and around the signals that the reading is done.
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::update_ghost_values().
        */
       template <typename Number, typename MemorySpaceType = MemorySpace::Host>
       void
       export_to_ghosted_array_finish(
-        const ArrayView<Number, MemorySpaceType> &ghost_array,
-        std::vector<MPI_Request> &                requests) const;
+        const ArrayView<Number, MemorySpaceType> &  ghost_array,
+        std::vector<MPI_Request> &                  requests,
+        const std::vector<ArrayView<const Number>> &shared_arrays =
+          std::vector<ArrayView<const Number>>(),
+        const unsigned int communication_channel = 0,
+        const MPI_Win      shared_window         = MPI_WIN_NULL) const;
 
       /**
        * Start importing the data on an array indexed by the ghost indices of
@@ -485,6 +652,15 @@ namespace Utilities
        * communication that will be finalized in the
        * export_to_ghosted_array_finish() call.
        *
+       * @param persistent_requests If not empty, the persistent requests set
+       * up by initialize_persistent_import_requests() for the same
+       * communication channel and the same arrays, which are then started
+       * with MPI_Startall() rather than posting new messages.
+       *
+       * @param shared_window In case shared memory communication is enabled,
+       * the MPI-3 shared-memory window that holds @p ghost_array, see
+       * export_to_ghosted_array_start().
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::compress().
        */
@@ -495,7 +671,10 @@ namespace Utilities
         const unsigned int                        communication_channel,
         const ArrayView<Number, MemorySpaceType> &ghost_array,
         const ArrayView<Number, MemorySpaceType> &temporary_storage,
-        std::vector<MPI_Request> &                requests) const;
+        std::vector<MPI_Request> &                requests,
+        const std::vector<MPI_Request> &          persistent_requests =
+          std::vector<MPI_Request>(),
+        const MPI_Win shared_window = MPI_WIN_NULL) const;
 
       /**
        * Finish importing the data from an array indexed by the ghost
@@ -528,6 +707,19 @@ namespace Utilities
        * import_to_ghosted_array_finish() call. This must be the same array as
        * passed to that function, otherwise MPI will likely throw an error.
        *
+       * @param shared_arrays In case shared memory communication is enabled,
+       * views to the arrays (both locally owned and ghost entries) of all
+       * processes in get_shared_memory_communicator(), indexed by the rank in
+       * that communicator. The ghost contributions of processes on the same
+       * node are directly read from these arrays. Unused otherwise.
+       *
+       * @param communication_channel The same channel as passed to
+       * import_from_ghosted_array_start(), see
+       * export_to_ghosted_array_finish().
+       *
+       * @param shared_window The shared-memory window that holds the arrays
+       * in @p shared_arrays, see export_to_ghosted_array_finish().
+       *
        * This functionality is used in
        * LinearAlgebra::distributed::Vector::compress().
        */
@@ -538,7 +730,108 @@ namespace Utilities
         const ArrayView<const Number, MemorySpaceType> &temporary_storage,
         const ArrayView<Number, MemorySpaceType> &      locally_owned_storage,
         const ArrayView<Number, MemorySpaceType> &      ghost_array,
-        std::vector<MPI_Request> &                      requests) const;
+        std::vector<MPI_Request> &                      requests,
+        const std::vector<ArrayView<const Number>> &    shared_arrays =
+          std::vector<ArrayView<const Number>>(),
+        const unsigned int communication_channel = 0,
+        const MPI_Win      shared_window         = MPI_WIN_NULL) const;
+
+      /**
+       * Set up persistent MPI requests (see MPI_Send_init() and
+       * MPI_Recv_init()) for the messages of export_to_ghosted_array_start()
+       * on the given arrays. Since the communication pattern and the arrays
+       * of a vector do not change between calls, repeated exchanges can then
+       * simply start these requests, which avoids the overhead of setting up
+       * the messages in the MPI library each time.
+       *
+       * The arguments have the same meaning as in
+       * export_to_ghosted_array_start(). The arrays must not be reallocated
+       * as long as the requests are in use. The requests must be freed with
+       * MPI_Request_free() by the caller once they are not needed anymore.
+       */
+      template <typename Number, typename MemorySpaceType = MemorySpace::Host>
+      void
+      initialize_persistent_export_requests(
+        const unsigned int                        communication_channel,
+        const ArrayView<Number, MemorySpaceType> &temporary_storage,
+        const ArrayView<Number, MemorySpaceType> &ghost_array,
+        std::vector<MPI_Request> &                persistent_requests) const;
+
+      /**
+       * Set up persistent MPI requests for the messages of
+       * import_from_ghosted_array_start() on the given arrays, see
+       * initialize_persistent_export_requests().
+       */
+      template <typename Number, typename MemorySpaceType = MemorySpace::Host>
+      void
+      initialize_persistent_import_requests(
+        const unsigned int                        communication_channel,
+        const ArrayView<Number, MemorySpaceType> &ghost_array,
+        const ArrayView<Number, MemorySpaceType> &temporary_storage,
+        std::vector<MPI_Request> &                persistent_requests) const;
+
+      /**
+       * Same as export_to_ghosted_array_start(), but the data is transmitted
+       * in the (typically lower) precision of
+       * internal::ReducedPrecision<Number>::type, i.e., double values are
+       * sent as float. Since the ghost exchange of a vector is usually
+       * limited by the bandwidth of the network, this halves its cost at the
+       * price of only approximately 7 correct digits in the ghost entries.
+       * Data from processes in the same shared-memory domain is still read
+       * in full precision.
+       *
+       * @param communication_channel See export_to_ghosted_array_start().
+       *
+       * @param locally_owned_array See export_to_ghosted_array_start().
+       *
+       * @param send_buffer A temporary storage array of length
+       * n_import_indices() that holds the converted data to be sent.
+       *
+       * @param receive_buffer A temporary storage array of length
+       * n_ghost_indices() that receives the data from remote processes.
+       * The data is converted into the ghost array in
+       * export_to_ghosted_array_reduced_precision_finish().
+       *
+       * @param requests See export_to_ghosted_array_start().
+       *
+       * @param shared_window See export_to_ghosted_array_start().
+       *
+       * This functionality is used in
+       * LinearAlgebra::distributed::Vector::update_ghost_values() if
+       * LinearAlgebra::distributed::Vector::set_reduced_precision_ghost_exchange()
+       * has been called.
+       */
+      template <typename Number>
+      void
+      export_to_ghosted_array_reduced_precision_start(
+        const unsigned int             communication_channel,
+        const ArrayView<const Number> &locally_owned_array,
+        const ArrayView<typename internal::ReducedPrecision<Number>::type>
+          &send_buffer,
+        const ArrayView<typename internal::ReducedPrecision<Number>::type>
+          &                       receive_buffer,
+        std::vector<MPI_Request> &requests,
+        const MPI_Win             shared_window = MPI_WIN_NULL) const;
+
+      /**
+       * Finish the exchange started by
+       * export_to_ghosted_array_reduced_precision_start() and convert the
+       * received data back to @p Number in @p ghost_array. The arguments
+       * have the same meaning as in export_to_ghosted_array_finish(), and
+       * @p receive_buffer must be the same array as passed to the start
+       * function.
+       */
+      template <typename Number>
+      void
+      export_to_ghosted_array_reduced_precision_finish(
+        const ArrayView<const typename internal::ReducedPrecision<Number>::type>
+          &                                         receive_buffer,
+        const ArrayView<Number> &                   ghost_array,
+        std::vector<MPI_Request> &                  requests,
+        const std::vector<ArrayView<const Number>> &shared_arrays =
+          std::vector<ArrayView<const Number>>(),
+        const unsigned int communication_channel = 0,
+        const MPI_Win      shared_window         = MPI_WIN_NULL) const;
 #endif
 
       /**
@@ -578,6 +871,34 @@ namespace Utilities
       void
       initialize_import_indices_plain_dev() const;
 
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * Set up the data structures for the exchange with the processes in
+       * communicator_sm, given the expanded list of ghost indices. Called
+       * from set_ghost_indices().
+       */
+      void
+      initialize_shared_memory_exchange(
+        const std::vector<types::global_dof_index> &expanded_ghost_indices);
+
+      /**
+       * Send a zero-byte message to the processes with ranks @p send_to and
+       * wait for the respective messages from the processes with ranks @p
+       * receive_from within communicator_sm, using the given @p tag. Used to
+       * signal that the shared arrays of the calling process are no longer
+       * accessed by its neighbors and vice versa. If @p shared_window is not
+       * MPI_WIN_NULL, it is synchronized with MPI_Win_sync() before the
+       * messages are sent and after they have been received, which orders
+       * the direct loads and stores to the window before and after the
+       * handshake.
+       */
+      void
+      shared_memory_handshake(const std::vector<unsigned int> &send_to,
+                              const std::vector<unsigned int> &receive_from,
+                              const int                        tag,
+                              const MPI_Win shared_window) const;
+#endif
+
       /**
        * The global size of the vector over all processors
        */
@@ -692,6 +1013,55 @@ namespace Utilities
        * A variable storing whether the ghost indices have been explicitly set.
        */
       bool have_ghost_indices;
+
+      /**
+       * A variable storing whether enable_shared_memory_communication() has
+       * been called.
+       */
+      bool use_shared_memory;
+
+      /**
+       * The communicator of all processes in @p communicator that share the
+       * memory of the same compute node, or MPI_COMM_SELF if shared memory
+       * communication is not enabled.
+       */
+      MPI_Comm communicator_sm;
+
+      /**
+       * The ranks within communicator_sm of the processes in
+       * ghost_targets_data, or numbers::invalid_unsigned_int for processes on
+       * other nodes.
+       */
+      std::vector<unsigned int> ghost_targets_sm_ranks_data;
+
+      /**
+       * The ranks within communicator_sm of the processes in
+       * import_targets_data, or numbers::invalid_unsigned_int for processes
+       * on other nodes.
+       */
+      std::vector<unsigned int> import_targets_sm_ranks_data;
+
+      /**
+       * For the ghost targets on the same node, the ranges of the ghost
+       * indices in terms of the local numbering on the owning process.
+       * Similar structure as import_indices_data, with the ranges for the
+       * i-th ghost target stored between the entries i and i+1 of
+       * ghost_indices_sm_chunks_by_rank_data.
+       */
+      std::vector<std::pair<unsigned int, unsigned int>> ghost_indices_sm_data;
+
+      /**
+       * An array that caches the number of chunks in ghost_indices_sm_data
+       * per ghost target. The length is ghost_targets_data.size()+1.
+       */
+      std::vector<unsigned int> ghost_indices_sm_chunks_by_rank_data;
+
+      /**
+       * For the import targets on the same node, the position of the ghost
+       * entries destined to the present process within the array of the
+       * importing process.
+       */
+      std::vector<unsigned int> import_targets_sm_offsets_data;
     };
 
 
@@ -891,6 +1261,38 @@ namespace Utilities
       return have_ghost_indices;
     }
 
+
+
+    inline bool
+    Partitioner::shared_memory_communication_enabled() const
+    {
+      return use_shared_memory;
+    }
+
+
+
+    inline const MPI_Comm &
+    Partitioner::get_shared_memory_communicator() const
+    {
+      return communicator_sm;
+    }
+
+
+
+    inline const std::vector<unsigned int> &
+    Partitioner::ghost_targets_shared_memory_ranks() const
+    {
+      return ghost_targets_sm_ranks_data;
+    }
+
+
+
+    inline const std::vector<unsigned int> &
+    Partitioner::import_targets_shared_memory_ranks() const
+    {
+      return import_targets_sm_ranks_data;
+    }
+
 #endif // ifndef DOXYGEN
 
   } // end of namespace MPI
@@ -44,7 +44,9 @@ namespace Utilities
       const ArrayView<const Number, MemorySpaceType> &locally_owned_array,
       const ArrayView<Number, MemorySpaceType> &      temporary_storage,
       const ArrayView<Number, MemorySpaceType> &      ghost_array,
-      std::vector<MPI_Request> &                      requests) const
+      std::vector<MPI_Request> &                      requests,
+      const std::vector<MPI_Request> &                persistent_requests,
+      const MPI_Win                                   shared_window) const
     {
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
@@ -59,10 +61,25 @@ namespace Utilities
       if (n_import_targets > 0)
         AssertDimension(locally_owned_array.size(), local_size());
 
+      // make the stores into our locally owned array visible to the
+      // processes on the same node before we tell them to read it
+      if (use_shared_memory && shared_window != MPI_WIN_NULL)
+        {
+          const int ierr = MPI_Win_sync(shared_window);
+          AssertThrowMPI(ierr);
+        }
+
       Assert(requests.size() == 0,
              ExcMessage("Another operation seems to still be running. "
                         "Call update_ghost_values_finish() first."));
 
+      // with persistent requests, the messages only need to be started
+      // after packing the data
+      const bool use_persistent_requests = persistent_requests.size() > 0;
+      if (use_persistent_requests)
+        AssertDimension(persistent_requests.size(),
+                        n_import_targets + n_ghost_targets);
+
       // Need to send and receive the data. Use non-blocking communication,
       // where it is usually less overhead to first initiate the receive and
       // then actually send the data
@@ -81,21 +98,34 @@ namespace Utilities
                            n_ghost_indices() :
                          ghost_array.data();
 
-      for (unsigned int i = 0; i < n_ghost_targets; i++)
-        {
-          // allow writing into ghost indices even though we are in a
-          // const function
-          const int ierr =
-            MPI_Irecv(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      ghost_targets_data[i].first,
-                      ghost_targets_data[i].first + communication_channel,
-                      communicator,
-                      &requests[i]);
-          AssertThrowMPI(ierr);
-          ghost_array_ptr += ghost_targets_data[i].second;
-        }
+      Assert(use_shared_memory == false ||
+               (std::is_same<MemorySpaceType, MemorySpace::Host>::value),
+             ExcNotImplemented());
+
+      if (!use_persistent_requests)
+        for (unsigned int i = 0; i < n_ghost_targets; i++)
+          {
+            // for processes on the same node, we only receive an empty
+            // message signaling that the owner's data is ready to be read,
+            // which we do in export_to_ghosted_array_finish()
+            const bool is_shared =
+              ghost_targets_sm_ranks_data[i] != numbers::invalid_unsigned_int;
+
+            // allow writing into ghost indices even though we are in a
+            // const function
+            const int ierr =
+              MPI_Irecv(ghost_array_ptr,
+                        is_shared ?
+                          0 :
+                          ghost_targets_data[i].second * sizeof(Number),
+                        MPI_BYTE,
+                        ghost_targets_data[i].first,
+                        ghost_targets_data[i].first + communication_channel,
+                        communicator,
+                        &requests[i]);
+            AssertThrowMPI(ierr);
+            ghost_array_ptr += ghost_targets_data[i].second;
+          }
 
       Number *temp_array_ptr = temporary_storage.data();
 #    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
@@ -112,6 +142,25 @@ namespace Utilities
 
       for (unsigned int i = 0; i < n_import_targets; i++)
         {
+          // processes on the same node read the data directly from
+          // locally_owned_array, so we only need to signal that it is ready
+          if (import_targets_sm_ranks_data[i] != numbers::invalid_unsigned_int)
+            {
+              if (!use_persistent_requests)
+                {
+                  const int ierr = MPI_Isend(temp_array_ptr,
+                                             0,
+                                             MPI_BYTE,
+                                             import_targets_data[i].first,
+                                             my_pid + communication_channel,
+                                             communicator,
+                                             &requests[n_ghost_targets + i]);
+                  AssertThrowMPI(ierr);
+                }
+              temp_array_ptr += import_targets_data[i].second;
+              continue;
+            }
+
 #    if defined(DEAL_II_COMPILER_CUDA_AWARE) && \
       defined(DEAL_II_WITH_CUDA_AWARE_MPI)
           if (std::is_same<MemorySpaceType, MemorySpace::CUDA>::value)
@@ -153,17 +202,29 @@ namespace Utilities
             }
 
           // start the send operations
-          const int ierr =
-            MPI_Isend(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      my_pid + communication_channel,
-                      communicator,
-                      &requests[n_ghost_targets + i]);
-          AssertThrowMPI(ierr);
+          if (!use_persistent_requests)
+            {
+              const int ierr =
+                MPI_Isend(temp_array_ptr,
+                          import_targets_data[i].second * sizeof(Number),
+                          MPI_BYTE,
+                          import_targets_data[i].first,
+                          my_pid + communication_channel,
+                          communicator,
+                          &requests[n_ghost_targets + i]);
+              AssertThrowMPI(ierr);
+            }
           temp_array_ptr += import_targets_data[i].second;
         }
+
+      // start all receives and sends at once. The requests are completed
+      // through the copies of the handles in export_to_ghosted_array_finish()
+      if (use_persistent_requests)
+        {
+          requests = persistent_requests;
+          const int ierr = MPI_Startall(requests.size(), requests.data());
+          AssertThrowMPI(ierr);
+        }
     }
 
 
@@ -171,8 +232,11 @@ namespace Utilities
     template <typename Number, typename MemorySpaceType>
     void
     Partitioner::export_to_ghosted_array_finish(
-      const ArrayView<Number, MemorySpaceType> &ghost_array,
-      std::vector<MPI_Request> &                requests) const
+      const ArrayView<Number, MemorySpaceType> &  ghost_array,
+      std::vector<MPI_Request> &                  requests,
+      const std::vector<ArrayView<const Number>> &shared_arrays,
+      const unsigned int                          communication_channel,
+      const MPI_Win                               shared_window) const
     {
       Assert(ghost_array.size() == n_ghost_indices() ||
                ghost_array.size() == n_ghost_indices_in_larger_set,
@@ -192,6 +256,66 @@ namespace Utilities
         }
       requests.resize(0);
 
+      // copy the data from the owners on the same node. The data is placed at
+      // the same position where export_to_ghosted_array_start() would have
+      // received it, such that the larger ghost set case below is handled
+      // uniformly
+      if (use_shared_memory)
+        {
+          // the owners have synchronized their part of the window before
+          // signaling that their data is ready, so we only need to
+          // synchronize our view of the window before reading it
+          if (shared_window != MPI_WIN_NULL)
+            {
+              const int ierr = MPI_Win_sync(shared_window);
+              AssertThrowMPI(ierr);
+            }
+
+          const bool use_larger_set =
+            (n_ghost_indices_in_larger_set > n_ghost_indices() &&
+             ghost_array.size() == n_ghost_indices_in_larger_set);
+          Number *ghost_array_ptr =
+            use_larger_set ? ghost_array.data() +
+                               n_ghost_indices_in_larger_set -
+                               n_ghost_indices() :
+                             ghost_array.data();
+          for (unsigned int i = 0; i < ghost_targets_data.size(); ++i)
+            {
+              const unsigned int sm_rank = ghost_targets_sm_ranks_data[i];
+              if (sm_rank != numbers::invalid_unsigned_int)
+                {
+                  AssertIndexRange(sm_rank, shared_arrays.size());
+                  const Number *owner_data = shared_arrays[sm_rank].data();
+                  unsigned int  index      = 0;
+                  for (unsigned int c = ghost_indices_sm_chunks_by_rank_data[i];
+                       c < ghost_indices_sm_chunks_by_rank_data[i + 1];
+                       ++c)
+                    {
+                      const unsigned int chunk_size =
+                        ghost_indices_sm_data[c].second -
+                        ghost_indices_sm_data[c].first;
+                      std::memcpy(ghost_array_ptr + index,
+                                  owner_data + ghost_indices_sm_data[c].first,
+                                  chunk_size * sizeof(Number));
+                      index += chunk_size;
+                    }
+                  AssertDimension(index, ghost_targets_data[i].second);
+                }
+              ghost_array_ptr += ghost_targets_data[i].second;
+            }
+
+          // signal to the owners that we are done reading their data and
+          // wait for the processes reading our data. The tag is derived from
+          // the communication channel in the same way as for the messages in
+          // export_to_ghosted_array_start(), shifted by one because tag zero
+          // is used by the setup in set_ghost_indices()
+          shared_memory_handshake(ghost_targets_sm_ranks_data,
+                                  import_targets_sm_ranks_data,
+                                  communication_channel + 1,
+                                  shared_window);
+        }
+      (void)shared_arrays;
+
       // in case we only sent a subset of indices, we now need to move the data
       // to the correct positions and delete the old content
       if (n_ghost_indices_in_larger_set > n_ghost_indices() &&
@@ -260,7 +384,9 @@ namespace Utilities
       const unsigned int                        communication_channel,
       const ArrayView<Number, MemorySpaceType> &ghost_array,
       const ArrayView<Number, MemorySpaceType> &temporary_storage,
-      std::vector<MPI_Request> &                requests) const
+      std::vector<MPI_Request> &                requests,
+      const std::vector<MPI_Request> &          persistent_requests,
+      const MPI_Win                             shared_window) const
     {
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
@@ -293,6 +419,11 @@ namespace Utilities
              ExcMessage("Another compress operation seems to still be running. "
                         "Call compress_finish() first."));
 
+      const bool use_persistent_requests = persistent_requests.size() > 0;
+      if (use_persistent_requests)
+        AssertDimension(persistent_requests.size(),
+                        n_import_targets + n_ghost_targets);
+
       // Need to send and receive the data. Use non-blocking communication,
       // where it is generally less overhead to first initiate the receive and
       // then actually send the data
@@ -301,10 +432,26 @@ namespace Utilities
       const unsigned int channel = communication_channel + 401;
       requests.resize(n_import_targets + n_ghost_targets);
 
-      // initiate the receive operations
+      Assert(use_shared_memory == false ||
+               (std::is_same<MemorySpaceType, MemorySpace::Host>::value),
+             ExcNotImplemented());
+
+      // make the stores into our ghost array visible to the owners on the
+      // same node before we tell them to read it
+      if (use_shared_memory && shared_window != MPI_WIN_NULL)
+        {
+          const int ierr = MPI_Win_sync(shared_window);
+          AssertThrowMPI(ierr);
+        }
+
+      // initiate the receive operations. For processes on the same node, we
+      // only receive an empty message signaling that the ghost data can be
+      // read from their array in import_from_ghosted_array_finish()
       Number *temp_array_ptr = temporary_storage.data();
       for (unsigned int i = 0; i < n_import_targets; i++)
         {
+          const bool is_shared =
+            import_targets_sm_ranks_data[i] != numbers::invalid_unsigned_int;
           AssertThrow(
             static_cast<std::size_t>(import_targets_data[i].second) *
                 sizeof(Number) <
@@ -312,15 +459,20 @@ namespace Utilities
             ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
                        "The number of ghost entries times the size of 'Number' "
                        "exceeds this value. This is not supported."));
-          const int ierr =
-            MPI_Irecv(temp_array_ptr,
-                      import_targets_data[i].second * sizeof(Number),
-                      MPI_BYTE,
-                      import_targets_data[i].first,
-                      import_targets_data[i].first + channel,
-                      communicator,
-                      &requests[i]);
-          AssertThrowMPI(ierr);
+          if (!use_persistent_requests)
+            {
+              const int ierr =
+                MPI_Irecv(temp_array_ptr,
+                          is_shared ?
+                            0 :
+                            import_targets_data[i].second * sizeof(Number),
+                          MPI_BYTE,
+                          import_targets_data[i].first,
+                          import_targets_data[i].first + channel,
+                          communicator,
+                          &requests[i]);
+              AssertThrowMPI(ierr);
+            }
           temp_array_ptr += import_targets_data[i].second;
         }
 
@@ -400,18 +552,321 @@ namespace Utilities
             ExcMessage("Index overflow: Maximum message size in MPI is 2GB. "
                        "The number of ghost entries times the size of 'Number' "
                        "exceeds this value. This is not supported."));
+          const bool is_shared =
+            ghost_targets_sm_ranks_data[i] != numbers::invalid_unsigned_int;
+          if (!use_persistent_requests)
+            {
+              const int ierr = MPI_Isend(
+                ghost_array_ptr,
+                is_shared ? 0 : ghost_targets_data[i].second * sizeof(Number),
+                MPI_BYTE,
+                ghost_targets_data[i].first,
+                this_mpi_process() + channel,
+                communicator,
+                &requests[n_import_targets + i]);
+              AssertThrowMPI(ierr);
+            }
+
+          ghost_array_ptr += ghost_targets_data[i].second;
+        }
+
+      if (use_persistent_requests)
+        {
+          requests = persistent_requests;
+          const int ierr = MPI_Startall(requests.size(), requests.data());
+          AssertThrowMPI(ierr);
+        }
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    void
+    Partitioner::initialize_persistent_export_requests(
+      const unsigned int                        communication_channel,
+      const ArrayView<Number, MemorySpaceType> &temporary_storage,
+      const ArrayView<Number, MemorySpaceType> &ghost_array,
+      std::vector<MPI_Request> &                persistent_requests) const
+    {
+      AssertDimension(temporary_storage.size(), n_import_indices());
+      Assert(ghost_array.size() == n_ghost_indices() ||
+               ghost_array.size() == n_ghost_indices_in_larger_set,
+             ExcGhostIndexArrayHasWrongSize(ghost_array.size(),
+                                            n_ghost_indices(),
+                                            n_ghost_indices_in_larger_set));
+      Assert(persistent_requests.size() == 0,
+             ExcMessage("The persistent requests have already been set up."));
+
+      const unsigned int n_import_targets = import_targets_data.size();
+      const unsigned int n_ghost_targets  = ghost_targets_data.size();
+      persistent_requests.resize(n_ghost_targets + n_import_targets);
+
+      // use the same buffers and the same order of the requests as in
+      // export_to_ghosted_array_start(): first the receives, then the sends
+      const bool use_larger_set =
+        (n_ghost_indices_in_larger_set > n_ghost_indices() &&
+         ghost_array.size() == n_ghost_indices_in_larger_set);
+      Number *ghost_array_ptr =
+        use_larger_set ? ghost_array.data() + n_ghost_indices_in_larger_set -
+                           n_ghost_indices() :
+                         ghost_array.data();
+      for (unsigned int i = 0; i < n_ghost_targets; i++)
+        {
+          const bool is_shared =
+            ghost_targets_sm_ranks_data[i] != numbers::invalid_unsigned_int;
+          const int ierr =
+            MPI_Recv_init(ghost_array_ptr,
+                          is_shared ?
+                            0 :
+                            ghost_targets_data[i].second * sizeof(Number),
+                          MPI_BYTE,
+                          ghost_targets_data[i].first,
+                          ghost_targets_data[i].first + communication_channel,
+                          communicator,
+                          &persistent_requests[i]);
+          AssertThrowMPI(ierr);
+          ghost_array_ptr += ghost_targets_data[i].second;
+        }
+
+      Number *temp_array_ptr = temporary_storage.data();
+      for (unsigned int i = 0; i < n_import_targets; i++)
+        {
+          const bool is_shared =
+            import_targets_sm_ranks_data[i] != numbers::invalid_unsigned_int;
+          const int ierr =
+            MPI_Send_init(temp_array_ptr,
+                          is_shared ?
+                            0 :
+                            import_targets_data[i].second * sizeof(Number),
+                          MPI_BYTE,
+                          import_targets_data[i].first,
+                          my_pid + communication_channel,
+                          communicator,
+                          &persistent_requests[n_ghost_targets + i]);
+          AssertThrowMPI(ierr);
+          temp_array_ptr += import_targets_data[i].second;
+        }
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    void
+    Partitioner::initialize_persistent_import_requests(
+      const unsigned int                        communication_channel,
+      const ArrayView<Number, MemorySpaceType> &ghost_array,
+      const ArrayView<Number, MemorySpaceType> &temporary_storage,
+      std::vector<MPI_Request> &                persistent_requests) const
+    {
+      AssertDimension(temporary_storage.size(), n_import_indices());
+      Assert(ghost_array.size() == n_ghost_indices() ||
+               ghost_array.size() == n_ghost_indices_in_larger_set,
+             ExcGhostIndexArrayHasWrongSize(ghost_array.size(),
+                                            n_ghost_indices(),
+                                            n_ghost_indices_in_larger_set));
+      Assert(persistent_requests.size() == 0,
+             ExcMessage("The persistent requests have already been set up."));
+
+      const unsigned int n_import_targets = import_targets_data.size();
+      const unsigned int n_ghost_targets  = ghost_targets_data.size();
+      persistent_requests.resize(n_import_targets + n_ghost_targets);
+
+      // use the same channels, buffers and order of the requests as in
+      // import_from_ghosted_array_start(), where the data to be sent is moved
+      // to the front of the ghost array
+      const unsigned int channel        = communication_channel + 401;
+      Number *           temp_array_ptr = temporary_storage.data();
+      for (unsigned int i = 0; i < n_import_targets; i++)
+        {
+          const bool is_shared =
+            import_targets_sm_ranks_data[i] != numbers::invalid_unsigned_int;
           const int ierr =
-            MPI_Isend(ghost_array_ptr,
-                      ghost_targets_data[i].second * sizeof(Number),
+            MPI_Recv_init(temp_array_ptr,
+                          is_shared ?
+                            0 :
+                            import_targets_data[i].second * sizeof(Number),
+                          MPI_BYTE,
+                          import_targets_data[i].first,
+                          import_targets_data[i].first + channel,
+                          communicator,
+                          &persistent_requests[i]);
+          AssertThrowMPI(ierr);
+          temp_array_ptr += import_targets_data[i].second;
+        }
+
+      Number *ghost_array_ptr = ghost_array.data();
+      for (unsigned int i = 0; i < n_ghost_targets; i++)
+        {
+          const bool is_shared =
+            ghost_targets_sm_ranks_data[i] != numbers::invalid_unsigned_int;
+          const int ierr =
+            MPI_Send_init(ghost_array_ptr,
+                          is_shared ?
+                            0 :
+                            ghost_targets_data[i].second * sizeof(Number),
+                          MPI_BYTE,
+                          ghost_targets_data[i].first,
+                          my_pid + channel,
+                          communicator,
+                          &persistent_requests[n_import_targets + i]);
+          AssertThrowMPI(ierr);
+          ghost_array_ptr += ghost_targets_data[i].second;
+        }
+    }
+
+
+
+    template <typename Number>
+    void
+    Partitioner::export_to_ghosted_array_reduced_precision_start(
+      const unsigned int             communication_channel,
+      const ArrayView<const Number> &locally_owned_array,
+      const ArrayView<typename internal::ReducedPrecision<Number>::type>
+        &send_buffer,
+      const ArrayView<typename internal::ReducedPrecision<Number>::type>
+        &                       receive_buffer,
+      std::vector<MPI_Request> &requests,
+      const MPI_Win             shared_window) const
+    {
+      using TransportNumber = typename internal::ReducedPrecision<Number>::type;
+
+      AssertDimension(send_buffer.size(), n_import_indices());
+      AssertDimension(receive_buffer.size(), n_ghost_indices());
+
+      const unsigned int n_import_targets = import_targets_data.size();
+      const unsigned int n_ghost_targets  = ghost_targets_data.size();
+
+      if (n_import_targets > 0)
+        AssertDimension(locally_owned_array.size(), local_size());
+
+      if (use_shared_memory && shared_window != MPI_WIN_NULL)
+        {
+          const int ierr = MPI_Win_sync(shared_window);
+          AssertThrowMPI(ierr);
+        }
+
+      Assert(requests.size() == 0,
+             ExcMessage("Another operation seems to still be running. "
+                        "Call update_ghost_values_finish() first."));
+
+      requests.resize(n_import_targets + n_ghost_targets);
+
+      // same messages as in export_to_ghosted_array_start(), only with a
+      // different type and a separate receive buffer
+      TransportNumber *receive_ptr = receive_buffer.data();
+      for (unsigned int i = 0; i < n_ghost_targets; i++)
+        {
+          const bool is_shared =
+            ghost_targets_sm_ranks_data[i] != numbers::invalid_unsigned_int;
+          const int ierr =
+            MPI_Irecv(receive_ptr,
+                      is_shared ?
+                        0 :
+                        ghost_targets_data[i].second * sizeof(TransportNumber),
                       MPI_BYTE,
                       ghost_targets_data[i].first,
-                      this_mpi_process() + channel,
+                      ghost_targets_data[i].first + communication_channel,
                       communicator,
-                      &requests[n_import_targets + i]);
+                      &requests[i]);
           AssertThrowMPI(ierr);
+          receive_ptr += ghost_targets_data[i].second;
+        }
 
+      TransportNumber *send_ptr = send_buffer.data();
+      for (unsigned int i = 0; i < n_import_targets; i++)
+        {
+          const bool is_shared =
+            import_targets_sm_ranks_data[i] != numbers::invalid_unsigned_int;
+
+          // pack and convert the data to be sent
+          if (!is_shared)
+            {
+              unsigned int index = 0;
+              for (unsigned int c = import_indices_chunks_by_rank_data[i];
+                   c < import_indices_chunks_by_rank_data[i + 1];
+                   ++c)
+                for (unsigned int j = import_indices_data[c].first;
+                     j < import_indices_data[c].second;
+                     ++j, ++index)
+                  send_ptr[index] =
+                    static_cast<TransportNumber>(locally_owned_array[j]);
+              AssertDimension(index, import_targets_data[i].second);
+            }
+
+          const int ierr =
+            MPI_Isend(send_ptr,
+                      is_shared ?
+                        0 :
+                        import_targets_data[i].second * sizeof(TransportNumber),
+                      MPI_BYTE,
+                      import_targets_data[i].first,
+                      my_pid + communication_channel,
+                      communicator,
+                      &requests[n_ghost_targets + i]);
+          AssertThrowMPI(ierr);
+          send_ptr += import_targets_data[i].second;
+        }
+    }
+
+
+
+    template <typename Number>
+    void
+    Partitioner::export_to_ghosted_array_reduced_precision_finish(
+      const ArrayView<const typename internal::ReducedPrecision<Number>::type>
+        &                                         receive_buffer,
+      const ArrayView<Number> &                   ghost_array,
+      std::vector<MPI_Request> &                  requests,
+      const std::vector<ArrayView<const Number>> &shared_arrays,
+      const unsigned int                          communication_channel,
+      const MPI_Win                               shared_window) const
+    {
+      using TransportNumber = typename internal::ReducedPrecision<Number>::type;
+
+      AssertDimension(receive_buffer.size(), n_ghost_indices());
+      Assert(ghost_array.size() == n_ghost_indices() ||
+               ghost_array.size() == n_ghost_indices_in_larger_set,
+             ExcGhostIndexArrayHasWrongSize(ghost_array.size(),
+                                            n_ghost_indices(),
+                                            n_ghost_indices_in_larger_set));
+      AssertDimension(ghost_targets().size() + import_targets().size(),
+                      requests.size());
+
+      if (requests.size() > 0)
+        {
+          const int ierr =
+            MPI_Waitall(requests.size(), requests.data(), MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+
+      // expand the received data to the positions where
+      // export_to_ghosted_array_start() would have placed it
+      const bool use_larger_set =
+        (n_ghost_indices_in_larger_set > n_ghost_indices() &&
+         ghost_array.size() == n_ghost_indices_in_larger_set);
+      Number *ghost_array_ptr =
+        use_larger_set ? ghost_array.data() + n_ghost_indices_in_larger_set -
+                           n_ghost_indices() :
+                         ghost_array.data();
+      const TransportNumber *receive_ptr = receive_buffer.data();
+      for (unsigned int i = 0; i < ghost_targets_data.size(); ++i)
+        {
+          if (ghost_targets_sm_ranks_data[i] == numbers::invalid_unsigned_int)
+            for (unsigned int j = 0; j < ghost_targets_data[i].second; ++j)
+              ghost_array_ptr[j] = static_cast<Number>(receive_ptr[j]);
           ghost_array_ptr += ghost_targets_data[i].second;
+          receive_ptr += ghost_targets_data[i].second;
         }
+
+      // the requests have completed, so the remaining steps (shared-memory
+      // copies and the larger ghost set) are the same as for the exchange in
+      // full precision
+      export_to_ghosted_array_finish<Number, MemorySpace::Host>(
+        ghost_array,
+        requests,
+        shared_arrays,
+        communication_channel,
+        shared_window);
     }
 
 
@@ -486,7 +941,10 @@ namespace Utilities
       const ArrayView<const Number, MemorySpaceType> &temporary_storage,
       const ArrayView<Number, MemorySpaceType> &      locally_owned_array,
       const ArrayView<Number, MemorySpaceType> &      ghost_array,
-      std::vector<MPI_Request> &                      requests) const
+      std::vector<MPI_Request> &                      requests,
+      const std::vector<ArrayView<const Number>> &    shared_arrays,
+      const unsigned int                              communication_channel,
+      const MPI_Win                                   shared_window) const
     {
       AssertDimension(temporary_storage.size(), n_import_indices());
       Assert(ghost_array.size() == n_ghost_indices() ||
@@ -548,62 +1006,105 @@ namespace Utilities
       if (requests.size() > 0 && n_import_targets > 0)
         {
           AssertDimension(locally_owned_array.size(), local_size());
-          const int ierr =
+          int ierr =
             MPI_Waitall(n_import_targets, requests.data(), MPI_STATUSES_IGNORE);
           AssertThrowMPI(ierr);
 
+          // synchronize our view of the window before reading the ghost
+          // data of the processes on the same node
+          if (use_shared_memory && shared_window != MPI_WIN_NULL)
+            {
+              ierr = MPI_Win_sync(shared_window);
+              AssertThrowMPI(ierr);
+            }
+
           const Number *read_position = temporary_storage.data();
 #    if !(defined(DEAL_II_COMPILER_CUDA_AWARE) && \
           defined(DEAL_II_WITH_CUDA_AWARE_MPI))
-          // If the operation is no insertion, add the imported data to the
-          // local values. For insert, nothing is done here (but in debug mode
-          // we assert that the specified value is either zero or matches with
-          // the ones already present
-          if (vector_operation == dealii::VectorOperation::add)
-            for (const auto &import_range : import_indices_data)
-              for (unsigned int j = import_range.first; j < import_range.second;
-                   j++)
-                locally_owned_array[j] += *read_position++;
-          else if (vector_operation == dealii::VectorOperation::min)
-            for (const auto &import_range : import_indices_data)
-              for (unsigned int j = import_range.first; j < import_range.second;
-                   j++)
-                {
-                  locally_owned_array[j] =
-                    internal::get_min(*read_position, locally_owned_array[j]);
-                  read_position++;
-                }
-          else if (vector_operation == dealii::VectorOperation::max)
-            for (const auto &import_range : import_indices_data)
-              for (unsigned int j = import_range.first; j < import_range.second;
-                   j++)
+          for (unsigned int i = 0; i < n_import_targets; ++i)
+            {
+              // the data of processes on the same node is directly read from
+              // their ghost array
+              const Number *     read_data = read_position;
+              const unsigned int sm_rank   = import_targets_sm_ranks_data[i];
+              if (sm_rank != numbers::invalid_unsigned_int)
                 {
-                  locally_owned_array[j] =
-                    internal::get_max(*read_position, locally_owned_array[j]);
-                  read_position++;
+                  AssertIndexRange(sm_rank, shared_arrays.size());
+                  read_data = shared_arrays[sm_rank].data() +
+                              import_targets_sm_offsets_data[i];
                 }
-          else
-            for (const auto &import_range : import_indices_data)
-              for (unsigned int j = import_range.first; j < import_range.second;
-                   j++, read_position++)
-                // Below we use relatively large precision in units in the last
-                // place (ULP) as this Assert can be easily triggered in
-                // p::d::SolutionTransfer. The rationale is that during
-                // interpolation on two elements sharing the face, values on
-                // this face obtained from each side might be different due to
-                // additions being done in different order.
-                Assert(*read_position == Number() ||
-                         internal::get_abs(locally_owned_array[j] -
-                                           *read_position) <=
-                           internal::get_abs(locally_owned_array[j] +
-                                             *read_position) *
-                             100000. *
-                             std::numeric_limits<typename numbers::NumberTraits<
-                               Number>::real_type>::epsilon(),
-                       typename LinearAlgebra::distributed::Vector<
-                         Number>::ExcNonMatchingElements(*read_position,
-                                                         locally_owned_array[j],
-                                                         my_pid));
+
+              const auto my_imports =
+                import_indices_data.begin() +
+                import_indices_chunks_by_rank_data[i];
+              const auto end_my_imports =
+                import_indices_data.begin() +
+                import_indices_chunks_by_rank_data[i + 1];
+
+              // If the operation is no insertion, add the imported data to
+              // the local values. For insert, nothing is done here (but in
+              // debug mode we assert that the specified value is either zero
+              // or matches with the ones already present
+              if (vector_operation == dealii::VectorOperation::add)
+                for (auto import_range = my_imports;
+                     import_range != end_my_imports;
+                     ++import_range)
+                  for (unsigned int j = import_range->first;
+                       j < import_range->second;
+                       j++)
+                    locally_owned_array[j] += *read_data++;
+              else if (vector_operation == dealii::VectorOperation::min)
+                for (auto import_range = my_imports;
+                     import_range != end_my_imports;
+                     ++import_range)
+                  for (unsigned int j = import_range->first;
+                       j < import_range->second;
+                       j++)
+                    {
+                      locally_owned_array[j] =
+                        internal::get_min(*read_data, locally_owned_array[j]);
+                      read_data++;
+                    }
+              else if (vector_operation == dealii::VectorOperation::max)
+                for (auto import_range = my_imports;
+                     import_range != end_my_imports;
+                     ++import_range)
+                  for (unsigned int j = import_range->first;
+                       j < import_range->second;
+                       j++)
+                    {
+                      locally_owned_array[j] =
+                        internal::get_max(*read_data, locally_owned_array[j]);
+                      read_data++;
+                    }
+              else
+                for (auto import_range = my_imports;
+                     import_range != end_my_imports;
+                     ++import_range)
+                  for (unsigned int j = import_range->first;
+                       j < import_range->second;
+                       j++, read_data++)
+                    // Below we use relatively large precision in units in the
+                    // last place (ULP) as this Assert can be easily triggered
+                    // in p::d::SolutionTransfer. The rationale is that during
+                    // interpolation on two elements sharing the face, values
+                    // on this face obtained from each side might be different
+                    // due to additions being done in different order.
+                    Assert(*read_data == Number() ||
+                             internal::get_abs(locally_owned_array[j] -
+                                               *read_data) <=
+                               internal::get_abs(locally_owned_array[j] +
+                                                 *read_data) *
+                                 100000. *
+                                 std::numeric_limits<
+                                   typename numbers::NumberTraits<
+                                     Number>::real_type>::epsilon(),
+                           typename LinearAlgebra::distributed::Vector<
+                             Number>::ExcNonMatchingElements(
+                             *read_data, locally_owned_array[j], my_pid));
+
+              read_position += import_targets_data[i].second;
+            }
 #    else
           if (vector_operation == dealii::VectorOperation::add)
             {
@@ -699,6 +1200,18 @@ namespace Utilities
       else
         AssertDimension(n_ghost_indices(), 0);
 
+      // signal to the processes on the same node that we are done reading
+      // their ghost data and wait until the owners of our ghost data are done
+      // reading it, before the ghost array gets cleared below. The tag
+      // follows the channels of import_from_ghosted_array_start(), see
+      // export_to_ghosted_array_finish()
+      if (use_shared_memory && requests.size() > 0)
+        shared_memory_handshake(import_targets_sm_ranks_data,
+                                ghost_targets_sm_ranks_data,
+                                communication_channel + 401 + 1,
+                                shared_window);
+      (void)shared_arrays;
+
       // clear the ghost array in case we did not yet do that in the _start
       // function
       if (ghost_array.size() > 0)
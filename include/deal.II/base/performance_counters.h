@@ -0,0 +1,342 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_performance_counters_h
+#define dealii_performance_counters_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <list>
+#include <map>
+#include <string>
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * This class measures hardware performance counters (CPU cycles, retired
+ * instructions, and misses in the last level cache) for different sections of
+ * a program, together with the wall time spent in them, and reports derived
+ * metrics like the number of instructions per cycle (IPC), the memory
+ * bandwidth estimated from the cache misses, and, if the number of floating
+ * point operations of a section is supplied by the user, its GFLOP/s rate
+ * and arithmetic intensity. This allows to attribute the hardware
+ * performance to individual parts of a program, such as the cell loop of a
+ * matrix-free operator evaluation, a sparse matrix-vector product, or the
+ * assembly, without resorting to external profiling tools.
+ *
+ * The counters are read through the <code>perf_event_open</code> interface
+ * of the Linux kernel. On other systems, or if the kernel does not allow
+ * access to the counters (which is frequently the case in containers or if
+ * <code>/proc/sys/kernel/perf_event_paranoid</code> is set restrictively),
+ * the class falls back to measuring the wall time only and reports the
+ * counter-based metrics as unavailable. Whether the counters can be used
+ * is reported by counters_available().
+ *
+ * <h3>Usage</h3>
+ *
+ * The interface follows the one of TimerOutput:
+ * @code
+ *   PerformanceCounters counters;
+ *
+ *   for (unsigned int i = 0; i < n_iterations; ++i)
+ *     {
+ *       PerformanceCounters::Scope scope(counters,
+ *                                        "matrix-free vmult",
+ *                                        n_flops_per_vmult);
+ *       laplace_operator.vmult(dst, src);
+ *     }
+ *   {
+ *     PerformanceCounters::Scope scope(counters, "sparse vmult");
+ *     sparse_matrix.vmult(dst, src);
+ *   }
+ *
+ *   counters.print_summary(std::cout);
+ * @endcode
+ * Sections may be nested, in which case the counts of the inner section are
+ * included in the ones of the outer one.
+ *
+ * The counters are bound to the thread that created the object and only
+ * count the events on this thread. Work that is done on other threads, such
+ * as in tasks spawned by WorkStream::run() or parallel::apply_to_subranges(),
+ * is therefore not included in the counter values, whereas the wall time is.
+ * For a reliable analysis of the hardware metrics of a code section, run it
+ * with a single thread. The class is not thread-safe.
+ *
+ * @ingroup utilities
+ */
+class PerformanceCounters
+{
+public:
+  /**
+   * The hardware events measured by this class.
+   */
+  enum Counter
+  {
+    /**
+     * The number of CPU cycles.
+     */
+    cycles,
+    /**
+     * The number of retired instructions.
+     */
+    instructions,
+    /**
+     * The number of misses in the last level cache.
+     */
+    cache_misses,
+    /**
+     * The number of counters.
+     */
+    n_counters
+  };
+
+  /**
+   * The data collected for a section.
+   */
+  struct SectionData
+  {
+    /**
+     * Constructor. Sets all values to zero.
+     */
+    SectionData();
+
+    /**
+     * The number of times the section was entered.
+     */
+    unsigned int n_calls;
+
+    /**
+     * The accumulated wall time in seconds.
+     */
+    double wall_time;
+
+    /**
+     * The accumulated values of the hardware counters.
+     */
+    std::array<double, n_counters> counts;
+
+    /**
+     * The number of floating point operations that was attributed to the
+     * section by the user.
+     */
+    double n_flops;
+
+    /**
+     * Return the number of instructions per cycle, or zero if the counters
+     * are unavailable.
+     */
+    double
+    instructions_per_cycle() const;
+
+    /**
+     * Return an estimate of the data transferred from main memory, namely the
+     * number of last level cache misses times the size of a cache line of 64
+     * bytes.
+     */
+    double
+    memory_bytes() const;
+
+    /**
+     * Return the rate of floating point operations in GFLOP/s.
+     */
+    double
+    gflops() const;
+
+    /**
+     * Return the arithmetic intensity, i.e., the number of floating point
+     * operations per byte transferred from main memory as estimated by
+     * memory_bytes(), or zero if the counters are unavailable.
+     */
+    double
+    arithmetic_intensity() const;
+  };
+
+  /**
+   * Helper class to enter and leave a section in a scope-based manner, as
+   * TimerOutput::Scope does.
+   */
+  class Scope
+  {
+  public:
+    /**
+     * Enter the given section. The optional argument @p n_flops_ is the
+     * number of floating point operations performed in this invocation of
+     * the section, which is used to compute the GFLOP/s rate and the
+     * arithmetic intensity.
+     */
+    Scope(PerformanceCounters &counters_,
+          const std::string &  section_name_,
+          const double         n_flops_ = 0.);
+
+    /**
+     * Destructor. Leaves the section.
+     */
+    ~Scope();
+
+  private:
+    /**
+     * Reference to the PerformanceCounters object.
+     */
+    PerformanceCounters &counters;
+
+    /**
+     * Name of the section.
+     */
+    const std::string section_name;
+
+    /**
+     * The number of floating point operations to attribute to the section.
+     */
+    const double n_flops;
+  };
+
+  /**
+   * Constructor. Tries to open the hardware counters for the calling thread.
+   */
+  PerformanceCounters();
+
+  /**
+   * Destructor. Closes the hardware counters.
+   */
+  ~PerformanceCounters();
+
+  /**
+   * Copying this object is not possible.
+   */
+  PerformanceCounters(const PerformanceCounters &) = delete;
+
+  /**
+   * Copying this object is not possible.
+   */
+  PerformanceCounters &
+  operator=(const PerformanceCounters &) = delete;
+
+  /**
+   * Return whether the hardware counters could be opened. If not, only the
+   * wall time and quantities derived from it are measured.
+   */
+  bool
+  counters_available() const;
+
+  /**
+   * Enter the given section.
+   */
+  void
+  enter_subsection(const std::string &section_name);
+
+  /**
+   * Leave the given section and attribute @p n_flops floating point
+   * operations to it.
+   */
+  void
+  leave_subsection(const std::string &section_name, const double n_flops = 0.);
+
+  /**
+   * Return the data collected for each section.
+   */
+  const std::map<std::string, SectionData> &
+  get_summary_data() const;
+
+  /**
+   * Print a table with the collected data and the derived metrics for each
+   * section to @p stream.
+   */
+  void
+  print_summary(std::ostream &stream) const;
+
+  /**
+   * Reset the collected data.
+   */
+  void
+  reset();
+
+  /**
+   * Exception.
+   */
+  DeclException1(ExcSectionNotActive,
+                 std::string,
+                 << "The section <" << arg1 << "> has not been entered.");
+
+private:
+  /**
+   * Read the current values of all counters into @p values. Sets all values
+   * to zero if the counters are unavailable.
+   */
+  void
+  read_counters(std::array<double, n_counters> &values) const;
+
+  /**
+   * The file descriptors of the counters, or -1 for counters that could not
+   * be opened.
+   */
+  std::array<int, n_counters> file_descriptors;
+
+  /**
+   * The state of an active section at the time it was entered.
+   */
+  struct ActiveSection
+  {
+    std::string                           name;
+    std::chrono::steady_clock::time_point start_time;
+    std::array<double, n_counters>        start_counts;
+  };
+
+  /**
+   * The sections that have been entered and not yet left.
+   */
+  std::list<ActiveSection> active_sections;
+
+  /**
+   * The data collected for all sections.
+   */
+  std::map<std::string, SectionData> sections;
+};
+
+
+
+/* ---------------- inline functions ----------------- */
+
+
+inline PerformanceCounters::Scope::Scope(PerformanceCounters &counters_,
+                                         const std::string &  section_name_,
+                                         const double         n_flops_)
+  : counters(counters_)
+  , section_name(section_name_)
+  , n_flops(n_flops_)
+{
+  counters.enter_subsection(section_name);
+}
+
+
+
+inline PerformanceCounters::Scope::~Scope()
+{
+  try
+    {
+      counters.leave_subsection(section_name, n_flops);
+    }
+  catch (...)
+    {}
+}
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
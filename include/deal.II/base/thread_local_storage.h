@@ -23,6 +23,14 @@
 #    include <tbb/enumerable_thread_specific.h>
 #  endif
 
+#  ifdef DEAL_II_USE_THREAD_POOL
+#    include <functional>
+#    include <list>
+#    include <map>
+#    include <mutex>
+#    include <thread>
+#  endif
+
 
 
 DEAL_II_NAMESPACE_OPEN
@@ -33,6 +41,154 @@ DEAL_II_NAMESPACE_OPEN
 
 namespace Threads
 {
+#  ifdef DEAL_II_USE_THREAD_POOL
+  namespace internal
+  {
+    /**
+     * A replacement for tbb::enumerable_thread_specific used if deal.II
+     * runs tasks on its own thread pool rather than with the Threading
+     * Building Blocks. The objects are kept in the order in which the
+     * threads first accessed them and are found through a map from thread
+     * ids that is protected by a mutex.
+     */
+    template <typename T>
+    class EnumerableThreadSpecific
+    {
+    public:
+      using iterator       = typename std::list<T>::iterator;
+      using const_iterator = typename std::list<T>::const_iterator;
+
+      /**
+       * Default constructor. Objects are default constructed.
+       */
+      EnumerableThreadSpecific()
+        : create([](std::list<T> &objects) { objects.emplace_back(); })
+      {}
+
+      /**
+       * Constructor. Objects are copied from @p exemplar.
+       */
+      explicit EnumerableThreadSpecific(const T &exemplar)
+        : create([exemplar](std::list<T> &objects) {
+          objects.push_back(exemplar);
+        })
+      {}
+
+      /**
+       * Copy constructor. Copies the objects of all threads.
+       */
+      EnumerableThreadSpecific(const EnumerableThreadSpecific &other)
+      {
+        *this = other;
+      }
+
+      /**
+       * Copy assignment. Copies the objects of all threads.
+       */
+      EnumerableThreadSpecific &
+      operator=(const EnumerableThreadSpecific &other)
+      {
+        if (this == &other)
+          return *this;
+
+        std::lock(mutex, other.mutex);
+        std::lock_guard<std::mutex> lock(mutex, std::adopt_lock);
+        std::lock_guard<std::mutex> other_lock(other.mutex, std::adopt_lock);
+        create  = other.create;
+        objects = other.objects;
+        index.clear();
+        auto object = objects.begin();
+        for (const T &other_object : other.objects)
+          {
+            for (const auto &entry : other.index)
+              if (entry.second == &other_object)
+                index[entry.first] = &*object;
+            ++object;
+          }
+        return *this;
+      }
+
+      /**
+       * Return the object of the current thread, creating it if it does not
+       * exist yet, and set @p exists accordingly.
+       */
+      T &
+      local(bool &exists)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::thread::id id    = std::this_thread::get_id();
+        const auto            entry = index.find(id);
+        exists                      = (entry != index.end());
+        if (exists)
+          return *entry->second;
+
+        // the elements of a list do not move, so we can keep pointers to
+        // them
+        create(objects);
+        index[id] = &objects.back();
+        return objects.back();
+      }
+
+      /**
+       * Return the object of the current thread.
+       */
+      T &
+      local()
+      {
+        bool exists;
+        return local(exists);
+      }
+
+      /**
+       * Remove the objects of all threads.
+       */
+      void
+      clear()
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        objects.clear();
+        index.clear();
+      }
+
+      /**
+       * Iterators over the objects of all threads. These must not be used
+       * while other threads create their objects.
+       */
+      iterator
+      begin()
+      {
+        return objects.begin();
+      }
+
+      iterator
+      end()
+      {
+        return objects.end();
+      }
+
+      const_iterator
+      begin() const
+      {
+        return objects.begin();
+      }
+
+      const_iterator
+      end() const
+      {
+        return objects.end();
+      }
+
+    private:
+      std::function<void(std::list<T> &)> create;
+      std::list<T>                         objects;
+      std::map<std::thread::id, T *>       index;
+      mutable std::mutex                   mutex;
+    };
+  } // namespace internal
+#  endif
+
+
+
   /**
    * @brief A class that provides a separate storage location on each thread
    * that accesses the object.
@@ -46,7 +202,9 @@ namespace Threads
    * tbb::enumerable_thread_specific class but wraps it in such a way that
    * this class can also be used when deal.II is configured not to use threads
    * at all -- in that case, this class simply stores a single copy of an
-   * object of type T.
+   * object of type T, unless deal.II runs tasks on its own thread pool, in
+   * which case internal::EnumerableThreadSpecific takes the place of the
+   * TBB class.
    *
    * <h3>Construction and destruction</h3>
    *
@@ -163,6 +321,8 @@ namespace Threads
      */
 #  ifdef DEAL_II_WITH_THREADS
     tbb::enumerable_thread_specific<T> &
+#  elif defined(DEAL_II_USE_THREAD_POOL)
+    internal::EnumerableThreadSpecific<T> &
 #  else
     T &
 #  endif
@@ -176,6 +336,8 @@ namespace Threads
      * Otherwise, it is simply a single object of type T.
      */
     tbb::enumerable_thread_specific<T> data;
+#  elif defined(DEAL_II_USE_THREAD_POOL)
+    internal::EnumerableThreadSpecific<T> data;
 #  else
     T data;
 #  endif
@@ -192,7 +354,11 @@ namespace Threads
   template <typename T>
   inline ThreadLocalStorage<T>::ThreadLocalStorage(
     const ThreadLocalStorage<T> &t)
+#  ifdef DEAL_II_USE_THREAD_POOL
+    : data(t.data)
+#  else
     : data(t)
+#  endif
   {}
 
 
@@ -200,7 +366,7 @@ namespace Threads
   inline T &
   ThreadLocalStorage<T>::get()
   {
-#  ifdef DEAL_II_WITH_THREADS
+#  if defined(DEAL_II_WITH_THREADS) || defined(DEAL_II_USE_THREAD_POOL)
     return data.local();
 #  else
     return data;
@@ -212,7 +378,7 @@ namespace Threads
   inline T &
   ThreadLocalStorage<T>::get(bool &exists)
   {
-#  ifdef DEAL_II_WITH_THREADS
+#  if defined(DEAL_II_WITH_THREADS) || defined(DEAL_II_USE_THREAD_POOL)
     return data.local(exists);
 #  else
     exists = true;
@@ -241,6 +407,8 @@ namespace Threads
   inline
 #  ifdef DEAL_II_WITH_THREADS
     tbb::enumerable_thread_specific<T> &
+#  elif defined(DEAL_II_USE_THREAD_POOL)
+    internal::EnumerableThreadSpecific<T> &
 #  else
     T &
 #  endif
@@ -255,7 +423,7 @@ namespace Threads
   inline void
   ThreadLocalStorage<T>::clear()
   {
-#  ifdef DEAL_II_WITH_THREADS
+#  if defined(DEAL_II_WITH_THREADS) || defined(DEAL_II_USE_THREAD_POOL)
     data.clear();
 #  else
     data = T{};
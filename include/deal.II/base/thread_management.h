@@ -40,6 +40,9 @@
 #    include <tbb/task.h>
 #    include <tbb/tbb_stddef.h>
 #  endif
+#  ifdef DEAL_II_USE_THREAD_POOL
+#    include <deal.II/base/thread_pool.h>
+#  endif
 
 
 
@@ -1434,6 +1437,98 @@ namespace Threads
 
 
 
+#  elif defined(DEAL_II_USE_THREAD_POOL)
+
+    /**
+     * A way to describe tasks if deal.II does not use the Threading
+     * Building Blocks: the function is run as a job on the thread pool of
+     * deal.II, see ThreadPool.
+     */
+    template <typename RT>
+    struct TaskDescriptor
+    {
+    private:
+      /**
+       * The function and its arguments that are to be run on the task.
+       */
+      std::function<RT()> function;
+
+      /**
+       * The job of the thread pool that runs the function. Set by
+       * queue_task().
+       */
+      std::shared_ptr<ThreadPool::Job> job;
+
+      /**
+       * A place where the task will deposit its return value.
+       */
+      return_value<RT> ret_val;
+
+    public:
+      /**
+       * Constructor. Take the function to be run on this task as argument.
+       */
+      TaskDescriptor(const std::function<RT()> &function)
+        : function(function)
+      {}
+
+      /**
+       * Task descriptors can not be copied since each of them corresponds
+       * to exactly one task.
+       */
+      TaskDescriptor(const TaskDescriptor &) = delete;
+
+      /**
+       * Destructor. Waits for the task to finish.
+       */
+      ~TaskDescriptor()
+      {
+        join();
+      }
+
+      /**
+       * Task descriptors can not be copied since each of them corresponds
+       * to exactly one task.
+       */
+      TaskDescriptor &
+      operator=(const TaskDescriptor &) = delete;
+
+      /**
+       * Queue up the task to the thread pool.
+       */
+      void
+      queue_task()
+      {
+        job = ThreadPool::instance().submit([this]() {
+          try
+            {
+              call(function, ret_val);
+            }
+          catch (const std::exception &exc)
+            {
+              internal::handle_std_exception(exc);
+            }
+          catch (...)
+            {
+              internal::handle_unknown_exception();
+            }
+        });
+      }
+
+      /**
+       * Join a task, i.e. wait for it to finish. While waiting, the calling
+       * thread works on other queued jobs.
+       */
+      void
+      join()
+      {
+        if (job != nullptr && job->is_done() == false)
+          ThreadPool::instance().wait(*job);
+      }
+
+      friend class dealii::Threads::Task<RT>;
+    };
+
 #  else // no threading enabled
 
     /**
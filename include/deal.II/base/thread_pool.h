@@ -0,0 +1,332 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_thread_pool_h
+#define dealii_thread_pool_h
+
+
+#include <deal.II/base/config.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Threads
+{
+  namespace internal
+  {
+    /**
+     * A work-stealing thread pool built on std::thread. If deal.II is
+     * configured without the Threading Building Blocks, this class is used
+     * to run the tasks created by Threads::new_task(), the loops of the
+     * functions in namespace parallel, and the WorkStream functions, so that
+     * these make use of several cores also in that case.
+     *
+     * The pool owns MultithreadInfo::n_threads()-1 worker threads, since the
+     * thread that submits work also takes part in executing it. Each worker
+     * has its own double-ended queue of jobs: Jobs submitted by a worker are
+     * added to the back of its own queue and taken from there again in LIFO
+     * order, which keeps the data of nested parallel loops in cache, whereas
+     * idle workers steal jobs from the front of the queues of other workers.
+     * Jobs submitted by threads outside the pool go to a shared queue.
+     *
+     * A thread that waits for a job to finish does not block, but executes
+     * other queued jobs in the meantime. Consequently, nested parallelism,
+     * e.g., tasks that wait for other tasks, can not deadlock even if all
+     * workers are busy.
+     *
+     * The number of workers is set through MultithreadInfo::set_thread_limit()
+     * and the pinning of the workers to cores through
+     * MultithreadInfo::set_thread_affinity().
+     *
+     * The class only relies on std::thread and is compiled in all
+     * configurations, but the functions named above only use it if
+     * DEAL_II_USE_THREAD_POOL is defined, i.e., without the Threading Building
+     * Blocks. The task-parallel schemes of MatrixFree and the vector
+     * operations that call the Threading Building Blocks directly are not
+     * ported to this class and run serially in that configuration.
+     */
+    class ThreadPool
+    {
+    public:
+      /**
+       * A job submitted to the pool.
+       */
+      class Job
+      {
+      public:
+        /**
+         * Constructor.
+         */
+        Job(const std::function<void()> &function);
+
+        /**
+         * Return whether the job has finished.
+         */
+        bool
+        is_done() const;
+
+      private:
+        /**
+         * The function to run.
+         */
+        std::function<void()> function;
+
+        /**
+         * A flag that is set once the function has returned.
+         */
+        std::atomic<bool> done;
+
+        friend class ThreadPool;
+      };
+
+      /**
+       * Return the thread pool of the program. The pool is created, and its
+       * worker threads started, upon the first call of this function.
+       */
+      static ThreadPool &
+      instance();
+
+      /**
+       * Set the total number of threads working on the jobs, including the
+       * thread that submits them, i.e., start @p n_threads-1 workers. This
+       * function takes effect right away if the pool already exists and
+       * must not be called while jobs are queued or running.
+       */
+      static void
+      set_n_threads(const unsigned int n_threads);
+
+      /**
+       * Set whether the worker threads are pinned to individual cores. The
+       * threads are only placed on the cores the process was allowed to run
+       * on when this function was first called with @p pin_threads set,
+       * see MultithreadInfo::set_thread_affinity(). Like set_n_threads(),
+       * this function must not be called while jobs are queued or running.
+       */
+      static void
+      set_thread_affinity(const bool pin_threads);
+
+      /**
+       * Destructor. Waits for the workers to finish their current job and
+       * terminates them.
+       */
+      ~ThreadPool();
+
+      /**
+       * Return the number of worker threads.
+       */
+      unsigned int
+      n_workers() const;
+
+      /**
+       * Queue @p function for execution on one of the threads of the pool.
+       * If the pool has no workers, the function is run right away. The
+       * function must not throw.
+       */
+      std::shared_ptr<Job>
+      submit(const std::function<void()> &function);
+
+      /**
+       * Wait for @p job to finish, executing other jobs in the meantime.
+       */
+      void
+      wait(const Job &job);
+
+      /**
+       * Return the number of chunks into which a loop over @p n elements
+       * should be split so that each chunk has at least @p grain_size
+       * elements and all threads get enough chunks to balance the load. The
+       * result is at least one.
+       */
+      unsigned int
+      n_chunks(const std::size_t n, const std::size_t grain_size) const;
+
+      /**
+       * Return the first element of chunk @p chunk when splitting a loop
+       * over @p n elements into @p n_chunks chunks of about equal size. The
+       * chunk ends at the first element of chunk <tt>chunk+1</tt>.
+       */
+      static std::size_t
+      chunk_begin(const std::size_t  n,
+                  const unsigned int n_chunks,
+                  const unsigned int chunk);
+
+      /**
+       * Call @p chunk_function for all chunk indices in
+       * <tt>[0,n_chunks)</tt>, in parallel, and return once all calls have
+       * finished. The calling thread works on the first chunk. Exceptions
+       * thrown on the calling thread are passed on once the other chunks
+       * have finished.
+       */
+      void
+      run_chunks(const unsigned int                             n_chunks,
+                 const std::function<void(const unsigned int)> &chunk_function);
+
+      /**
+       * Return the index of the calling thread: zero for threads that do not
+       * belong to the pool, such as the main thread, and
+       * <tt>1,...,n_workers()</tt> for the workers.
+       */
+      static unsigned int
+      current_thread_index();
+
+    private:
+      /**
+       * Constructor.
+       */
+      ThreadPool();
+
+      /**
+       * Start @p n_workers worker threads.
+       */
+      void
+      start_workers(const unsigned int n_workers);
+
+      /**
+       * Terminate all worker threads and move the jobs left in their queues
+       * to the shared queue.
+       */
+      void
+      stop_workers();
+
+      /**
+       * The function run by the worker with index @p index.
+       */
+      void
+      worker_loop(const unsigned int index);
+
+      /**
+       * Take a job out of the queues, looking first at the queue of the
+       * thread with index @p index, then at the shared queue, and then at
+       * the queues of the other workers. Return a null pointer if all
+       * queues are empty.
+       */
+      std::shared_ptr<Job>
+      take_job(const unsigned int index);
+
+      /**
+       * Run @p job and wake up threads waiting for it.
+       */
+      void
+      run_job(Job &job);
+
+      /**
+       * Wake up sleeping threads, if any.
+       */
+      void
+      notify_sleeping_threads();
+
+      /**
+       * A queue of jobs together with the mutex protecting it.
+       */
+      struct Queue
+      {
+        std::mutex                       mutex;
+        std::deque<std::shared_ptr<Job>> jobs;
+      };
+
+      /**
+       * The queues of jobs. The first one is shared by all threads outside
+       * of the pool, the others belong to the workers.
+       */
+      std::vector<std::unique_ptr<Queue>> queues;
+
+      /**
+       * The worker threads.
+       */
+      std::vector<std::thread> workers;
+
+      /**
+       * The number of jobs currently in the queues.
+       */
+      std::atomic<unsigned int> n_queued_jobs;
+
+      /**
+       * The number of jobs that have been submitted and have not finished
+       * yet, whether they are still queued or already running. The number of
+       * threads and their affinity may only be changed while this is zero.
+       */
+      std::atomic<unsigned int> n_unfinished_jobs;
+
+      /**
+       * The number of threads sleeping on @p wake_up.
+       */
+      std::atomic<unsigned int> n_sleeping_threads;
+
+      /**
+       * Mutex and condition variable used by idle threads to wait for new
+       * jobs or for the job they are waiting for to finish.
+       */
+      std::mutex              sleep_mutex;
+      std::condition_variable wake_up;
+
+      /**
+       * A flag telling the workers to terminate, protected by
+       * @p sleep_mutex.
+       */
+      bool stop;
+
+      /**
+       * Whether the workers are pinned to cores.
+       */
+      bool pin_threads;
+    };
+
+
+
+    inline ThreadPool::Job::Job(const std::function<void()> &function)
+      : function(function)
+      , done(false)
+    {}
+
+
+
+    inline bool
+    ThreadPool::Job::is_done() const
+    {
+      return done.load();
+    }
+
+
+
+    inline unsigned int
+    ThreadPool::n_workers() const
+    {
+      return workers.size();
+    }
+
+
+
+    inline std::size_t
+    ThreadPool::chunk_begin(const std::size_t  n,
+                            const unsigned int n_chunks,
+                            const unsigned int chunk)
+    {
+      return (n / n_chunks) * chunk + (n % n_chunks) * chunk / n_chunks;
+    }
+  } // namespace internal
+} // namespace Threads
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
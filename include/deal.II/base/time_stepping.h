@@ -53,6 +53,13 @@ namespace TimeStepping
    *     in MATLAB)
    *   - FEHLBERG (fifth order)
    *   - CASH_KARP (firth order)
+   * - Low-storage explicit methods (see LowStorageRungeKutta::initialize):
+   *   - LOW_STORAGE_RK_STAGE3_ORDER3: three-stage third order method of
+   *     Williamson
+   *   - LOW_STORAGE_RK_STAGE5_ORDER4: five-stage fourth order method of
+   *     Carpenter and Kennedy
+   *   - LOW_STORAGE_RK_STAGE6_ORDER4: six-stage fourth order method of
+   *     Berland, Bogey and Bailly, optimized for wave propagation
    */
   enum runge_kutta_method
   {
@@ -68,6 +75,9 @@ namespace TimeStepping
     DOPRI,
     FEHLBERG,
     CASH_KARP,
+    LOW_STORAGE_RK_STAGE3_ORDER3,
+    LOW_STORAGE_RK_STAGE5_ORDER4,
+    LOW_STORAGE_RK_STAGE6_ORDER4,
     invalid
   };
 
@@ -324,6 +334,146 @@ namespace TimeStepping
 
 
 
+  /**
+   * LowStorageRungeKutta is derived from RungeKutta and implements explicit
+   * methods in the 2N-storage form of Williamson (J. Comput. Phys. 35,
+   * 48-56, 1980). Given the solution $y$ and an auxiliary vector $k$, each
+   * stage $i$ performs the two updates
+   * @f[
+   *   k \leftarrow A_i k + f(t + c_i \Delta t, y), \quad
+   *   y \leftarrow y + B_i \Delta t k,
+   * @f]
+   * with $A_1 = 0$. Contrary to ExplicitRungeKutta, which keeps all stage
+   * vectors in memory, these methods only need the two vectors $y$ and $k$
+   * regardless of the number of stages, which allows to solve larger
+   * problems with the same amount of memory.
+   *
+   * The methods implemented are the three-stage third order scheme by
+   * Williamson, the five-stage fourth order scheme by Carpenter and Kennedy
+   * (NASA TM-109112, 1994) and the six-stage fourth order scheme RK46-NL by
+   * Berland, Bogey and Bailly (Comput. Fluids 35, 1459-1463, 2006).
+   *
+   * Besides the usual interface with a function that returns the value of
+   * $f(t,y)$ as a new vector, evolve_one_time_step_fused() takes a function
+   * that directly computes the update of $k$. This allows to fuse the
+   * update with the evaluation of the operator, e.g. in a matrix-free
+   * operator that writes its result into $k$, such that each stage only
+   * needs one sweep through the data besides the update of $y$.
+   */
+  template <typename VectorType>
+  class LowStorageRungeKutta : public RungeKutta<VectorType>
+  {
+  public:
+    using RungeKutta<VectorType>::evolve_one_time_step;
+
+    /**
+     * Default constructor. This constructor creates an object for which
+     * you will want to call <code>initialize(runge_kutta_method)</code>
+     * before it can be used.
+     */
+    LowStorageRungeKutta() = default;
+
+    /**
+     * Constructor. This function calls initialize(runge_kutta_method).
+     */
+    LowStorageRungeKutta(const runge_kutta_method method);
+
+    /**
+     * Initialize the low-storage Runge-Kutta method.
+     */
+    void
+    initialize(const runge_kutta_method method) override;
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t. It
+     * allocates the auxiliary vector internally, see the other
+     * evolve_one_time_step() functions. @p id_minus_tau_J_inverse is not
+     * used. evolve_one_time_step returns the time at the end of the time
+     * step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      const std::function<
+        VectorType(const double, const double, const VectorType &)>
+        &         id_minus_tau_J_inverse,
+      double      t,
+      double      delta_t,
+      VectorType &y) override;
+
+    /**
+     * This function is used to advance from time @p t to t+ @p delta_t. @p f
+     * is the function $ f(t,y) $ that should be integrated, the input
+     * parameters are the time t and the vector y and the output is value of
+     * f at this point. @p k is the auxiliary vector of the method, which
+     * must have the same layout as @p y but need not be initialized. It can
+     * be reused from one time step to the next. evolve_one_time_step returns
+     * the time at the end of the time step.
+     */
+    double
+    evolve_one_time_step(
+      const std::function<VectorType(const double, const VectorType &)> &f,
+      double                                                             t,
+      double      delta_t,
+      VectorType &y,
+      VectorType &k);
+
+    /**
+     * Same as the function above, but the stages are computed by @p
+     * stage_update, which is called with the time $t + c_i \Delta t$, the
+     * current solution $y$, the factor $A_i$ and the vector $k$, and must
+     * compute $k \leftarrow A_i k + f(t + c_i \Delta t, y)$. For the first
+     * stage, the factor is zero and @p k must be overwritten without reading
+     * its old content. evolve_one_time_step_fused returns the time at the
+     * end of the time step.
+     */
+    double
+    evolve_one_time_step_fused(
+      const std::function<
+        void(const double, const VectorType &, const double, VectorType &)>
+        &         stage_update,
+      double      t,
+      double      delta_t,
+      VectorType &y,
+      VectorType &k);
+
+    /**
+     * This structure stores the name of the method used.
+     */
+    struct Status : public TimeStepping<VectorType>::Status
+    {
+      Status()
+        : method(invalid)
+      {}
+
+      runge_kutta_method method;
+    };
+
+    /**
+     * Return the status of the current object.
+     */
+    const Status &
+    get_status() const override;
+
+  private:
+    /**
+     * The coefficients $A_i$ of the 2N-storage form.
+     */
+    std::vector<double> low_storage_a;
+
+    /**
+     * The coefficients $B_i$ of the 2N-storage form.
+     */
+    std::vector<double> low_storage_b;
+
+    /**
+     * Status structure of the object.
+     */
+    Status status;
+  };
+
+
+
   /**
    * This class is derived from RungeKutta and implement the implicit methods.
    * This class works only for Diagonal Implicit Runge-Kutta (DIRK) methods.
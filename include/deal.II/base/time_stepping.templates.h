@@ -216,6 +216,171 @@ namespace TimeStepping
 
 
 
+  // ----------------------------------------------------------------------
+  // LowStorageRungeKutta
+  // ----------------------------------------------------------------------
+
+  template <typename VectorType>
+  LowStorageRungeKutta<VectorType>::LowStorageRungeKutta(
+    const runge_kutta_method method)
+  {
+    // virtual functions called in constructors and destructors never use the
+    // override in a derived class
+    // for clarity be explicit on which function is called
+    LowStorageRungeKutta<VectorType>::initialize(method);
+  }
+
+
+
+  template <typename VectorType>
+  void
+  LowStorageRungeKutta<VectorType>::initialize(const runge_kutta_method method)
+  {
+    status.method = method;
+
+    switch (method)
+      {
+        case (LOW_STORAGE_RK_STAGE3_ORDER3):
+          {
+            this->n_stages = 3;
+            low_storage_a  = {0., -5. / 9., -153. / 128.};
+            low_storage_b  = {1. / 3., 15. / 16., 8. / 15.};
+            this->c        = {0., 1. / 3., 3. / 4.};
+
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE5_ORDER4):
+          {
+            this->n_stages = 5;
+            low_storage_a  = {0.,
+                             -567301805773. / 1357537059087.,
+                             -2404267990393. / 2016746695238.,
+                             -3550918686646. / 2091501179385.,
+                             -1275806237668. / 842570457699.};
+            low_storage_b  = {1432997174477. / 9575080441755.,
+                             5161836677717. / 13612068292357.,
+                             1720146321549. / 2090206949498.,
+                             3134564353537. / 4481467310338.,
+                             2277821191437. / 14882151754819.};
+            this->c        = {0.,
+                             1432997174477. / 9575080441755.,
+                             2526269341429. / 6820363962896.,
+                             2006345519317. / 3224310063776.,
+                             2802321613138. / 2924317926251.};
+
+            break;
+          }
+        case (LOW_STORAGE_RK_STAGE6_ORDER4):
+          {
+            this->n_stages = 6;
+            low_storage_a  = {0.,
+                             -0.737101392796,
+                             -1.634740794343,
+                             -0.744739003780,
+                             -1.469897351522,
+                             -2.813971388035};
+            low_storage_b  = {0.032918605146,
+                             0.823256998200,
+                             0.381530948900,
+                             0.200092213184,
+                             1.718581042715,
+                             0.27};
+            this->c        = {0.,
+                             0.032918605146,
+                             0.249351723343,
+                             0.466911705055,
+                             0.582030414044,
+                             0.847252983783};
+
+            break;
+          }
+        default:
+          {
+            AssertThrow(
+              false,
+              ExcMessage("Unimplemented low-storage Runge-Kutta method."));
+          }
+      }
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    const std::function<
+      VectorType(const double, const double, const VectorType &)>
+      & /*id_minus_tau_J_inverse*/,
+    double      t,
+    double      delta_t,
+    VectorType &y)
+  {
+    VectorType k(y);
+    return evolve_one_time_step(f, t, delta_t, y, k);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step(
+    const std::function<VectorType(const double, const VectorType &)> &f,
+    double                                                             t,
+    double                                                             delta_t,
+    VectorType &                                                       y,
+    VectorType &                                                       k)
+  {
+    return evolve_one_time_step_fused(
+      [&f](const double      time,
+           const VectorType &solution,
+           const double      factor,
+           VectorType &      stage) {
+        if (factor == 0.)
+          stage = f(time, solution);
+        else
+          stage.sadd(factor, 1., f(time, solution));
+      },
+      t,
+      delta_t,
+      y,
+      k);
+  }
+
+
+
+  template <typename VectorType>
+  double
+  LowStorageRungeKutta<VectorType>::evolve_one_time_step_fused(
+    const std::function<
+      void(const double, const VectorType &, const double, VectorType &)>
+      &         stage_update,
+    double      t,
+    double      delta_t,
+    VectorType &y,
+    VectorType &k)
+  {
+    Assert(status.method != invalid, ExcNotInitialized());
+    for (unsigned int i = 0; i < this->n_stages; ++i)
+      {
+        stage_update(t + this->c[i] * delta_t, y, low_storage_a[i], k);
+        y.add(delta_t * low_storage_b[i], k);
+      }
+
+    return (t + delta_t);
+  }
+
+
+
+  template <typename VectorType>
+  const typename LowStorageRungeKutta<VectorType>::Status &
+  LowStorageRungeKutta<VectorType>::get_status() const
+  {
+    return status;
+  }
+
+
+
   // ----------------------------------------------------------------------
   // ImplicitRungeKutta
   // ----------------------------------------------------------------------
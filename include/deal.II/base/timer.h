@@ -20,13 +20,18 @@
 
 #include <deal.II/base/conditional_ostream.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/thread_local_storage.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -574,6 +579,51 @@ private:
  * sure that we only generate output on a single processor. See the step-32,
  * step-40, and step-42 tutorial programs for this kind of usage of this class.
  *
+ *
+ * <h3>Recording a trace</h3>
+ *
+ * The summary above only reports accumulated times. To find out how sections
+ * nest, how the work is distributed among the threads of a task-parallel
+ * program, or how long processes wait for each other, the class can also
+ * record a trace of all sections entered and left. Recording is switched on
+ * by enable_trace_recording(). From then on, every section entered through
+ * enter_subsection() or a TimerOutput::Scope object is recorded as an event
+ * with its start and end time, and sections entered while another one is
+ * active are recorded as its children. In addition, the lightweight
+ * TimerOutput::TraceScope class records events without contributing to the
+ * summary. It does not acquire a lock and only stores a time stamp in a
+ * buffer local to the current thread, so that it can be used within tasks
+ * running in parallel and in tight loops, where the tens of nanoseconds it
+ * costs do not matter:
+ * @code
+ *   TimerOutput timer (MPI_COMM_WORLD, pcout, TimerOutput::summary,
+ *                      TimerOutput::wall_times);
+ *   timer.enable_trace_recording();
+ *
+ *   {
+ *     TimerOutput::Scope timer_section(timer, "Assemble");
+ *     WorkStream::run(..., [&](...) {
+ *       TimerOutput::TraceScope trace(timer, "Assemble cell");
+ *       ...
+ *     }, ...);
+ *   }
+ *
+ *   std::ofstream trace_file("trace.json");
+ *   timer.write_trace(trace_file);
+ *   timer.print_hierarchical_summary();
+ * @endcode
+ * write_trace() writes the events of all processes in the Chrome trace event
+ * format, which can be viewed with the <code>chrome://tracing</code> page of
+ * the Chrome browser or with Perfetto, with one track per MPI process and
+ * thread. print_hierarchical_summary() prints the accumulated times of the
+ * recorded sections on the current process as a tree.
+ *
+ * Each event is stored in the buffer of the thread that started it, so a
+ * section or TraceScope that is recorded must be left on the same thread on
+ * which it was entered. Furthermore, reset() and enable_trace_recording()
+ * discard the recorded events and must not be called while a recorded
+ * section or TraceScope is still active.
+ *
  * @ingroup utilities
  * @author M. Kronbichler, 2009.
  */
@@ -623,6 +673,52 @@ public:
     bool in;
   };
 
+private:
+  struct ThreadTrace;
+
+public:
+  /**
+   * Helper class to record an event in the trace of a TimerOutput object,
+   * see the section on recording a trace in the documentation of
+   * TimerOutput. Contrary to Scope, this class does not create a section
+   * and does not contribute to the summary. It does nothing if trace
+   * recording is not enabled, and it may be used concurrently on several
+   * threads. An object of this class must be destroyed on the thread it was
+   * created on.
+   */
+  class TraceScope
+  {
+  public:
+    /**
+     * Start an event with the given name. The name is not copied, so the
+     * string it points to needs to remain valid as long as the trace is
+     * needed, which is the case for string literals.
+     */
+    TraceScope(dealii::TimerOutput &timer_, const char *event_name);
+
+    /**
+     * Destructor. Ends the event.
+     */
+    ~TraceScope();
+
+  private:
+    /**
+     * Reference to the TimerOutput object.
+     */
+    dealii::TimerOutput &timer;
+
+    /**
+     * The events of the thread this object was created on, or nullptr if no
+     * event is recorded.
+     */
+    ThreadTrace *trace;
+
+    /**
+     * The index of the event in @p trace.
+     */
+    unsigned int event_index;
+  };
+
   /**
    * An enumeration data type that describes whether to generate output every
    * time we exit a section, just in the end, both, or never.
@@ -842,12 +938,108 @@ public:
   enable_output();
 
   /**
-   * Resets the recorded timing information.
+   * Resets the recorded timing information, including the trace. This
+   * function must not be called while a recorded section or
+   * TimerOutput::TraceScope is active.
    */
   void
   reset();
 
+  /**
+   * Start recording a trace of all sections, see the documentation of this
+   * class. If this object was constructed with an MPI communicator, this
+   * function is collective and synchronizes the processes so that the time
+   * stamps of all processes refer to approximately the same point in time.
+   * Events recorded before are discarded, so this function must not be
+   * called while a recorded section or TimerOutput::TraceScope is active.
+   */
+  void
+  enable_trace_recording();
+
+  /**
+   * Stop recording a trace. The events recorded so far are kept.
+   */
+  void
+  disable_trace_recording();
+
+  /**
+   * Write the recorded trace in the JSON-based Chrome trace event format to
+   * @p stream. The process with rank zero in the MPI communicator of this
+   * object collects the events of all processes and writes them, with the
+   * MPI rank as process id and a number for each thread that recorded
+   * events as thread id. This function is collective and must not be called
+   * while events are being recorded.
+   */
+  void
+  write_trace(std::ostream &stream) const;
+
+  /**
+   * Print the accumulated wall times of the sections recorded in the trace
+   * on the current process as a tree, where each section is shown below the
+   * section in which it was entered, summed over all threads.
+   */
+  void
+  print_hierarchical_summary() const;
+
 private:
+  /**
+   * An event of the trace: a section or TraceScope that was entered at time
+   * @p start and left at time @p end, both measured in nanoseconds since the
+   * trace recording was enabled, and that is nested in the event with index
+   * @p parent in the same buffer (or -1 for top-level events).
+   */
+  struct TraceEvent
+  {
+    const char *  name;
+    std::uint64_t start;
+    std::uint64_t end;
+    int           parent;
+  };
+
+  /**
+   * The events recorded on one thread, the number by which this thread is
+   * identified in the trace, the index of the innermost open event, and the
+   * number of events that have been started but not ended yet.
+   */
+  struct ThreadTrace
+  {
+    ThreadTrace();
+
+    unsigned int            thread_index;
+    std::vector<TraceEvent> events;
+    int                     current_event;
+    unsigned int            n_open_events;
+  };
+
+  /**
+   * Return the time in nanoseconds since the trace recording was enabled.
+   */
+  std::uint64_t
+  trace_time_stamp() const;
+
+  /**
+   * Start a new event on the current thread, set @p trace to the buffer of
+   * the current thread and return the index of the event in it. If trace
+   * recording is disabled, return numbers::invalid_unsigned_int and leave
+   * @p trace untouched.
+   */
+  unsigned int
+  begin_trace_event(const char *name, ThreadTrace *&trace);
+
+  /**
+   * End the event with the given index in the buffer @p trace, which must be
+   * the buffer of the current thread.
+   */
+  void
+  end_trace_event(const unsigned int event_index, ThreadTrace &trace);
+
+  /**
+   * Discard the events recorded so far. The buffers of the threads are
+   * emptied but not destroyed. No event may be open.
+   */
+  void
+  clear_trace();
+
   /**
    * When to output information to the output stream.
    */
@@ -911,6 +1103,42 @@ private:
    * used with several threads.
    */
   Threads::Mutex mutex;
+
+  /**
+   * Whether events are currently recorded.
+   */
+  std::atomic<bool> trace_is_enabled;
+
+  /**
+   * The point in time the trace recording was enabled, to which all time
+   * stamps refer.
+   */
+  std::chrono::steady_clock::time_point trace_start_time;
+
+  /**
+   * The number of threads that have recorded events so far.
+   */
+  std::atomic<unsigned int> n_trace_threads;
+
+  /**
+   * The events recorded on each thread.
+   */
+  mutable Threads::ThreadLocalStorage<ThreadTrace> thread_traces;
+
+  /**
+   * For each active section, the buffer of the thread that entered it and
+   * the index of its event in there.
+   */
+  std::map<std::string, std::pair<ThreadTrace *, unsigned int>>
+    active_trace_events;
+
+  /**
+   * The names of all sections that have been recorded in the trace. The
+   * events point to the strings stored here. Contrary to @p sections, this
+   * set is not cleared by reset(), so that the names stay valid as long as
+   * this object exists.
+   */
+  std::set<std::string> trace_section_names;
 };
 
 
@@ -1037,6 +1265,76 @@ TimerOutput::Scope::stop()
 }
 
 
+
+inline std::uint64_t
+TimerOutput::trace_time_stamp() const
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now() - trace_start_time)
+    .count();
+}
+
+
+
+inline unsigned int
+TimerOutput::begin_trace_event(const char *name, ThreadTrace *&trace)
+{
+  if (trace_is_enabled.load(std::memory_order_relaxed) == false)
+    return numbers::invalid_unsigned_int;
+
+  trace = &thread_traces.get();
+  if (trace->thread_index == numbers::invalid_unsigned_int)
+    trace->thread_index = n_trace_threads++;
+
+  const std::uint64_t start = trace_time_stamp();
+  trace->events.push_back({name, start, start, trace->current_event});
+  trace->current_event = trace->events.size() - 1;
+  ++trace->n_open_events;
+  return trace->current_event;
+}
+
+
+
+inline void
+TimerOutput::end_trace_event(const unsigned int event_index,
+                             ThreadTrace &      trace)
+{
+  if (event_index == numbers::invalid_unsigned_int)
+    return;
+
+  Assert(&trace == &thread_traces.get(),
+         ExcMessage("A recorded section or TraceScope must be left on the "
+                    "thread on which it was entered."));
+  AssertIndexRange(event_index, trace.events.size());
+  Assert(trace.n_open_events > 0, ExcInternalError());
+  TraceEvent &event = trace.events[event_index];
+  event.end         = trace_time_stamp();
+  --trace.n_open_events;
+
+  // sections may be left in a different order than they were entered, so
+  // only step out if this is the innermost event
+  if (trace.current_event == static_cast<int>(event_index))
+    trace.current_event = event.parent;
+}
+
+
+
+inline TimerOutput::TraceScope::TraceScope(dealii::TimerOutput &timer_,
+                                           const char *         event_name)
+  : timer(timer_)
+  , trace(nullptr)
+  , event_index(timer.begin_trace_event(event_name, trace))
+{}
+
+
+
+inline TimerOutput::TraceScope::~TraceScope()
+{
+  if (trace != nullptr)
+    timer.end_trace_event(event_index, *trace);
+}
+
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
@@ -47,6 +47,16 @@ namespace types
    */
   using global_vertex_index = unsigned long long int;
 
+  /**
+   * The type used to identify the coarse cells of a triangulation across
+   * processors, see CellId and
+   * Triangulation::coarse_cell_index_to_coarse_cell_id().
+   *
+   * There is a special value, numbers::invalid_coarse_cell_id that is used to
+   * indicate an invalid value of this type.
+   */
+  using coarse_cell_id = unsigned int;
+
   /**
    * An identifier that denotes the MPI type associated with
    * types::global_vertex_index.
@@ -274,6 +284,14 @@ namespace numbers
    */
   const types::subdomain_id artificial_subdomain_id =
     static_cast<types::subdomain_id>(-2);
+
+  /**
+   * A special id for an invalid coarse cell id, returned for example by
+   * Triangulation::coarse_cell_id_to_coarse_cell_index() for coarse cells
+   * that are not stored on the current processor.
+   */
+  const types::coarse_cell_id invalid_coarse_cell_id =
+    static_cast<types::coarse_cell_id>(-1);
 } // namespace numbers
 
 DEAL_II_NAMESPACE_CLOSE
@@ -32,7 +32,15 @@
 #    include <tbb/pipeline.h>
 #  endif
 
+#  ifdef DEAL_II_USE_THREAD_POOL
+#    include <deal.II/base/thread_pool.h>
+#  endif
+
+#  include <atomic>
+#  include <chrono>
+#  include <cstdint>
 #  include <functional>
+#  include <list>
 #  include <memory>
 #  include <utility>
 #  include <vector>
@@ -137,15 +145,226 @@ DEAL_II_NAMESPACE_OPEN
  * CopyData can be resized in accordance with the number of local DoFs on the
  * current cell.
  *
- * The functions in this namespace only really work in parallel when
- * multithread mode was selected during deal.II configuration. Otherwise they
- * simply work on each item sequentially.
+ * <h3>Thread-local reduction</h3>
+ *
+ * For cheap worker functions, the sequential copier stage easily becomes the
+ * bottleneck of the pipeline used by run(), and the ring buffer of
+ * <tt>queue_length*chunk_size</tt> CopyData objects occupies a considerable
+ * amount of memory if these objects are large, as is the case for the local
+ * matrices of high order elements. If the operation performed by the copier
+ * is commutative, as for example the addition of local contributions into a
+ * global vector or matrix, run_with_thread_local_reduction() can be used
+ * instead: There, every thread copies the results of the worker function
+ * into a thread-local copy of the target object directly after computing
+ * them, and the thread-local copies are merged into the global target in a
+ * final parallel reduction. This removes both the serialization of the
+ * copier and the buffer of CopyData objects, at the cost of one copy of the
+ * target per thread and of a result that is not bitwise reproducible since
+ * the order of the additions depends on the scheduling of the tasks.
+ *
+ * <h3>Statistics</h3>
+ *
+ * All run() functions take an optional pointer to a WorkStream::Statistics
+ * object as last argument. If given, the time spent in the worker and copier
+ * functions is measured and stored in this object, which helps to identify
+ * whether the copier is the bottleneck and to tune the @p chunk_size
+ * argument.
+ *
+ * The functions in this namespace use the TBB if multithread mode was
+ * selected during deal.II configuration. Otherwise, they run on the thread
+ * pool of deal.II described in Threads::internal::ThreadPool if the system
+ * supports threads, and simply work on each item sequentially if not.
  *
  * @ingroup threads
  * @author Wolfgang Bangerth, 2007, 2008, 2009, 2013. Bruno Turcksin, 2013.
  */
 namespace WorkStream
 {
+  /**
+   * A structure that holds statistics about a call to one of the run()
+   * functions or to run_with_thread_local_reduction(), filled if a pointer
+   * to an object of this type is passed as the last argument.
+   *
+   * The times spent in the worker and copier functions are summed over all
+   * threads and may therefore exceed the wall time of the whole call. If the
+   * copier time is close to the wall time of run(), the sequential copier
+   * stage is the bottleneck and run_with_thread_local_reduction() or a
+   * colored iterator range should be considered. If the worker time per
+   * chunk, i.e., worker_time/n_chunks, is very small, the overhead of
+   * scheduling the chunks is significant and @p chunk_size should be
+   * increased.
+   */
+  struct Statistics
+  {
+    /**
+     * Constructor. Sets all values to zero.
+     */
+    Statistics()
+      : n_items(0)
+      , n_chunks(0)
+      , worker_time(0.)
+      , copier_time(0.)
+      , reduction_time(0.)
+      , wall_time(0.)
+    {}
+
+    /**
+     * The number of items, i.e., elements of the iterator range, that were
+     * worked on.
+     */
+    unsigned int n_items;
+
+    /**
+     * The number of chunks into which the items were grouped.
+     */
+    unsigned int n_chunks;
+
+    /**
+     * The accumulated time in seconds spent in the worker function.
+     */
+    double worker_time;
+
+    /**
+     * The accumulated time in seconds spent in the copier function.
+     */
+    double copier_time;
+
+    /**
+     * The time in seconds spent in merging the thread-local results of
+     * run_with_thread_local_reduction(). Zero for the other functions.
+     */
+    double reduction_time;
+
+    /**
+     * The wall time in seconds of the whole call.
+     */
+    double wall_time;
+  };
+
+
+
+  namespace internal
+  {
+    /**
+     * A class that accumulates the times measured in the various stages of
+     * the WorkStream implementations and writes them into a Statistics
+     * object at the end of a run. All functions may be called concurrently
+     * and do nothing if no Statistics object was given, in which case not
+     * even the clock is queried.
+     */
+    class StatisticsRecorder
+    {
+    public:
+      using time_point = std::chrono::steady_clock::time_point;
+
+      /**
+       * Constructor. Starts the measurement of the wall time.
+       */
+      StatisticsRecorder(Statistics *statistics)
+        : statistics(statistics)
+        , start_time(now())
+        , n_items(0)
+        , n_chunks(0)
+        , worker_time(0)
+        , copier_time(0)
+        , reduction_time(0)
+      {}
+
+      /**
+       * Return the current time, or a default-constructed time point if no
+       * statistics are collected.
+       */
+      time_point
+      now() const
+      {
+        return (statistics != nullptr) ? std::chrono::steady_clock::now() :
+                                         time_point();
+      }
+
+      /**
+       * Record that a chunk of @p n_chunk_items items has been worked on.
+       */
+      void
+      add_chunk(const unsigned int n_chunk_items)
+      {
+        if (statistics != nullptr)
+          {
+            n_items += n_chunk_items;
+            ++n_chunks;
+          }
+      }
+
+      /**
+       * Add the time elapsed since @p start to the worker time.
+       */
+      void
+      add_worker_time(const time_point &start)
+      {
+        if (statistics != nullptr)
+          worker_time += elapsed(start);
+      }
+
+      /**
+       * Add the time elapsed since @p start to the copier time.
+       */
+      void
+      add_copier_time(const time_point &start)
+      {
+        if (statistics != nullptr)
+          copier_time += elapsed(start);
+      }
+
+      /**
+       * Add the time elapsed since @p start to the reduction time.
+       */
+      void
+      add_reduction_time(const time_point &start)
+      {
+        if (statistics != nullptr)
+          reduction_time += elapsed(start);
+      }
+
+      /**
+       * Write the accumulated values into the Statistics object.
+       */
+      void
+      finalize()
+      {
+        if (statistics == nullptr)
+          return;
+
+        statistics->n_items        = n_items;
+        statistics->n_chunks       = n_chunks;
+        statistics->worker_time    = 1e-9 * worker_time;
+        statistics->copier_time    = 1e-9 * copier_time;
+        statistics->reduction_time = 1e-9 * reduction_time;
+        statistics->wall_time      = 1e-9 * elapsed(start_time);
+      }
+
+    private:
+      /**
+       * Return the time elapsed since @p start in nanoseconds.
+       */
+      std::uint64_t
+      elapsed(const time_point &start) const
+      {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                 std::chrono::steady_clock::now() - start)
+          .count();
+      }
+
+      Statistics *const          statistics;
+      const time_point           start_time;
+      std::atomic<unsigned int>  n_items;
+      std::atomic<unsigned int>  n_chunks;
+      std::atomic<std::uint64_t> worker_time;
+      std::atomic<std::uint64_t> copier_time;
+      std::atomic<std::uint64_t> reduction_time;
+    };
+  } // namespace internal
+
+
+
 #  ifdef DEAL_II_WITH_THREADS
 
   namespace internal
@@ -471,15 +690,18 @@ namespace WorkStream
         /**
          * Constructor. Takes a reference to the object on which we will
          * operate as well as a pointer to the function that will do the
-         * assembly.
+         * assembly, and optionally an object that records the time spent in
+         * the worker function.
          */
         Worker(
           const std::function<void(const Iterator &, ScratchData &, CopyData &)>
-            &  worker,
-          bool copier_exist = true)
+            &                 worker,
+          bool                copier_exist = true,
+          StatisticsRecorder *recorder     = nullptr)
           : tbb::filter(/* is_serial= */ false)
           , worker(worker)
           , copier_exist(copier_exist)
+          , recorder(recorder)
         {}
 
 
@@ -542,6 +764,9 @@ namespace WorkStream
           // given. since these worker functions are called on separate threads,
           // nothing good can happen if they throw an exception and we are best
           // off catching it and showing an error message
+          const StatisticsRecorder::time_point start_time =
+            (recorder != nullptr) ? recorder->now() :
+                                    StatisticsRecorder::time_point();
           for (unsigned int i = 0; i < current_item->n_items; ++i)
             {
               try
@@ -560,6 +785,11 @@ namespace WorkStream
                   Threads::internal::handle_unknown_exception();
                 }
             }
+          if (recorder != nullptr)
+            {
+              recorder->add_worker_time(start_time);
+              recorder->add_chunk(current_item->n_items);
+            }
 
           // finally mark the scratch object as unused again. as above, there
           // is no need to lock anything here since the object we work on
@@ -603,6 +833,12 @@ namespace WorkStream
          * worker has to free the buffer. Otherwise the copier will do it.
          */
         bool copier_exist;
+
+        /**
+         * The object recording the time spent in the worker function, or
+         * nullptr.
+         */
+        StatisticsRecorder *recorder;
       };
 
 
@@ -620,11 +856,14 @@ namespace WorkStream
          * Constructor. Takes a reference to the object on which we will
          * operate as well as a pointer to the function that will do the
          * copying from the additional data object to the global matrix or
-         * similar.
+         * similar, and optionally an object that records the time spent in
+         * the copier function.
          */
-        Copier(const std::function<void(const CopyData &)> &copier)
+        Copier(const std::function<void(const CopyData &)> &copier,
+               StatisticsRecorder *                         recorder = nullptr)
           : tbb::filter(/*is_serial=*/true)
           , copier(copier)
+          , recorder(recorder)
         {}
 
 
@@ -645,6 +884,9 @@ namespace WorkStream
           // initiate copying data. for the same reasons as in the worker class
           // above, catch exceptions rather than letting it propagate into
           // unknown territories
+          const StatisticsRecorder::time_point start_time =
+            (recorder != nullptr) ? recorder->now() :
+                                    StatisticsRecorder::time_point();
           for (unsigned int i = 0; i < current_item->n_items; ++i)
             {
               try
@@ -661,6 +903,8 @@ namespace WorkStream
                   Threads::internal::handle_unknown_exception();
                 }
             }
+          if (recorder != nullptr)
+            recorder->add_copier_time(start_time);
 
           // mark current item as usable again
           current_item->currently_in_use = false;
@@ -677,6 +921,12 @@ namespace WorkStream
          * Pointer to the function that does the copying of data.
          */
         const std::function<void(const CopyData &)> copier;
+
+        /**
+         * The object recording the time spent in the copier function, or
+         * nullptr.
+         */
+        StatisticsRecorder *recorder;
       };
 
     } // namespace Implementation2
@@ -753,11 +1003,13 @@ namespace WorkStream
             &                                          worker,
           const std::function<void(const CopyData &)> &copier,
           const ScratchData &                          sample_scratch_data,
-          const CopyData &                             sample_copy_data)
+          const CopyData &                             sample_copy_data,
+          StatisticsRecorder &                         recorder)
           : worker(worker)
           , copier(copier)
           , sample_scratch_data(sample_scratch_data)
           , sample_copy_data(sample_copy_data)
+          , recorder(recorder)
         {}
 
 
@@ -820,10 +1072,17 @@ namespace WorkStream
             {
               try
                 {
+                  const StatisticsRecorder::time_point start_time =
+                    recorder.now();
                   if (worker)
                     worker(*p, *scratch_data, *copy_data);
+                  recorder.add_worker_time(start_time);
+
+                  const StatisticsRecorder::time_point copier_start_time =
+                    recorder.now();
                   if (copier)
                     copier(*copy_data);
+                  recorder.add_copier_time(copier_start_time);
                 }
               catch (const std::exception &exc)
                 {
@@ -851,6 +1110,8 @@ namespace WorkStream
                   p->currently_in_use = false;
                 }
           }
+
+          recorder.add_chunk(range.size());
         }
 
       private:
@@ -883,15 +1144,560 @@ namespace WorkStream
          */
         const ScratchData &sample_scratch_data;
         const CopyData &   sample_copy_data;
+
+        /**
+         * The object recording the time spent in the worker and copier
+         * functions.
+         */
+        StatisticsRecorder &recorder;
       };
     } // namespace Implementation3
 
+
+
+    /**
+     * A namespace for the implementation of
+     * run_with_thread_local_reduction(), where the results of the worker
+     * function are accumulated into a copy of the target object owned by
+     * the current thread instead of being passed to a sequential copier.
+     */
+    namespace ThreadLocalReduction
+    {
+      /**
+       * A class that manages calling the worker and copier functions on a
+       * range of items, using scratch and copy data objects as well as a
+       * copy of the target object that are local to the current thread.
+       */
+      template <typename Iterator,
+                typename ScratchData,
+                typename CopyData,
+                typename TargetType>
+      class WorkerAndCopier
+      {
+      public:
+        /**
+         * Constructor.
+         */
+        WorkerAndCopier(
+          const std::function<void(const Iterator &, ScratchData &, CopyData &)>
+            &worker,
+          const std::function<void(const CopyData &, TargetType &)> &copier,
+          const ScratchData &sample_scratch_data,
+          const CopyData &   sample_copy_data,
+          const TargetType & sample_local_target,
+          StatisticsRecorder &recorder)
+          : worker(worker)
+          , copier(copier)
+          , sample_scratch_data(sample_scratch_data)
+          , sample_copy_data(sample_copy_data)
+          , sample_local_target(sample_local_target)
+          , recorder(recorder)
+        {}
+
+
+        /**
+         * The function that calls the worker and the copier functions on a
+         * range of items denoted by the argument.
+         */
+        void
+        operator()(const tbb::blocked_range<
+                   typename std::vector<Iterator>::const_iterator> &range)
+        {
+          // find an unused scratch and copy data object in the list of the
+          // current thread or create one, see Implementation3 for why we
+          // need a list and why we do not need to lock. the thread-local
+          // target, on the other hand, can be shared among all instances of
+          // this function on the current thread: the copier does not yield,
+          // so the copier calls of different instances never interleave
+          ThreadData & thread_data  = data.get();
+          ScratchData *scratch_data = nullptr;
+          CopyData *   copy_data    = nullptr;
+          for (auto &p : thread_data.scratch_and_copy_data)
+            if (p.currently_in_use == false)
+              {
+                scratch_data       = p.scratch_data.get();
+                copy_data          = p.copy_data.get();
+                p.currently_in_use = true;
+                break;
+              }
+          if (scratch_data == nullptr)
+            {
+              scratch_data = new ScratchData(sample_scratch_data);
+              copy_data    = new CopyData(sample_copy_data);
+              thread_data.scratch_and_copy_data.emplace_back(scratch_data,
+                                                             copy_data,
+                                                             true);
+            }
+
+          // create the local target on first use, which places its memory
+          // close to the thread that works on it
+          if (thread_data.local_target == nullptr)
+            thread_data.local_target =
+              std::make_shared<TargetType>(sample_local_target);
+          TargetType &local_target = *thread_data.local_target;
+
+          for (typename std::vector<Iterator>::const_iterator p = range.begin();
+               p != range.end();
+               ++p)
+            {
+              try
+                {
+                  const StatisticsRecorder::time_point start_time =
+                    recorder.now();
+                  if (worker)
+                    worker(*p, *scratch_data, *copy_data);
+                  recorder.add_worker_time(start_time);
+
+                  const StatisticsRecorder::time_point copier_start_time =
+                    recorder.now();
+                  copier(*copy_data, local_target);
+                  recorder.add_copier_time(copier_start_time);
+                }
+              catch (const std::exception &exc)
+                {
+                  Threads::internal::handle_std_exception(exc);
+                }
+              catch (...)
+                {
+                  Threads::internal::handle_unknown_exception();
+                }
+            }
+
+          // mark the scratch object as unused again. note that we must
+          // not keep a reference into the list across the calls above
+          for (auto &p : data.get().scratch_and_copy_data)
+            if (p.scratch_data.get() == scratch_data)
+              {
+                Assert(p.currently_in_use == true, ExcInternalError());
+                p.currently_in_use = false;
+              }
+
+          recorder.add_chunk(range.size());
+        }
+
+
+        /**
+         * Return pointers to the local targets of all threads that took
+         * part in the computation.
+         */
+        std::vector<TargetType *>
+        get_local_targets()
+        {
+          std::vector<TargetType *> local_targets;
+          for (auto &thread_data : data.get_implementation())
+            if (thread_data.local_target != nullptr)
+              local_targets.push_back(thread_data.local_target.get());
+          return local_targets;
+        }
+
+      private:
+        using ScratchAndCopyDataObjects = typename Implementation3::
+          ScratchAndCopyDataObjects<Iterator, ScratchData, CopyData>;
+
+        /**
+         * The objects owned by each thread.
+         */
+        struct ThreadData
+        {
+          std::list<ScratchAndCopyDataObjects> scratch_and_copy_data;
+          std::shared_ptr<TargetType>          local_target;
+        };
+
+        Threads::ThreadLocalStorage<ThreadData> data;
+
+        /**
+         * Pointer to the function that does the assembling on the sequence of
+         * cells.
+         */
+        const std::function<void(const Iterator &, ScratchData &, CopyData &)>
+          worker;
+
+        /**
+         * Pointer to the function that adds the local contributions to the
+         * thread-local target.
+         */
+        const std::function<void(const CopyData &, TargetType &)> copier;
+
+        /**
+         * References to sample objects for when we need them.
+         */
+        const ScratchData &sample_scratch_data;
+        const CopyData &   sample_copy_data;
+        const TargetType & sample_local_target;
+
+        /**
+         * The object recording the time spent in the worker and copier
+         * functions.
+         */
+        StatisticsRecorder &recorder;
+      };
+
+
+
+      /**
+       * Merge the objects pointed to by @p targets pairwise in parallel,
+       * using @p reducer, until only the first of them is left. This needs
+       * a logarithmic number of steps in the number of threads.
+       */
+      template <typename TargetType>
+      void
+      reduce(
+        std::vector<TargetType *> &                                  targets,
+        const std::function<void(const TargetType &, TargetType &)> &reducer)
+      {
+        while (targets.size() > 1)
+          {
+            const std::size_t n_pairs = targets.size() / 2;
+            const std::size_t offset  = targets.size() - n_pairs;
+            tbb::parallel_for(
+              tbb::blocked_range<std::size_t>(0, n_pairs, 1),
+              [&](const tbb::blocked_range<std::size_t> &range) {
+                for (std::size_t i = range.begin(); i < range.end(); ++i)
+                  try
+                    {
+                      reducer(*targets[offset + i], *targets[i]);
+                    }
+                  catch (const std::exception &exc)
+                    {
+                      Threads::internal::handle_std_exception(exc);
+                    }
+                  catch (...)
+                    {
+                      Threads::internal::handle_unknown_exception();
+                    }
+              });
+            targets.resize(offset);
+          }
+      }
+    } // namespace ThreadLocalReduction
+
   } // namespace internal
 
 
 #  endif // DEAL_II_WITH_THREADS
 
 
+#  ifdef DEAL_II_USE_THREAD_POOL
+
+  namespace internal
+  {
+    /**
+     * A namespace for the implementation of the WorkStream functions on the
+     * thread pool of deal.II, which is used if deal.II is configured without
+     * the Threading Building Blocks, see Threads::internal::ThreadPool.
+     */
+    namespace ThreadPoolImplementation
+    {
+      using Threads::internal::ThreadPool;
+
+      /**
+       * A scratch and a copy data object together with a flag that
+       * indicates whether they are currently in use.
+       */
+      template <typename ScratchData, typename CopyData>
+      struct ScratchAndCopyData
+      {
+        ScratchAndCopyData(const ScratchData &scratch_data,
+                           const CopyData &   copy_data)
+          : scratch_data(scratch_data)
+          , copy_data(copy_data)
+          , currently_in_use(true)
+        {}
+
+        ScratchData scratch_data;
+        CopyData    copy_data;
+        bool        currently_in_use;
+      };
+
+
+
+      /**
+       * A list of scratch and copy data objects for each thread. As
+       * discussed for Implementation2::IteratorRangeToItemStream::scratch_data,
+       * a single object per thread is not sufficient since a worker function
+       * that waits for other tasks may run another instance of the worker
+       * on the same thread in the meantime.
+       */
+      template <typename ScratchData, typename CopyData>
+      class ThreadLocalScratchAndCopyData
+      {
+      public:
+        using ObjectType = ScratchAndCopyData<ScratchData, CopyData>;
+
+        /**
+         * Constructor.
+         */
+        ThreadLocalScratchAndCopyData(const ScratchData &sample_scratch_data,
+                                      const CopyData &   sample_copy_data)
+          : sample_scratch_data(sample_scratch_data)
+          , sample_copy_data(sample_copy_data)
+        {}
+
+        /**
+         * Return an unused object of the current thread and mark it as used.
+         * New objects are created on the thread that uses them.
+         */
+        ObjectType &
+        acquire()
+        {
+          std::list<ObjectType> &list = data.get();
+          for (ObjectType &object : list)
+            if (object.currently_in_use == false)
+              {
+                object.currently_in_use = true;
+                return object;
+              }
+          list.emplace_back(sample_scratch_data, sample_copy_data);
+          return list.back();
+        }
+
+        /**
+         * Mark @p object as unused again.
+         */
+        static void
+        release(ObjectType &object)
+        {
+          Assert(object.currently_in_use == true, ExcInternalError());
+          object.currently_in_use = false;
+        }
+
+      private:
+        Threads::ThreadLocalStorage<std::list<ObjectType>> data;
+        const ScratchData &                                sample_scratch_data;
+        const CopyData &                                   sample_copy_data;
+      };
+
+
+
+      /**
+       * Run the worker on all items of [begin,end) and the copier on the
+       * results, in the order of the items. The items are processed in
+       * blocks: while the worker functions run in parallel on one block, the
+       * copier works on the previous one as a job of the thread pool. Each
+       * of the two blocks holds about half of the
+       * <tt>queue_length*chunk_size</tt> CopyData objects of the TBB pipeline.
+       */
+      template <typename Iterator, typename ScratchData, typename CopyData>
+      void
+      run(const Iterator &begin,
+          const Iterator &end,
+          const std::function<void(const Iterator &, ScratchData &, CopyData &)>
+            &                                          worker,
+          const std::function<void(const CopyData &)> &copier,
+          const ScratchData &                          sample_scratch_data,
+          const CopyData &                             sample_copy_data,
+          const unsigned int                           queue_length,
+          const unsigned int                           chunk_size,
+          StatisticsRecorder &                         recorder)
+      {
+        ThreadPool &       pool = ThreadPool::instance();
+        const unsigned int block_size =
+          std::max(queue_length / 2, 1U) * chunk_size;
+
+        struct Block
+        {
+          std::vector<Iterator> items;
+          std::vector<CopyData> copy_datas;
+        };
+        Block blocks[2];
+        for (Block &block : blocks)
+          {
+            block.items.reserve(block_size);
+            block.copy_datas.resize(block_size, sample_copy_data);
+          }
+
+        ThreadLocalScratchAndCopyData<ScratchData, CopyData> scratch_data(
+          sample_scratch_data, sample_copy_data);
+
+        std::shared_ptr<ThreadPool::Job> copier_job;
+        unsigned int                     current = 0;
+        for (Iterator next = begin; next != end; current = 1 - current)
+          {
+            Block &block = blocks[current];
+            block.items.clear();
+            for (; next != end && block.items.size() < block_size; ++next)
+              block.items.push_back(next);
+
+            const unsigned int n_items = block.items.size();
+            const unsigned int n_chunks =
+              (n_items + chunk_size - 1) / chunk_size;
+            pool.run_chunks(n_chunks, [&](const unsigned int chunk) {
+              auto &objects = scratch_data.acquire();
+              const StatisticsRecorder::time_point start_time =
+                recorder.now();
+              const unsigned int end_item =
+                std::min((chunk + 1) * chunk_size, n_items);
+              for (unsigned int i = chunk * chunk_size; i < end_item; ++i)
+                if (worker)
+                  worker(block.items[i],
+                         objects.scratch_data,
+                         block.copy_datas[i]);
+              recorder.add_worker_time(start_time);
+              recorder.add_chunk(end_item - chunk * chunk_size);
+              scratch_data.release(objects);
+            });
+
+            // copy the results of the previous block before those of the
+            // current one
+            if (copier_job != nullptr)
+              pool.wait(*copier_job);
+            copier_job = pool.submit([&block, &copier, &recorder]() {
+              const StatisticsRecorder::time_point start_time =
+                recorder.now();
+              try
+                {
+                  for (unsigned int i = 0; i < block.items.size(); ++i)
+                    copier(block.copy_datas[i]);
+                }
+              catch (const std::exception &exc)
+                {
+                  Threads::internal::handle_std_exception(exc);
+                }
+              catch (...)
+                {
+                  Threads::internal::handle_unknown_exception();
+                }
+              recorder.add_copier_time(start_time);
+            });
+          }
+
+        if (copier_job != nullptr)
+          pool.wait(*copier_job);
+      }
+
+
+
+      /**
+       * Run the worker and, directly afterwards, the copier on all
+       * @p items, in parallel. This is used for the individual colors of
+       * the colored version of run().
+       */
+      template <typename Iterator, typename ScratchData, typename CopyData>
+      void
+      run(const std::vector<Iterator> &items,
+          const std::function<void(const Iterator &, ScratchData &, CopyData &)>
+            &                                                   worker,
+          const std::function<void(const CopyData &)> &         copier,
+          ThreadLocalScratchAndCopyData<ScratchData, CopyData> &data,
+          const unsigned int                                    chunk_size,
+          StatisticsRecorder &                                  recorder)
+      {
+        ThreadPool &       pool     = ThreadPool::instance();
+        const std::size_t  n_items  = items.size();
+        const unsigned int n_chunks = pool.n_chunks(n_items, chunk_size);
+        pool.run_chunks(n_chunks, [&](const unsigned int chunk) {
+          auto &            objects = data.acquire();
+          const std::size_t end_item =
+            ThreadPool::chunk_begin(n_items, n_chunks, chunk + 1);
+          for (std::size_t i = ThreadPool::chunk_begin(n_items, n_chunks, chunk);
+               i < end_item;
+               ++i)
+            {
+              const StatisticsRecorder::time_point start_time =
+                recorder.now();
+              if (worker)
+                worker(items[i], objects.scratch_data, objects.copy_data);
+              recorder.add_worker_time(start_time);
+
+              const StatisticsRecorder::time_point copier_start_time =
+                recorder.now();
+              if (copier)
+                copier(objects.copy_data);
+              recorder.add_copier_time(copier_start_time);
+            }
+          recorder.add_chunk(
+            end_item - ThreadPool::chunk_begin(n_items, n_chunks, chunk));
+          data.release(objects);
+        });
+      }
+
+
+
+      /**
+       * The implementation of run_with_thread_local_reduction() on the
+       * thread pool: the same as ThreadLocalReduction::WorkerAndCopier
+       * together with ThreadLocalReduction::reduce() for the TBB.
+       */
+      template <typename Iterator,
+                typename ScratchData,
+                typename CopyData,
+                typename TargetType>
+      void
+      run_with_thread_local_reduction(
+        const std::vector<Iterator> &items,
+        const std::function<void(const Iterator &, ScratchData &, CopyData &)>
+          &worker,
+        const std::function<void(const CopyData &, TargetType &)> &copier,
+        const std::function<void(const TargetType &, TargetType &)> &reducer,
+        const ScratchData & sample_scratch_data,
+        const CopyData &    sample_copy_data,
+        const TargetType &  sample_local_target,
+        TargetType &        target,
+        const unsigned int  chunk_size,
+        StatisticsRecorder &recorder)
+      {
+        ThreadPool &pool = ThreadPool::instance();
+        ThreadLocalScratchAndCopyData<ScratchData, CopyData> data(
+          sample_scratch_data, sample_copy_data);
+        Threads::ThreadLocalStorage<std::shared_ptr<TargetType>> local_targets;
+
+        const std::size_t  n_items  = items.size();
+        const unsigned int n_chunks = pool.n_chunks(n_items, chunk_size);
+        pool.run_chunks(n_chunks, [&](const unsigned int chunk) {
+          auto &                       objects      = data.acquire();
+          std::shared_ptr<TargetType> &local_target = local_targets.get();
+          if (local_target == nullptr)
+            local_target = std::make_shared<TargetType>(sample_local_target);
+
+          const std::size_t end_item =
+            ThreadPool::chunk_begin(n_items, n_chunks, chunk + 1);
+          for (std::size_t i = ThreadPool::chunk_begin(n_items, n_chunks, chunk);
+               i < end_item;
+               ++i)
+            {
+              const StatisticsRecorder::time_point start_time =
+                recorder.now();
+              if (worker)
+                worker(items[i], objects.scratch_data, objects.copy_data);
+              recorder.add_worker_time(start_time);
+
+              const StatisticsRecorder::time_point copier_start_time =
+                recorder.now();
+              copier(objects.copy_data, *local_target);
+              recorder.add_copier_time(copier_start_time);
+            }
+          recorder.add_chunk(
+            end_item - ThreadPool::chunk_begin(n_items, n_chunks, chunk));
+          data.release(objects);
+        });
+
+        // merge the thread-local results pairwise, as in
+        // ThreadLocalReduction::reduce()
+        const StatisticsRecorder::time_point reduction_start_time =
+          recorder.now();
+        std::vector<TargetType *> targets;
+        for (const auto &local_target : local_targets.get_implementation())
+          if (local_target != nullptr)
+            targets.push_back(local_target.get());
+        while (targets.size() > 1)
+          {
+            const std::size_t n_pairs = targets.size() / 2;
+            const std::size_t offset  = targets.size() - n_pairs;
+            pool.run_chunks(n_pairs, [&](const unsigned int i) {
+              reducer(*targets[offset + i], *targets[i]);
+            });
+            targets.resize(offset);
+          }
+        if (targets.size() == 1)
+          reducer(*targets[0], target);
+        recorder.add_reduction_time(reduction_start_time);
+      }
+    } // namespace ThreadPoolImplementation
+  }   // namespace internal
+
+#  endif // DEAL_II_USE_THREAD_POOL
+
+
   /**
    * This is one of two main functions of the WorkStream concept, doing work
    * as described in the introduction to this namespace. It corresponds to
@@ -925,6 +1731,9 @@ namespace WorkStream
    * copies of the <tt>ScratchData</tt> object and
    * <tt>queue_length*chunk_size</tt> copies of the <tt>CopyData</tt> object
    * are generated.
+   *
+   * If @p statistics is not a null pointer, the time spent in the worker and
+   * copier functions is measured and stored in the object it points to.
    */
   template <typename Worker,
             typename Copier,
@@ -938,7 +1747,8 @@ namespace WorkStream
       const ScratchData &                       sample_scratch_data,
       const CopyData &                          sample_copy_data,
       const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
-      const unsigned int chunk_size   = 8);
+      const unsigned int chunk_size   = 8,
+      Statistics *       statistics   = nullptr);
 
 
   /**
@@ -974,6 +1784,9 @@ namespace WorkStream
    * copies of the <tt>ScratchData</tt> object and
    * <tt>queue_length*chunk_size</tt> copies of the <tt>CopyData</tt> object
    * are generated.
+   *
+   * If @p statistics is not a null pointer, the time spent in the worker and
+   * copier functions is measured and stored in the object it points to.
    */
   template <typename Worker,
             typename Copier,
@@ -988,7 +1801,8 @@ namespace WorkStream
       const ScratchData &                      sample_scratch_data,
       const CopyData &                         sample_copy_data,
       const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
-      const unsigned int chunk_size   = 8)
+      const unsigned int chunk_size   = 8,
+      Statistics *       statistics   = nullptr)
   {
     Assert(queue_length > 0,
            ExcMessage("The queue length must be at least one, and preferably "
@@ -1000,11 +1814,17 @@ namespace WorkStream
     // if no work then skip. (only use operator!= for iterators since we may
     // not have an equality comparison operator)
     if (!(begin != end))
-      return;
+      {
+        if (statistics != nullptr)
+          *statistics = Statistics();
+        return;
+      }
 
-      // we want to use TBB if we have support and if it is not disabled at
-      // runtime:
-#  ifdef DEAL_II_WITH_THREADS
+    internal::StatisticsRecorder recorder(statistics);
+
+    // we want to use TBB or the thread pool if we have support and if it is
+    // not disabled at runtime:
+#  if defined(DEAL_II_WITH_THREADS) || defined(DEAL_II_USE_THREAD_POOL)
     if (MultithreadInfo::n_threads() == 1)
 #  endif
       {
@@ -1016,12 +1836,20 @@ namespace WorkStream
           {
             // need to check if the function is not the zero function. To
             // check zero-ness, create a C++ function out of it and check that
+            const internal::StatisticsRecorder::time_point start_time =
+              recorder.now();
             if (static_cast<const std::function<
                   void(const Iterator &, ScratchData &, CopyData &)> &>(worker))
               worker(i, scratch_data, copy_data);
+            recorder.add_worker_time(start_time);
+
+            const internal::StatisticsRecorder::time_point copier_start_time =
+              recorder.now();
             if (static_cast<const std::function<void(const CopyData &)> &>(
                   copier))
               copier(copy_data);
+            recorder.add_copier_time(copier_start_time);
+            recorder.add_chunk(1);
           }
       }
 #  ifdef DEAL_II_WITH_THREADS
@@ -1041,9 +1869,9 @@ namespace WorkStream
                                               sample_copy_data);
 
             internal::Implementation2::Worker<Iterator, ScratchData, CopyData>
-              worker_filter(worker);
+              worker_filter(worker, true, &recorder);
             internal::Implementation2::Copier<Iterator, ScratchData, CopyData>
-              copier_filter(copier);
+              copier_filter(copier, &recorder);
 
             // now create a pipeline from these stages
             tbb::pipeline assembly_line;
@@ -1082,10 +1910,30 @@ namespace WorkStream
                 sample_scratch_data,
                 sample_copy_data,
                 queue_length,
-                chunk_size);
+                chunk_size,
+                statistics);
+            return;
           }
       }
+#  elif defined(DEAL_II_USE_THREAD_POOL)
+    else // use the thread pool with more than one thread
+      {
+        const Iterator end_iterator = end;
+        internal::ThreadPoolImplementation::run<Iterator,
+                                                ScratchData,
+                                                CopyData>(begin,
+                                                          end_iterator,
+                                                          worker,
+                                                          copier,
+                                                          sample_scratch_data,
+                                                          sample_copy_data,
+                                                          queue_length,
+                                                          chunk_size,
+                                                          recorder);
+      }
 #  endif
+
+    recorder.finalize();
   }
 
 
@@ -1102,7 +1950,8 @@ namespace WorkStream
       const ScratchData &                       sample_scratch_data,
       const CopyData &                          sample_copy_data,
       const unsigned int                        queue_length,
-      const unsigned int                        chunk_size)
+      const unsigned int                        chunk_size,
+      Statistics *                              statistics)
   {
     Assert(queue_length > 0,
            ExcMessage("The queue length must be at least one, and preferably "
@@ -1111,9 +1960,11 @@ namespace WorkStream
     Assert(chunk_size > 0, ExcMessage("The chunk_size must be at least one."));
     (void)chunk_size; // removes -Wunused-parameter warning in optimized mode
 
-    // we want to use TBB if we have support and if it is not disabled at
-    // runtime:
-#  ifdef DEAL_II_WITH_THREADS
+    internal::StatisticsRecorder recorder(statistics);
+
+    // we want to use TBB or the thread pool if we have support and if it is
+    // not disabled at runtime:
+#  if defined(DEAL_II_WITH_THREADS) || defined(DEAL_II_USE_THREAD_POOL)
     if (MultithreadInfo::n_threads() == 1)
 #  endif
       {
@@ -1129,12 +1980,20 @@ namespace WorkStream
             {
               // need to check if the function is not the zero function. To
               // check zero-ness, create a C++ function out of it and check that
+              const internal::StatisticsRecorder::time_point start_time =
+                recorder.now();
               if (static_cast<const std::function<void(
                     const Iterator &, ScratchData &, CopyData &)> &>(worker))
                 worker(*p, scratch_data, copy_data);
+              recorder.add_worker_time(start_time);
+
+              const internal::StatisticsRecorder::time_point
+                copier_start_time = recorder.now();
               if (static_cast<const std::function<void(const CopyData &)> &>(
                     copier))
                 copier(copy_data);
+              recorder.add_copier_time(copier_start_time);
+              recorder.add_chunk(1);
             }
       }
 #  ifdef DEAL_II_WITH_THREADS
@@ -1152,7 +2011,8 @@ namespace WorkStream
               WorkerAndCopier worker_and_copier(worker,
                                                 copier,
                                                 sample_scratch_data,
-                                                sample_copy_data);
+                                                sample_copy_data,
+                                                recorder);
 
               tbb::parallel_for(
                 tbb::blocked_range<RangeType>(colored_iterators[color].begin(),
@@ -1164,7 +2024,23 @@ namespace WorkStream
                 tbb::auto_partitioner());
             }
       }
+#  elif defined(DEAL_II_USE_THREAD_POOL)
+    else // use the thread pool with more than one thread
+      {
+        internal::ThreadPoolImplementation::
+          ThreadLocalScratchAndCopyData<ScratchData, CopyData>
+            data(sample_scratch_data, sample_copy_data);
+
+        // loop over the various colors of what we're given
+        for (unsigned int color = 0; color < colored_iterators.size(); ++color)
+          internal::ThreadPoolImplementation::run<Iterator,
+                                                  ScratchData,
+                                                  CopyData>(
+            colored_iterators[color], worker, copier, data, chunk_size, recorder);
+      }
 #  endif
+
+    recorder.finalize();
   }
 
 
@@ -1197,6 +2073,9 @@ namespace WorkStream
    * copies of the <tt>ScratchData</tt> object and
    * <tt>queue_length*chunk_size</tt> copies of the <tt>CopyData</tt> object
    * are generated.
+   *
+   * If @p statistics is not a null pointer, the time spent in the worker and
+   * copier functions is measured and stored in the object it points to.
    */
   template <typename MainClass,
             typename Iterator,
@@ -1211,7 +2090,8 @@ namespace WorkStream
       const ScratchData &sample_scratch_data,
       const CopyData &   sample_copy_data,
       const unsigned int queue_length = 2 * MultithreadInfo::n_threads(),
-      const unsigned int chunk_size   = 8)
+      const unsigned int chunk_size   = 8,
+      Statistics *       statistics   = nullptr)
   {
     // forward to the other function
     run(begin,
@@ -1225,7 +2105,187 @@ namespace WorkStream
         sample_scratch_data,
         sample_copy_data,
         queue_length,
-        chunk_size);
+        chunk_size,
+        statistics);
+  }
+
+
+
+  /**
+   * A variant of run() for copiers whose effect on the target object does
+   * not depend on the order in which they are called, such as the addition
+   * of local contributions into a global vector or matrix. Instead of
+   * passing the CopyData objects to a copier that runs sequentially, each
+   * thread calls @p copier on the results of its worker calls right away,
+   * with a copy of the target object owned by this thread as second
+   * argument. Once all items have been worked on, the thread-local targets
+   * are merged in a parallel reduction by calls to
+   * <code>reducer(const TargetType &local_target, TargetType &dst)</code>,
+   * the last of which adds the accumulated result to @p target. See the
+   * documentation of the namespace for when this is faster than run().
+   *
+   * The thread-local targets are created as copies of
+   * @p sample_local_target, which must therefore represent the neutral
+   * element of the operation, e.g., a zero vector of the right size. For a
+   * vector, a typical call looks as follows:
+   * @code
+   *   WorkStream::run_with_thread_local_reduction(
+   *     dof_handler.begin_active(),
+   *     dof_handler.end(),
+   *     worker,
+   *     [](const CopyData &data, Vector<double> &local_rhs) {
+   *       local_rhs.add(data.local_dof_indices, data.cell_rhs);
+   *     },
+   *     [](const Vector<double> &local_rhs, Vector<double> &dst) {
+   *       dst += local_rhs;
+   *     },
+   *     ScratchData(fe, quadrature),
+   *     CopyData(fe.dofs_per_cell),
+   *     Vector<double>(dof_handler.n_dofs()),
+   *     system_rhs);
+   * @endcode
+   *
+   * Only a single ScratchData and CopyData object per thread (plus one per
+   * nested invocation if the worker function spawns tasks) is used, rather
+   * than the <tt>queue_length*chunk_size</tt> CopyData objects of run(),
+   * but the target object is copied once per thread. The @p chunk_size
+   * argument is the minimal number of consecutive items that a thread works
+   * on. In contrast to run(), the order in which the contributions are
+   * added to the target depends on how the items are distributed to the
+   * threads, so results may differ in the last digits between different
+   * runs.
+   *
+   * If only a single thread is used, no thread-local copy of the target is
+   * created and @p copier is called on @p target directly, in the order of
+   * the iterator range, exactly as run() would do. If @p statistics is not
+   * a null pointer, the time spent in the worker and copier functions and
+   * in the final reduction is measured and stored in the object it points
+   * to.
+   */
+  template <typename Worker,
+            typename Copier,
+            typename Reducer,
+            typename Iterator,
+            typename ScratchData,
+            typename CopyData,
+            typename TargetType>
+  void
+  run_with_thread_local_reduction(
+    const Iterator &                         begin,
+    const typename identity<Iterator>::type &end,
+    Worker                                   worker,
+    Copier                                   copier,
+    Reducer                                  reducer,
+    const ScratchData &                      sample_scratch_data,
+    const CopyData &                         sample_copy_data,
+    const TargetType &                       sample_local_target,
+    TargetType &                             target,
+    const unsigned int                       chunk_size = 8,
+    Statistics *                             statistics = nullptr)
+  {
+    Assert(chunk_size > 0, ExcMessage("The chunk_size must be at least one."));
+    (void)chunk_size; // removes -Wunused-parameter warning in optimized mode
+    (void)reducer;
+    (void)sample_local_target;
+
+    internal::StatisticsRecorder recorder(statistics);
+
+#  if defined(DEAL_II_WITH_THREADS) || defined(DEAL_II_USE_THREAD_POOL)
+    if (MultithreadInfo::n_threads() == 1)
+#  endif
+      {
+        // need to copy the sample since it is marked const
+        ScratchData scratch_data = sample_scratch_data;
+        CopyData    copy_data    = sample_copy_data; // NOLINT
+
+        for (Iterator i = begin; i != end; ++i)
+          {
+            const internal::StatisticsRecorder::time_point start_time =
+              recorder.now();
+            if (static_cast<const std::function<
+                  void(const Iterator &, ScratchData &, CopyData &)> &>(worker))
+              worker(i, scratch_data, copy_data);
+            recorder.add_worker_time(start_time);
+
+            const internal::StatisticsRecorder::time_point copier_start_time =
+              recorder.now();
+            copier(static_cast<const CopyData &>(copy_data), target);
+            recorder.add_copier_time(copier_start_time);
+            recorder.add_chunk(1);
+          }
+      }
+#  ifdef DEAL_II_WITH_THREADS
+    else
+      {
+        // as in run(), copy the iterators into an array that tbb can
+        // subdivide
+        std::vector<Iterator> iterators;
+        for (Iterator p = begin; p != end; ++p)
+          iterators.push_back(p);
+
+        if (iterators.size() > 0)
+          {
+            using WorkerAndCopier = internal::ThreadLocalReduction::
+              WorkerAndCopier<Iterator, ScratchData, CopyData, TargetType>;
+
+            using RangeType = typename std::vector<Iterator>::const_iterator;
+
+            WorkerAndCopier worker_and_copier(worker,
+                                              copier,
+                                              sample_scratch_data,
+                                              sample_copy_data,
+                                              sample_local_target,
+                                              recorder);
+
+            tbb::parallel_for(
+              tbb::blocked_range<RangeType>(iterators.cbegin(),
+                                            iterators.cend(),
+                                            /*grain_size=*/chunk_size),
+              std::bind(&WorkerAndCopier::operator(),
+                        std::ref(worker_and_copier),
+                        std::placeholders::_1),
+              tbb::auto_partitioner());
+
+            // merge the thread-local results and add them to the target
+            const internal::StatisticsRecorder::time_point
+              reduction_start_time = recorder.now();
+            const std::function<void(const TargetType &, TargetType &)>
+                                      reducer_function = reducer;
+            std::vector<TargetType *> local_targets =
+              worker_and_copier.get_local_targets();
+            internal::ThreadLocalReduction::reduce(local_targets,
+                                                   reducer_function);
+            Assert(local_targets.size() == 1, ExcInternalError());
+            reducer_function(static_cast<const TargetType &>(*local_targets[0]),
+                             target);
+            recorder.add_reduction_time(reduction_start_time);
+          }
+      }
+#  elif defined(DEAL_II_USE_THREAD_POOL)
+    else
+      {
+        std::vector<Iterator> iterators;
+        for (Iterator p = begin; p != end; ++p)
+          iterators.push_back(p);
+
+        internal::ThreadPoolImplementation::run_with_thread_local_reduction<
+          Iterator,
+          ScratchData,
+          CopyData,
+          TargetType>(iterators,
+                      worker,
+                      copier,
+                      reducer,
+                      sample_scratch_data,
+                      sample_copy_data,
+                      sample_local_target,
+                      target,
+                      chunk_size,
+                      recorder);
+      }
+#  endif
+
+    recorder.finalize();
   }
 
 } // namespace WorkStream
@@ -0,0 +1,394 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_distributed_fully_distributed_tria_h
+#define dealii_distributed_fully_distributed_tria_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/types.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/cell_id.h>
+#include <deal.II/grid/tria.h>
+
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include <array>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#ifdef DEAL_II_WITH_MPI
+#  include <mpi.h>
+#endif
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  namespace fullydistributed
+  {
+    /**
+     * The information about a single cell of a
+     * parallel::fullydistributed::Triangulation, see ConstructionData.
+     */
+    template <int dim>
+    struct CellData
+    {
+      /**
+       * Constructor. Set all indicators to their default values.
+       */
+      CellData();
+
+      /**
+       * The id of the cell.
+       */
+      CellId id;
+
+      /**
+       * The subdomain id of the cell. This is only used for active cells and
+       * is either the rank of the current process for locally owned cells,
+       * or the rank of the owner of a ghost cell.
+       */
+      types::subdomain_id subdomain_id;
+
+      /**
+       * The manifold id of the cell.
+       */
+      types::manifold_id manifold_id;
+
+      /**
+       * The manifold ids of the lines of the cell. Only used if dim>1.
+       */
+      std::array<types::manifold_id, GeometryInfo<dim>::lines_per_cell>
+        manifold_line_ids;
+
+      /**
+       * The manifold ids of the quads of the cell. Only used if dim==3.
+       */
+      std::array<types::manifold_id, GeometryInfo<dim>::quads_per_cell>
+        manifold_quad_ids;
+
+      /**
+       * The boundary ids of those faces of the cell that are at the boundary
+       * of the global mesh, as pairs of the face number and the boundary id.
+       */
+      std::vector<std::pair<unsigned int, types::boundary_id>> boundary_ids;
+
+      /**
+       * Read or write the data of this object to or from a stream for the
+       * purpose of serialization.
+       */
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int version);
+    };
+
+
+
+    /**
+     * The description of the part of a mesh that is stored by a single
+     * process of a parallel::fullydistributed::Triangulation.
+     *
+     * It consists of the coarse cells that contain at least one locally owned
+     * cell or one ghost cell, and, for every level of the mesh, of the cells
+     * on that level that are either locally owned, ghost cells, or ancestors
+     * of such cells. Every cell that is listed on a level larger than zero is
+     * created by refining its parent; all other children of this parent end
+     * up as artificial cells. The description can be computed from a
+     * partitioned serial triangulation by
+     * create_construction_data_from_triangulation(), or it can be filled
+     * directly, e.g., by a parallel mesh reader that only reads the cells a
+     * process needs.
+     */
+    template <int dim, int spacedim = dim>
+    struct ConstructionData
+    {
+      /**
+       * The coarse cells stored on the current process. The vertex indices
+       * refer to @p coarse_cell_vertices.
+       */
+      std::vector<dealii::CellData<dim>> coarse_cells;
+
+      /**
+       * The vertices of the coarse cells.
+       */
+      std::vector<Point<spacedim>> coarse_cell_vertices;
+
+      /**
+       * The global id of each of the coarse cells, i.e., the number by which
+       * the coarse cell is identified in CellId objects on all processes. The
+       * ids must be sorted in ascending order.
+       */
+      std::vector<types::coarse_cell_id> coarse_cell_index_to_coarse_cell_id;
+
+      /**
+       * For every level, the cells on that level as described in the class
+       * documentation.
+       */
+      std::vector<std::vector<CellData<dim>>> cell_infos;
+
+      /**
+       * Read or write the data of this object to or from a stream for the
+       * purpose of serialization, e.g., to send it to another process with
+       * Utilities::pack().
+       */
+      template <class Archive>
+      void
+      serialize(Archive &ar, const unsigned int version);
+    };
+
+
+
+    /**
+     * Compute the ConstructionData of the process with rank
+     * <tt>Utilities::MPI::this_mpi_process(comm)</tt> from the serial
+     * triangulation @p tria, whose active cells have been assigned to the
+     * processes through their subdomain ids, e.g., by
+     * GridTools::partition_triangulation(). A cell is a ghost cell of a
+     * process if it shares a vertex with a cell owned by that process.
+     *
+     * Since this function needs the whole mesh, it is mostly useful for
+     * meshes that are small enough to be created on each process, or for
+     * creating the descriptions on a single process and distributing them
+     * afterwards.
+     */
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data_from_triangulation(
+      const dealii::Triangulation<dim, spacedim> &tria,
+      const MPI_Comm                              comm);
+
+
+
+    /**
+     * Compute the ConstructionData of the process with rank
+     * <tt>Utilities::MPI::this_mpi_process(comm)</tt> without creating the
+     * serial triangulation on every process. The processes of @p comm are
+     * split into groups, and only the first process of each group calls
+     * @p serial_grid_generator to create the serial triangulation and
+     * @p serial_grid_partitioner to assign its active cells to all processes
+     * of @p comm by setting their subdomain ids, e.g., through
+     * GridTools::partition_triangulation_zorder(). The partitioner is called
+     * with the serial triangulation and the number of processes. The group
+     * root then computes the ConstructionData of each process of its group,
+     * see create_construction_data_from_triangulation(), and sends it there.
+     *
+     * By default, the groups consist of the processes that share the memory
+     * of a compute node, i.e., the serial mesh exists only once per node. This
+     * requires MPI 3.0; with older MPI versions, every process forms a group
+     * of its own. Alternatively, @p group_size consecutive processes form a
+     * group. The serial triangulations created on the different groups must
+     * be identical.
+     *
+     * A typical use is
+     * @code
+     * parallel::fullydistributed::Triangulation<dim> tria(comm);
+     * tria.create_triangulation(
+     *   parallel::fullydistributed::create_construction_data_in_groups<dim,
+     *                                                                  dim>(
+     *     [](Triangulation<dim> &serial_tria) {
+     *       GridGenerator::hyper_cube(serial_tria);
+     *       serial_tria.refine_global(5);
+     *     },
+     *     [](Triangulation<dim> &serial_tria, const unsigned int n_partitions) {
+     *       GridTools::partition_triangulation_zorder(n_partitions,
+     *                                                 serial_tria);
+     *     },
+     *     comm));
+     * @endcode
+     *
+     * @note This is a collective operation.
+     */
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data_in_groups(
+      const std::function<void(dealii::Triangulation<dim, spacedim> &)>
+        &serial_grid_generator,
+      const std::function<void(dealii::Triangulation<dim, spacedim> &,
+                               const unsigned int)> &serial_grid_partitioner,
+      const MPI_Comm                                 comm,
+      const unsigned int group_size = numbers::invalid_unsigned_int);
+
+
+
+    /**
+     * A distributed triangulation in which each process only stores the
+     * cells it owns, one layer of ghost cells around them, and the
+     * artificial cells needed to complete the refinement hierarchy of these
+     * cells. In contrast to parallel::distributed::Triangulation, this
+     * includes the coarse mesh: only those coarse cells are stored that
+     * contain locally owned or ghost cells. The memory consumption per
+     * process hence scales with the size of the local part of the mesh, which
+     * makes this class suitable for coarse meshes too large to be replicated
+     * on every process.
+     *
+     * The triangulation is created from a ConstructionData object describing
+     * the local part of the mesh, i.e., the mesh is partitioned before it is
+     * created, for example by METIS on a serial mesh through
+     * copy_triangulation(), or by a parallel mesh reader. If the serial mesh
+     * is too large to be created on every process,
+     * create_construction_data_in_groups() creates it only once per compute
+     * node. Since cells and
+     * vertices are numbered locally, coarse cells are identified across
+     * processes by the ids given in
+     * ConstructionData::coarse_cell_index_to_coarse_cell_id, which are used
+     * in the CellId of all cells.
+     *
+     * The class can be used with DoFHandler and hp::DoFHandler objects,
+     * MatrixFree, and the parallel output functions of DataOut, like the
+     * other parallel triangulations. The mesh can not be refined or coarsened
+     * once it has been created, and multigrid levels as well as periodic
+     * boundary conditions are not supported.
+     *
+     * Faces of the locally stored cells that are at the boundary of the
+     * locally stored part of the mesh, but not at the boundary of the global
+     * mesh, only belong to ghost or artificial cells. Their boundary id is
+     * zero.
+     */
+    template <int dim, int spacedim = dim>
+    class Triangulation : public parallel::Triangulation<dim, spacedim>
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      explicit Triangulation(MPI_Comm mpi_communicator);
+
+      /**
+       * Destructor.
+       */
+      virtual ~Triangulation() override = default;
+
+      /**
+       * Create the local part of the triangulation as described by
+       * @p construction_data. Every process must own at least one cell. The
+       * manifolds referenced by the manifold ids in @p construction_data must
+       * have been attached before, since they are used to place the new
+       * vertices when the finer levels are created.
+       *
+       * @note This is a collective operation.
+       */
+      void
+      create_triangulation(
+        const ConstructionData<dim, spacedim> &construction_data);
+
+      /**
+       * This function is not implemented, since every process only receives
+       * a part of the mesh. Use the function above instead.
+       */
+      virtual void
+      create_triangulation(const std::vector<Point<spacedim>> &vertices,
+                           const std::vector<dealii::CellData<dim>> &cells,
+                           const SubCellData &subcelldata) override;
+
+      /**
+       * Create the triangulation from the serial triangulation
+       * @p other_tria, whose active cells must have been partitioned by
+       * setting their subdomain ids to the ranks of the processes that are
+       * to own them, see create_construction_data_from_triangulation().
+       */
+      virtual void
+      copy_triangulation(
+        const dealii::Triangulation<dim, spacedim> &other_tria) override;
+
+      /**
+       * This function is not implemented, since the mesh can not be changed
+       * once it has been created.
+       */
+      virtual void
+      execute_coarsening_and_refinement() override;
+
+      /**
+       * Return true if the triangulation has hanging nodes on any process.
+       *
+       * @note This is a collective operation.
+       */
+      virtual bool
+      has_hanging_nodes() const override;
+
+      virtual types::coarse_cell_id
+      coarse_cell_index_to_coarse_cell_id(
+        const unsigned int coarse_cell_index) const override;
+
+      virtual unsigned int
+      coarse_cell_id_to_coarse_cell_index(
+        const types::coarse_cell_id coarse_cell_id) const override;
+
+      /**
+       * Return the local memory consumption in bytes.
+       */
+      virtual std::size_t
+      memory_consumption() const override;
+
+    private:
+      /**
+       * The global ids of the locally stored coarse cells, sorted in
+       * ascending order, such that the index of a coarse cell can be found by
+       * a binary search.
+       */
+      std::vector<types::coarse_cell_id> coarse_cell_ids;
+    };
+
+
+#ifndef DOXYGEN
+
+    template <int dim>
+    template <class Archive>
+    void
+    CellData<dim>::serialize(Archive &ar, const unsigned int /*version*/)
+    {
+      ar &id;
+      ar &subdomain_id;
+      ar &manifold_id;
+      // the arrays are empty in low dimensions, which boost can not
+      // serialize as a whole
+      for (auto &manifold_line_id : manifold_line_ids)
+        ar &manifold_line_id;
+      for (auto &manifold_quad_id : manifold_quad_ids)
+        ar &manifold_quad_id;
+      ar &boundary_ids;
+    }
+
+
+
+    template <int dim, int spacedim>
+    template <class Archive>
+    void
+    ConstructionData<dim, spacedim>::serialize(Archive &ar,
+                                               const unsigned int /*version*/)
+    {
+      ar &coarse_cells;
+      ar &coarse_cell_vertices;
+      ar &coarse_cell_index_to_coarse_cell_id;
+      ar &cell_infos;
+    }
+
+#endif // DOXYGEN
+
+  } // namespace fullydistributed
+} // namespace parallel
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
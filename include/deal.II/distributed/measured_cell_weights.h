@@ -0,0 +1,351 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_distributed_measured_cell_weights_h
+#define dealii_distributed_measured_cell_weights_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/smartpointer.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <boost/signals2/connection.hpp>
+
+#include <chrono>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  /**
+   * A class that computes the weights for the load balancing of a
+   * parallel::Triangulation from the work that has actually been measured on
+   * each cell, rather than from a model of the cost like in CellWeights.
+   * This is useful if the cost per cell varies strongly and in ways that
+   * are hard to predict, e.g., because of plasticity, particles, or hp
+   * adaptivity.
+   *
+   * The work done on the locally owned cells is recorded by add_cost(),
+   * either with user-defined counters or with measured times. For
+   * WorkStream::run() and MeshWorker::mesh_loop(), timed_worker() wraps the
+   * worker function such that the wall time spent on each cell is recorded
+   * automatically. In MatrixFree loops, the time of a batch of cells can be
+   * attributed to the cells of the batch:
+   * @code
+   * for (unsigned int v = 0; v < matrix_free.n_components_filled(cell); ++v)
+   *   cell_weights.add_cost(matrix_free.get_cell_iterator(cell, v),
+   *                         time / matrix_free.n_components_filled(cell));
+   * @endcode
+   *
+   * At the end of each step, e.g., each time step, finish_step() smoothes the
+   * costs recorded during the step with those of the previous steps, to
+   * avoid reacting to the noise of single measurements, and computes the
+   * imbalance of the work between the processes. Whether a repartitioning is
+   * worthwhile can then be decided by comparing the imbalance with a
+   * threshold:
+   * @code
+   * parallel::MeasuredCellWeights<dim> cell_weights(triangulation);
+   * for (unsigned int step = 0; step < n_steps; ++step)
+   *   {
+   *     ... // assemble and solve, recording the costs
+   *     cell_weights.finish_step();
+   *     if (cell_weights.get_imbalance() > 1.1)
+   *       triangulation.repartition();
+   *   }
+   * @endcode
+   *
+   * The smoothed costs are connected to the Triangulation::Signals::cell_weight
+   * signal of the triangulation, from which
+   * parallel::distributed::Triangulation computes the weights of its
+   * partitioning, both in repartition() and when the mesh is refined. The
+   * costs are scaled such that a cell with the average cost gets the
+   * additional weight @p weight_factor, see the constructor. Since the cells
+   * and their numbering change with the mesh, all recorded costs are
+   * discarded whenever the triangulation is changed, and the recording
+   * starts anew.
+   *
+   * Only the costs of locally owned cells are taken into account. This class
+   * is therefore meant for parallel::distributed::Triangulation objects,
+   * where every process only computes the weights of its own cells.
+   *
+   * @ingroup distributed
+   */
+  template <int dim, int spacedim = dim>
+  class MeasuredCellWeights
+  {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param[in] triangulation The triangulation whose cells are measured.
+     * @param[in] smoothing_factor The weight of the costs of the most recent
+     *    step in the exponential moving average with the costs of the
+     *    previous steps. A value of one disables the smoothing.
+     * @param[in] weight_factor The additional weight of a cell with the
+     *    average cost in the partitioning. Every cell has a weight of 1000 in
+     *    addition, see Triangulation::Signals::cell_weight, so the default
+     *    value lets the measured costs dominate.
+     */
+    MeasuredCellWeights(
+      const parallel::Triangulation<dim, spacedim> &triangulation,
+      const double                                  smoothing_factor = 0.5,
+      const unsigned int                            weight_factor    = 10000);
+
+    /**
+     * Destructor.
+     */
+    ~MeasuredCellWeights();
+
+    /**
+     * Add @p cost to the cost of @p cell in the current step. The cell must be
+     * a locally owned active cell. The cost may be any measure of work, like a
+     * time or the number of iterations of a local solver, as long as the same
+     * measure is used for all cells.
+     *
+     * This function may be called concurrently for different cells, e.g.,
+     * from the worker functions of WorkStream::run().
+     */
+    template <typename CellIteratorType>
+    void
+    add_cost(const CellIteratorType &cell, const double cost);
+
+    /**
+     * A function object that calls a worker function and records the wall
+     * time spent in it as the cost of the cell it is called with, see
+     * timed_worker().
+     */
+    template <typename Worker>
+    class TimedWorker
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      TimedWorker(MeasuredCellWeights<dim, spacedim> &cell_weights,
+                  const Worker &                      worker);
+
+      /**
+       * Call the worker function for @p cell and record the time it took.
+       */
+      template <typename CellIteratorType,
+                typename ScratchData,
+                typename CopyData>
+      void
+      operator()(const CellIteratorType &cell,
+                 ScratchData &           scratch_data,
+                 CopyData &              copy_data) const;
+
+    private:
+      /**
+       * The object the times are recorded in.
+       */
+      MeasuredCellWeights<dim, spacedim> &cell_weights;
+
+      /**
+       * The wrapped worker function.
+       */
+      const Worker worker;
+    };
+
+    /**
+     * Return a function object that calls @p worker and records the wall time
+     * spent in it as the cost of the cell it is called with. The returned
+     * object can be passed to WorkStream::run() and MeshWorker::mesh_loop() in
+     * place of @p worker.
+     */
+    template <typename Worker>
+    TimedWorker<Worker>
+    timed_worker(const Worker &worker);
+
+    /**
+     * Finish the current step: combine the costs recorded since the last call
+     * with the ones of the previous steps, reset the recorded costs to zero,
+     * and compute the imbalance of the work between the processes.
+     *
+     * @note This is a collective operation.
+     */
+    void
+    finish_step();
+
+    /**
+     * Return the smoothed cost of the locally owned active cell @p cell, as
+     * computed by the last call to finish_step().
+     */
+    template <typename CellIteratorType>
+    double
+    get_cost(const CellIteratorType &cell) const;
+
+    /**
+     * Return the ratio between the largest work on any process and the average
+     * work per process, as computed by the last call to finish_step() from the
+     * smoothed costs. A value of one means that the work is perfectly
+     * balanced. Before the first step has been finished after a change of the
+     * mesh, one is returned.
+     */
+    double
+    get_imbalance() const;
+
+    /**
+     * Return the number of calls to finish_step() since the triangulation has
+     * last been changed.
+     */
+    unsigned int
+    n_finished_steps() const;
+
+  private:
+    /**
+     * The triangulation whose cells are measured.
+     */
+    SmartPointer<const parallel::Triangulation<dim, spacedim>,
+                 MeasuredCellWeights>
+      triangulation;
+
+    /**
+     * The weight of the newest costs in the moving average.
+     */
+    const double smoothing_factor;
+
+    /**
+     * The weight of a cell with the average cost.
+     */
+    const unsigned int weight_factor;
+
+    /**
+     * The costs recorded in the current step, indexed by the active cell
+     * index.
+     */
+    std::vector<double> current_costs;
+
+    /**
+     * The smoothed costs of the finished steps, indexed by the active cell
+     * index.
+     */
+    std::vector<double> smoothed_costs;
+
+    /**
+     * The average smoothed cost of all locally owned cells of all processes.
+     */
+    double average_cost;
+
+    /**
+     * The imbalance computed by the last call to finish_step().
+     */
+    double imbalance;
+
+    /**
+     * The number of finished steps since the last change of the mesh.
+     */
+    unsigned int n_steps;
+
+    /**
+     * The connections to the signals of the triangulation.
+     */
+    std::vector<boost::signals2::connection> tria_listeners;
+
+    /**
+     * Discard all costs and size the arrays for the current mesh.
+     */
+    void
+    reset();
+
+    /**
+     * The function connected to the cell_weight signal of the triangulation.
+     */
+    unsigned int
+    weight_callback(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+      const typename Triangulation<dim, spacedim>::CellStatus     status) const;
+  };
+
+
+
+#ifndef DOXYGEN
+
+  template <int dim, int spacedim>
+  template <typename CellIteratorType>
+  inline void
+  MeasuredCellWeights<dim, spacedim>::add_cost(const CellIteratorType &cell,
+                                               const double            cost)
+  {
+    Assert(cell->is_locally_owned(),
+           ExcMessage("Costs can only be recorded on locally owned cells."));
+    AssertIndexRange(cell->active_cell_index(), current_costs.size());
+    current_costs[cell->active_cell_index()] += cost;
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename Worker>
+  MeasuredCellWeights<dim, spacedim>::TimedWorker<Worker>::TimedWorker(
+    MeasuredCellWeights<dim, spacedim> &cell_weights,
+    const Worker &                      worker)
+    : cell_weights(cell_weights)
+    , worker(worker)
+  {}
+
+
+
+  template <int dim, int spacedim>
+  template <typename Worker>
+  template <typename CellIteratorType, typename ScratchData, typename CopyData>
+  void
+  MeasuredCellWeights<dim, spacedim>::TimedWorker<Worker>::
+  operator()(const CellIteratorType &cell,
+             ScratchData &           scratch_data,
+             CopyData &              copy_data) const
+  {
+    const auto start = std::chrono::steady_clock::now();
+    worker(cell, scratch_data, copy_data);
+    cell_weights.add_cost(
+      cell,
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+        .count());
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename Worker>
+  typename MeasuredCellWeights<dim, spacedim>::template TimedWorker<Worker>
+  MeasuredCellWeights<dim, spacedim>::timed_worker(const Worker &worker)
+  {
+    return TimedWorker<Worker>(*this, worker);
+  }
+
+
+
+  template <int dim, int spacedim>
+  template <typename CellIteratorType>
+  inline double
+  MeasuredCellWeights<dim, spacedim>::get_cost(
+    const CellIteratorType &cell) const
+  {
+    AssertIndexRange(cell->active_cell_index(), smoothed_costs.size());
+    return smoothed_costs[cell->active_cell_index()];
+  }
+
+#endif // DOXYGEN
+
+} // namespace parallel
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -113,7 +113,8 @@ namespace parallel
        *
        * The constructor requires that exactly one of
        * <code>partition_auto</code>, <code>partition_metis</code>,
-       * <code>partition_zorder</code>, <code>partition_zoltan</code> and
+       * <code>partition_zorder</code>, <code>partition_zoltan</code>,
+       * <code>partition_hilbert</code> and
        * <code>partition_custom_signal</code> is set. If
        * <code>partition_auto</code> is chosen, it will use
        * <code>partition_zoltan</code> (if available), then
@@ -222,6 +223,20 @@ namespace parallel
          * active cell partitioning method.
          */
         construct_multigrid_hierarchy = 0x8,
+
+        /**
+         * Partition active cells along a Hilbert space filling curve through
+         * the centers of the active cells, see
+         * GridTools::partition_triangulation_hilbert(). Like
+         * partition_zorder, this does not need any external library, but the
+         * subdomains are compact also for meshes with many coarse cells.
+         * The partitioning is much cheaper to compute than the one by
+         * partition_metis or partition_zoltan, at the price of somewhat more
+         * faces between the subdomains, which makes it a good choice for
+         * large meshes on many processes. If the cell_weight signal of the
+         * triangulation is connected, the cells are weighted accordingly.
+         */
+        partition_hilbert = 0x10,
       };
 
 
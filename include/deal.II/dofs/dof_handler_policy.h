@@ -213,7 +213,9 @@ namespace internal
 
       /**
        * This class implements the policy for operations when we use a
-       * parallel::distributed::Triangulation object.
+       * parallel::distributed::Triangulation or a
+       * parallel::fullydistributed::Triangulation object. The multigrid
+       * functions are only implemented for the former.
        */
       template <class DoFHandlerType>
       class ParallelDistributed
@@ -404,6 +404,35 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &                                     p) const = 0;
 
+  /**
+   * Map several points from their locations on the real @p cell to the
+   * corresponding points on the unit cell. The result agrees with the one of
+   * transform_real_to_unit_cell() wherever that function succeeds, up to
+   * the tolerance of the iterative inversion of the mapping. Derived classes
+   * may succeed for points where transform_real_to_unit_cell() fails, e.g.
+   * for points far outside of the cell.
+   *
+   * This function never throws an ExcTransformationFailed exception. Instead,
+   * if the transformation fails for <tt>real_points[i]</tt>, the first
+   * coordinate of <tt>unit_points[i]</tt> is set to
+   * <tt>std::numeric_limits<double>::infinity()</tt>, which serves as the
+   * failure flag of the point.
+   *
+   * The default implementation simply loops over the points. Derived classes
+   * such as MappingQGeneric implement a faster variant that shares the work
+   * that only depends on the cell between all points.
+   *
+   * @param cell Iterator to the cell that will be used to define the mapping.
+   * @param real_points Locations of the points on the given cell.
+   * @param unit_points The reference cell locations of the points. This
+   * array must have the same size as @p real_points.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const;
+
   /**
    * Transform the point @p p on the real @p cell to the corresponding point
    * on the unit cell, and then projects it to a dim-1  point on the face with
@@ -180,6 +180,27 @@ public:
     const typename Triangulation<dim, spacedim>::cell_iterator &cell,
     const Point<spacedim> &p) const override;
 
+  /**
+   * Map several points from the real @p cell to the unit cell. Rather than
+   * running the Newton iteration of transform_real_to_unit_cell() point by
+   * point, this function computes the support points of the mapping on the
+   * cell only once and runs the Newton iterations for several points at a
+   * time in the lanes of VectorizedArray, evaluating the mapping through the
+   * tensor product of the one-dimensional Lagrange polynomials. Points for
+   * which this iteration does not converge are handed to
+   * transform_real_to_unit_cell(). The results agree with the ones of
+   * transform_real_to_unit_cell() up to the tolerance of the Newton
+   * iteration wherever that function succeeds. For points far outside the
+   * cell, this function may find the inverse even where
+   * transform_real_to_unit_cell() gives up because its line search fails.
+   * The vectorized iteration is only used for dim==spacedim.
+   */
+  virtual void
+  transform_points_real_to_unit_cell(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const ArrayView<const Point<spacedim>> &                    real_points,
+    const ArrayView<Point<dim>> &unit_points) const override;
+
   /**
    * @}
    */
@@ -19,6 +19,7 @@
 #include <deal.II/base/config.h>
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/types.h>
 
 #include <array>
 #include <cstdint>
@@ -131,6 +132,21 @@ public:
   typename Triangulation<dim, spacedim>::cell_iterator
   to_cell(const Triangulation<dim, spacedim> &tria) const;
 
+  /**
+   * Return the id of the coarse cell within whose tree the cell represented
+   * by the current object is located, see
+   * Triangulation::coarse_cell_index_to_coarse_cell_id().
+   */
+  types::coarse_cell_id
+  get_coarse_cell_id() const;
+
+  /**
+   * Return the id of the parent of the cell represented by the current
+   * object. The current object must not represent a coarse cell.
+   */
+  CellId
+  parent_cell_id() const;
+
   /**
    * Compare two CellId objects for equality.
    */
@@ -305,6 +321,24 @@ CellId::operator<(const CellId &other) const
   return true; // other.id is longer
 }
 
+
+
+inline types::coarse_cell_id
+CellId::get_coarse_cell_id() const
+{
+  return coarse_cell_id;
+}
+
+
+
+inline CellId
+CellId::parent_cell_id() const
+{
+  Assert(n_child_indices > 0,
+         ExcMessage("A coarse cell does not have a parent."));
+  return CellId(coarse_cell_id, n_child_indices - 1, child_indices.data());
+}
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
@@ -153,6 +153,10 @@ struct CellData;
  * The read_msh() function automatically determines whether an input file is
  * version 1 or version 2.
  *
+ * <li> <tt>Gmsh 4.0 mesh</tt> format: the current version of the format, which
+ * can be read both in its ASCII and in its binary variant. The latter is
+ * considerably faster to read for large meshes.
+ *
  * <li> <tt>Tecplot</tt> format: this format is used by @p TECPLOT and often
  * serves as a basis for data exchange between different applications. Note,
  * that currently only the ASCII format is supported, binary data cannot be
@@ -479,9 +483,16 @@ public:
   read_xda(std::istream &in);
 
   /**
-   * Read grid data from an msh file, either version 1 or version 2 of that
-   * file format. The Gmsh formats are documented at
-   * http://www.geuz.org/gmsh/.
+   * Read grid data from an msh file, either version 1, 2, or 4 of that file
+   * format. The Gmsh formats are documented at http://www.geuz.org/gmsh/.
+   *
+   * Files of version 4 may also be in the binary variant of the format, as
+   * written by Gmsh with the option "-bin". The nodes and elements of such
+   * files are read block by block with a single read operation per block,
+   * which makes reading large meshes much faster than parsing the ASCII
+   * variant. Binary files have to be written on a machine with the same
+   * endianness as the one reading them, and the stream has to be opened in
+   * binary mode.
    *
    * @note The input function of deal.II does not distinguish between newline
    * and other whitespace. Therefore, deal.II will be able to read files in a
@@ -1237,6 +1237,20 @@ namespace GridTools
    * A version of the previous function that exploits an already existing
    * GridTools::Cache<dim,spacedim> object.
    *
+   * The search around the vertices closest to @p p can miss the cell that
+   * contains the point on coarse or strongly curved meshes. If it fails, no
+   * @p marked_vertices are given, and the cell bucket grid of @p cache has
+   * already been built (see Cache::has_cell_bucket_grid()), this function
+   * also checks the cells of Cache::get_cell_bucket_grid() whose bounding
+   * boxes contain the point before it throws an exception of type
+   * GridTools::ExcPointNotFound. This function never builds the bucket grid
+   * itself: doing so maps $3^\text{dim}$ points per active cell, which is
+   * too expensive to pay for every point that is not found, e.g., in
+   * distributed_compute_point_locations() where points outside of the
+   * locally owned part of the mesh are expected. Callers that want the
+   * fallback, like Utilities::MPI::RemotePointEvaluation, call
+   * Cache::get_cell_bucket_grid() before the search.
+   *
    * @author Luca Heltai, 2017
    */
   template <int dim, int spacedim>
@@ -1249,6 +1263,35 @@ namespace GridTools
                              cell_hint = typename Triangulation<dim, spacedim>::active_cell_iterator(),
     const std::vector<bool> &marked_vertices = {});
 
+  /**
+   * Find the active cells around all points in @p points, together with the
+   * positions of the points in the reference coordinates of these cells. This
+   * function finds the same cells as calling find_active_cell_around_point()
+   * for each point, up to the choice among several cells for points on the
+   * faces between cells, but is much faster for many points since it uses
+   * the CellBucketGrid of the @p cache to find the candidate cells of a
+   * point, rather than searching around the closest vertex.
+   *
+   * The points are processed in the order of the buckets they lie in, so
+   * that consecutive points are likely to lie in the same cell. For each
+   * point, the cell in which the previous point was found is tested first.
+   * Otherwise, Mapping::transform_real_to_unit_cell() is only called on those
+   * cells of the bucket of the point whose bounding box contains the point.
+   * In particular, points outside of the bounding boxes of all cells are
+   * rejected without any call to the mapping.
+   *
+   * @return A vector with one entry per point, containing the cell around the
+   * point and the position of the point in the reference coordinates of that
+   * cell. For points that are not found in the mesh, the cell iterator is
+   * invalid, i.e., its state() is not IteratorState::valid.
+   */
+  template <int dim, int spacedim>
+  std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>>
+  find_active_cells_around_points(const Cache<dim, spacedim> &        cache,
+                                  const std::vector<Point<spacedim>> &points);
+
   /**
    * A variant of the previous find_active_cell_around_point() function that,
    * instead of returning only the first matching cell, identifies all cells
@@ -1901,6 +1944,53 @@ namespace GridTools
   partition_triangulation_zorder(const unsigned int            n_partitions,
                                  Triangulation<dim, spacedim> &triangulation);
 
+  /**
+   * Generates a partitioning of the active cells along a Hilbert space
+   * filling curve through the centers of the active cells. The cells are
+   * sorted by their index on the curve, and the resulting sequence is cut into
+   * @p n_partitions contiguous pieces of approximately equal weight. After
+   * calling this function, the subdomain ids of all active cells will have
+   * values between zero and @p n_partitions-1.
+   *
+   * Since the Hilbert curve preserves locality, the subdomains are compact
+   * and mostly connected, although not as optimal with respect to the number
+   * of faces between subdomains as the partitions computed by
+   * partition_triangulation(). On the other hand, the partitioning only
+   * requires sorting the cells, i.e., it runs in $O(N \log N)$ time for $N$
+   * active cells, does not need any external library, and computes the
+   * indices on the curve in parallel using multiple threads. In contrast to
+   * partition_triangulation_zorder(), the partitioning does not depend on the
+   * order of the coarse cells, but only on the location of the active cells.
+   *
+   * If the @p cell_weight signal has been attached to the @p triangulation,
+   * then the weight of each cell is the value returned by the signal plus
+   * 1000, in the same way as in parallel::distributed::Triangulation.
+   * Otherwise, all cells have the same weight.
+   *
+   * The result only depends on the triangulation and not on the number of
+   * threads, so all processes that share the same triangulation compute the
+   * same partitioning.
+   */
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_hilbert(const unsigned int            n_partitions,
+                                  Triangulation<dim, spacedim> &triangulation);
+
+  /**
+   * This function does the same as the previous one, but uses the given
+   * @p cell_weights, indexed by the active cell index, as the weights of the
+   * cells.
+   *
+   * @note If the @p cell_weights vector is empty, then all cells have the same
+   * weight. If not, then the size of this vector must equal the number of
+   * active cells in the triangulation.
+   */
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_hilbert(const unsigned int               n_partitions,
+                                  const std::vector<unsigned int> &cell_weights,
+                                  Triangulation<dim, spacedim> &triangulation);
+
   /**
    * Partitions the cells of a multigrid hierarchy by assigning level subdomain
    * ids using the "youngest child" rule, that is, each cell in the hierarchy is
@@ -19,6 +19,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/point.h>
 #include <deal.II/base/subscriptor.h>
@@ -35,12 +36,123 @@
 
 #include <boost/signals2.hpp>
 
+#include <array>
 #include <cmath>
 
 DEAL_II_NAMESPACE_OPEN
 
 namespace GridTools
 {
+  /**
+   * A uniform grid of buckets covering the bounding box of the active cells
+   * of a triangulation, where each bucket stores the indices of the active
+   * cells whose bounding box intersects the bucket. Given a point, the
+   * candidate cells that may contain it are then found by a simple index
+   * computation, without the tree traversal of an RTree.
+   *
+   * The bounding boxes of the cells are computed from the vertices returned
+   * by Mapping::get_vertices(). If the mapping curves a cell beyond the
+   * bounding box of its vertices, as detected by mapping the midpoints of the
+   * edges and faces of the cell, its box is enlarged accordingly. The number
+   * of buckets is chosen such that each bucket contains about one cell on a
+   * mesh of uniformly sized cells.
+   *
+   * Objects of this class are usually obtained through
+   * Cache::get_cell_bucket_grid() and used by
+   * GridTools::find_active_cells_around_points().
+   */
+  template <int dim, int spacedim = dim>
+  class CellBucketGrid
+  {
+  public:
+    /**
+     * Compute the bounding boxes of the active cells of @p tria, as seen
+     * through @p mapping, and sort the cells into the buckets.
+     */
+    void
+    reinit(const Triangulation<dim, spacedim> &tria,
+           const Mapping<dim, spacedim> &      mapping);
+
+    /**
+     * Return the index of the bucket containing the point @p p, or
+     * numbers::invalid_unsigned_int if the point lies outside of the
+     * bounding box of the triangulation.
+     */
+    unsigned int
+    bucket_index(const Point<spacedim> &p) const;
+
+    /**
+     * Return the active cell indices of the cells whose bounding box
+     * intersects the bucket with index @p bucket, sorted in ascending order.
+     */
+    ArrayView<const unsigned int>
+    get_cells_in_bucket(const unsigned int bucket) const;
+
+    /**
+     * Return whether @p p lies inside the bounding box of the active cell
+     * with index @p active_cell_index, enlarged by a small tolerance.
+     */
+    bool
+    point_inside_cell_box(const Point<spacedim> &p,
+                          const unsigned int     active_cell_index) const;
+
+    /**
+     * Return the active cell with index @p active_cell_index.
+     */
+    const typename Triangulation<dim, spacedim>::active_cell_iterator &
+    get_cell(const unsigned int active_cell_index) const;
+
+    /**
+     * Return the total number of buckets.
+     */
+    unsigned int
+    n_buckets() const;
+
+  private:
+    /**
+     * The lower left corner of the grid of buckets.
+     */
+    Point<spacedim> lower_corner;
+
+    /**
+     * The inverse of the size of the buckets in each coordinate direction,
+     * or zero for directions in which the triangulation has no extent.
+     */
+    std::array<double, spacedim> inverse_bucket_size;
+
+    /**
+     * The number of buckets in each coordinate direction.
+     */
+    std::array<unsigned int, spacedim> n_buckets_per_direction;
+
+    /**
+     * The position in @p bucket_cells of the first cell of each bucket, in
+     * compressed row storage. The last entry is the total number of entries
+     * in @p bucket_cells.
+     */
+    std::vector<unsigned int> bucket_start;
+
+    /**
+     * The active cell indices of the cells in each bucket.
+     */
+    std::vector<unsigned int> bucket_cells;
+
+    /**
+     * The lower and upper corners of the bounding boxes of all active cells,
+     * stored contiguously as <tt>2*spacedim</tt> numbers per cell in the
+     * order of the active cell index.
+     */
+    std::vector<double> cell_boxes;
+
+    /**
+     * The active cells, in the order of their active cell index.
+     */
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      cells;
+  };
+
+
+
   /**
    * A class that caches computationally intensive information about a
    * Triangulation.
@@ -138,6 +250,22 @@ namespace GridTools
                 typename Triangulation<dim, spacedim>::active_cell_iterator>> &
     get_cell_bounding_boxes_rtree() const;
 
+    /**
+     * Return the cached CellBucketGrid object, a uniform grid of buckets
+     * storing the active cells whose bounding boxes intersect each bucket,
+     * as used by GridTools::find_active_cells_around_points().
+     */
+    const CellBucketGrid<dim, spacedim> &
+    get_cell_bucket_grid() const;
+
+    /**
+     * Return whether the CellBucketGrid object returned by
+     * get_cell_bucket_grid() is currently built, i.e., whether that function
+     * has been called since the triangulation was last changed.
+     */
+    bool
+    has_cell_bucket_grid() const;
+
     /**
      * Return a reference to the stored triangulation.
      */
@@ -251,6 +379,12 @@ namespace GridTools
                 typename Triangulation<dim, spacedim>::active_cell_iterator>>
       cell_bounding_boxes_rtree;
 
+    /**
+     * Store a uniform grid of buckets of the active cells of the
+     * triangulation.
+     */
+    mutable CellBucketGrid<dim, spacedim> cell_bucket_grid;
+
     /**
      * Storage for the status of the triangulation signal.
      */
@@ -260,6 +394,77 @@ namespace GridTools
 
 
   // Inline functions
+  template <int dim, int spacedim>
+  inline unsigned int
+  CellBucketGrid<dim, spacedim>::bucket_index(const Point<spacedim> &p) const
+  {
+    if (bucket_start.empty())
+      return numbers::invalid_unsigned_int;
+
+    unsigned int index = 0;
+    for (int d = spacedim - 1; d >= 0; --d)
+      {
+        const double x = (p[d] - lower_corner[d]) * inverse_bucket_size[d];
+        // also accept points on the upper end of the grid
+        if (!(x >= 0. && x <= n_buckets_per_direction[d]))
+          return numbers::invalid_unsigned_int;
+        index = index * n_buckets_per_direction[d] +
+                std::min(static_cast<unsigned int>(x),
+                         n_buckets_per_direction[d] - 1);
+      }
+    return index;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline ArrayView<const unsigned int>
+  CellBucketGrid<dim, spacedim>::get_cells_in_bucket(
+    const unsigned int bucket) const
+  {
+    AssertIndexRange(bucket, n_buckets());
+    return make_array_view(bucket_cells.data() + bucket_start[bucket],
+                           bucket_cells.data() + bucket_start[bucket + 1]);
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline bool
+  CellBucketGrid<dim, spacedim>::point_inside_cell_box(
+    const Point<spacedim> &p,
+    const unsigned int     active_cell_index) const
+  {
+    AssertIndexRange(active_cell_index, cells.size());
+    const double *box = cell_boxes.data() + 2 * spacedim * active_cell_index;
+    bool          inside = true;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      inside &= (p[d] >= box[d]) & (p[d] <= box[spacedim + d]);
+    return inside;
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline const typename Triangulation<dim, spacedim>::active_cell_iterator &
+  CellBucketGrid<dim, spacedim>::get_cell(
+    const unsigned int active_cell_index) const
+  {
+    AssertIndexRange(active_cell_index, cells.size());
+    return cells[active_cell_index];
+  }
+
+
+
+  template <int dim, int spacedim>
+  inline unsigned int
+  CellBucketGrid<dim, spacedim>::n_buckets() const
+  {
+    return bucket_start.empty() ? 0 : bucket_start.size() - 1;
+  }
+
+
+
   template <int dim, int spacedim>
   inline const Triangulation<dim, spacedim> &
   Cache<dim, spacedim>::get_triangulation() const
@@ -83,6 +83,12 @@ namespace GridTools
      */
     update_covering_rtree = 0x040,
 
+    /**
+     * Update a uniform grid of buckets storing the active cells whose
+     * bounding boxes intersect each bucket.
+     */
+    update_cell_bucket_grid = 0x080,
+
     /**
      * Update all objects.
      */
@@ -106,6 +112,8 @@ namespace GridTools
       s << "|vertex_to_cells_centers_directions";
     if (u & update_covering_rtree)
       s << "|covering_rtree";
+    if (u & update_cell_bucket_grid)
+      s << "|cell_bucket_grid";
 #ifdef DEAL_II_WITH_NANOFLANN
     if (u & update_vertex_kdtree)
       s << "|vertex_kdtree";
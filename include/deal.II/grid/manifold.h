@@ -322,6 +322,23 @@ namespace Manifolds
  * approximate the limit process, and derived classes should do so.
  *
  *
+ * <h3>Thread safety</h3>
+ *
+ * Triangulation::execute_coarsening_and_refinement() computes the new
+ * vertices of all refined lines and faces in parallel, see
+ * MultithreadInfo. As a consequence, the const member functions used to
+ * compute new points, i.e., get_new_point(), get_new_points(),
+ * get_intermediate_point(), get_new_point_on_line(), get_new_point_on_quad()
+ * and project_to_manifold(), as well as pull_back() and push_forward() of
+ * the ChartManifold class, may be called concurrently on the same manifold
+ * object from several threads. Derived classes must make sure that these
+ * functions can be called in this way. This is the case if they do not
+ * modify any state, or protect all mutable state such as caches by a mutex,
+ * as done by TransfiniteInterpolationManifold. If a manifold can not be
+ * made thread-safe, the refinement can be run serially by limiting the
+ * number of threads through MultithreadInfo::set_thread_limit(1).
+ *
+ *
  * @ingroup manifold
  * @author Luca Heltai, Wolfgang Bangerth, 2014, 2016
  */
@@ -21,11 +21,15 @@
 
 #include <deal.II/base/function.h>
 #include <deal.II/base/function_parser.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/grid/manifold.h>
 
 #include <boost/container/small_vector.hpp>
 
+#include <array>
+#include <map>
+
 DEAL_II_NAMESPACE_OPEN
 
 /**
@@ -931,6 +935,15 @@ private:
  * current implementation by a pre-identification of relevant cells with
  * axis-aligned bounding boxes.
  *
+ * Each vertex of a mesh is typically pulled back to the chart many times:
+ * once for every line, face, and cell that gets refined around it, and again
+ * for every cell on which a MappingQGeneric computes its support points.
+ * Since each pull back involves a Newton iteration that evaluates the
+ * underlying manifolds several times, it may be worthwhile to store the
+ * chart coordinates of the points. This can be enabled by
+ * use_chart_point_cache(). The cache is cleared whenever the triangulation
+ * changes, e.g., after each refinement.
+ *
  * @ingroup manifold
  *
  * @author Martin Kronbichler, Luca Heltai, 2017
@@ -970,6 +983,18 @@ public:
   void
   initialize(const Triangulation<dim, spacedim> &triangulation);
 
+  /**
+   * Enable or disable the cache of the chart coordinates of points, see the
+   * general documentation of this class. With the cache, the pull back of a
+   * point always starts from the affine approximation of the inverse map of
+   * the coarse cell, so the chart coordinates, and hence the new points, do
+   * not depend on the order in which the points are requested. They may
+   * differ from the ones computed without the cache by the tolerance of the
+   * Newton iteration. The cache is disabled by default.
+   */
+  void
+  use_chart_point_cache(const bool use_cache);
+
   /**
    * Return the point which shall become the new vertex surrounded by the
    * given points @p surrounding_points. @p weights contains appropriate
@@ -1062,6 +1087,16 @@ private:
             const Point<spacedim> &                                     p,
             const Point<dim> &initial_guess) const;
 
+  /**
+   * Return the pull back of the point @p p into the unit coordinates on the
+   * given coarse cell, starting from the affine approximation of the inverse
+   * map of the cell, and store the result in the chart point cache.
+   */
+  Point<dim>
+  cached_pull_back(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const Point<spacedim> &                                     p) const;
+
   /**
    * Push forward operation.
    *
@@ -1123,6 +1158,31 @@ private:
    * this class goes out of scope.
    */
   boost::signals2::connection clear_signal;
+
+  /**
+   * Whether the chart coordinates of points are cached.
+   */
+  bool chart_point_cache_enabled;
+
+  /**
+   * The cached chart coordinates, indexed by the index of the coarse cell
+   * and the coordinates of the point in real space.
+   */
+  mutable std::map<std::pair<unsigned int, std::array<double, spacedim>>,
+                   Point<dim>>
+    chart_point_cache;
+
+  /**
+   * A mutex that guards access to @p chart_point_cache, since new points may
+   * be computed concurrently.
+   */
+  mutable Threads::Mutex chart_point_cache_mutex;
+
+  /**
+   * The connection to Triangulation::signals::any_change, which clears the
+   * chart point cache.
+   */
+  boost::signals2::connection change_signal;
 };
 
 DEAL_II_NAMESPACE_CLOSE
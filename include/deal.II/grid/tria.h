@@ -189,6 +189,14 @@ struct CellData
    * - manifold id to numbers::flat_manifold_id
    */
   CellData();
+
+  /**
+   * Read or write the data of this object to or from a stream for the
+   * purpose of serialization.
+   */
+  template <class Archive>
+  void
+  serialize(Archive &ar, const unsigned int version);
 };
 
 
@@ -3378,6 +3386,23 @@ public:
   virtual std::size_t
   memory_consumption() const;
 
+  /**
+   * Return a breakdown of the memory consumption (in bytes) of this object
+   * into its data fields, i.e., the data stored per cell on the levels
+   * (named <tt>"level.refine_flags"</tt>, <tt>"level.neighbors"</tt>, etc.),
+   * the data stored per object for the cells and faces (named, e.g.,
+   * <tt>"cells.children"</tt>, <tt>"cells.manifold_id"</tt>,
+   * <tt>"faces.lines.user_data"</tt>, or <tt>"faces.quads.used"</tt>), the
+   * vertices, and a few more entries. The entries sum up to the value
+   * returned by memory_consumption() of this class; data stored by derived
+   * classes is not included.
+   *
+   * This function is useful to find out which data dominates the memory
+   * footprint of large meshes.
+   */
+  std::map<std::string, std::size_t>
+  memory_consumption_per_field() const;
+
   /**
    * Write the data of this object to a stream for the purpose of
    * serialization.
@@ -3437,6 +3462,28 @@ public:
     std::pair<std::pair<cell_iterator, unsigned int>, std::bitset<3>>> &
   get_periodic_face_map() const;
 
+  /**
+   * Return the id by which the coarse cell with index @p coarse_cell_index
+   * is identified in CellId objects, i.e., across all processors that share
+   * this triangulation. For all triangulations that store the complete
+   * coarse mesh, this is the index of the coarse cell itself. The
+   * parallel::fullydistributed::Triangulation class, which only stores the
+   * coarse cells needed on the current processor, overrides this function.
+   */
+  virtual types::coarse_cell_id
+  coarse_cell_index_to_coarse_cell_id(
+    const unsigned int coarse_cell_index) const;
+
+  /**
+   * The inverse of coarse_cell_index_to_coarse_cell_id(): return the index
+   * of the coarse cell identified by @p coarse_cell_id, or
+   * numbers::invalid_unsigned_int if this coarse cell is not stored in the
+   * current triangulation.
+   */
+  virtual unsigned int
+  coarse_cell_id_to_coarse_cell_index(
+    const types::coarse_cell_id coarse_cell_id) const;
+
 
   BOOST_SERIALIZATION_SPLIT_MEMBER()
 
@@ -4037,6 +4084,20 @@ inline CellData<structdim>::CellData()
 
 
 
+template <int structdim>
+template <class Archive>
+void
+CellData<structdim>::serialize(Archive &ar, const unsigned int /*version*/)
+{
+  ar &vertices;
+  // material_id and boundary_id share their storage, so it is enough to
+  // store one of them
+  ar &material_id;
+  ar &manifold_id;
+}
+
+
+
 namespace internal
 {
   namespace TriangulationImplementation
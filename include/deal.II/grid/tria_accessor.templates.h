@@ -1737,7 +1737,10 @@ void *
 TriaAccessor<structdim, dim, spacedim>::user_pointer() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  return this->objects().user_pointer(this->present_index);
+  // go through the const version so that reading the user pointer does not
+  // allocate the user data of all objects
+  const auto &objects = this->objects();
+  return const_cast<void *>(objects.user_pointer(this->present_index));
 }
 
 
@@ -1794,7 +1797,8 @@ unsigned int
 TriaAccessor<structdim, dim, spacedim>::user_index() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
-  return this->objects().user_index(this->present_index);
+  const auto &objects = this->objects();
+  return objects.user_index(this->present_index);
 }
 
 
@@ -1962,7 +1966,7 @@ TriaAccessor<structdim, dim, spacedim>::manifold_id() const
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
 
-  return this->objects().manifold_id[this->present_index];
+  return this->objects().get_manifold_id(this->present_index);
 }
 
 
@@ -1974,7 +1978,7 @@ TriaAccessor<structdim, dim, spacedim>::set_manifold_id(
 {
   Assert(this->used(), TriaAccessorExceptions::ExcCellNotUsed());
 
-  this->objects().manifold_id[this->present_index] = manifold_ind;
+  this->objects().set_manifold_id(this->present_index, manifold_ind);
 }
 
 
@@ -21,6 +21,9 @@
 #include <deal.II/grid/tria_object.h>
 #include <deal.II/grid/tria_objects.h>
 
+#include <map>
+#include <string>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -76,6 +79,14 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the data fields of
+       * this object to the entry <tt>"faces." + kind of object + "." + name of
+       * the field</tt> of @p fields.
+       */
+      void
+      add_memory_consumption(std::map<std::string, std::size_t> &fields) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -105,6 +116,14 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the data fields of
+       * this object to the entry <tt>"faces." + kind of object + "." + name of
+       * the field</tt> of @p fields.
+       */
+      void
+      add_memory_consumption(std::map<std::string, std::size_t> &fields) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -141,6 +160,14 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the data fields of
+       * this object to the entry <tt>"faces." + kind of object + "." + name of
+       * the field</tt> of @p fields.
+       */
+      void
+      add_memory_consumption(std::map<std::string, std::size_t> &fields) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -27,6 +27,8 @@
 #include <boost/serialization/utility.hpp>
 
 #include <cstdint>
+#include <map>
+#include <string>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -92,7 +94,11 @@ namespace internal
        * and so on.
        *
        * In neighbors, <tt>neighbors[i].first</tt> is the level, while
-       * <tt>neighbors[i].first</tt> is the index of the neighbor.
+       * <tt>neighbors[i].second</tt> is the index of the neighbor. The two
+       * are not packed into a single integer, since a neighbor may be
+       * several levels coarser than the cell in 1d and with anisotropic
+       * refinement, and the bits needed for the level would reduce the
+       * number of cells a level can hold.
        *
        * If a neighbor does not exist (cell is at the boundary),
        * <tt>level=index=-1</tt> is set.
@@ -187,6 +193,16 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the data fields of
+       * this object to the corresponding entry of @p fields. The fields
+       * stored per cell are named <tt>"level." + name of the field</tt>, the
+       * ones of the TriaObjects holding the cells <tt>"cells." + name of the
+       * field</tt>.
+       */
+      void
+      add_memory_consumption(std::map<std::string, std::size_t> &fields) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -243,6 +259,8 @@ namespace internal
       monitor_memory(const unsigned int true_dimension) const;
       std::size_t
       memory_consumption() const;
+      void
+      add_memory_consumption(std::map<std::string, std::size_t> &fields) const;
 
       /**
        * Read or write the data of this object to or from a stream for the
@@ -20,9 +20,13 @@
 
 #include <deal.II/base/exceptions.h>
 #include <deal.II/base/geometry_info.h>
+#include <deal.II/base/thread_management.h>
 
 #include <deal.II/grid/tria_object.h>
 
+#include <atomic>
+#include <map>
+#include <string>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -171,9 +175,30 @@ namespace internal
       /**
        * Store manifold ids. This field stores the manifold id of each object,
        * which is a number between 0 and numbers::flat_manifold_id-1.
+       *
+       * Many triangulations never use a manifold id other than
+       * numbers::flat_manifold_id for some or all kinds of objects. To save
+       * the memory for these, this field is empty as long as all objects
+       * have the flat manifold id, and it is only allocated once a different
+       * id is set through set_manifold_id(). Use get_manifold_id() to read
+       * the manifold id of an object.
        */
       std::vector<types::manifold_id> manifold_id;
 
+      /**
+       * Return the manifold id of the object with index @p i.
+       */
+      types::manifold_id
+      get_manifold_id(const unsigned int i) const;
+
+      /**
+       * Set the manifold id of the object with index @p i. Setting an id
+       * other than numbers::flat_manifold_id allocates the field
+       * @p manifold_id for all objects if it has been empty so far.
+       */
+      void
+      set_manifold_id(const unsigned int i, const types::manifold_id id);
+
       /**
        * Assert that enough space is allocated to accommodate
        * <code>new_objs_in_pairs</code> new objects, stored in pairs, plus
@@ -309,6 +334,15 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the data fields of
+       * this object to the entry <tt>prefix + "." + name of the field</tt>
+       * of @p fields.
+       */
+      void
+      add_memory_consumption(std::map<std::string, std::size_t> &fields,
+                             const std::string &                  prefix) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -384,6 +418,31 @@ namespace internal
         serialize(Archive &ar, const unsigned int version);
       };
 
+      /**
+       * A flag that can be read and written by several threads at the same
+       * time. Contrary to std::atomic<bool>, it can be copied together with
+       * the object it belongs to.
+       */
+      struct AtomicFlag
+      {
+        AtomicFlag(const bool initial_value = false)
+          : value(initial_value)
+        {}
+
+        AtomicFlag(const AtomicFlag &other)
+          : value(other.value.load())
+        {}
+
+        AtomicFlag &
+        operator=(const AtomicFlag &other)
+        {
+          value = other.value.load();
+          return *this;
+        }
+
+        std::atomic<bool> value;
+      };
+
       /**
        * Enum describing the possible types of userdata.
        */
@@ -401,9 +460,38 @@ namespace internal
       /**
        * Pointer which is not used by the library but may be accessed and set
        * by the user to handle data local to a line/quad/etc.
+       *
+       * Since most programs never use user data, or only for some kinds of
+       * objects, this field is only allocated upon the first write access
+       * through the non-const user_pointer() or user_index() functions, and
+       * it is released again by clear_user_data(). Until then, the user
+       * pointers and indices of all objects are zero. The allocation is
+       * protected by @p user_data_mutex, so the user data of different
+       * objects may be written concurrently, e.g., from the worker threads of
+       * WorkStream::run(), also if none has been written before.
        */
       std::vector<UserData> user_data;
 
+      /**
+       * Whether @p user_data has been allocated, i.e., whether it is not
+       * empty. The accessors read this flag without acquiring
+       * @p user_data_mutex, so that only the first write access has to lock.
+       */
+      AtomicFlag user_data_is_allocated;
+
+      /**
+       * A mutex that makes sure that @p user_data is allocated only once if
+       * the user data of several objects is written concurrently.
+       */
+      Threads::Mutex user_data_mutex;
+
+      /**
+       * Allocate the field @p user_data for all objects if this has not
+       * happened yet. This function may be called concurrently.
+       */
+      void
+      allocate_user_data();
+
       /**
        * In order to avoid confusion between user pointers and indices, this
        * enum is set by the first function accessing either and subsequent
@@ -496,6 +584,15 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the data fields of
+       * this object to the entry <tt>prefix + "." + name of the field</tt>
+       * of @p fields.
+       */
+      void
+      add_memory_consumption(std::map<std::string, std::size_t> &fields,
+                             const std::string &                  prefix) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -564,6 +661,15 @@ namespace internal
       std::size_t
       memory_consumption() const;
 
+      /**
+       * Add the memory consumption (in bytes) of each of the data fields of
+       * this object to the entry <tt>prefix + "." + name of the field</tt>
+       * of @p fields.
+       */
+      void
+      add_memory_consumption(std::map<std::string, std::size_t> &fields,
+                             const std::string &                  prefix) const;
+
       /**
        * Read or write the data of this object to or from a stream for the
        * purpose of serialization
@@ -624,6 +730,54 @@ namespace internal
     }
 
 
+    template <typename G>
+    inline types::manifold_id
+    TriaObjects<G>::get_manifold_id(const unsigned int i) const
+    {
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (manifold_id.size() == 0)
+        return numbers::flat_manifold_id;
+      return manifold_id[i];
+    }
+
+
+    template <typename G>
+    inline void
+    TriaObjects<G>::set_manifold_id(const unsigned int       i,
+                                    const types::manifold_id id)
+    {
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (manifold_id.size() == 0)
+        {
+          if (id == numbers::flat_manifold_id)
+            return;
+          manifold_id.reserve(cells.size());
+          manifold_id.resize(cells.size(), numbers::flat_manifold_id);
+        }
+      manifold_id[i] = id;
+    }
+
+
+    template <typename G>
+    inline void
+    TriaObjects<G>::allocate_user_data()
+    {
+      // the flag is only set once the field has been resized, so threads
+      // that see it set also see the complete field
+      if (user_data_is_allocated.value.load(std::memory_order_acquire))
+        return;
+
+      std::lock_guard<std::mutex> lock(user_data_mutex);
+      if (user_data.size() == 0)
+        {
+          user_data.reserve(cells.size());
+          user_data.resize(cells.size());
+        }
+      user_data_is_allocated.value.store(user_data.size() != 0,
+                                         std::memory_order_release);
+    }
+
+
     template <typename G>
     inline void *&
     TriaObjects<G>::user_pointer(const unsigned int i)
@@ -632,7 +786,8 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      allocate_user_data();
       return user_data[i].p;
     }
 
@@ -645,7 +800,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_pointer;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (!user_data_is_allocated.value.load(std::memory_order_acquire))
+        return nullptr;
       return user_data[i].p;
     }
 
@@ -658,7 +815,8 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      allocate_user_data();
       return user_data[i].i;
     }
 
@@ -667,8 +825,9 @@ namespace internal
     inline void
     TriaObjects<G>::clear_user_data(const unsigned int i)
     {
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
-      user_data[i].i = 0;
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (user_data_is_allocated.value.load(std::memory_order_acquire))
+        user_data[i].i = 0;
     }
 
 
@@ -689,7 +848,9 @@ namespace internal
              ExcPointerIndexClash());
       user_data_type = data_index;
 
-      Assert(i < user_data.size(), ExcIndexRange(i, 0, user_data.size()));
+      Assert(i < cells.size(), ExcIndexRange(i, 0, cells.size()));
+      if (!user_data_is_allocated.value.load(std::memory_order_acquire))
+        return 0;
       return user_data[i].i;
     }
 
@@ -698,9 +859,9 @@ namespace internal
     inline void
     TriaObjects<G>::clear_user_data()
     {
-      user_data_type = data_unknown;
-      for (unsigned int i = 0; i < user_data.size(); ++i)
-        user_data[i].p = nullptr;
+      user_data_type               = data_unknown;
+      user_data_is_allocated.value = false;
+      std::vector<UserData>().swap(user_data);
     }
 
 
@@ -736,6 +897,7 @@ namespace internal
       ar &       manifold_id;
       ar &next_free_single &next_free_pair &reverse_order_next_free_single;
       ar &user_data &user_data_type;
+      user_data_is_allocated.value = (user_data.size() != 0);
     }
 
 
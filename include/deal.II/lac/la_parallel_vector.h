@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/memory_space.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/numbers.h>
@@ -28,6 +29,7 @@
 #include <deal.II/lac/vector_space_vector.h>
 #include <deal.II/lac/vector_type_traits.h>
 
+#include <array>
 #include <iomanip>
 #include <memory>
 
@@ -128,6 +130,15 @@ namespace LinearAlgebra
      * in other parts of the code.
      * <li> Of course, reduction operations (like norms) make use of
      * collective all-to-all MPI communications.
+     * <li> If the partitioner has shared memory communication enabled (see
+     * Utilities::MPI::Partitioner::enable_shared_memory_communication()),
+     * the vector entries of all processes on a compute node are allocated in
+     * an MPI-3 shared-memory window. compress() and update_ghost_values()
+     * then read the data of neighbors on the same node directly from their
+     * memory and only send MPI messages to processes on other nodes. Since
+     * the window is a collective object, such vectors must be created,
+     * reinitialized with a different partitioner and destroyed by all
+     * processes on a node at the same time.
      * </ul>
      *
      * This vector can take two different states with respect to ghost
@@ -298,6 +309,12 @@ namespace LinearAlgebra
 
       /**
        * Destructor.
+       *
+       * If the vector is allocated in an MPI-3 shared-memory window (see
+       * Utilities::MPI::Partitioner::enable_shared_memory_communication()),
+       * the destructor frees the window, which is collective over the
+       * shared-memory communicator of the partitioner. All processes on a
+       * node must then destroy their copies of the vector together.
        */
       virtual ~Vector() override;
 
@@ -317,6 +334,9 @@ namespace LinearAlgebra
        * be initialized with zero, otherwise the memory will be untouched (and
        * the user must make sure to fill it with reasonable data before using
        * it).
+       *
+       * For vectors allocated in a shared-memory window, see the comments on
+       * reinit() with a partitioner argument.
        */
       template <typename Number2>
       void
@@ -355,6 +375,16 @@ namespace LinearAlgebra
        * @p partitioner. The input argument is a shared pointer, which store
        * the partitioner data only once and share it between several vectors
        * with the same layout.
+       *
+       * If @p partitioner has shared memory communication enabled, the
+       * entries are allocated in an MPI-3 shared-memory window. Allocating
+       * the window and freeing the previous one are collective operations
+       * over the shared-memory communicator of the partitioner, so all
+       * processes on a node must call this function together. The only
+       * exception is the case where the vector already is allocated in a
+       * window of the same processes and the number of locally stored
+       * entries (owned plus ghosts) does not change on any of them: then,
+       * the present window is kept and the call does not communicate.
        */
       void
       reinit(
@@ -573,6 +603,33 @@ namespace LinearAlgebra
       void
       update_ghost_values_finish() const;
 
+      /**
+       * Select whether update_ghost_values() transmits the ghost values
+       * through MPI in reduced precision, i.e., vectors of type double (or
+       * std::complex<double>) send them as float (std::complex<float>) and
+       * expand them again on receipt. Since the ghost exchange is typically
+       * limited by the network bandwidth, this halves its cost. The ghost
+       * entries are then only accurate to about 7 digits, which is usually
+       * enough for example for the vectors of a multigrid smoother, whereas
+       * the vectors of an outer Krylov solver should keep the default full
+       * precision.
+       *
+       * The setting only affects the exchange of ghost values with processes
+       * outside the shared-memory domain of the partitioner and has no effect
+       * on compress(), on other number types, or when the data is sent
+       * directly from device memory with CUDA-aware MPI. It is preserved
+       * when copy-constructing a vector, but not by reinit().
+       */
+      void
+      set_reduced_precision_ghost_exchange(const bool reduced_precision);
+
+      /**
+       * Return whether update_ghost_values() transmits the ghost values in
+       * reduced precision, see set_reduced_precision_ghost_exchange().
+       */
+      bool
+      has_reduced_precision_ghost_exchange() const;
+
       /**
        * This method zeros the entries on ghost dofs, but does not touch
        * locally owned DoFs.
@@ -783,6 +840,61 @@ namespace LinearAlgebra
                   const VectorSpaceVector<Number> &V,
                   const VectorSpaceVector<Number> &W) override;
 
+      /**
+       * Fused update of the vector by a linear combination of @p n_vectors
+       * other vectors. The result is the same as if the user called
+       * @code
+       * this->operator*=(s);
+       * for (unsigned int k = 0; k < n_vectors; ++k)
+       *   this->add(a[k], *V[k]);
+       * @endcode
+       * except that a zero @p s overwrites the vector without reading its old
+       * entries (as in equ()). All vectors are traversed in a single
+       * threaded and vectorized loop, i.e., the calling vector is loaded and
+       * stored only once instead of @p n_vectors times. Since the number of
+       * vectors is a template argument, the loop is completely unrolled over
+       * the vectors. Typical uses are the stage updates of time integrators:
+       * @code
+       * u.template sadd<3>(1., {{a0, a1, a2}}, {{&k0, &k1, &k2}});
+       * @endcode
+       *
+       * This function is only implemented for MemorySpace::Host. It is
+       * explicitly instantiated for real numbers and up to four vectors,
+       * other cases are available by including
+       * la_parallel_vector.templates.h.
+       */
+      template <std::size_t n_vectors>
+      void
+      sadd(const Number                                               s,
+           const std::array<Number, n_vectors> &                      a,
+           const std::array<const Vector<Number, MemorySpace> *, n_vectors> &V);
+
+      /**
+       * Same as the fused sadd() above, but additionally compute the inner
+       * products of the updated vector with each of the vectors in @p W in
+       * the same loop and return them. This includes the square of the $l_2$
+       * norm of the result if @p W contains the calling vector. The local
+       * contributions are combined with a single MPI reduction. In other
+       * words, the result of this function is the same as if the user called
+       * @code
+       * this->sadd<n_vectors>(s, a, V);
+       * for (unsigned int d = 0; d < n_dots; ++d)
+       *   return_value[d] = *this * (*W[d]);
+       * @endcode
+       *
+       * This function is only implemented for MemorySpace::Host and real
+       * numbers. It is explicitly instantiated for up to four vectors in @p V
+       * and up to two vectors in @p W, more vectors are available by
+       * including la_parallel_vector.templates.h.
+       */
+      template <std::size_t n_vectors, std::size_t n_dots>
+      std::array<Number, n_dots>
+      sadd_and_dot(
+        const Number                                                      s,
+        const std::array<Number, n_vectors> &                             a,
+        const std::array<const Vector<Number, MemorySpace> *, n_vectors> &V,
+        const std::array<const Vector<Number, MemorySpace> *, n_dots> &   W);
+
       /**
        * Return the global size of the vector, equal to the sum of the number of
        * locally owned indices among all processors.
@@ -1325,6 +1437,23 @@ namespace LinearAlgebra
       mutable std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
         thread_loop_partitioner;
 
+      /**
+       * In case the vector is allocated in an MPI-3 shared-memory window,
+       * views to the locally owned and ghost entries of all processes in the
+       * shared-memory communicator of the partitioner, in the order of their
+       * rank in that communicator. Empty otherwise.
+       */
+      std::vector<ArrayView<const Number>> shared_values;
+
+#ifdef DEAL_II_WITH_MPI
+      /**
+       * The shared-memory window holding the entries in case @p
+       * shared_values is not empty, and MPI_WIN_NULL otherwise. The window
+       * is owned by the deleter of @p data.
+       */
+      MPI_Win shared_window;
+#endif
+
       /**
        * Temporary storage that holds the data that is sent to this processor
        * in @p compress() or sent from this processor in
@@ -1342,22 +1471,75 @@ namespace LinearAlgebra
        */
       mutable bool vector_is_ghosted;
 
+      /**
+       * Stores whether update_ghost_values() transmits the ghost values in
+       * reduced precision, see set_reduced_precision_ghost_exchange().
+       */
+      bool reduced_precision_ghost_exchange;
+
+      /**
+       * Temporary storage for the data sent and received by
+       * update_ghost_values() in reduced precision, holding the import
+       * indices followed by the ghost indices.
+       */
+      mutable std::vector<
+        typename Utilities::MPI::internal::ReducedPrecision<Number>::type>
+        reduced_precision_buffer;
+
 #ifdef DEAL_II_WITH_MPI
       /**
        * A vector that collects all requests from @p compress() operations.
-       * This class uses persistent MPI communicators, i.e., the communication
-       * channels are stored during successive calls to a given function. This
-       * reduces the overhead involved with setting up the MPI machinery, but
-       * it does not remove the need for a receive operation to be posted
-       * before the data can actually be sent.
        */
       std::vector<MPI_Request> compress_requests;
 
       /**
        * A vector that collects all requests from @p update_ghost_values()
-       * operations. This class uses persistent MPI communicators.
+       * operations.
        */
       mutable std::vector<MPI_Request> update_ghost_values_requests;
+
+      /**
+       * Persistent MPI requests for @p compress() operations. This class
+       * uses persistent MPI communicators, i.e., the communication channels
+       * are set up by the partitioner on the first call and stored during
+       * successive calls (see
+       * Utilities::MPI::Partitioner::initialize_persistent_import_requests()).
+       * This reduces the overhead involved with setting up the MPI machinery,
+       * but it does not remove the need for a receive operation to be posted
+       * before the data can actually be sent.
+       */
+      std::vector<MPI_Request> compress_persistent_requests;
+
+      /**
+       * The communication channel the persistent requests in
+       * @p compress_persistent_requests have been set up for.
+       */
+      unsigned int compress_persistent_channel;
+
+      /**
+       * Persistent MPI requests for @p update_ghost_values() operations, see
+       * @p compress_persistent_requests.
+       */
+      mutable std::vector<MPI_Request> update_ghost_values_persistent_requests;
+
+      /**
+       * The communication channel the persistent requests in
+       * @p update_ghost_values_persistent_requests have been set up for.
+       */
+      mutable unsigned int update_ghost_values_persistent_channel;
+
+      /**
+       * The communication channel passed to the currently running
+       * compress_start(), needed to finish the exchange with the processes
+       * on the same node in compress_finish().
+       */
+      unsigned int compress_channel;
+
+      /**
+       * The communication channel passed to the currently running
+       * update_ghost_values_start(), see @p compress_channel.
+       */
+      mutable unsigned int update_ghost_values_channel;
 #endif
 
       /**
@@ -1369,11 +1551,20 @@ namespace LinearAlgebra
 
       /**
        * A helper function that clears the compress_requests and
-       * update_ghost_values_requests field. Used in reinit functions.
+       * update_ghost_values_requests fields and frees the persistent
+       * requests. Used in reinit functions.
        */
       void
       clear_mpi_requests();
 
+      /**
+       * Return whether update_ghost_values() currently transmits the ghost
+       * values in reduced precision, i.e., whether this was requested and
+       * the number type has a lower-precision counterpart.
+       */
+      bool
+      exchange_ghosts_in_reduced_precision() const;
+
       /**
        * A helper function that is used to resize the val array.
        */
@@ -1494,6 +1685,15 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpace>
+    inline bool
+    Vector<Number, MemorySpace>::has_reduced_precision_ghost_exchange() const
+    {
+      return reduced_precision_ghost_exchange;
+    }
+
+
+
     template <typename Number, typename MemorySpace>
     inline typename Vector<Number, MemorySpace>::size_type
     Vector<Number, MemorySpace>::size() const
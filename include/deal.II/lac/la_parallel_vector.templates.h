@@ -96,6 +96,19 @@ namespace LinearAlgebra
             & /*data*/)
         {}
 
+#ifdef DEAL_II_WITH_MPI
+        static void
+        resize_val_shared(
+          const types::global_dof_index /*new_alloc_size*/,
+          types::global_dof_index & /*allocated_size*/,
+          ::dealii::MemorySpace::MemorySpaceData<Number, MemorySpaceType>
+            & /*data*/,
+          const MPI_Comm & /*communicator_sm*/,
+          std::vector<ArrayView<const Number>> & /*shared_values*/,
+          MPI_Win & /*shared_window*/)
+        {}
+#endif
+
         static void
         import(
           const ::dealii::LinearAlgebra::ReadWriteVector<Number> & /*V*/,
@@ -140,7 +153,9 @@ namespace LinearAlgebra
                 reinterpret_cast<void **>(&new_val),
                 64,
                 sizeof(Number) * new_alloc_size);
-              data.values.reset(new_val);
+              // explicitly set the deleter because the previous memory might
+              // have been allocated in a shared-memory window
+              data.values = decltype(data.values)(new_val, &free);
 
               allocated_size = new_alloc_size;
             }
@@ -151,6 +166,119 @@ namespace LinearAlgebra
             }
         }
 
+#ifdef DEAL_II_WITH_MPI
+        static void
+        resize_val_shared(
+          const types::global_dof_index new_alloc_size,
+          types::global_dof_index &     allocated_size,
+          ::dealii::MemorySpace::MemorySpaceData<Number,
+                                                 ::dealii::MemorySpace::Host>
+            &                                   data,
+          const MPI_Comm &                      communicator_sm,
+          std::vector<ArrayView<const Number>> &shared_values,
+          MPI_Win &                             shared_window)
+        {
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+          // the shared-memory window is a collective object of all processes
+          // in communicator_sm. Unlike resize_val(), we can therefore not
+          // keep a larger allocation, since the other processes would not
+          // know about the new size of our array. We only keep the present
+          // window if it belongs to the same group of processes and the size
+          // stays the same, which the documentation of reinit() requires to
+          // hold on all processes of the node. Then, no collective call is
+          // made and vectors can be reinitialized with the same layout
+          // independently on each process
+          int ierr;
+          if (shared_values.size() > 0 && new_alloc_size == allocated_size)
+            {
+              MPI_Group window_group, communicator_group;
+              ierr = MPI_Win_get_group(shared_window, &window_group);
+              AssertThrowMPI(ierr);
+              ierr = MPI_Comm_group(communicator_sm, &communicator_group);
+              AssertThrowMPI(ierr);
+              int result = MPI_UNEQUAL;
+              ierr =
+                MPI_Group_compare(window_group, communicator_group, &result);
+              AssertThrowMPI(ierr);
+              ierr = MPI_Group_free(&window_group);
+              AssertThrowMPI(ierr);
+              ierr = MPI_Group_free(&communicator_group);
+              AssertThrowMPI(ierr);
+              if (result == MPI_IDENT)
+                return;
+            }
+
+          data.values.reset();
+          shared_values.clear();
+          shared_window = MPI_WIN_NULL;
+
+          MPI_Info info;
+          ierr = MPI_Info_create(&info);
+          AssertThrowMPI(ierr);
+          // let the MPI implementation place the memory of each process
+          // separately (e.g. page-aligned and close to the process), we do
+          // not need a contiguous array across the processes
+          ierr = MPI_Info_set(info, "alloc_shared_noncontig", "true");
+          AssertThrowMPI(ierr);
+
+          // allocate at least one entry in order to get a valid pointer on
+          // every process, whose deleter then releases the window
+          const std::size_t n_entries =
+            std::max<std::size_t>(new_alloc_size, 1);
+          MPI_Win *window  = new MPI_Win;
+          Number * new_val = nullptr;
+          ierr             = MPI_Win_allocate_shared(n_entries * sizeof(Number),
+                                         sizeof(Number),
+                                         info,
+                                         communicator_sm,
+                                         &new_val,
+                                         window);
+          AssertThrowMPI(ierr);
+          ierr = MPI_Info_free(&info);
+          AssertThrowMPI(ierr);
+
+          // open a passive target epoch for the lifetime of the window,
+          // which is needed for the MPI_Win_sync() calls that order the
+          // direct loads and stores with the messages of the partitioner
+          ierr = MPI_Win_lock_all(MPI_MODE_NOCHECK, *window);
+          AssertThrowMPI(ierr);
+
+          data.values = decltype(data.values)(new_val, [window](Number *) {
+            int ierr = MPI_Win_unlock_all(*window);
+            AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+            ierr = MPI_Win_free(window);
+            (void)ierr;
+            AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+            delete window;
+          });
+          allocated_size = new_alloc_size;
+          shared_window  = *window;
+
+          // query the arrays of all other processes on the node
+          const unsigned int n_processes_sm =
+            Utilities::MPI::n_mpi_processes(communicator_sm);
+          shared_values.reserve(n_processes_sm);
+          for (unsigned int i = 0; i < n_processes_sm; ++i)
+            {
+              MPI_Aint size;
+              int      disp_unit;
+              Number * ptr;
+              ierr = MPI_Win_shared_query(*window, i, &size, &disp_unit, &ptr);
+              AssertThrowMPI(ierr);
+              shared_values.emplace_back(ptr, size / sizeof(Number));
+            }
+#  else
+          (void)new_alloc_size;
+          (void)allocated_size;
+          (void)data;
+          (void)communicator_sm;
+          (void)shared_values;
+          (void)shared_window;
+          AssertThrow(false, ExcNotImplemented());
+#  endif
+        }
+#endif
+
         static void
         import(const ::dealii::LinearAlgebra::ReadWriteVector<Number> &V,
                ::dealii::VectorOperation::values operation,
@@ -253,6 +381,24 @@ namespace LinearAlgebra
             }
         }
 
+#  ifdef DEAL_II_WITH_MPI
+        static void
+        resize_val_shared(
+          const types::global_dof_index /*new_alloc_size*/,
+          types::global_dof_index & /*allocated_size*/,
+          ::dealii::MemorySpace::MemorySpaceData<Number,
+                                                 ::dealii::MemorySpace::CUDA>
+            & /*data*/,
+          const MPI_Comm & /*communicator_sm*/,
+          std::vector<ArrayView<const Number>> & /*shared_values*/,
+          MPI_Win & /*shared_window*/)
+        {
+          AssertThrow(false,
+                      ExcMessage("Shared memory communication is not "
+                                 "supported for MemorySpace::CUDA."));
+        }
+#  endif
+
         static void
         import(const ReadWriteVector<Number> &V,
                VectorOperation::values        operation,
@@ -380,18 +526,39 @@ namespace LinearAlgebra
     Vector<Number, MemorySpaceType>::clear_mpi_requests()
     {
 #ifdef DEAL_II_WITH_MPI
-      for (size_type j = 0; j < compress_requests.size(); j++)
+      // the active requests are copies of the persistent requests if the
+      // latter are set up, so free each request only once
+      if (compress_persistent_requests.empty())
+        for (size_type j = 0; j < compress_requests.size(); j++)
+          {
+            const int ierr = MPI_Request_free(&compress_requests[j]);
+            AssertThrowMPI(ierr);
+          }
+      compress_requests.clear();
+      if (update_ghost_values_persistent_requests.empty())
+        for (size_type j = 0; j < update_ghost_values_requests.size(); j++)
+          {
+            const int ierr = MPI_Request_free(&update_ghost_values_requests[j]);
+            AssertThrowMPI(ierr);
+          }
+      update_ghost_values_requests.clear();
+
+      for (MPI_Request &request : compress_persistent_requests)
         {
-          const int ierr = MPI_Request_free(&compress_requests[j]);
+          const int ierr = MPI_Request_free(&request);
           AssertThrowMPI(ierr);
         }
-      compress_requests.clear();
-      for (size_type j = 0; j < update_ghost_values_requests.size(); j++)
+      compress_persistent_requests.clear();
+      compress_persistent_channel = 0;
+      for (MPI_Request &request : update_ghost_values_persistent_requests)
         {
-          const int ierr = MPI_Request_free(&update_ghost_values_requests[j]);
+          const int ierr = MPI_Request_free(&request);
           AssertThrowMPI(ierr);
         }
-      update_ghost_values_requests.clear();
+      update_ghost_values_persistent_requests.clear();
+      update_ghost_values_persistent_channel = 0;
+      compress_channel                       = 0;
+      update_ghost_values_channel            = 0;
 #endif
     }
 
@@ -401,9 +568,33 @@ namespace LinearAlgebra
     void
     Vector<Number, MemorySpaceType>::resize_val(const size_type new_alloc_size)
     {
-      internal::la_parallel_vector_templates_functions<
-        Number,
-        MemorySpaceType>::resize_val(new_alloc_size, allocated_size, data);
+#ifdef DEAL_II_WITH_MPI
+      if (partitioner->shared_memory_communication_enabled())
+        internal::la_parallel_vector_templates_functions<Number,
+                                                         MemorySpaceType>::
+          resize_val_shared(new_alloc_size,
+                            allocated_size,
+                            data,
+                            partitioner->get_shared_memory_communicator(),
+                            shared_values,
+                            shared_window);
+      else
+#endif
+        {
+          // release the memory of a shared-memory window, if any
+          if (shared_values.size() > 0)
+            {
+              data.values.reset();
+              allocated_size = 0;
+              shared_values.clear();
+            }
+#ifdef DEAL_II_WITH_MPI
+          shared_window = MPI_WIN_NULL;
+#endif
+          internal::la_parallel_vector_templates_functions<
+            Number,
+            MemorySpaceType>::resize_val(new_alloc_size, allocated_size, data);
+        }
 
       thread_loop_partitioner =
         std::make_shared<::dealii::parallel::internal::TBBPartitioner>();
@@ -418,6 +609,9 @@ namespace LinearAlgebra
     {
       clear_mpi_requests();
 
+      // set partitioner to serial version
+      partitioner = std::make_shared<Utilities::MPI::Partitioner>(size);
+
       // check whether we need to reallocate
       resize_val(size);
 
@@ -425,9 +619,6 @@ namespace LinearAlgebra
       import_data.values.reset();
       import_data.values_dev.reset();
 
-      // set partitioner to serial version
-      partitioner = std::make_shared<Utilities::MPI::Partitioner>(size);
-
       // set entries to zero if so requested
       if (omit_zeroing_entries == false)
         this->operator=(Number());
@@ -540,6 +731,7 @@ namespace LinearAlgebra
     Vector<Number, MemorySpaceType>::Vector()
       : partitioner(new Utilities::MPI::Partitioner())
       , allocated_size(0)
+      , reduced_precision_ghost_exchange(false)
     {
       reinit(0);
     }
@@ -552,6 +744,7 @@ namespace LinearAlgebra
       : Subscriptor()
       , allocated_size(0)
       , vector_is_ghosted(false)
+      , reduced_precision_ghost_exchange(v.reduced_precision_ghost_exchange)
     {
       reinit(v, true);
 
@@ -574,6 +767,7 @@ namespace LinearAlgebra
                                             const MPI_Comm  communicator)
       : allocated_size(0)
       , vector_is_ghosted(false)
+      , reduced_precision_ghost_exchange(false)
     {
       reinit(local_range, ghost_indices, communicator);
     }
@@ -585,6 +779,7 @@ namespace LinearAlgebra
                                             const MPI_Comm  communicator)
       : allocated_size(0)
       , vector_is_ghosted(false)
+      , reduced_precision_ghost_exchange(false)
     {
       reinit(local_range, communicator);
     }
@@ -595,6 +790,7 @@ namespace LinearAlgebra
     Vector<Number, MemorySpaceType>::Vector(const size_type size)
       : allocated_size(0)
       , vector_is_ghosted(false)
+      , reduced_precision_ghost_exchange(false)
     {
       reinit(size, false);
     }
@@ -606,6 +802,7 @@ namespace LinearAlgebra
       const std::shared_ptr<const Utilities::MPI::Partitioner> &partitioner)
       : allocated_size(0)
       , vector_is_ghosted(false)
+      , reduced_precision_ghost_exchange(false)
     {
       reinit(partitioner);
     }
@@ -873,6 +1070,36 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    void
+    Vector<Number, MemorySpaceType>::set_reduced_precision_ghost_exchange(
+      const bool reduced_precision)
+    {
+#ifdef DEAL_II_WITH_MPI
+      Assert(update_ghost_values_requests.empty(),
+             ExcMessage("Cannot change the precision of the ghost exchange "
+                        "while update_ghost_values() is running."));
+#endif
+      reduced_precision_ghost_exchange = reduced_precision;
+      if (reduced_precision_ghost_exchange == false)
+        reduced_precision_buffer.clear();
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    bool
+    Vector<Number, MemorySpaceType>::exchange_ghosts_in_reduced_precision()
+      const
+    {
+      return reduced_precision_ghost_exchange &&
+             !std::is_same<Number,
+                           typename Utilities::MPI::internal::ReducedPrecision<
+                             Number>::type>::value;
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     void
     Vector<Number, MemorySpaceType>::compress_start(
@@ -888,6 +1115,8 @@ namespace LinearAlgebra
       // make this function thread safe
       std::lock_guard<std::mutex> lock(mutex);
 
+      compress_channel = counter;
+
       // allocate import_data in case it is not set up yet
       if (partitioner->n_import_indices() > 0)
         {
@@ -941,15 +1170,47 @@ namespace LinearAlgebra
 
 #  if !(defined(DEAL_II_COMPILER_CUDA_AWARE) && \
         defined(DEAL_II_WITH_CUDA_AWARE_MPI))
+      const ArrayView<Number, MemorySpace::Host> ghost_array(
+        data.values.get() + partitioner->local_size(),
+        partitioner->n_ghost_indices());
+      const ArrayView<Number, MemorySpace::Host> temporary_storage(
+        import_data.values.get(), partitioner->n_import_indices());
+
+#    ifndef DEAL_II_COMPILER_CUDA_AWARE
+      // set up the persistent requests on the first call. The arrays of the
+      // vector stay the same until the next reinit(), which frees them
+      if (compress_persistent_requests.size() > 0 &&
+          compress_persistent_channel != counter)
+        {
+          for (MPI_Request &request : compress_persistent_requests)
+            {
+              const int ierr = MPI_Request_free(&request);
+              AssertThrowMPI(ierr);
+            }
+          compress_persistent_requests.clear();
+        }
+      if (compress_persistent_requests.empty() &&
+          partitioner->ghost_targets().size() +
+              partitioner->import_targets().size() >
+            0)
+        {
+          partitioner->initialize_persistent_import_requests(
+            counter,
+            ghost_array,
+            temporary_storage,
+            compress_persistent_requests);
+          compress_persistent_channel = counter;
+        }
+#    endif
+
       partitioner->import_from_ghosted_array_start(
         operation,
         counter,
-        ArrayView<Number, MemorySpace::Host>(data.values.get() +
-                                               partitioner->local_size(),
-                                             partitioner->n_ghost_indices()),
-        ArrayView<Number, MemorySpace::Host>(import_data.values.get(),
-                                             partitioner->n_import_indices()),
-        compress_requests);
+        ghost_array,
+        temporary_storage,
+        compress_requests,
+        compress_persistent_requests,
+        shared_window);
 #  else
       partitioner->import_from_ghosted_array_start(
         operation,
@@ -994,7 +1255,10 @@ namespace LinearAlgebra
         ArrayView<Number, MemorySpace::Host>(data.values.get() +
                                                partitioner->local_size(),
                                              partitioner->n_ghost_indices()),
-        compress_requests);
+        compress_requests,
+        shared_values,
+        compress_channel,
+        shared_window);
 #  else
       Assert(partitioner->n_import_indices() == 0 ||
                import_data.values_dev != nullptr,
@@ -1048,6 +1312,8 @@ namespace LinearAlgebra
       // make this function thread safe
       std::lock_guard<std::mutex> lock(mutex);
 
+      update_ghost_values_channel = counter;
+
       // allocate import_data in case it is not set up yet
       if (partitioner->n_import_indices() > 0)
         {
@@ -1101,16 +1367,66 @@ namespace LinearAlgebra
 
 #  if !(defined(DEAL_II_COMPILER_CUDA_AWARE) && \
         defined(DEAL_II_WITH_CUDA_AWARE_MPI))
+      const ArrayView<Number, MemorySpace::Host> temporary_storage(
+        import_data.values.get(), partitioner->n_import_indices());
+      const ArrayView<Number, MemorySpace::Host> ghost_array(
+        data.values.get() + partitioner->local_size(),
+        partitioner->n_ghost_indices());
+
+      if (exchange_ghosts_in_reduced_precision())
+        {
+          using TransportNumber =
+            typename Utilities::MPI::internal::ReducedPrecision<Number>::type;
+          const unsigned int n_import_indices =
+            partitioner->n_import_indices();
+          reduced_precision_buffer.resize(n_import_indices +
+                                          partitioner->n_ghost_indices());
+          partitioner->export_to_ghosted_array_reduced_precision_start(
+            counter,
+            ArrayView<const Number>(data.values.get(),
+                                    partitioner->local_size()),
+            ArrayView<TransportNumber>(reduced_precision_buffer.data(),
+                                       n_import_indices),
+            ArrayView<TransportNumber>(reduced_precision_buffer.data() +
+                                         n_import_indices,
+                                       partitioner->n_ghost_indices()),
+            update_ghost_values_requests,
+            shared_window);
+          return;
+        }
+
+#    ifndef DEAL_II_COMPILER_CUDA_AWARE
+      // set up the persistent requests on the first call, see compress_start()
+      if (update_ghost_values_persistent_requests.size() > 0 &&
+          update_ghost_values_persistent_channel != counter)
+        {
+          for (MPI_Request &request : update_ghost_values_persistent_requests)
+            {
+              const int ierr = MPI_Request_free(&request);
+              AssertThrowMPI(ierr);
+            }
+          update_ghost_values_persistent_requests.clear();
+        }
+      if (update_ghost_values_persistent_requests.empty())
+        {
+          partitioner->initialize_persistent_export_requests(
+            counter,
+            temporary_storage,
+            ghost_array,
+            update_ghost_values_persistent_requests);
+          update_ghost_values_persistent_channel = counter;
+        }
+#    endif
+
       partitioner->export_to_ghosted_array_start<Number, MemorySpace::Host>(
         counter,
         ArrayView<const Number, MemorySpace::Host>(data.values.get(),
                                                    partitioner->local_size()),
-        ArrayView<Number, MemorySpace::Host>(import_data.values.get(),
-                                             partitioner->n_import_indices()),
-        ArrayView<Number, MemorySpace::Host>(data.values.get() +
-                                               partitioner->local_size(),
-                                             partitioner->n_ghost_indices()),
-        update_ghost_values_requests);
+        temporary_storage,
+        ghost_array,
+        update_ghost_values_requests,
+        update_ghost_values_persistent_requests,
+        shared_window);
 #  else
       partitioner->export_to_ghosted_array_start<Number, MemorySpace::CUDA>(
         counter,
@@ -1148,11 +1464,28 @@ namespace LinearAlgebra
 
 #  if !(defined(DEAL_II_COMPILER_CUDA_AWARE) && \
         defined(DEAL_II_WITH_CUDA_AWARE_MPI))
-          partitioner->export_to_ghosted_array_finish(
-            ArrayView<Number, MemorySpace::Host>(
-              data.values.get() + partitioner->local_size(),
-              partitioner->n_ghost_indices()),
-            update_ghost_values_requests);
+          if (exchange_ghosts_in_reduced_precision())
+            partitioner->export_to_ghosted_array_reduced_precision_finish(
+              ArrayView<const typename Utilities::MPI::internal::
+                          ReducedPrecision<Number>::type>(
+                reduced_precision_buffer.data() +
+                  partitioner->n_import_indices(),
+                partitioner->n_ghost_indices()),
+              ArrayView<Number>(data.values.get() + partitioner->local_size(),
+                                partitioner->n_ghost_indices()),
+              update_ghost_values_requests,
+              shared_values,
+              update_ghost_values_channel,
+              shared_window);
+          else
+            partitioner->export_to_ghosted_array_finish(
+              ArrayView<Number, MemorySpace::Host>(
+                data.values.get() + partitioner->local_size(),
+                partitioner->n_ghost_indices()),
+              update_ghost_values_requests,
+              shared_values,
+              update_ghost_values_channel,
+              shared_window);
 #  else
           partitioner->export_to_ghosted_array_finish(
             ArrayView<Number, MemorySpace::CUDA>(
@@ -1308,14 +1641,27 @@ namespace LinearAlgebra
 
       std::swap(compress_requests, v.compress_requests);
       std::swap(update_ghost_values_requests, v.update_ghost_values_requests);
+      std::swap(compress_persistent_requests, v.compress_persistent_requests);
+      std::swap(compress_persistent_channel, v.compress_persistent_channel);
+      std::swap(update_ghost_values_persistent_requests,
+                v.update_ghost_values_persistent_requests);
+      std::swap(update_ghost_values_persistent_channel,
+                v.update_ghost_values_persistent_channel);
+      std::swap(compress_channel, v.compress_channel);
+      std::swap(update_ghost_values_channel, v.update_ghost_values_channel);
+      std::swap(shared_window, v.shared_window);
 #endif
 
       std::swap(partitioner, v.partitioner);
       std::swap(thread_loop_partitioner, v.thread_loop_partitioner);
       std::swap(allocated_size, v.allocated_size);
       std::swap(data, v.data);
+      std::swap(shared_values, v.shared_values);
       std::swap(import_data, v.import_data);
       std::swap(vector_is_ghosted, v.vector_is_ghosted);
+      std::swap(reduced_precision_ghost_exchange,
+                v.reduced_precision_ghost_exchange);
+      std::swap(reduced_precision_buffer, v.reduced_precision_buffer);
     }
 
 
@@ -1974,6 +2320,110 @@ namespace LinearAlgebra
 
 
 
+    template <typename Number, typename MemorySpaceType>
+    template <std::size_t n_vectors>
+    void
+    Vector<Number, MemorySpaceType>::sadd(
+      const Number                                                   s,
+      const std::array<Number, n_vectors> &                          a,
+      const std::array<const Vector<Number, MemorySpaceType> *, n_vectors> &V)
+    {
+      static_assert(std::is_same<MemorySpaceType, MemorySpace::Host>::value,
+                    "The fused sadd() is only implemented for "
+                    "MemorySpace::Host.");
+      static_assert(n_vectors > 0, "At least one vector must be given.");
+      AssertIsFinite(s);
+
+      std::array<const Number *, n_vectors> v_values;
+      for (std::size_t k = 0; k < n_vectors; ++k)
+        {
+          AssertIsFinite(a[k]);
+          Assert(V[k] != nullptr, ExcNotInitialized());
+          AssertDimension(local_size(), V[k]->local_size());
+          v_values[k] = V[k]->data.values.get();
+        }
+
+      dealii::internal::VectorOperations::
+        functions<Number, Number, MemorySpaceType>::linear_combination(
+          thread_loop_partitioner,
+          partitioner->local_size(),
+          s,
+          a,
+          v_values,
+          data);
+
+      if (vector_is_ghosted)
+        update_ghost_values();
+    }
+
+
+
+    template <typename Number, typename MemorySpaceType>
+    template <std::size_t n_vectors, std::size_t n_dots>
+    std::array<Number, n_dots>
+    Vector<Number, MemorySpaceType>::sadd_and_dot(
+      const Number                                                   s,
+      const std::array<Number, n_vectors> &                          a,
+      const std::array<const Vector<Number, MemorySpaceType> *, n_vectors> &V,
+      const std::array<const Vector<Number, MemorySpaceType> *, n_dots> &W)
+    {
+      static_assert(std::is_same<MemorySpaceType, MemorySpace::Host>::value,
+                    "The fused sadd_and_dot() is only implemented for "
+                    "MemorySpace::Host.");
+      static_assert(n_vectors > 0 && n_dots > 0,
+                    "At least one vector must be given for the update and "
+                    "for the inner products.");
+      AssertIsFinite(s);
+
+      std::array<const Number *, n_vectors> v_values;
+      for (std::size_t k = 0; k < n_vectors; ++k)
+        {
+          AssertIsFinite(a[k]);
+          Assert(V[k] != nullptr, ExcNotInitialized());
+          AssertDimension(local_size(), V[k]->local_size());
+          v_values[k] = V[k]->data.values.get();
+        }
+      std::array<const Number *, n_dots> w_values;
+      for (std::size_t d = 0; d < n_dots; ++d)
+        {
+          Assert(W[d] != nullptr, ExcNotInitialized());
+          AssertDimension(local_size(), W[d]->local_size());
+          w_values[d] = W[d]->data.values.get();
+        }
+
+      const Tensor<1, n_dots, Number> sums =
+        dealii::internal::VectorOperations::
+          functions<Number, Number, MemorySpaceType>::
+            template linear_combination_and_dot<n_vectors, n_dots>(
+              thread_loop_partitioner,
+              partitioner->local_size(),
+              s,
+              a,
+              v_values,
+              w_values,
+              data);
+
+      std::array<Number, n_dots> result;
+      for (std::size_t d = 0; d < n_dots; ++d)
+        {
+          AssertIsFinite(sums[d]);
+          result[d] = sums[d];
+        }
+
+      // a single reduction for all inner products
+      if (partitioner->n_mpi_processes() > 1)
+        Utilities::MPI::sum(ArrayView<const Number>(result.data(), n_dots),
+                            partitioner->get_mpi_communicator(),
+                            ArrayView<Number>(result.data(), n_dots));
+
+      if (vector_is_ghosted)
+        update_ghost_values();
+
+      return result;
+    }
+
+
+
     template <typename Number, typename MemorySpaceType>
     inline bool
     Vector<Number, MemorySpaceType>::partitioners_are_compatible(
@@ -20,6 +20,7 @@
 #include <deal.II/base/memory_space.h>
 #include <deal.II/base/multithread_info.h>
 #include <deal.II/base/parallel.h>
+#include <deal.II/base/tensor.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/types.h>
 #include <deal.II/base/vectorization.h>
@@ -27,6 +28,7 @@
 #include <deal.II/lac/cuda_kernels.h>
 #include <deal.II/lac/cuda_kernels.templates.h>
 
+#include <array>
 #include <cstdio>
 #include <cstring>
 
@@ -713,6 +715,81 @@ namespace internal
       const Number        c;
     };
 
+    template <typename Number, std::size_t n_vectors>
+    struct Vectorization_linear_combination
+    {
+      Vectorization_linear_combination(
+        Number *const                                val,
+        const Number                                 s,
+        const std::array<Number, n_vectors> &        a,
+        const std::array<const Number *, n_vectors> &v_val)
+        : val(val)
+        , s(s)
+        , a(a)
+        , v_val(v_val)
+      {}
+
+      void
+      operator()(const size_type begin, const size_type end) const
+      {
+        // do not read the old entries if they get overwritten, such that
+        // uninitialized entries do not pollute the result
+        if (s == Number())
+          {
+            if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
+              {
+                DEAL_II_OPENMP_SIMD_PRAGMA
+                for (size_type i = begin; i < end; ++i)
+                  {
+                    Number x = a[0] * v_val[0][i];
+                    for (std::size_t k = 1; k < n_vectors; ++k)
+                      x += a[k] * v_val[k][i];
+                    val[i] = x;
+                  }
+              }
+            else
+              {
+                for (size_type i = begin; i < end; ++i)
+                  {
+                    Number x = a[0] * v_val[0][i];
+                    for (std::size_t k = 1; k < n_vectors; ++k)
+                      x += a[k] * v_val[k][i];
+                    val[i] = x;
+                  }
+              }
+          }
+        else
+          {
+            if (parallel::internal::EnableOpenMPSimdFor<Number>::value)
+              {
+                DEAL_II_OPENMP_SIMD_PRAGMA
+                for (size_type i = begin; i < end; ++i)
+                  {
+                    Number x = s * val[i];
+                    for (std::size_t k = 0; k < n_vectors; ++k)
+                      x += a[k] * v_val[k][i];
+                    val[i] = x;
+                  }
+              }
+            else
+              {
+                for (size_type i = begin; i < end; ++i)
+                  {
+                    Number x = s * val[i];
+                    for (std::size_t k = 0; k < n_vectors; ++k)
+                      x += a[k] * v_val[k][i];
+                    val[i] = x;
+                  }
+              }
+          }
+      }
+
+      Number *const                               val;
+      const Number                                s;
+      const std::array<Number, n_vectors>         a;
+      const std::array<const Number *, n_vectors> v_val;
+    };
+
     template <typename Number>
     struct Vectorization_ratio
     {
@@ -958,6 +1035,81 @@ namespace internal
 
 
 
+    template <typename Number, std::size_t n_vectors, std::size_t n_dots>
+    struct LinearCombinationAndDot
+    {
+      static const bool vectorizes =
+        VectorizedArray<Number>::n_array_elements > 1;
+
+      LinearCombinationAndDot(Number *const                                X,
+                              const Number                                 s,
+                              const std::array<Number, n_vectors> &        a,
+                              const std::array<const Number *, n_vectors> &V,
+                              const std::array<const Number *, n_dots> &   W)
+        : X(X)
+        , s(s)
+        , a(a)
+        , V(V)
+        , W(W)
+      {}
+
+      Tensor<1, n_dots, Number>
+      operator()(const size_type i) const
+      {
+        Number x = (s == Number()) ? Number() : s * X[i];
+        for (std::size_t k = 0; k < n_vectors; ++k)
+          x += a[k] * V[k][i];
+        X[i] = x;
+
+        // may only load from W after storing in X because the pointers might
+        // point to the same memory
+        Tensor<1, n_dots, Number> result;
+        for (std::size_t d = 0; d < n_dots; ++d)
+          result[d] =
+            x * Number(numbers::NumberTraits<Number>::conjugate(W[d][i]));
+        return result;
+      }
+
+      Tensor<1, n_dots, VectorizedArray<Number>>
+      do_vectorized(const size_type i) const
+      {
+        VectorizedArray<Number> x, v;
+        if (s == Number())
+          x = Number();
+        else
+          {
+            x.load(X + i);
+            x = s * x;
+          }
+        for (std::size_t k = 0; k < n_vectors; ++k)
+          {
+            v.load(V[k] + i);
+            x += a[k] * v;
+          }
+        x.store(X + i);
+
+        // see the comment in AddAndDot regarding complex numbers
+        static_assert(numbers::NumberTraits<Number>::is_complex == false,
+                      "This operation is not correctly implemented for "
+                      "complex-valued objects.");
+        Tensor<1, n_dots, VectorizedArray<Number>> result;
+        for (std::size_t d = 0; d < n_dots; ++d)
+          {
+            v.load(W[d] + i);
+            result[d] = x * v;
+          }
+        return result;
+      }
+
+      Number *const                               X;
+      const Number                                s;
+      const std::array<Number, n_vectors>         a;
+      const std::array<const Number *, n_vectors> V;
+      const std::array<const Number *, n_dots>    W;
+    };
+
+
+
     // this is the main working loop for all vector sums using the templated
     // operation above. it accumulates the sums using a block-wise summation
     // algorithm with post-update. this blocked algorithm has been proposed in
@@ -1243,6 +1395,70 @@ namespace internal
 
 
 
+    // this is the vectorized inner working routine for operations that
+    // compute several sums at once, such as LinearCombinationAndDot. The
+    // layout is the same as in the function above, with the lanes of each
+    // component written to separate entries of outer_results.
+    template <typename Operation, int n_components, typename Number>
+    void
+    accumulate_regular(
+      const Operation &op,
+      size_type &      n_chunks,
+      size_type &      index,
+      Tensor<1, n_components, Number> (
+        &outer_results)[vector_accumulation_recursion_threshold],
+      std::integral_constant<bool, true>)
+    {
+      const unsigned int nvecs = VectorizedArray<Number>::n_array_elements;
+      const size_type    regular_chunks = n_chunks / nvecs;
+      for (size_type i = 0; i < regular_chunks; ++i)
+        {
+          Tensor<1, n_components, VectorizedArray<Number>> r0 =
+            op.do_vectorized(index);
+          Tensor<1, n_components, VectorizedArray<Number>> r1 =
+            op.do_vectorized(index + nvecs);
+          Tensor<1, n_components, VectorizedArray<Number>> r2 =
+            op.do_vectorized(index + 2 * nvecs);
+          Tensor<1, n_components, VectorizedArray<Number>> r3 =
+            op.do_vectorized(index + 3 * nvecs);
+          index += nvecs * 4;
+          for (size_type j = 1; j < 8; ++j, index += nvecs * 4)
+            {
+              r0 += op.do_vectorized(index);
+              r1 += op.do_vectorized(index + nvecs);
+              r2 += op.do_vectorized(index + 2 * nvecs);
+              r3 += op.do_vectorized(index + 3 * nvecs);
+            }
+          r0 += r1;
+          r2 += r3;
+          r0 += r2;
+          for (unsigned int v = 0; v < nvecs; ++v)
+            for (unsigned int d = 0; d < n_components; ++d)
+              outer_results[i * nvecs + v][d] = r0[d][v];
+        }
+
+      AssertIndexRange(VectorizedArray<Number>::n_array_elements, 17);
+      Assert(16 % nvecs == 0, ExcInternalError());
+      if (n_chunks % VectorizedArray<Number>::n_array_elements != 0)
+        {
+          Tensor<1, n_components, VectorizedArray<Number>> r0, r1;
+          const size_type start_irreg = regular_chunks * nvecs;
+          for (size_type c = start_irreg; c < n_chunks; ++c)
+            for (size_type j = 0; j < 32; j += 2 * nvecs, index += 2 * nvecs)
+              {
+                r0 += op.do_vectorized(index);
+                r1 += op.do_vectorized(index + nvecs);
+              }
+          r0 += r1;
+          for (unsigned int v = 0; v < nvecs; ++v)
+            for (unsigned int d = 0; d < n_components; ++d)
+              outer_results[start_irreg + v][d] = r0[d][v];
+          n_chunks = start_irreg + VectorizedArray<Number>::n_array_elements;
+        }
+    }
+
+
+
 #ifdef DEAL_II_WITH_THREADS
     /**
      * This struct takes the loop range from the tbb parallel for loop and
@@ -1984,6 +2200,46 @@ namespace internal
 
         return sum;
       }
+
+      template <std::size_t n_vectors>
+      static void
+      linear_combination(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &                                          thread_loop_partitioner,
+        const size_type                              size,
+        const Number                                 s,
+        const std::array<Number, n_vectors> &        a,
+        const std::array<const Number *, n_vectors> &v_values,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::Host>
+          &data)
+      {
+        Vectorization_linear_combination<Number, n_vectors> vector_update(
+          data.values.get(), s, a, v_values);
+        parallel_for(vector_update, 0, size, thread_loop_partitioner);
+      }
+
+      template <std::size_t n_vectors, std::size_t n_dots>
+      static Tensor<1, n_dots, Number>
+      linear_combination_and_dot(
+        const std::shared_ptr<::dealii::parallel::internal::TBBPartitioner>
+          &                                          thread_loop_partitioner,
+        const size_type                              size,
+        const Number                                 s,
+        const std::array<Number, n_vectors> &        a,
+        const std::array<const Number *, n_vectors> &v_values,
+        const std::array<const Number *, n_dots> &   w_values,
+        ::dealii::MemorySpace::MemorySpaceData<Number,
+                                               ::dealii::MemorySpace::Host>
+          &data)
+      {
+        Tensor<1, n_dots, Number> sums;
+        LinearCombinationAndDot<Number, n_vectors, n_dots> updater(
+          data.values.get(), s, a, v_values, w_values);
+        parallel_reduce(updater, 0, size, sums, thread_loop_partitioner);
+
+        return sums;
+      }
     };
 
 
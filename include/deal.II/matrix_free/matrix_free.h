@@ -216,7 +216,8 @@ public:
       const bool         initialize_mapping  = true,
       const bool         overlap_communication_computation    = true,
       const bool         hold_all_faces_to_owned_cells        = false,
-      const bool         cell_vectorization_categories_strict = false)
+      const bool         cell_vectorization_categories_strict = false,
+      const bool         use_shared_memory_communication      = false)
       : tasks_parallel_scheme(tasks_parallel_scheme)
       , tasks_block_size(tasks_block_size)
       , mapping_update_flags(mapping_update_flags)
@@ -231,6 +232,7 @@ public:
       , hold_all_faces_to_owned_cells(hold_all_faces_to_owned_cells)
       , cell_vectorization_categories_strict(
           cell_vectorization_categories_strict)
+      , use_shared_memory_communication(use_shared_memory_communication)
     {}
 
     /**
@@ -454,6 +456,16 @@ public:
      * them in a single vectorized array.
      */
     bool cell_vectorization_categories_strict;
+
+    /**
+     * Option to control whether the vector partitioners of this class should
+     * exchange ghost data among the MPI processes on the same compute node
+     * directly through shared memory rather than through MPI messages, see
+     * Utilities::MPI::Partitioner::enable_shared_memory_communication(). The
+     * vectors created by initialize_dof_vector() are then allocated in MPI-3
+     * shared-memory windows. The default is false.
+     */
+    bool use_shared_memory_communication;
   };
 
   /**
@@ -862,9 +862,14 @@ MatrixFree<dim, Number>::initialize_indices(
 
       // set locally owned range for each component
       Assert(locally_owned_set[no].is_contiguous(), ExcNotImplemented());
-      dof_info[no].vector_partitioner.reset(
-        new Utilities::MPI::Partitioner(locally_owned_set[no],
-                                        task_info.communicator));
+      {
+        std::shared_ptr<Utilities::MPI::Partitioner> partitioner(
+          new Utilities::MPI::Partitioner(locally_owned_set[no],
+                                          task_info.communicator));
+        if (additional_data.use_shared_memory_communication)
+          partitioner->enable_shared_memory_communication();
+        dof_info[no].vector_partitioner = partitioner;
+      }
 
       // initialize the arrays for indices
       const unsigned int n_components_total =
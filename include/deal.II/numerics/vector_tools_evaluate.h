@@ -0,0 +1,122 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_vector_tools_evaluate_h
+#define dealii_vector_tools_evaluate_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace VectorTools
+{
+  /**
+   * Evaluate component @p component of the finite element field described by
+   * @p dof_handler and @p vector at the points that @p cache has been set up
+   * with through Utilities::MPI::RemotePointEvaluation::reinit(). Each
+   * process gets the values at its own points, regardless of which process
+   * owns the cells around them. If a point has been found on several cells,
+   * e.g., because it lies on a face, the average of the values on these
+   * cells is returned. Points that have not been found get the value zero,
+   * see Utilities::MPI::RemotePointEvaluation::all_points_found().
+   *
+   * Since the setup of @p cache is done only once, calling this function
+   * repeatedly for the same points, e.g., in every time step, only costs the
+   * evaluation on the local cells and one round of point-to-point messages
+   * with the processes that own the points.
+   *
+   * The values of the shape functions are computed on the reference cell,
+   * so this function can only be used with elements whose shape functions
+   * are defined there, such as FE_Q, FE_DGQ, or FESystem objects of these.
+   * The @p vector must contain the values of the degrees of freedom of all
+   * locally owned cells, i.e., a parallel vector needs to have its ghost
+   * values updated.
+   *
+   * @note This is a collective operation.
+   */
+  template <int dim, int spacedim, typename VectorType>
+  std::vector<typename VectorType::value_type>
+  point_values(
+    const Utilities::MPI::RemotePointEvaluation<dim, spacedim> &cache,
+    const DoFHandler<dim, spacedim> &                           dof_handler,
+    const VectorType &                                          vector,
+    const unsigned int                                          component = 0)
+  {
+    using Number = typename VectorType::value_type;
+    Assert(&dof_handler.get_triangulation() == &cache.get_triangulation(),
+           ExcMessage("The DoFHandler must be based on the triangulation "
+                      "the cache has been set up with."));
+    AssertIndexRange(component, dof_handler.get_fe().n_components());
+
+    const auto evaluate = [&](
+      const ArrayView<Number> &values,
+      const typename Utilities::MPI::RemotePointEvaluation<dim, spacedim>::
+        CellData &cell_data) {
+      const FiniteElement<dim, spacedim> &fe = dof_handler.get_fe();
+      Vector<Number>                      local_values(fe.dofs_per_cell);
+      for (unsigned int c = 0; c < cell_data.cells.size(); ++c)
+        {
+          const typename DoFHandler<dim, spacedim>::active_cell_iterator cell(
+            &cache.get_triangulation(),
+            cell_data.cells[c].first,
+            cell_data.cells[c].second,
+            &dof_handler);
+          cell->get_dof_values(vector, local_values);
+
+          for (unsigned int q = cell_data.reference_point_ptrs[c];
+               q < cell_data.reference_point_ptrs[c + 1];
+               ++q)
+            {
+              Number value = Number();
+              for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+                value += local_values[i] *
+                         fe.shape_value_component(
+                           i, cell_data.reference_point_values[q], component);
+              values[q] = value;
+            }
+        }
+    };
+
+    std::vector<Number> values;
+    cache.template evaluate_and_process<Number>(values, evaluate);
+
+    // average the values of the points found on several cells
+    const std::vector<unsigned int> &point_ptrs = cache.get_point_ptrs();
+    std::vector<Number>              result(point_ptrs.size() - 1);
+    for (unsigned int i = 0; i < result.size(); ++i)
+      if (point_ptrs[i + 1] > point_ptrs[i])
+        {
+          for (unsigned int j = point_ptrs[i]; j < point_ptrs[i + 1]; ++j)
+            result[i] += values[j];
+          result[i] /= static_cast<double>(point_ptrs[i + 1] - point_ptrs[i]);
+        }
+    return result;
+  }
+} // namespace VectorTools
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // dealii_vector_tools_evaluate_h
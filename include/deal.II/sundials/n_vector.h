@@ -0,0 +1,297 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2018 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#ifndef dealii_sundials_n_vector_h
+#define dealii_sundials_n_vector_h
+
+#include <deal.II/base/config.h>
+#ifdef DEAL_II_WITH_SUNDIALS
+
+#  include <deal.II/lac/block_vector.h>
+#  include <deal.II/lac/la_parallel_vector.h>
+#  include <deal.II/lac/vector.h>
+#  include <deal.II/lac/vector_memory.h>
+
+#  include <deal.II/sundials/copy.h>
+
+#  include <sundials/sundials_nvector.h>
+#  ifdef DEAL_II_WITH_MPI
+#    include <nvector/nvector_parallel.h>
+#  endif
+#  include <nvector/nvector_serial.h>
+
+#  include <functional>
+#  include <type_traits>
+
+DEAL_II_NAMESPACE_OPEN
+namespace SUNDIALS
+{
+  namespace internal
+  {
+    /**
+     * Type trait that is true for all vector types for which a native
+     * SUNDIALS N_Vector is provided by make_nvector(). For these types, the
+     * N_Vector does not own any data of its own but stores a pointer to a
+     * deal.II vector, and all N_Vector operations SUNDIALS performs are
+     * forwarded to the (threaded and, where applicable, MPI parallel) vector
+     * operations of deal.II. As a consequence, the SUNDIALS wrappers can hand
+     * the vectors to the user callbacks without copying them.
+     *
+     * For all other vector types, the wrappers fall back to the serial and
+     * parallel N_Vector implementations of SUNDIALS and copy the data with
+     * the functions in copy.h.
+     */
+    template <typename VectorType>
+    struct is_nvector_compatible : std::false_type
+    {};
+
+    template <>
+    struct is_nvector_compatible<Vector<double>> : std::true_type
+    {};
+
+    template <>
+    struct is_nvector_compatible<BlockVector<double>> : std::true_type
+    {};
+
+    template <>
+    struct is_nvector_compatible<LinearAlgebra::distributed::Vector<double>>
+      : std::true_type
+    {};
+
+
+
+    /**
+     * Create a native N_Vector that refers to @p vector. If
+     * @p take_ownership is true, the vector is deleted together with the
+     * N_Vector, i.e., upon a call to N_VDestroy(). Vectors created by
+     * SUNDIALS through N_VClone() always own their data.
+     *
+     * This function is only available for vector types for which
+     * is_nvector_compatible is true.
+     */
+    template <typename VectorType>
+    N_Vector
+    make_nvector(VectorType *vector, const bool take_ownership);
+
+    /**
+     * Return the deal.II vector stored in a native N_Vector that was
+     * created by make_nvector() or cloned from such a vector.
+     */
+    template <typename VectorType>
+    VectorType *
+    unwrap_nvector(N_Vector vector);
+
+
+
+    namespace NVectorImplementation
+    {
+      template <typename VectorType>
+      N_Vector
+      create(const VectorType &model, const MPI_Comm &, std::true_type)
+      {
+        VectorType *vector = new VectorType();
+        vector->reinit(model, /*omit_zeroing_entries = */ false);
+        return make_nvector(vector, true);
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      create(const VectorType &model,
+             const MPI_Comm &  communicator,
+             std::false_type)
+      {
+        (void)communicator;
+        const std::size_t global_size = model.size();
+#  ifdef DEAL_II_WITH_MPI
+        if (is_serial_vector<VectorType>::value == false)
+          {
+            const std::size_t local_size =
+              model.locally_owned_elements().n_elements();
+            return N_VNew_Parallel(communicator, local_size, global_size);
+          }
+        else
+#  endif
+          {
+            Assert(is_serial_vector<VectorType>::value,
+                   ExcInternalError(
+                     "Trying to use a serial code with a parallel vector."));
+            return N_VNew_Serial(global_size);
+          }
+      }
+
+
+
+      template <typename VectorType>
+      void
+      copy(VectorType &dst, N_Vector src, std::true_type)
+      {
+        dst = *unwrap_nvector<VectorType>(src);
+      }
+
+
+
+      template <typename VectorType>
+      void
+      copy(VectorType &dst, N_Vector src, std::false_type)
+      {
+        internal::copy(dst, src);
+      }
+
+
+
+      template <typename VectorType>
+      void
+      copy(N_Vector dst, const VectorType &src, std::true_type)
+      {
+        *unwrap_nvector<VectorType>(dst) = src;
+      }
+
+
+
+      template <typename VectorType>
+      void
+      copy(N_Vector dst, const VectorType &src, std::false_type)
+      {
+        internal::copy(dst, src);
+      }
+    } // namespace NVectorImplementation
+
+
+
+    /**
+     * Create an N_Vector with the same layout as @p model. For vector types
+     * that are compatible with the native N_Vector, the result owns a new
+     * deal.II vector; otherwise, a serial or parallel SUNDIALS vector (the
+     * latter over @p communicator) of the appropriate local size is created.
+     * In either case, the result has to be freed with N_VDestroy().
+     */
+    template <typename VectorType>
+    N_Vector
+    create_nvector(const VectorType &model, const MPI_Comm &communicator)
+    {
+      return NVectorImplementation::create(
+        model, communicator, is_nvector_compatible<VectorType>());
+    }
+
+    /**
+     * Copy the content of the N_Vector @p src, created by create_nvector(),
+     * into @p dst.
+     */
+    template <typename VectorType>
+    void
+    copy_from_nvector(VectorType &dst, N_Vector src)
+    {
+      NVectorImplementation::copy(dst,
+                                  src,
+                                  is_nvector_compatible<VectorType>());
+    }
+
+    /**
+     * Copy @p src into the N_Vector @p dst, created by create_nvector().
+     */
+    template <typename VectorType>
+    void
+    copy_to_nvector(N_Vector dst, const VectorType &src)
+    {
+      NVectorImplementation::copy(dst,
+                                  src,
+                                  is_nvector_compatible<VectorType>());
+    }
+
+
+
+    /**
+     * A view of an N_Vector handed to one of the callbacks of the SUNDIALS
+     * wrappers as a deal.II vector. For native N_Vectors this is simply a
+     * reference to the underlying vector. For all other vector types, a
+     * temporary vector is taken from a GrowingVectorMemory pool, initialized
+     * with the function @p reinit_vector of the wrapper, and filled with the
+     * values of the N_Vector if @p import_values is true. Results written
+     * into the view must then be transferred back with export_values().
+     */
+    template <typename VectorType>
+    class NVectorView
+    {
+    public:
+      /**
+       * Constructor.
+       */
+      NVectorView(N_Vector                                 vector,
+                  const std::function<void(VectorType &)> &reinit_vector,
+                  const bool import_values = true)
+        : nvector(vector)
+        , view(nullptr)
+      {
+        initialize(reinit_vector,
+                   import_values,
+                   is_nvector_compatible<VectorType>());
+      }
+
+      /**
+       * Access the vector.
+       */
+      VectorType &operator*()
+      {
+        return *view;
+      }
+
+      /**
+       * Write the content of the view back into the N_Vector. This is a
+       * no-op for native N_Vectors.
+       */
+      void
+      export_values()
+      {
+        if (view != memory_pointer.get())
+          return;
+        NVectorImplementation::copy(nvector,
+                                    static_cast<const VectorType &>(*view),
+                                    is_nvector_compatible<VectorType>());
+      }
+
+    private:
+      void
+      initialize(const std::function<void(VectorType &)> &,
+                 const bool,
+                 std::true_type)
+      {
+        view = unwrap_nvector<VectorType>(nvector);
+      }
+
+      void
+      initialize(const std::function<void(VectorType &)> &reinit_vector,
+                 const bool                               import_values,
+                 std::false_type)
+      {
+        memory_pointer = typename VectorMemory<VectorType>::Pointer(memory);
+        view           = memory_pointer.get();
+        reinit_vector(*view);
+        if (import_values)
+          NVectorImplementation::copy(*view, nvector, std::false_type());
+      }
+
+      N_Vector                                   nvector;
+      GrowingVectorMemory<VectorType>            memory;
+      typename VectorMemory<VectorType>::Pointer memory_pointer;
+      VectorType *                               view;
+    };
+  } // namespace internal
+} // namespace SUNDIALS
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SUNDIALS
+#endif // dealii_sundials_n_vector_h
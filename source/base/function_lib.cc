@@ -49,9 +49,9 @@ namespace Functions
 
   template <int dim>
   void
-  SquareFunction<dim>::value_list(const std::vector<Point<dim>> &points,
-                                  std::vector<double> &          values,
-                                  const unsigned int) const
+  SquareFunction<dim>::value_batch(const ArrayView<const Point<dim>> &points,
+                                   const ArrayView<double> &          values,
+                                   const unsigned int) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
@@ -136,9 +136,9 @@ namespace Functions
 
   template <int dim>
   void
-  Q1WedgeFunction<dim>::value_list(const std::vector<Point<dim>> &points,
-                                   std::vector<double> &          values,
-                                   const unsigned int) const
+  Q1WedgeFunction<dim>::value_batch(const ArrayView<const Point<dim>> &points,
+                                    const ArrayView<double> &          values,
+                                    const unsigned int) const
   {
     Assert(dim >= 2, ExcInternalError());
     Assert(values.size() == points.size(),
@@ -277,9 +277,9 @@ namespace Functions
 
   template <int dim>
   void
-  PillowFunction<dim>::value_list(const std::vector<Point<dim>> &points,
-                                  std::vector<double> &          values,
-                                  const unsigned int) const
+  PillowFunction<dim>::value_batch(const ArrayView<const Point<dim>> &points,
+                                   const ArrayView<double> &          values,
+                                   const unsigned int) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
@@ -451,9 +451,9 @@ namespace Functions
 
   template <int dim>
   void
-  CosineFunction<dim>::value_list(const std::vector<Point<dim>> &points,
-                                  std::vector<double> &          values,
-                                  const unsigned int) const
+  CosineFunction<dim>::value_batch(const ArrayView<const Point<dim>> &points,
+                                   const ArrayView<double> &          values,
+                                   const unsigned int) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
@@ -779,9 +779,10 @@ namespace Functions
 
   template <int dim>
   void
-  CosineGradFunction<dim>::value_list(const std::vector<Point<dim>> &points,
-                                      std::vector<double> &          values,
-                                      const unsigned int             d) const
+  CosineGradFunction<dim>::value_batch(
+    const ArrayView<const Point<dim>> &points,
+    const ArrayView<double> &          values,
+    const unsigned int                 d) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
@@ -1034,9 +1035,9 @@ namespace Functions
 
   template <int dim>
   void
-  ExpFunction<dim>::value_list(const std::vector<Point<dim>> &points,
-                               std::vector<double> &          values,
-                               const unsigned int) const
+  ExpFunction<dim>::value_batch(const ArrayView<const Point<dim>> &points,
+                                const ArrayView<double> &          values,
+                                const unsigned int) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
@@ -1186,9 +1187,9 @@ namespace Functions
 
 
   void
-  LSingularityFunction::value_list(const std::vector<Point<2>> &points,
-                                   std::vector<double> &        values,
-                                   const unsigned int) const
+  LSingularityFunction::value_batch(const ArrayView<const Point<2>> &points,
+                                    const ArrayView<double> &        values,
+                                    const unsigned int) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
@@ -1357,9 +1358,9 @@ namespace Functions
 
 
   void
-  LSingularityGradFunction::value_list(const std::vector<Point<2>> &points,
-                                       std::vector<double> &        values,
-                                       const unsigned int           d) const
+  LSingularityGradFunction::value_batch(const ArrayView<const Point<2>> &points,
+                                        const ArrayView<double> &        values,
+                                        const unsigned int d) const
   {
     AssertIndexRange(d, 2);
     AssertDimension(values.size(), points.size());
@@ -1476,9 +1477,9 @@ namespace Functions
 
   template <int dim>
   void
-  SlitSingularityFunction<dim>::value_list(
-    const std::vector<Point<dim>> &points,
-    std::vector<double> &          values,
+  SlitSingularityFunction<dim>::value_batch(
+    const ArrayView<const Point<dim>> &points,
+    const ArrayView<double> &          values,
     const unsigned int) const
   {
     Assert(values.size() == points.size(),
@@ -1645,9 +1646,10 @@ namespace Functions
 
 
   void
-  SlitHyperSingularityFunction::value_list(const std::vector<Point<2>> &points,
-                                           std::vector<double> &        values,
-                                           const unsigned int) const
+  SlitHyperSingularityFunction::value_batch(
+    const ArrayView<const Point<2>> &points,
+    const ArrayView<double> &        values,
+    const unsigned int) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
@@ -1824,9 +1826,9 @@ namespace Functions
 
   template <int dim>
   void
-  JumpFunction<dim>::value_list(const std::vector<Point<dim>> &p,
-                                std::vector<double> &          values,
-                                const unsigned int) const
+  JumpFunction<dim>::value_batch(const ArrayView<const Point<dim>> &p,
+                                 const ArrayView<double> &          values,
+                                 const unsigned int) const
   {
     Assert(values.size() == p.size(),
            ExcDimensionMismatch(values.size(), p.size()));
@@ -2251,9 +2253,9 @@ namespace Functions
 
   template <int dim>
   void
-  Monomial<dim>::value_list(const std::vector<Point<dim>> &points,
-                            std::vector<double> &          values,
-                            const unsigned int             component) const
+  Monomial<dim>::value_batch(const ArrayView<const Point<dim>> &points,
+                             const ArrayView<double> &          values,
+                             const unsigned int                 component) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
@@ -2286,9 +2288,9 @@ namespace Functions
 
   template <int dim>
   void
-  Bessel1<dim>::value_list(const std::vector<Point<dim>> &points,
-                           std::vector<double> &          values,
-                           const unsigned int) const
+  Bessel1<dim>::value_batch(const ArrayView<const Point<dim>> &points,
+                            const ArrayView<double> &          values,
+                            const unsigned int) const
   {
     Assert(dim == 2, ExcNotImplemented());
     AssertDimension(points.size(), values.size());
@@ -2718,9 +2720,9 @@ namespace Functions
 
   template <int dim>
   void
-  Polynomial<dim>::value_list(const std::vector<Point<dim>> &points,
-                              std::vector<double> &          values,
-                              const unsigned int             component) const
+  Polynomial<dim>::value_batch(const ArrayView<const Point<dim>> &points,
+                               const ArrayView<double> &          values,
+                               const unsigned int component) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
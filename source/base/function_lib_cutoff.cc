@@ -79,9 +79,10 @@ namespace Functions
 
   template <int dim>
   void
-  CutOffFunctionLinfty<dim>::value_list(const std::vector<Point<dim>> &points,
-                                        std::vector<double> &          values,
-                                        const unsigned int component) const
+  CutOffFunctionLinfty<dim>::value_batch(
+    const ArrayView<const Point<dim>> &points,
+    const ArrayView<double> &          values,
+    const unsigned int                 component) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
@@ -148,9 +149,9 @@ namespace Functions
 
   template <int dim>
   void
-  CutOffFunctionW1<dim>::value_list(const std::vector<Point<dim>> &points,
-                                    std::vector<double> &          values,
-                                    const unsigned int component) const
+  CutOffFunctionW1<dim>::value_batch(const ArrayView<const Point<dim>> &points,
+                                     const ArrayView<double> &          values,
+                                     const unsigned int component) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
@@ -223,9 +224,10 @@ namespace Functions
 
   template <int dim>
   void
-  CutOffFunctionCinfty<dim>::value_list(const std::vector<Point<dim>> &points,
-                                        std::vector<double> &          values,
-                                        const unsigned int component) const
+  CutOffFunctionCinfty<dim>::value_batch(
+    const ArrayView<const Point<dim>> &points,
+    const ArrayView<double> &          values,
+    const unsigned int                 component) const
   {
     Assert(values.size() == points.size(),
            ExcDimensionMismatch(values.size(), points.size()));
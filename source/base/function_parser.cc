@@ -23,6 +23,7 @@
 
 #include <boost/random.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 
@@ -42,6 +43,14 @@ namespace fparser
 DEAL_II_NAMESPACE_OPEN
 
 
+template <int dim>
+const unsigned int FunctionParser<dim>::max_bulk_size;
+
+template <int dim>
+const unsigned int FunctionParser<dim>::min_bulk_size;
+
+
+
 template <int dim>
 const std::vector<std::string> &
 FunctionParser<dim>::get_expressions() const
@@ -285,7 +294,7 @@ FunctionParser<dim>::init_muparser() const
   // initialize the objects for the current thread (fp.get() and
   // vars.get())
   fp.get().reserve(this->n_components);
-  vars.get().resize(var_names.size());
+  vars.get().resize(var_names.size() * max_bulk_size);
   for (unsigned int component = 0; component < this->n_components; ++component)
     {
       fp.get().emplace_back(new mu::Parser());
@@ -299,7 +308,8 @@ FunctionParser<dim>::init_muparser() const
         }
 
       for (unsigned int iv = 0; iv < var_names.size(); ++iv)
-        fp.get()[component]->DefineVar(var_names[iv], &vars.get()[iv]);
+        fp.get()[component]->DefineVar(var_names[iv],
+                                       &vars.get()[iv * max_bulk_size]);
 
       // define some compatibility functions:
       fp.get()[component]->DefineFun("if", internal::mu_if, true);
@@ -443,9 +453,9 @@ FunctionParser<dim>::value(const Point<dim> & p,
     init_muparser();
 
   for (unsigned int i = 0; i < dim; ++i)
-    vars.get()[i] = p(i);
+    vars.get()[i * max_bulk_size] = p(i);
   if (dim != n_vars)
-    vars.get()[dim] = this->get_time();
+    vars.get()[dim * max_bulk_size] = this->get_time();
 
   try
     {
@@ -480,14 +490,134 @@ FunctionParser<dim>::vector_value(const Point<dim> &p,
     init_muparser();
 
   for (unsigned int i = 0; i < dim; ++i)
-    vars.get()[i] = p(i);
+    vars.get()[i * max_bulk_size] = p(i);
   if (dim != n_vars)
-    vars.get()[dim] = this->get_time();
+    vars.get()[dim * max_bulk_size] = this->get_time();
 
   for (unsigned int component = 0; component < this->n_components; ++component)
     values(component) = fp.get()[component]->Eval();
 }
 
+
+
+template <int dim>
+void
+FunctionParser<dim>::set_bulk_variables(
+  const ArrayView<const Point<dim>> &points,
+  const unsigned int                 begin,
+  const unsigned int                 n_points) const
+{
+  std::vector<double> &variables = vars.get();
+  for (unsigned int d = 0; d < dim; ++d)
+    for (unsigned int j = 0; j < n_points; ++j)
+      variables[d * max_bulk_size + j] = points[begin + j][d];
+  if (dim != n_vars)
+    std::fill(variables.begin() + dim * max_bulk_size,
+              variables.begin() + dim * max_bulk_size + n_points,
+              this->get_time());
+}
+
+
+
+template <int dim>
+void
+FunctionParser<dim>::value_batch(const ArrayView<const Point<dim>> &points,
+                                 const ArrayView<double> &          values,
+                                 const unsigned int component) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  Assert(component < this->n_components,
+         ExcIndexRange(component, 0, this->n_components));
+  Assert(values.size() == points.size(),
+         ExcDimensionMismatch(values.size(), points.size()));
+
+  if (points.size() < min_bulk_size)
+    {
+      for (unsigned int i = 0; i < points.size(); ++i)
+        values[i] = value(points[i], component);
+      return;
+    }
+
+  // initialize the parser if that hasn't happened yet on the current thread
+  if (fp.get().size() == 0)
+    init_muparser();
+
+  // split the points into blocks of about equal size, rather than filling
+  // up all but the last block, to keep the overhead of recreating the byte
+  // code small for all blocks
+  const unsigned int n_blocks =
+    (points.size() + max_bulk_size - 1) / max_bulk_size;
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      const unsigned int begin    = points.size() * block / n_blocks;
+      const unsigned int n_points =
+        points.size() * (block + 1) / n_blocks - begin;
+      set_bulk_variables(points, begin, n_points);
+
+      try
+        {
+          fp.get()[component]->Eval(&values[begin], n_points);
+        }
+      catch (mu::ParserError &e)
+        {
+          std::cerr << "Message:  <" << e.GetMsg() << ">\n";
+          std::cerr << "Formula:  <" << e.GetExpr() << ">\n";
+          std::cerr << "Token:    <" << e.GetToken() << ">\n";
+          std::cerr << "Position: <" << e.GetPos() << ">\n";
+          std::cerr << "Errc:     <" << e.GetCode() << ">" << std::endl;
+          AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+        }
+    }
+}
+
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(
+  const std::vector<Point<dim>> &points,
+  std::vector<Vector<double>> &  values) const
+{
+  Assert(initialized == true, ExcNotInitialized());
+  Assert(values.size() == points.size(),
+         ExcDimensionMismatch(values.size(), points.size()));
+
+  if (points.size() < min_bulk_size)
+    {
+      for (unsigned int i = 0; i < points.size(); ++i)
+        vector_value(points[i], values[i]);
+      return;
+    }
+
+  // initialize the parser if that hasn't happened yet on the current thread
+  if (fp.get().size() == 0)
+    init_muparser();
+
+  std::vector<double> component_values(max_bulk_size);
+  const unsigned int  n_blocks =
+    (points.size() + max_bulk_size - 1) / max_bulk_size;
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      const unsigned int begin    = points.size() * block / n_blocks;
+      const unsigned int n_points =
+        points.size() * (block + 1) / n_blocks - begin;
+      set_bulk_variables(make_array_view(points), begin, n_points);
+
+      for (unsigned int component = 0; component < this->n_components;
+           ++component)
+        {
+          fp.get()[component]->Eval(component_values.data(), n_points);
+          for (unsigned int j = 0; j < n_points; ++j)
+            {
+              Assert(values[begin + j].size() == this->n_components,
+                     ExcDimensionMismatch(values[begin + j].size(),
+                                          this->n_components));
+              values[begin + j](component) = component_values[j];
+            }
+        }
+    }
+}
+
 #else
 
 
@@ -530,6 +660,26 @@ FunctionParser<dim>::vector_value(const Point<dim> &, Vector<double> &) const
 }
 
 
+
+template <int dim>
+void
+FunctionParser<dim>::value_batch(const ArrayView<const Point<dim>> &,
+                                 const ArrayView<double> &,
+                                 const unsigned int) const
+{
+  Assert(false, ExcNeedsFunctionparser());
+}
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(const std::vector<Point<dim>> &,
+                                       std::vector<Vector<double>> &) const
+{
+  Assert(false, ExcNeedsFunctionparser());
+}
+
+
 #endif
 
 // Explicit Instantiations.
@@ -16,7 +16,10 @@
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 
+#include <limits>
 #include <vector>
 
 #ifdef DEAL_II_WITH_TRILINOS
@@ -42,6 +45,7 @@ IndexSet::IndexSet(const Epetra_BlockMap &map)
   : is_compressed(true)
   , index_space_size(1 + map.MaxAllGID64())
   , largest_range(numbers::invalid_unsigned_int)
+  , bitmap_offset(0)
 {
   Assert(map.MinAllGID64() == 0,
          ExcMessage(
@@ -69,6 +73,7 @@ IndexSet::IndexSet(const Epetra_BlockMap &map)
   : is_compressed(true)
   , index_space_size(1 + map.MaxAllGID())
   , largest_range(numbers::invalid_unsigned_int)
+  , bitmap_offset(0)
 {
   Assert(map.MinAllGID() == 0,
          ExcMessage(
@@ -133,6 +138,10 @@ IndexSet::do_compress() const
   // which itself calls the current function)
   std::lock_guard<std::mutex> lock(compress_mutex);
 
+  // another thread may have compressed the set while we waited for the lock
+  if (is_compressed.load(std::memory_order_relaxed) == true)
+    return;
+
   // see if any of the contiguous ranges can be merged. do not use
   // std::vector::erase in-place as it is quadratic in the number of
   // ranges. since the ranges are sorted by their first index, determining
@@ -179,7 +188,11 @@ IndexSet::do_compress() const
           largest_range      = i - ranges.begin();
         }
     }
-  is_compressed = true;
+  build_bitmap();
+
+  // only now flag the set as compressed: this releases the data computed
+  // above to the threads that check the flag in compress() without locking
+  is_compressed.store(true, std::memory_order_release);
 
   // check that next_index is correct. needs to be after the previous
   // statement because we otherwise will get into an endless loop
@@ -188,46 +201,259 @@ IndexSet::do_compress() const
 
 
 
-IndexSet IndexSet::operator&(const IndexSet &is) const
+void
+IndexSet::build_bitmap() const
 {
-  Assert(size() == is.size(), ExcDimensionMismatch(size(), is.size()));
+  bitmap.clear();
+  bitmap_rank.clear();
+  bitmap_offset = 0;
 
-  compress();
-  is.compress();
+  // only use a bitmap for sets with many ranges and if the bitmap with the
+  // ranks of its blocks does not need more memory than the ranges
+  if (ranges.size() < 64)
+    return;
+  const size_type first_index = ranges.front().begin / 64 * 64;
+  const size_type n_words     = (ranges.back().end - first_index + 63) / 64;
+  const size_type n_blocks =
+    (n_words + bitmap_block_size - 1) / bitmap_block_size;
+  if (n_words * sizeof(std::uint64_t) + n_blocks * sizeof(size_type) >
+      ranges.size() * sizeof(Range))
+    return;
 
-  std::vector<Range>::const_iterator r1 = ranges.begin(),
-                                     r2 = is.ranges.begin();
-  IndexSet result(size());
+  bitmap_offset = first_index;
+  bitmap.resize(n_words, 0);
+  for (const Range &range : ranges)
+    {
+      const size_type begin = range.begin - bitmap_offset;
+      const size_type end   = range.end - bitmap_offset;
+      const size_type first_full_word = (begin + 63) / 64;
+      const size_type last_full_word  = end / 64;
+      if (first_full_word > last_full_word)
+        {
+          // the range lies within a single word
+          for (size_type bit = begin; bit < end; ++bit)
+            bitmap[bit / 64] |= std::uint64_t(1) << (bit % 64);
+          continue;
+        }
+      for (size_type bit = begin; bit < 64 * first_full_word; ++bit)
+        bitmap[bit / 64] |= std::uint64_t(1) << (bit % 64);
+      for (size_type word = first_full_word; word < last_full_word; ++word)
+        bitmap[word] = ~std::uint64_t(0);
+      for (size_type bit = 64 * last_full_word; bit < end; ++bit)
+        bitmap[bit / 64] |= std::uint64_t(1) << (bit % 64);
+    }
 
-  while ((r1 != ranges.end()) && (r2 != is.ranges.end()))
+  bitmap_rank.resize(n_blocks);
+  size_type n_elements_before = 0;
+  for (size_type word = 0; word < n_words; ++word)
     {
-      // if r1 and r2 do not overlap at all, then move the pointer that sits
-      // to the left of the other up by one
-      if (r1->end <= r2->begin)
-        ++r1;
-      else if (r2->end <= r1->begin)
-        ++r2;
-      else
+      if (word % bitmap_block_size == 0)
+        bitmap_rank[word / bitmap_block_size] = n_elements_before;
+      n_elements_before += std::bitset<64>(bitmap[word]).count();
+    }
+  Assert(n_elements_before ==
+           ranges.back().nth_index_in_set + ranges.back().end -
+             ranges.back().begin,
+         ExcInternalError());
+}
+
+
+
+std::vector<IndexSet::Range>
+IndexSet::combine_ranges(const std::vector<Range> &ranges_1,
+                         const std::vector<Range> &ranges_2,
+                         const size_type           offset_2,
+                         const SetOperation        operation)
+{
+  // split the work only if both lists are long enough to make up for the
+  // overhead of starting tasks
+  const std::size_t  grain_size = 4096;
+  const unsigned int n_windows  = std::min<std::size_t>(
+    4 * MultithreadInfo::n_threads(),
+    (ranges_1.size() + ranges_2.size()) / grain_size);
+
+  std::vector<Range> result;
+  if (n_windows <= 1)
+    {
+      combine_ranges_in_window(ranges_1,
+                               ranges_2,
+                               offset_2,
+                               operation,
+                               0,
+                               std::numeric_limits<size_type>::max(),
+                               result);
+      return result;
+    }
+
+  // split the index space at the beginnings of evenly spaced ranges of the
+  // longer list. since the ranges are compressed, these are strictly
+  // increasing
+  const bool use_first = (ranges_1.size() >= ranges_2.size());
+  const std::vector<Range> &splitting_ranges = use_first ? ranges_1 : ranges_2;
+  const size_type           splitting_offset = use_first ? 0 : offset_2;
+  std::vector<size_type>    splits(n_windows + 1);
+  splits[0]         = 0;
+  splits[n_windows] = std::numeric_limits<size_type>::max();
+  for (unsigned int w = 1; w < n_windows; ++w)
+    splits[w] =
+      splitting_ranges[w * splitting_ranges.size() / n_windows].begin +
+      splitting_offset;
+
+  std::vector<std::vector<Range>> window_results(n_windows);
+  parallel::apply_to_subranges(
+    0U,
+    n_windows,
+    [&](const unsigned int begin, const unsigned int end) {
+      for (unsigned int w = begin; w < end; ++w)
+        combine_ranges_in_window(ranges_1,
+                                 ranges_2,
+                                 offset_2,
+                                 operation,
+                                 splits[w],
+                                 splits[w + 1],
+                                 window_results[w]);
+    },
+    1);
+
+  std::size_t n_ranges = 0;
+  for (const std::vector<Range> &window_result : window_results)
+    n_ranges += window_result.size();
+  result.reserve(n_ranges);
+  for (const std::vector<Range> &window_result : window_results)
+    result.insert(result.end(), window_result.begin(), window_result.end());
+  return result;
+}
+
+
+
+void
+IndexSet::combine_ranges_in_window(const std::vector<Range> &ranges_1,
+                                   const std::vector<Range> &ranges_2,
+                                   const size_type           offset_2,
+                                   const SetOperation        operation,
+                                   const size_type           window_begin,
+                                   const size_type           window_end,
+                                   std::vector<Range> &      result)
+{
+  // find the first ranges that end within the window, and clip all ranges
+  // to the window as we go
+  std::vector<Range>::const_iterator r1 =
+    std::partition_point(ranges_1.begin(),
+                         ranges_1.end(),
+                         [window_begin](const Range &r) {
+                           return r.end <= window_begin;
+                         });
+  std::vector<Range>::const_iterator r2 =
+    std::partition_point(ranges_2.begin(),
+                         ranges_2.end(),
+                         [window_begin, offset_2](const Range &r) {
+                           return r.end + offset_2 <= window_begin;
+                         });
+  const auto at_end_1 = [&]() {
+    return r1 == ranges_1.end() || r1->begin >= window_end;
+  };
+  const auto at_end_2 = [&]() {
+    return r2 == ranges_2.end() || r2->begin + offset_2 >= window_end;
+  };
+  const auto begin_1 = [&]() { return std::max(r1->begin, window_begin); };
+  const auto end_1   = [&]() { return std::min(r1->end, window_end); };
+  const auto begin_2 = [&]() {
+    return std::max(r2->begin + offset_2, window_begin);
+  };
+  const auto end_2 = [&]() { return std::min(r2->end + offset_2, window_end); };
+
+  switch (operation)
+    {
+      case SetOperation::intersection:
         {
-          // the ranges must overlap somehow
-          Assert(((r1->begin <= r2->begin) && (r1->end > r2->begin)) ||
-                   ((r2->begin <= r1->begin) && (r2->end > r1->begin)),
-                 ExcInternalError());
-
-          // add the overlapping range to the result
-          result.add_range(std::max(r1->begin, r2->begin),
-                           std::min(r1->end, r2->end));
-
-          // now move that iterator that ends earlier one up. note that it has
-          // to be this one because a subsequent range may still have a chance
-          // of overlapping with the range that ends later
-          if (r1->end <= r2->end)
-            ++r1;
-          else
-            ++r2;
+          while (!at_end_1() && !at_end_2())
+            {
+              // if r1 and r2 do not overlap at all, then move the pointer that
+              // sits to the left of the other up by one
+              if (end_1() <= begin_2())
+                ++r1;
+              else if (end_2() <= begin_1())
+                ++r2;
+              else
+                {
+                  // add the overlapping range to the result
+                  result.emplace_back(std::max(begin_1(), begin_2()),
+                                      std::min(end_1(), end_2()));
+
+                  // now move that iterator that ends earlier one up. note that
+                  // it has to be this one because a subsequent range may still
+                  // have a chance of overlapping with the range that ends later
+                  if (end_1() <= end_2())
+                    ++r1;
+                  else
+                    ++r2;
+                }
+            }
+          break;
+        }
+
+      case SetOperation::set_union:
+        {
+          // merge the two sorted lists, taking the ranges with the smaller
+          // first index first. overlapping ranges are merged by compress()
+          while (!at_end_1() || !at_end_2())
+            if (at_end_2() || (!at_end_1() && begin_1() <= begin_2()))
+              {
+                result.emplace_back(begin_1(), end_1());
+                ++r1;
+              }
+            else
+              {
+                result.emplace_back(begin_2(), end_2());
+                ++r2;
+              }
+          break;
+        }
+
+      case SetOperation::difference:
+        {
+          for (; !at_end_1(); ++r1)
+            {
+              size_type       begin = begin_1();
+              const size_type end   = end_1();
+
+              // skip the ranges of the second list before the current range
+              // and cut out the ones that overlap with it
+              while (!at_end_2() && end_2() <= begin)
+                ++r2;
+              for (std::vector<Range>::const_iterator p = r2;
+                   p != ranges_2.end() && p->begin + offset_2 < end &&
+                   begin < end;
+                   ++p)
+                {
+                  if (p->begin + offset_2 > begin)
+                    result.emplace_back(begin, p->begin + offset_2);
+                  begin = std::max(begin, p->end + offset_2);
+                }
+              if (begin < end)
+                result.emplace_back(begin, end);
+            }
+          break;
         }
+
+      default:
+        Assert(false, ExcNotImplemented());
     }
+}
+
+
+
+IndexSet IndexSet::operator&(const IndexSet &is) const
+{
+  Assert(size() == is.size(), ExcDimensionMismatch(size(), is.size()));
 
+  compress();
+  is.compress();
+
+  IndexSet result(size());
+  result.ranges =
+    combine_ranges(ranges, is.ranges, 0, SetOperation::intersection);
+  result.is_compressed = false;
   result.compress();
   return result;
 }
@@ -268,68 +494,9 @@ IndexSet::subtract_set(const IndexSet &other)
 {
   compress();
   other.compress();
-  is_compressed = false;
-
-
-  // we save new ranges to be added to our IndexSet in an temporary vector and
-  // add all of them in one go at the end.
-  std::vector<Range> new_ranges;
-
-  std::vector<Range>::iterator own_it   = ranges.begin();
-  std::vector<Range>::iterator other_it = other.ranges.begin();
-
-  while (own_it != ranges.end() && other_it != other.ranges.end())
-    {
-      // advance own iterator until we get an overlap
-      if (own_it->end <= other_it->begin)
-        {
-          ++own_it;
-          continue;
-        }
-      // we are done with other_it, so advance
-      if (own_it->begin >= other_it->end)
-        {
-          ++other_it;
-          continue;
-        }
-
-      // Now own_it and other_it overlap.  First save the part of own_it that
-      // is before other_it (if not empty).
-      if (own_it->begin < other_it->begin)
-        {
-          Range r(own_it->begin, other_it->begin);
-          r.nth_index_in_set = 0; // fix warning of unused variable
-          new_ranges.push_back(r);
-        }
-      // change own_it to the sub range behind other_it. Do not delete own_it
-      // in any case. As removal would invalidate iterators, we just shrink
-      // the range to an empty one.
-      own_it->begin = other_it->end;
-      if (own_it->begin > own_it->end)
-        {
-          own_it->begin = own_it->end;
-          ++own_it;
-        }
-
-      // continue without advancing iterators, the right one will be advanced
-      // next.
-    }
-
-  // Now delete all empty ranges we might
-  // have created.
-  for (std::vector<Range>::iterator it = ranges.begin(); it != ranges.end();)
-    {
-      if (it->begin >= it->end)
-        it = ranges.erase(it);
-      else
-        ++it;
-    }
-
-  // done, now add the temporary ranges
-  const std::vector<Range>::iterator end = new_ranges.end();
-  for (std::vector<Range>::iterator it = new_ranges.begin(); it != end; ++it)
-    add_range(it->begin, it->end);
 
+  ranges = combine_ranges(ranges, other.ranges, 0, SetOperation::difference);
+  is_compressed = false;
   compress();
 }
 
@@ -348,6 +515,10 @@ IndexSet::pop_back()
   if (ranges.back().begin == ranges.back().end)
     ranges.pop_back();
 
+  // the bitmap, if any, still contains the index
+  if (bitmap.empty() == false)
+    is_compressed = false;
+
   return index;
 }
 
@@ -390,40 +561,8 @@ IndexSet::add_indices(const IndexSet &other, const unsigned int offset)
   compress();
   other.compress();
 
-  std::vector<Range>::const_iterator r1 = ranges.begin(),
-                                     r2 = other.ranges.begin();
-
-  std::vector<Range> new_ranges;
-  // just get the start and end of the ranges right in this method, everything
-  // else will be done in compress()
-  while (r1 != ranges.end() || r2 != other.ranges.end())
-    {
-      // the two ranges do not overlap or we are at the end of one of the
-      // ranges
-      if (r2 == other.ranges.end() ||
-          (r1 != ranges.end() && r1->end < (r2->begin + offset)))
-        {
-          new_ranges.push_back(*r1);
-          ++r1;
-        }
-      else if (r1 == ranges.end() || (r2->end + offset) < r1->begin)
-        {
-          new_ranges.emplace_back(r2->begin + offset, r2->end + offset);
-          ++r2;
-        }
-      else
-        {
-          // ok, we do overlap, so just take the combination of the current
-          // range (do not bother to merge with subsequent ranges)
-          Range next(std::min(r1->begin, r2->begin + offset),
-                     std::max(r1->end, r2->end + offset));
-          new_ranges.push_back(next);
-          ++r1;
-          ++r2;
-        }
-    }
-  ranges.swap(new_ranges);
-
+  ranges =
+    combine_ranges(ranges, other.ranges, offset, SetOperation::set_union);
   is_compressed = false;
   compress();
 }
@@ -496,7 +635,9 @@ IndexSet::block_read(std::istream &in)
     in.read(reinterpret_cast<char *>(&*ranges.begin()),
             ranges.size() * sizeof(Range));
 
-  do_compress(); // needed so that largest_range can be recomputed
+  // needed so that largest_range and the bitmap can be recomputed
+  is_compressed = false;
+  do_compress();
 }
 
 
@@ -657,8 +798,10 @@ std::size_t
 IndexSet::memory_consumption() const
 {
   return (MemoryConsumption::memory_consumption(ranges) +
-          MemoryConsumption::memory_consumption(is_compressed) +
+          sizeof(is_compressed) +
           MemoryConsumption::memory_consumption(index_space_size) +
+          MemoryConsumption::memory_consumption(bitmap) +
+          MemoryConsumption::memory_consumption(bitmap_rank) +
           sizeof(compress_mutex));
 }
 
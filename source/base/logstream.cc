@@ -381,7 +381,7 @@ LogStream::log_thread_id(const bool flag)
 std::stack<std::string> &
 LogStream::get_prefixes() const
 {
-#ifdef DEAL_II_WITH_THREADS
+#if defined(DEAL_II_WITH_THREADS) || defined(DEAL_II_USE_THREAD_POOL)
   bool                     exists         = false;
   std::stack<std::string> &local_prefixes = prefixes.get(exists);
 
@@ -389,13 +389,11 @@ LogStream::get_prefixes() const
   // from the initial thread that created logstream.
   if (!exists)
     {
-      const tbb::enumerable_thread_specific<std::stack<std::string>> &impl =
-        prefixes.get_implementation();
+      const auto &impl = prefixes.get_implementation();
 
       // The thread that created this LogStream object should be the first
-      // in tbb's enumerable_thread_specific container.
-      const tbb::enumerable_thread_specific<
-        std::stack<std::string>>::const_iterator first_elem = impl.begin();
+      // in the container of thread-local objects.
+      const auto first_elem = impl.begin();
 
       if (first_elem != impl.end())
         {
@@ -15,6 +15,7 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/index_set.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
 #include <deal.II/base/multithread_info.h>
@@ -356,6 +357,155 @@ namespace Utilities
 
 
 
+    std::vector<unsigned int>
+    compute_index_owner(const IndexSet &owned_indices,
+                        const IndexSet &indices_to_look_up,
+                        const MPI_Comm &mpi_comm)
+    {
+      Assert(owned_indices.size() == indices_to_look_up.size(),
+             ExcDimensionMismatch(owned_indices.size(),
+                                  indices_to_look_up.size()));
+
+      const unsigned int my_pid  = this_mpi_process(mpi_comm);
+      const unsigned int n_procs = n_mpi_processes(mpi_comm);
+      const types::global_dof_index size = owned_indices.size();
+
+      // the dictionary: process p keeps track of the owners of the indices
+      // in the range [p*chunk_size, (p+1)*chunk_size)
+      const types::global_dof_index chunk_size =
+        std::max<types::global_dof_index>((size + n_procs - 1) / n_procs, 1);
+      const types::global_dof_index my_chunk_begin =
+        std::min<types::global_dof_index>(size, my_pid * chunk_size);
+      const types::global_dof_index my_chunk_end =
+        std::min<types::global_dof_index>(size, my_chunk_begin + chunk_size);
+      const auto dictionary_rank = [&](const types::global_dof_index index) {
+        return static_cast<unsigned int>(index / chunk_size);
+      };
+
+      // register the owned ranges with the processes managing the
+      // respective chunks of the dictionary. the ranges are sent as a flat
+      // list of [begin,end) pairs
+      std::vector<unsigned int> dictionary(my_chunk_end - my_chunk_begin,
+                                           numbers::invalid_unsigned_int);
+      {
+        std::map<unsigned int, std::vector<types::global_dof_index>>
+          owned_ranges;
+        for (auto interval = owned_indices.begin_intervals();
+             interval != owned_indices.end_intervals();
+             ++interval)
+          {
+            types::global_dof_index       begin = *interval->begin();
+            const types::global_dof_index end   = interval->last() + 1;
+            while (begin < end)
+              {
+                const unsigned int rank = dictionary_rank(begin);
+                const types::global_dof_index chunk_end =
+                  std::min<types::global_dof_index>(
+                    end, static_cast<types::global_dof_index>(rank + 1) *
+                           chunk_size);
+                owned_ranges[rank].push_back(begin);
+                owned_ranges[rank].push_back(chunk_end);
+                begin = chunk_end;
+              }
+          }
+
+        const auto received_ranges =
+          consensus_exchange(mpi_comm, owned_ranges, 32761);
+        for (const auto &rank_ranges : received_ranges)
+          for (unsigned int i = 0; i < rank_ranges.second.size(); i += 2)
+            {
+              Assert(rank_ranges.second[i] >= my_chunk_begin &&
+                       rank_ranges.second[i + 1] <= my_chunk_end,
+                     ExcInternalError());
+              for (types::global_dof_index index = rank_ranges.second[i];
+                   index < rank_ranges.second[i + 1];
+                   ++index)
+                {
+                  Assert(dictionary[index - my_chunk_begin] ==
+                           numbers::invalid_unsigned_int,
+                         ExcMessage("The owned index sets of the processes "
+                                    "must not overlap."));
+                  dictionary[index - my_chunk_begin] = rank_ranges.first;
+                }
+            }
+      }
+
+      // send the indices to look up to the processes managing them in the
+      // dictionary. since the indices are sorted, the dictionary ranks are
+      // increasing and every request covers a contiguous part of the result
+      std::map<unsigned int, std::vector<types::global_dof_index>> requests;
+      for (const types::global_dof_index index : indices_to_look_up)
+        requests[dictionary_rank(index)].push_back(index);
+
+      const auto received_requests =
+        consensus_exchange(mpi_comm, requests, 32762);
+
+      // answer the requests of the other processes
+      const auto look_up = [&](const types::global_dof_index index) {
+        AssertIndexRange(index - my_chunk_begin, dictionary.size());
+        Assert(dictionary[index - my_chunk_begin] !=
+                 numbers::invalid_unsigned_int,
+               ExcMessage("Index " + Utilities::to_string(index) +
+                          " is not owned by any process."));
+        return dictionary[index - my_chunk_begin];
+      };
+      std::vector<std::vector<unsigned int>> answers;
+      std::vector<MPI_Request>               answer_requests;
+      answers.reserve(received_requests.size());
+      answer_requests.reserve(received_requests.size());
+      for (const auto &rank_request : received_requests)
+        if (rank_request.first != my_pid)
+          {
+            answers.emplace_back(rank_request.second.size());
+            for (unsigned int i = 0; i < rank_request.second.size(); ++i)
+              answers.back()[i] = look_up(rank_request.second[i]);
+            answer_requests.emplace_back();
+            const int ierr = MPI_Isend(answers.back().data(),
+                                       answers.back().size(),
+                                       MPI_UNSIGNED,
+                                       rank_request.first,
+                                       32763,
+                                       mpi_comm,
+                                       &answer_requests.back());
+            AssertThrowMPI(ierr);
+          }
+
+      // receive the answers to our own requests
+      std::vector<unsigned int> owners(indices_to_look_up.n_elements());
+      unsigned int              offset = 0;
+      for (const auto &rank_request : requests)
+        {
+          if (rank_request.first == my_pid)
+            for (unsigned int i = 0; i < rank_request.second.size(); ++i)
+              owners[offset + i] = look_up(rank_request.second[i]);
+          else
+            {
+              const int ierr = MPI_Recv(owners.data() + offset,
+                                        rank_request.second.size(),
+                                        MPI_UNSIGNED,
+                                        rank_request.first,
+                                        32763,
+                                        mpi_comm,
+                                        MPI_STATUS_IGNORE);
+              AssertThrowMPI(ierr);
+            }
+          offset += rank_request.second.size();
+        }
+      AssertDimension(offset, owners.size());
+
+      if (answer_requests.size() > 0)
+        {
+          const int ierr = MPI_Waitall(answer_requests.size(),
+                                       answer_requests.data(),
+                                       MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+
+      return owners;
+    }
+
+
+
     namespace
     {
       // custom MIP_Op for calculate_collective_mpi_min_max_avg
@@ -492,6 +642,20 @@ namespace Utilities
 
 
 
+    std::vector<unsigned int>
+    compute_index_owner(const IndexSet &owned_indices,
+                        const IndexSet &indices_to_look_up,
+                        const MPI_Comm &)
+    {
+      Assert((indices_to_look_up & owned_indices) == indices_to_look_up,
+             ExcMessage("Without MPI, all indices must be owned by the "
+                        "current process."));
+      (void)owned_indices;
+      return std::vector<unsigned int>(indices_to_look_up.n_elements(), 0);
+    }
+
+
+
     MinMaxAvg
     min_max_avg(const double my_value, const MPI_Comm &)
     {
@@ -511,6 +675,29 @@ namespace Utilities
 
 
 
+    std::map<unsigned int, std::vector<char>>
+    some_to_some(
+      const MPI_Comm &                                 comm,
+      const std::map<unsigned int, std::vector<char>> &buffers_to_send)
+    {
+      const std::map<unsigned int, std::vector<char>> received_buffers =
+        consensus_exchange(comm, buffers_to_send, 21);
+
+#ifdef DEAL_II_WITH_MPI
+      // a process leaves the exchange above once all processes have had
+      // their messages received, but other processes may still be waiting
+      // for the completion of the exchange. wait for them, so that messages
+      // of a subsequent call with the same tag can not be taken for
+      // messages of this one
+      const int ierr = MPI_Barrier(comm);
+      AssertThrowMPI(ierr);
+#endif
+
+      return received_buffers;
+    }
+
+
+
     MPI_InitFinalize::MPI_InitFinalize(int &              argc,
                                        char **&           argv,
                                        const unsigned int max_num_threads)
@@ -0,0 +1,490 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/geometry_info.h>
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+#include <deal.II/base/std_cxx14/memory.h>
+
+#include <deal.II/distributed/tria_base.h>
+
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <set>
+#include <tuple>
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Utilities
+{
+  namespace MPI
+  {
+    template <int dim, int spacedim>
+    RemotePointEvaluation<dim, spacedim>::RemotePointEvaluation(
+      const double tolerance)
+      : tolerance(tolerance)
+      , communicator(MPI_COMM_SELF)
+      , ready(false)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    RemotePointEvaluation<dim, spacedim>::~RemotePointEvaluation()
+    {
+      if (tria_signal.connected())
+        tria_signal.disconnect();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::reinit(
+      const std::vector<Point<spacedim>> &points,
+      const Triangulation<dim, spacedim> &tria,
+      const Mapping<dim, spacedim> &      mapping)
+    {
+      if (cache == nullptr || &cache->get_triangulation() != &tria ||
+          &cache->get_mapping() != &mapping)
+        {
+          if (tria_signal.connected())
+            tria_signal.disconnect();
+          tria_signal = tria.signals.any_change.connect([&]() {
+            global_bboxes.clear();
+            ready = false;
+          });
+
+          cache =
+            std_cxx14::make_unique<GridTools::Cache<dim, spacedim>>(tria,
+                                                                    mapping);
+          global_bboxes.clear();
+        }
+      this->tria    = &tria;
+      this->mapping = &mapping;
+
+      const parallel::Triangulation<dim, spacedim> *parallel_tria =
+        dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(&tria);
+      communicator = (parallel_tria != nullptr) ?
+                       parallel_tria->get_communicator() :
+                       MPI_COMM_SELF;
+
+      // the search around the closest vertices can miss the cell that
+      // contains a point on coarse curved meshes. building the cell bucket
+      // grid makes GridTools::find_active_cell_around_point() fall back to
+      // the cells whose bounding boxes contain the point
+      cache->get_cell_bucket_grid();
+
+      // find the locally owned cells around the points of all processes.
+      // for each cell, we get the reference coordinates of the points in it,
+      // the ranks of the processes that asked for them, and the indices of
+      // the points on those processes
+      std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+                                             cells;
+      std::vector<std::vector<Point<dim>>>   reference_points;
+      std::vector<std::vector<unsigned int>> point_indices;
+      std::vector<std::vector<unsigned int>> owners;
+      std::vector<unsigned int>              searched_points;
+      if (parallel_tria != nullptr)
+        {
+          // the bounding boxes only change with the triangulation, so we
+          // only compute and exchange them once
+          if (global_bboxes.empty())
+            {
+              const std::function<bool(
+                const typename Triangulation<dim,
+                                             spacedim>::active_cell_iterator &)>
+                locally_owned =
+                  [](const typename Triangulation<dim, spacedim>::
+                       active_cell_iterator &cell) {
+                    return cell->is_locally_owned();
+                  };
+              const std::vector<BoundingBox<spacedim>> local_bboxes =
+                GridTools::compute_mesh_predicate_bounding_box(
+                  tria, locally_owned, std::min(2U, tria.n_levels() - 1), true);
+              global_bboxes =
+                GridTools::exchange_local_bounding_boxes(local_bboxes,
+                                                         communicator);
+            }
+
+          // points outside of all bounding boxes are certainly not in the
+          // mesh and must not be passed to the search below
+          for (unsigned int i = 0; i < points.size(); ++i)
+            for (const auto &bboxes : global_bboxes)
+              if (std::any_of(bboxes.begin(),
+                              bboxes.end(),
+                              [&](const BoundingBox<spacedim> &box) {
+                                return box.point_inside(points[i]);
+                              }))
+                {
+                  searched_points.push_back(i);
+                  break;
+                }
+          std::vector<Point<spacedim>> inside_points;
+          for (const unsigned int i : searched_points)
+            inside_points.push_back(points[i]);
+
+          const auto point_locations =
+            GridTools::distributed_compute_point_locations(*cache,
+                                                           inside_points,
+                                                           global_bboxes);
+          cells            = std::get<0>(point_locations);
+          reference_points = std::get<1>(point_locations);
+          point_indices    = std::get<2>(point_locations);
+          owners           = std::get<4>(point_locations);
+        }
+      else
+        {
+          const auto point_locations =
+            GridTools::compute_point_locations_try_all(*cache, points);
+          cells            = std::get<0>(point_locations);
+          reference_points = std::get<1>(point_locations);
+          point_indices    = std::get<2>(point_locations);
+          owners.resize(cells.size());
+          for (unsigned int c = 0; c < cells.size(); ++c)
+            owners[c].resize(point_indices[c].size(), 0);
+          searched_points.resize(points.size());
+          std::iota(searched_points.begin(), searched_points.end(), 0U);
+        }
+
+      // collect the points evaluated on the current process and sort them
+      // by the process that asked for them. the position of a point within
+      // the part of the send buffer of that process is given by the order
+      // of its index in the message below
+      cell_data = CellData();
+      cell_data.reference_point_ptrs.push_back(0);
+      std::map<unsigned int, std::vector<unsigned int>> requested_indices;
+      std::vector<std::pair<unsigned int, unsigned int>> rank_and_position;
+      for (unsigned int c = 0; c < cells.size(); ++c)
+        {
+          cell_data.cells.emplace_back(cells[c]->level(), cells[c]->index());
+          for (unsigned int q = 0; q < reference_points[c].size(); ++q)
+            {
+              cell_data.reference_point_values.push_back(
+                reference_points[c][q]);
+              std::vector<unsigned int> &indices =
+                requested_indices[owners[c][q]];
+              rank_and_position.emplace_back(owners[c][q], indices.size());
+              indices.push_back(point_indices[c][q]);
+            }
+          cell_data.reference_point_ptrs.push_back(
+            cell_data.reference_point_values.size());
+        }
+
+      send_ranks.clear();
+      send_ptrs.assign(1, 0);
+      std::map<unsigned int, unsigned int> send_offsets;
+      for (const auto &rank_and_indices : requested_indices)
+        {
+          send_offsets[rank_and_indices.first] = send_ptrs.back();
+          send_ranks.push_back(rank_and_indices.first);
+          send_ptrs.push_back(send_ptrs.back() +
+                              rank_and_indices.second.size());
+        }
+      send_permutation.resize(rank_and_position.size());
+      for (unsigned int i = 0; i < rank_and_position.size(); ++i)
+        send_permutation[i] =
+          send_offsets[rank_and_position[i].first] + rank_and_position[i].second;
+
+      // tell the processes which of their points we evaluate, which also
+      // tells the current process from whom it is going to receive values
+      const std::map<unsigned int, std::vector<unsigned int>> evaluated_indices =
+        consensus_exchange(communicator, requested_indices, 32751);
+
+      recv_ranks.clear();
+      recv_ptrs.assign(1, 0);
+      recv_point_indices.clear();
+      for (const auto &rank_and_indices : evaluated_indices)
+        {
+          recv_ranks.push_back(rank_and_indices.first);
+          for (const unsigned int i : rank_and_indices.second)
+            recv_point_indices.push_back(searched_points[i]);
+          recv_ptrs.push_back(recv_point_indices.size());
+        }
+
+      setup_output_pattern(points.size());
+      ready = true;
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::update(
+      const std::vector<Point<spacedim>> &points)
+    {
+      Assert(ready,
+             ExcMessage("RemotePointEvaluation::reinit() has to be called "
+                        "after creation or a change of the triangulation."));
+      AssertDimension(points.size() + 1, point_ptrs.size());
+
+      // send the new coordinates of the points along the existing pattern,
+      // i.e., from the processes that own the points to the ones that
+      // evaluate them
+      std::vector<std::array<double, spacedim>> coordinates(
+        recv_point_indices.size());
+      for (unsigned int i = 0; i < recv_point_indices.size(); ++i)
+        for (unsigned int d = 0; d < spacedim; ++d)
+          coordinates[i][d] = points[recv_point_indices[i]][d];
+      std::vector<std::array<double, spacedim>> evaluated_coordinates(
+        send_permutation.size());
+      exchange(coordinates,
+               recv_ranks,
+               recv_ptrs,
+               evaluated_coordinates,
+               send_ranks,
+               send_ptrs,
+               32752);
+
+      // search the points in the cell they have been in before and in the
+      // locally owned cells sharing a vertex with it
+      const std::vector<
+        std::set<typename Triangulation<dim, spacedim>::active_cell_iterator>>
+        &vertex_to_cells = cache->get_vertex_to_cell_map();
+      std::vector<std::tuple<std::pair<int, int>, Point<dim>, unsigned int>>
+                                 relocated_points;
+      std::vector<unsigned char> found(send_permutation.size(), 0);
+      for (unsigned int c = 0; c < cell_data.cells.size(); ++c)
+        {
+          const typename Triangulation<dim, spacedim>::active_cell_iterator
+                             cell(&*tria,
+                                  cell_data.cells[c].first,
+                                  cell_data.cells[c].second);
+          const unsigned int begin = cell_data.reference_point_ptrs[c];
+          const unsigned int end   = cell_data.reference_point_ptrs[c + 1];
+
+          std::vector<Point<spacedim>> real_points(end - begin);
+          for (unsigned int i = begin; i < end; ++i)
+            for (unsigned int d = 0; d < spacedim; ++d)
+              real_points[i - begin][d] =
+                evaluated_coordinates[send_permutation[i]][d];
+          std::vector<Point<dim>> unit_points(end - begin);
+          mapping->transform_points_real_to_unit_cell(
+            cell, make_array_view(real_points), make_array_view(unit_points));
+
+          for (unsigned int i = begin; i < end; ++i)
+            {
+              const unsigned int position = send_permutation[i];
+              if (GeometryInfo<dim>::is_inside_unit_cell(unit_points[i - begin],
+                                                         tolerance))
+                {
+                  relocated_points.emplace_back(cell_data.cells[c],
+                                                unit_points[i - begin],
+                                                position);
+                  found[position] = 1;
+                  continue;
+                }
+
+              for (unsigned int v = 0;
+                   v < GeometryInfo<dim>::vertices_per_cell && !found[position];
+                   ++v)
+                for (const auto &neighbor :
+                     vertex_to_cells[cell->vertex_index(v)])
+                  if (neighbor != cell && neighbor->is_locally_owned())
+                    {
+                      try
+                        {
+                          const Point<dim> unit_point =
+                            mapping->transform_real_to_unit_cell(
+                              neighbor, real_points[i - begin]);
+                          if (GeometryInfo<dim>::is_inside_unit_cell(
+                                unit_point, tolerance))
+                            {
+                              relocated_points.emplace_back(
+                                std::make_pair(neighbor->level(),
+                                               neighbor->index()),
+                                unit_point,
+                                position);
+                              found[position] = 1;
+                              break;
+                            }
+                        }
+                      catch (const typename Mapping<dim, spacedim>::
+                               ExcTransformationFailed &)
+                        {}
+                    }
+            }
+        }
+
+      // tell the owners of the points which ones have been found
+      std::vector<unsigned char> found_by_owner(recv_point_indices.size());
+      exchange(found,
+               send_ranks,
+               send_ptrs,
+               found_by_owner,
+               recv_ranks,
+               recv_ptrs,
+               32753);
+
+      // if a point is no longer found on any of the processes that evaluated
+      // it before, or has never been found, we need the global search
+      std::vector<unsigned int> n_found(points.size(), 0);
+      for (unsigned int i = 0; i < recv_point_indices.size(); ++i)
+        n_found[recv_point_indices[i]] += found_by_owner[i];
+      const bool all_found =
+        std::find(n_found.begin(), n_found.end(), 0U) == n_found.end();
+      if (Utilities::MPI::min(static_cast<unsigned int>(all_found),
+                              communicator) == 0)
+        {
+          reinit(points, *tria, *mapping);
+          return false;
+        }
+
+      // otherwise, drop the points that have not been found from the
+      // communication pattern, keeping the order of the others. start with
+      // the points evaluated on the current process
+      std::vector<unsigned int> new_position(found.size());
+      std::vector<unsigned int> new_send_ranks, new_send_ptrs(1, 0);
+      for (unsigned int r = 0; r < send_ranks.size(); ++r)
+        {
+          unsigned int n_kept = 0;
+          for (unsigned int i = send_ptrs[r]; i < send_ptrs[r + 1]; ++i)
+            if (found[i])
+              new_position[i] = new_send_ptrs.back() + n_kept++;
+          if (n_kept > 0)
+            {
+              new_send_ranks.push_back(send_ranks[r]);
+              new_send_ptrs.push_back(new_send_ptrs.back() + n_kept);
+            }
+        }
+      send_ranks.swap(new_send_ranks);
+      send_ptrs.swap(new_send_ptrs);
+
+      std::stable_sort(relocated_points.begin(),
+                       relocated_points.end(),
+                       [](const std::tuple<std::pair<int, int>,
+                                           Point<dim>,
+                                           unsigned int> &a,
+                          const std::tuple<std::pair<int, int>,
+                                           Point<dim>,
+                                           unsigned int> &b) {
+                         return std::get<0>(a) < std::get<0>(b);
+                       });
+      cell_data = CellData();
+      cell_data.reference_point_ptrs.push_back(0);
+      send_permutation.clear();
+      for (const auto &point : relocated_points)
+        {
+          if (cell_data.cells.empty() ||
+              cell_data.cells.back() != std::get<0>(point))
+            {
+              if (cell_data.cells.size() > 0)
+                cell_data.reference_point_ptrs.push_back(
+                  cell_data.reference_point_values.size());
+              cell_data.cells.push_back(std::get<0>(point));
+            }
+          cell_data.reference_point_values.push_back(std::get<1>(point));
+          send_permutation.push_back(new_position[std::get<2>(point)]);
+        }
+      if (cell_data.cells.size() > 0)
+        cell_data.reference_point_ptrs.push_back(
+          cell_data.reference_point_values.size());
+
+      // then the values received by the current process
+      std::vector<unsigned int> new_recv_ranks, new_recv_ptrs(1, 0),
+        new_recv_point_indices;
+      for (unsigned int r = 0; r < recv_ranks.size(); ++r)
+        {
+          for (unsigned int i = recv_ptrs[r]; i < recv_ptrs[r + 1]; ++i)
+            if (found_by_owner[i])
+              new_recv_point_indices.push_back(recv_point_indices[i]);
+          if (new_recv_point_indices.size() > new_recv_ptrs.back())
+            {
+              new_recv_ranks.push_back(recv_ranks[r]);
+              new_recv_ptrs.push_back(new_recv_point_indices.size());
+            }
+        }
+      recv_ranks.swap(new_recv_ranks);
+      recv_ptrs.swap(new_recv_ptrs);
+      recv_point_indices.swap(new_recv_point_indices);
+
+      setup_output_pattern(points.size());
+      return true;
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    RemotePointEvaluation<dim, spacedim>::setup_output_pattern(
+      const unsigned int n_points)
+    {
+      point_ptrs.assign(n_points + 1, 0);
+      for (const unsigned int index : recv_point_indices)
+        ++point_ptrs[index + 1];
+      for (unsigned int i = 0; i < n_points; ++i)
+        point_ptrs[i + 1] += point_ptrs[i];
+
+      std::vector<unsigned int> next_position(point_ptrs.begin(),
+                                              point_ptrs.end() - 1);
+      recv_permutation.resize(recv_point_indices.size());
+      for (unsigned int i = 0; i < recv_point_indices.size(); ++i)
+        recv_permutation[i] = next_position[recv_point_indices[i]]++;
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::is_map_unique() const
+    {
+      for (unsigned int i = 0; i + 1 < point_ptrs.size(); ++i)
+        if (point_ptrs[i + 1] - point_ptrs[i] != 1)
+          return false;
+      return true;
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    RemotePointEvaluation<dim, spacedim>::all_points_found() const
+    {
+      for (unsigned int i = 0; i + 1 < point_ptrs.size(); ++i)
+        if (point_ptrs[i + 1] == point_ptrs[i])
+          return false;
+      return true;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const Triangulation<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_triangulation() const
+    {
+      Assert(tria != nullptr, ExcNotInitialized());
+      return *tria;
+    }
+
+
+
+    template <int dim, int spacedim>
+    const Mapping<dim, spacedim> &
+    RemotePointEvaluation<dim, spacedim>::get_mapping() const
+    {
+      Assert(mapping != nullptr, ExcNotInitialized());
+      return *mapping;
+    }
+  } // namespace MPI
+} // namespace Utilities
+
+// explicit instantiations
+#include "mpi_remote_point_evaluation.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -33,9 +33,13 @@
 #  include <tbb/task_scheduler_init.h>
 #endif
 
+#ifdef DEAL_II_USE_THREAD_POOL
+#  include <deal.II/base/thread_pool.h>
+#endif
+
 DEAL_II_NAMESPACE_OPEN
 
-#ifdef DEAL_II_WITH_THREADS
+#if defined(DEAL_II_WITH_THREADS) || defined(DEAL_II_USE_THREAD_POOL)
 
 /* Detecting how many processors a given machine has is something that
    varies greatly between operating systems. For a few operating
@@ -152,6 +156,7 @@ MultithreadInfo::set_thread_limit(const unsigned int max_threads)
           n_max_threads = max_threads_env;
       }
   }
+#  ifdef DEAL_II_WITH_THREADS
   // Without restrictions from the user query TBB for the recommended number
   // of threads:
   if (n_max_threads == numbers::invalid_unsigned_int)
@@ -162,6 +167,27 @@ MultithreadInfo::set_thread_limit(const unsigned int max_threads)
   if (dummy.is_active())
     dummy.terminate();
   dummy.initialize(n_max_threads);
+#  else
+  // Without restrictions from the user use one thread per core. The thread
+  // pool is only created upon its first use, but needs to be adjusted if it
+  // already exists
+  if (n_max_threads == numbers::invalid_unsigned_int)
+    n_max_threads = n_cpus;
+  n_max_threads = std::max(n_max_threads, 1U);
+
+  Threads::internal::ThreadPool::set_n_threads(n_max_threads);
+#  endif
+}
+
+
+void
+MultithreadInfo::set_thread_affinity(const bool pin_threads)
+{
+#  ifdef DEAL_II_USE_THREAD_POOL
+  Threads::internal::ThreadPool::set_thread_affinity(pin_threads);
+#  else
+  (void)pin_threads;
+#  endif
 }
 
 
@@ -197,6 +223,10 @@ void
 MultithreadInfo::set_thread_limit(const unsigned int)
 {}
 
+void
+MultithreadInfo::set_thread_affinity(const bool)
+{}
+
 #endif
 
 
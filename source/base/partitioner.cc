@@ -33,6 +33,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(MPI_COMM_SELF)
       , have_ghost_indices(false)
+      , use_shared_memory(false)
+      , communicator_sm(MPI_COMM_SELF)
     {}
 
 
@@ -49,6 +51,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(MPI_COMM_SELF)
       , have_ghost_indices(false)
+      , use_shared_memory(false)
+      , communicator_sm(MPI_COMM_SELF)
     {
       locally_owned_range_data.add_range(0, size);
       locally_owned_range_data.compress();
@@ -69,6 +73,8 @@ namespace Utilities
       , n_procs(1)
       , communicator(communicator_in)
       , have_ghost_indices(false)
+      , use_shared_memory(false)
+      , communicator_sm(MPI_COMM_SELF)
     {
       set_owned_indices(locally_owned_indices);
       set_ghost_indices(ghost_indices_in);
@@ -87,12 +93,28 @@ namespace Utilities
       , n_procs(1)
       , communicator(communicator_in)
       , have_ghost_indices(false)
+      , use_shared_memory(false)
+      , communicator_sm(MPI_COMM_SELF)
     {
       set_owned_indices(locally_owned_indices);
     }
 
 
 
+    Partitioner::~Partitioner()
+    {
+#ifdef DEAL_II_WITH_MPI
+      if (use_shared_memory && Utilities::MPI::job_supports_mpi())
+        {
+          const int ierr = MPI_Comm_free(&communicator_sm);
+          (void)ierr;
+          AssertNothrow(ierr == MPI_SUCCESS, ExcMPI(ierr));
+        }
+#endif
+    }
+
+
+
     void
     Partitioner::reinit(const IndexSet &vector_space_vector_index_set,
                         const IndexSet &read_write_vector_index_set,
@@ -100,12 +122,58 @@ namespace Utilities
     {
       have_ghost_indices = false;
       communicator       = communicator_in;
-      set_owned_indices(vector_space_vector_index_set);
+      if (use_shared_memory)
+        {
+          // the shared-memory communicator must be derived from the new
+          // communicator
+          use_shared_memory = false;
+#ifdef DEAL_II_WITH_MPI
+          const int ierr = MPI_Comm_free(&communicator_sm);
+          AssertThrowMPI(ierr);
+#endif
+          communicator_sm = MPI_COMM_SELF;
+          set_owned_indices(vector_space_vector_index_set);
+          enable_shared_memory_communication();
+        }
+      else
+        set_owned_indices(vector_space_vector_index_set);
       set_ghost_indices(read_write_vector_index_set);
     }
 
 
 
+    void
+    Partitioner::enable_shared_memory_communication()
+    {
+      if (use_shared_memory)
+        return;
+
+#ifdef DEAL_II_WITH_MPI
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+      if (Utilities::MPI::job_supports_mpi() == false)
+        return;
+
+      // use the rank within the original communicator as key, such that the
+      // processes in the shared-memory communicator are ordered in the same
+      // way as in the original communicator
+      const int ierr = MPI_Comm_split_type(communicator,
+                                           MPI_COMM_TYPE_SHARED,
+                                           my_pid,
+                                           MPI_INFO_NULL,
+                                           &communicator_sm);
+      AssertThrowMPI(ierr);
+      use_shared_memory = true;
+#  else
+      AssertThrow(false,
+                  ExcMessage("Shared memory communication in the "
+                             "Partitioner requires an MPI library supporting "
+                             "the MPI-3.0 standard."));
+#  endif
+#endif
+    }
+
+
+
     void
     Partitioner::set_owned_indices(const IndexSet &locally_owned_indices)
     {
@@ -181,8 +249,6 @@ namespace Utilities
       // that are locally held but ghost indices of other processors. This
       // allows then to import and export data very easily.
 
-      // find out the end index for each processor and communicate it (this
-      // implies the start index for the next processor)
 #ifdef DEAL_II_WITH_MPI
       if (n_procs < 2)
         {
@@ -192,235 +258,158 @@ namespace Utilities
           return;
         }
 
-      std::vector<types::global_dof_index> first_index(n_procs + 1);
-      // Allow non-zero start index for the vector. send this data to all
-      // processors
-      first_index[0] = local_range_data.first;
-      int ierr       = MPI_Bcast(
-        first_index.data(), 1, DEAL_II_DOF_INDEX_MPI_TYPE, 0, communicator);
-      AssertThrowMPI(ierr);
-
-      // Get the end-of-local_range for all processors
-      ierr = MPI_Allgather(&local_range_data.second,
-                           1,
-                           DEAL_II_DOF_INDEX_MPI_TYPE,
-                           &first_index[1],
-                           1,
-                           DEAL_II_DOF_INDEX_MPI_TYPE,
-                           communicator);
-      AssertThrowMPI(ierr);
-      first_index[n_procs] = global_size;
-
       // fix case when there are some processors without any locally owned
-      // indices: then there might be a zero in some entries. The reason
-      // is that local_range_data will contain [0,0) and second index is
-      // incorrect inside the Allgather'ed first_index. Below we fix this
-      // by ensuring that the start point is always the end index of the
-      // processor immediately before.
+      // indices: their local range is [0,0), whereas it should start at the
+      // end index of the processors before them. a prefix scan gives this
+      // information at logarithmic cost, rather than collecting the ranges
+      // of all processors everywhere.
       if (global_size > 0)
         {
-          for (unsigned int i = 1; i < n_procs; ++i)
-            if (first_index[i] == 0)
-              first_index[i] = first_index[i - 1];
-
-          // correct if our processor has a wrong local range
-          if (first_index[my_pid] != local_range_data.first)
-            {
-              Assert(local_range_data.first == local_range_data.second,
-                     ExcInternalError());
-              local_range_data.first = local_range_data.second =
-                first_index[my_pid];
-            }
+          types::global_dof_index previous_end = 0;
+          const int               ierr = MPI_Exscan(&local_range_data.second,
+                                      &previous_end,
+                                      1,
+                                      DEAL_II_DOF_INDEX_MPI_TYPE,
+                                      MPI_MAX,
+                                      communicator);
+          AssertThrowMPI(ierr);
+          if (my_pid > 0 && local_range_data.first == local_range_data.second)
+            local_range_data.first = local_range_data.second = previous_end;
         }
 
-      // Allocate memory for data that will be exported
+      // find the owners of the ghost indices by a lookup in a distributed
+      // dictionary. the cost of this operation scales with the number of
+      // processors we actually communicate with, not with the total number
+      // of processors.
       std::vector<types::global_dof_index> expanded_ghost_indices(
         n_ghost_indices_data);
-      unsigned int n_ghost_targets = 0;
-      if (n_ghost_indices_data > 0)
-        {
-          // Create first a vector of ghost_targets from the list of ghost
-          // indices and then push back new values. When we are done, copy the
-          // data to that field of the partitioner. This way, the variable
-          // ghost_targets will have exactly the size we need, whereas the
-          // vector filled with emplace_back might actually be too long.
-          unsigned int current_proc = 0;
-          ghost_indices_data.fill_index_vector(expanded_ghost_indices);
-          types::global_dof_index current_index = expanded_ghost_indices[0];
-          while (current_index >= first_index[current_proc + 1])
-            current_proc++;
-          AssertIndexRange(current_proc, n_procs);
-
-          // since DoFs are contiguous, populate a vector which stores
-          // a process rank and the number of ghosts
-          std::vector<std::pair<unsigned int, unsigned int>> ghost_targets_temp(
-            1, std::pair<unsigned int, unsigned int>(current_proc, 0));
-          n_ghost_targets++;
-
-          // find which process is the owner of other indices:
-          for (unsigned int iterator = 1; iterator < n_ghost_indices_data;
-               ++iterator)
-            {
-              current_index = expanded_ghost_indices[iterator];
-              while (current_index >= first_index[current_proc + 1])
-                current_proc++;
-              AssertIndexRange(current_proc, n_procs);
-              // if we found a new target (i.e. higher rank) then adjust the
-              // pair.second in the last element so that it stores the total
-              // number of ghosts owned by pair.first
-              if (ghost_targets_temp[n_ghost_targets - 1].first < current_proc)
-                {
-                  ghost_targets_temp[n_ghost_targets - 1].second =
-                    iterator - ghost_targets_temp[n_ghost_targets - 1].second;
-                  ghost_targets_temp.emplace_back(current_proc, iterator);
-                  n_ghost_targets++;
-                }
-            }
-          // adjust the last element so that pair.second stores the number of
-          // elements
-          ghost_targets_temp[n_ghost_targets - 1].second =
-            n_ghost_indices_data -
-            ghost_targets_temp[n_ghost_targets - 1].second;
-          ghost_targets_data = ghost_targets_temp;
-        }
-      // find the processes that want to import to me
+      ghost_indices_data.fill_index_vector(expanded_ghost_indices);
+      const std::vector<unsigned int> ghost_owners =
+        Utilities::MPI::compute_index_owner(locally_owned_range_data,
+                                            ghost_indices_data,
+                                            communicator);
+
+      // since the locally owned ranges are sorted by the rank of the
+      // processors, the ghost indices of each owner form a contiguous part of
+      // the ghost indices. populate a vector which stores a process rank and
+      // the number of ghosts
       {
-        std::vector<int> send_buffer(n_procs, 0);
-        std::vector<int> receive_buffer(n_procs, 0);
-        for (unsigned int i = 0; i < n_ghost_targets; i++)
-          send_buffer[ghost_targets_data[i].first] =
-            ghost_targets_data[i].second;
-
-        const int ierr = MPI_Alltoall(send_buffer.data(),
-                                      1,
-                                      MPI_INT,
-                                      receive_buffer.data(),
-                                      1,
-                                      MPI_INT,
-                                      communicator);
-        AssertThrowMPI(ierr);
-
-        // allocate memory for import data
-        std::vector<std::pair<unsigned int, unsigned int>> import_targets_temp;
-        n_import_indices_data = 0;
-        for (unsigned int i = 0; i < n_procs; i++)
-          if (receive_buffer[i] > 0)
-            {
-              n_import_indices_data += receive_buffer[i];
-              import_targets_temp.emplace_back(i, receive_buffer[i]);
-            }
+        std::vector<std::pair<unsigned int, unsigned int>> ghost_targets_temp;
+        for (const unsigned int owner : ghost_owners)
+          {
+            Assert(owner != my_pid, ExcInternalError());
+            if (ghost_targets_temp.empty() ||
+                ghost_targets_temp.back().first != owner)
+              {
+                Assert(ghost_targets_temp.empty() ||
+                         ghost_targets_temp.back().first < owner,
+                       ExcMessage("The locally owned ranges must be sorted "
+                                  "by the rank of the processors."));
+                ghost_targets_temp.emplace_back(owner, 0);
+              }
+            ++ghost_targets_temp.back().second;
+          }
         // copy, don't move, to get deterministic memory usage.
-        import_targets_data = import_targets_temp;
+        ghost_targets_data = ghost_targets_temp;
       }
 
-      // now that we know how many indices each process will receive from
-      // ghosts, send and receive indices for import data. non-blocking receives
-      // and blocking sends
-      std::vector<types::global_dof_index> expanded_import_indices(
-        n_import_indices_data);
+      // send the ghost indices to their owners. this also tells the owners
+      // which processors import data from them, so no exchange of message
+      // sizes among all processors is necessary.
+      std::vector<types::global_dof_index> expanded_import_indices;
       {
-        unsigned int             current_index_start = 0;
-        std::vector<MPI_Request> import_requests(import_targets_data.size() +
-                                                 n_ghost_targets);
-        for (unsigned int i = 0; i < import_targets_data.size(); i++)
+        std::map<unsigned int, std::vector<types::global_dof_index>>
+                     ghost_indices_by_owner;
+        unsigned int shift = 0;
+        for (const auto &target : ghost_targets_data)
           {
-            const int ierr =
-              MPI_Irecv(&expanded_import_indices[current_index_start],
-                        import_targets_data[i].second,
-                        DEAL_II_DOF_INDEX_MPI_TYPE,
-                        import_targets_data[i].first,
-                        import_targets_data[i].first,
-                        communicator,
-                        &import_requests[i]);
-            AssertThrowMPI(ierr);
-            current_index_start += import_targets_data[i].second;
+            ghost_indices_by_owner[target.first].assign(
+              expanded_ghost_indices.begin() + shift,
+              expanded_ghost_indices.begin() + shift + target.second);
+            shift += target.second;
           }
-        AssertDimension(current_index_start, n_import_indices_data);
+        AssertDimension(shift, n_ghost_indices_data);
 
-        // use non-blocking send for ghost indices stored in
-        // expanded_ghost_indices
-        current_index_start = 0;
-        for (unsigned int i = 0; i < n_ghost_targets; i++)
+        const std::map<unsigned int, std::vector<types::global_dof_index>>
+          import_indices_by_rank =
+            Utilities::MPI::consensus_exchange(communicator,
+                                               ghost_indices_by_owner);
+
+        std::vector<std::pair<unsigned int, unsigned int>> import_targets_temp;
+        n_import_indices_data = 0;
+        for (const auto &rank_indices : import_indices_by_rank)
           {
-            const int ierr =
-              MPI_Isend(&expanded_ghost_indices[current_index_start],
-                        ghost_targets_data[i].second,
-                        DEAL_II_DOF_INDEX_MPI_TYPE,
-                        ghost_targets_data[i].first,
-                        my_pid,
-                        communicator,
-                        &import_requests[import_targets_data.size() + i]);
-            AssertThrowMPI(ierr);
-            current_index_start += ghost_targets_data[i].second;
+            n_import_indices_data += rank_indices.second.size();
+            import_targets_temp.emplace_back(rank_indices.first,
+                                             rank_indices.second.size());
           }
-        AssertDimension(current_index_start, n_ghost_indices_data);
+        // copy, don't move, to get deterministic memory usage.
+        import_targets_data = import_targets_temp;
 
-        // wait for all import from other processes to be done
-        if (import_requests.size() > 0)
+        expanded_import_indices.reserve(n_import_indices_data);
+        for (const auto &rank_indices : import_indices_by_rank)
+          expanded_import_indices.insert(expanded_import_indices.end(),
+                                         rank_indices.second.begin(),
+                                         rank_indices.second.end());
+      }
+
+      // transform import indices to local index space and compress
+      // contiguous indices in form of ranges
+      {
+        import_indices_chunks_by_rank_data.resize(import_targets_data.size() +
+                                                  1);
+        import_indices_chunks_by_rank_data[0] = 0;
+        // a vector which stores import indices as ranges [a_i,b_i)
+        std::vector<std::pair<unsigned int, unsigned int>>
+                     compressed_import_indices;
+        unsigned int shift = 0;
+        for (unsigned int p = 0; p < import_targets_data.size(); ++p)
           {
-            const int ierr = MPI_Waitall(import_requests.size(),
-                                         import_requests.data(),
-                                         MPI_STATUSES_IGNORE);
-            AssertThrowMPI(ierr);
+            types::global_dof_index last_index =
+              numbers::invalid_dof_index - 1;
+            for (unsigned int ii = 0; ii < import_targets_data[p].second; ++ii)
+              {
+                // index in expanded_import_indices for a pair (p,ii):
+                const unsigned int i = shift + ii;
+                Assert(expanded_import_indices[i] >= local_range_data.first &&
+                         expanded_import_indices[i] < local_range_data.second,
+                       ExcIndexRange(expanded_import_indices[i],
+                                     local_range_data.first,
+                                     local_range_data.second));
+                // local index starting from the beginning of locally owned
+                // DoFs:
+                types::global_dof_index new_index =
+                  (expanded_import_indices[i] - local_range_data.first);
+                Assert(new_index < numbers::invalid_unsigned_int,
+                       ExcNotImplemented());
+                if (new_index == last_index + 1)
+                  // if contiguous, increment the end of last range:
+                  compressed_import_indices.back().second++;
+                else
+                  // otherwise start a new range:
+                  compressed_import_indices.emplace_back(new_index,
+                                                         new_index + 1);
+                last_index = new_index;
+              }
+            shift += import_targets_data[p].second;
+            import_indices_chunks_by_rank_data[p + 1] =
+              compressed_import_indices.size();
           }
+        import_indices_data = compressed_import_indices;
 
-        // transform import indices to local index space and compress
-        // contiguous indices in form of ranges
-        {
-          import_indices_chunks_by_rank_data.resize(import_targets_data.size() +
-                                                    1);
-          import_indices_chunks_by_rank_data[0] = 0;
-          // a vector which stores import indices as ranges [a_i,b_i)
-          std::vector<std::pair<unsigned int, unsigned int>>
-                       compressed_import_indices;
-          unsigned int shift = 0;
-          for (unsigned int p = 0; p < import_targets_data.size(); ++p)
-            {
-              types::global_dof_index last_index =
-                numbers::invalid_dof_index - 1;
-              for (unsigned int ii = 0; ii < import_targets_data[p].second;
-                   ++ii)
-                {
-                  // index in expanded_import_indices for a pair (p,ii):
-                  const unsigned int i = shift + ii;
-                  Assert(expanded_import_indices[i] >= local_range_data.first &&
-                           expanded_import_indices[i] < local_range_data.second,
-                         ExcIndexRange(expanded_import_indices[i],
-                                       local_range_data.first,
-                                       local_range_data.second));
-                  // local index starting from the beginning of locally owned
-                  // DoFs:
-                  types::global_dof_index new_index =
-                    (expanded_import_indices[i] - local_range_data.first);
-                  Assert(new_index < numbers::invalid_unsigned_int,
-                         ExcNotImplemented());
-                  if (new_index == last_index + 1)
-                    // if contiguous, increment the end of last range:
-                    compressed_import_indices.back().second++;
-                  else
-                    // otherwise start a new range:
-                    compressed_import_indices.emplace_back(new_index,
-                                                           new_index + 1);
-                  last_index = new_index;
-                }
-              shift += import_targets_data[p].second;
-              import_indices_chunks_by_rank_data[p + 1] =
-                compressed_import_indices.size();
-            }
-          import_indices_data = compressed_import_indices;
-
-          // sanity check
+        // sanity check
 #  ifdef DEBUG
-          const types::global_dof_index n_local_dofs =
-            local_range_data.second - local_range_data.first;
-          for (const auto &range : import_indices_data)
-            {
-              AssertIndexRange(range.first, n_local_dofs);
-              AssertIndexRange(range.second - 1, n_local_dofs);
-            }
+        const types::global_dof_index n_local_dofs =
+          local_range_data.second - local_range_data.first;
+        for (const auto &range : import_indices_data)
+          {
+            AssertIndexRange(range.first, n_local_dofs);
+            AssertIndexRange(range.second - 1, n_local_dofs);
+          }
 #  endif
-        }
       }
+
+      initialize_shared_memory_exchange(expanded_ghost_indices);
 #endif // #ifdef DEAL_II_WITH_MPI
 
       if (larger_ghost_index_set.size() == 0)
@@ -498,6 +487,202 @@ namespace Utilities
 
 
 
+#ifdef DEAL_II_WITH_MPI
+    void
+    Partitioner::initialize_shared_memory_exchange(
+      const std::vector<types::global_dof_index> &expanded_ghost_indices)
+    {
+      const unsigned int n_ghost_targets  = ghost_targets_data.size();
+      const unsigned int n_import_targets = import_targets_data.size();
+
+      ghost_targets_sm_ranks_data.assign(n_ghost_targets,
+                                         numbers::invalid_unsigned_int);
+      import_targets_sm_ranks_data.assign(n_import_targets,
+                                          numbers::invalid_unsigned_int);
+      ghost_indices_sm_data.clear();
+      ghost_indices_sm_chunks_by_rank_data.assign(n_ghost_targets + 1, 0);
+      import_targets_sm_offsets_data.assign(n_import_targets, 0);
+
+      if (use_shared_memory == false)
+        return;
+
+      // get the ranks in the original communicator of all processes in the
+      // shared-memory communicator. Since we used the original rank as key in
+      // MPI_Comm_split_type(), this list is sorted.
+      std::vector<unsigned int> sm_to_global_rank(
+        Utilities::MPI::n_mpi_processes(communicator_sm));
+      int ierr = MPI_Allgather(&my_pid,
+                               1,
+                               MPI_UNSIGNED,
+                               sm_to_global_rank.data(),
+                               1,
+                               MPI_UNSIGNED,
+                               communicator_sm);
+      AssertThrowMPI(ierr);
+
+      // the first index owned by each process on the node, needed to
+      // translate the ghost indices into the local numbering of the owner
+      std::vector<types::global_dof_index> sm_first_index(
+        sm_to_global_rank.size());
+      ierr = MPI_Allgather(&local_range_data.first,
+                           1,
+                           DEAL_II_DOF_INDEX_MPI_TYPE,
+                           sm_first_index.data(),
+                           1,
+                           DEAL_II_DOF_INDEX_MPI_TYPE,
+                           communicator_sm);
+      AssertThrowMPI(ierr);
+
+      const auto find_sm_rank = [&](const unsigned int global_rank) {
+        const auto it = std::lower_bound(sm_to_global_rank.begin(),
+                                         sm_to_global_rank.end(),
+                                         global_rank);
+        return (it != sm_to_global_rank.end() && *it == global_rank) ?
+                 static_cast<unsigned int>(it - sm_to_global_rank.begin()) :
+                 numbers::invalid_unsigned_int;
+      };
+
+      // translate the ghost indices owned by processes on the same node into
+      // the local numbering on the owner, compressed into ranges
+      unsigned int shift = 0;
+      for (unsigned int p = 0; p < n_ghost_targets; ++p)
+        {
+          ghost_targets_sm_ranks_data[p] =
+            find_sm_rank(ghost_targets_data[p].first);
+          if (ghost_targets_sm_ranks_data[p] != numbers::invalid_unsigned_int)
+            {
+              unsigned int last_index = numbers::invalid_unsigned_int - 1;
+              for (unsigned int ii = 0; ii < ghost_targets_data[p].second; ++ii)
+                {
+                  const unsigned int index = static_cast<unsigned int>(
+                    expanded_ghost_indices[shift + ii] -
+                    sm_first_index[ghost_targets_sm_ranks_data[p]]);
+                  if (index == last_index + 1)
+                    ghost_indices_sm_data.back().second++;
+                  else
+                    ghost_indices_sm_data.emplace_back(index, index + 1);
+                  last_index = index;
+                }
+            }
+          shift += ghost_targets_data[p].second;
+          ghost_indices_sm_chunks_by_rank_data[p + 1] =
+            ghost_indices_sm_data.size();
+        }
+
+      // the owners on the same node need to know where the ghost entries
+      // of the present process are located in its array in order to read
+      // them in compress(), so send the position of each chunk
+      std::vector<unsigned int> ghost_offsets(n_ghost_targets);
+      std::vector<MPI_Request>  requests;
+      requests.reserve(n_ghost_targets + n_import_targets);
+      for (unsigned int p = 0; p < n_import_targets; ++p)
+        {
+          import_targets_sm_ranks_data[p] =
+            find_sm_rank(import_targets_data[p].first);
+          if (import_targets_sm_ranks_data[p] != numbers::invalid_unsigned_int)
+            {
+              requests.emplace_back();
+              ierr = MPI_Irecv(&import_targets_sm_offsets_data[p],
+                               1,
+                               MPI_UNSIGNED,
+                               import_targets_sm_ranks_data[p],
+                               0,
+                               communicator_sm,
+                               &requests.back());
+              AssertThrowMPI(ierr);
+            }
+        }
+      unsigned int offset = local_size();
+      for (unsigned int p = 0; p < n_ghost_targets; ++p)
+        {
+          ghost_offsets[p] = offset;
+          if (ghost_targets_sm_ranks_data[p] != numbers::invalid_unsigned_int)
+            {
+              requests.emplace_back();
+              ierr = MPI_Isend(&ghost_offsets[p],
+                               1,
+                               MPI_UNSIGNED,
+                               ghost_targets_sm_ranks_data[p],
+                               0,
+                               communicator_sm,
+                               &requests.back());
+              AssertThrowMPI(ierr);
+            }
+          offset += ghost_targets_data[p].second;
+        }
+      if (requests.size() > 0)
+        {
+          ierr = MPI_Waitall(requests.size(),
+                             requests.data(),
+                             MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+    }
+
+
+
+    void
+    Partitioner::shared_memory_handshake(
+      const std::vector<unsigned int> &send_to,
+      const std::vector<unsigned int> &receive_from,
+      const int                        tag,
+      const MPI_Win                    shared_window) const
+    {
+      // complete our loads and stores to the window before the neighbors
+      // learn that they may access it
+      if (shared_window != MPI_WIN_NULL)
+        {
+          const int ierr = MPI_Win_sync(shared_window);
+          AssertThrowMPI(ierr);
+        }
+
+      std::vector<MPI_Request> requests;
+      requests.reserve(send_to.size() + receive_from.size());
+      for (const unsigned int rank : receive_from)
+        if (rank != numbers::invalid_unsigned_int)
+          {
+            requests.emplace_back();
+            const int ierr = MPI_Irecv(nullptr,
+                                       0,
+                                       MPI_BYTE,
+                                       rank,
+                                       tag,
+                                       communicator_sm,
+                                       &requests.back());
+            AssertThrowMPI(ierr);
+          }
+      for (const unsigned int rank : send_to)
+        if (rank != numbers::invalid_unsigned_int)
+          {
+            requests.emplace_back();
+            const int ierr = MPI_Isend(nullptr,
+                                       0,
+                                       MPI_BYTE,
+                                       rank,
+                                       tag,
+                                       communicator_sm,
+                                       &requests.back());
+            AssertThrowMPI(ierr);
+          }
+      if (requests.size() > 0)
+        {
+          const int ierr = MPI_Waitall(requests.size(),
+                                       requests.data(),
+                                       MPI_STATUSES_IGNORE);
+          AssertThrowMPI(ierr);
+        }
+
+      // and see their accesses that were completed before they signaled us
+      if (shared_window != MPI_WIN_NULL)
+        {
+          const int ierr = MPI_Win_sync(shared_window);
+          AssertThrowMPI(ierr);
+        }
+    }
+#endif
+
+
+
     bool
     Partitioner::is_compatible(const Partitioner &part) const
     {
@@ -550,6 +735,15 @@ namespace Utilities
       memory +=
         MemoryConsumption::memory_consumption(ghost_indices_subset_data);
       memory += MemoryConsumption::memory_consumption(ghost_indices_data);
+      memory +=
+        MemoryConsumption::memory_consumption(ghost_targets_sm_ranks_data);
+      memory +=
+        MemoryConsumption::memory_consumption(import_targets_sm_ranks_data);
+      memory += MemoryConsumption::memory_consumption(ghost_indices_sm_data);
+      memory += MemoryConsumption::memory_consumption(
+        ghost_indices_sm_chunks_by_rank_data);
+      memory +=
+        MemoryConsumption::memory_consumption(import_targets_sm_offsets_data);
       return memory;
     }
 
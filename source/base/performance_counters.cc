@@ -0,0 +1,291 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/performance_counters.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifdef DEAL_II_HAVE_LINUX_PERF_EVENT_H
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace
+{
+#ifdef DEAL_II_HAVE_LINUX_PERF_EVENT_H
+  /**
+   * Open a counter for the given hardware event on the calling thread,
+   * counting only events in user space. Return -1 if this is not possible.
+   */
+  int
+  open_counter(const std::uint64_t event)
+  {
+    perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.type           = PERF_TYPE_HARDWARE;
+    attributes.size           = sizeof(attributes);
+    attributes.config         = event;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv     = 1;
+
+    // if there are more counters than hardware registers, the kernel
+    // multiplexes them and we need the times the counter was enabled and
+    // running to extrapolate the count
+    attributes.read_format =
+      PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+  }
+#endif
+} // namespace
+
+
+
+PerformanceCounters::SectionData::SectionData()
+  : n_calls(0)
+  , wall_time(0.)
+  , n_flops(0.)
+{
+  counts.fill(0.);
+}
+
+
+
+double
+PerformanceCounters::SectionData::instructions_per_cycle() const
+{
+  return counts[cycles] > 0. ? counts[instructions] / counts[cycles] : 0.;
+}
+
+
+
+double
+PerformanceCounters::SectionData::memory_bytes() const
+{
+  return 64. * counts[cache_misses];
+}
+
+
+
+double
+PerformanceCounters::SectionData::gflops() const
+{
+  return wall_time > 0. ? 1e-9 * n_flops / wall_time : 0.;
+}
+
+
+
+double
+PerformanceCounters::SectionData::arithmetic_intensity() const
+{
+  return memory_bytes() > 0. ? n_flops / memory_bytes() : 0.;
+}
+
+
+
+PerformanceCounters::PerformanceCounters()
+{
+  file_descriptors.fill(-1);
+
+#ifdef DEAL_II_HAVE_LINUX_PERF_EVENT_H
+  file_descriptors[cycles]       = open_counter(PERF_COUNT_HW_CPU_CYCLES);
+  file_descriptors[instructions] = open_counter(PERF_COUNT_HW_INSTRUCTIONS);
+  file_descriptors[cache_misses] = open_counter(PERF_COUNT_HW_CACHE_MISSES);
+#endif
+}
+
+
+
+PerformanceCounters::~PerformanceCounters()
+{
+#ifdef DEAL_II_HAVE_LINUX_PERF_EVENT_H
+  for (const int fd : file_descriptors)
+    if (fd >= 0)
+      close(fd);
+#endif
+}
+
+
+
+bool
+PerformanceCounters::counters_available() const
+{
+  return std::all_of(file_descriptors.begin(),
+                     file_descriptors.end(),
+                     [](const int fd) { return fd >= 0; });
+}
+
+
+
+void
+PerformanceCounters::read_counters(std::array<double, n_counters> &values) const
+{
+  values.fill(0.);
+
+#ifdef DEAL_II_HAVE_LINUX_PERF_EVENT_H
+  for (unsigned int c = 0; c < n_counters; ++c)
+    if (file_descriptors[c] >= 0)
+      {
+        // the value, the time enabled, and the time running
+        std::uint64_t data[3];
+        if (read(file_descriptors[c], data, sizeof(data)) ==
+              static_cast<ssize_t>(sizeof(data)) &&
+            data[2] > 0)
+          values[c] = static_cast<double>(data[0]) * data[1] / data[2];
+      }
+#endif
+}
+
+
+
+void
+PerformanceCounters::enter_subsection(const std::string &section_name)
+{
+  Assert(section_name.empty() == false, ExcMessage("Section string is empty."));
+
+  active_sections.emplace_back();
+  ActiveSection &section = active_sections.back();
+  section.name           = section_name;
+  section.start_time     = std::chrono::steady_clock::now();
+
+  // read the counters last so that the bookkeeping above is not measured
+  read_counters(section.start_counts);
+}
+
+
+
+void
+PerformanceCounters::leave_subsection(const std::string &section_name,
+                                      const double       n_flops)
+{
+  // read the counters first so that the bookkeeping below is not measured
+  std::array<double, n_counters> end_counts;
+  read_counters(end_counts);
+  const auto end_time = std::chrono::steady_clock::now();
+
+  // search from the back, as the section left is usually the innermost one
+  const auto active = std::find_if(active_sections.rbegin(),
+                                   active_sections.rend(),
+                                   [&](const ActiveSection &section) {
+                                     return section.name == section_name;
+                                   });
+  AssertThrow(active != active_sections.rend(),
+              ExcSectionNotActive(section_name));
+
+  SectionData &data = sections[section_name];
+  ++data.n_calls;
+  data.wall_time +=
+    std::chrono::duration<double>(end_time - active->start_time).count();
+  for (unsigned int c = 0; c < n_counters; ++c)
+    data.counts[c] += end_counts[c] - active->start_counts[c];
+  data.n_flops += n_flops;
+
+  active_sections.erase(std::next(active).base());
+}
+
+
+
+const std::map<std::string, PerformanceCounters::SectionData> &
+PerformanceCounters::get_summary_data() const
+{
+  return sections;
+}
+
+
+
+void
+PerformanceCounters::print_summary(std::ostream &stream) const
+{
+  // print the values into strings first to determine the column widths
+  const std::vector<std::string> header = {"Section",
+                                           "no. calls",
+                                           "wall time",
+                                           "GFLOP/s",
+                                           "IPC",
+                                           "LLC misses",
+                                           "GB/s (est.)",
+                                           "flop/byte"};
+  std::vector<std::vector<std::string>> rows(1, header);
+
+  const bool        available     = counters_available();
+  const std::string not_available = "n/a";
+  const auto format = [](const double value, const unsigned int precision) {
+    std::ostringstream s;
+    s << std::fixed << std::setprecision(precision) << value;
+    return s.str();
+  };
+
+  for (const auto &section : sections)
+    {
+      const SectionData &data = section.second;
+
+      std::vector<std::string> row(header.size(), not_available);
+      row[0] = section.first;
+      row[1] = std::to_string(data.n_calls);
+      row[2] = format(data.wall_time, 4) + "s";
+      if (data.n_flops > 0.)
+        row[3] = format(data.gflops(), 2);
+      if (available)
+        {
+          row[4] = format(data.instructions_per_cycle(), 2);
+          row[5] = format(data.counts[cache_misses], 0);
+          if (data.wall_time > 0.)
+            row[6] = format(1e-9 * data.memory_bytes() / data.wall_time, 2);
+          if (data.n_flops > 0.)
+            row[7] = format(data.arithmetic_intensity(), 2);
+        }
+      rows.push_back(row);
+    }
+
+  std::vector<std::size_t> widths(header.size(), 0);
+  for (const auto &row : rows)
+    for (unsigned int i = 0; i < row.size(); ++i)
+      widths[i] = std::max(widths[i], row[i].size());
+
+  for (const auto &row : rows)
+    {
+      stream << std::left << std::setw(widths[0]) << row[0] << std::right;
+      for (unsigned int i = 1; i < row.size(); ++i)
+        stream << " | " << std::setw(widths[i]) << row[i];
+      stream << std::endl;
+    }
+
+  if (available == false)
+    stream << "(Hardware performance counters are not available on this system."
+           << std::endl
+           << " Only the wall time and the rate of floating point operations"
+           << std::endl
+           << " are reported.)" << std::endl;
+}
+
+
+
+void
+PerformanceCounters::reset()
+{
+  active_sections.clear();
+  sections.clear();
+}
+
+DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,440 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/thread_pool.h>
+
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/thread_management.h>
+
+#include <algorithm>
+#include <exception>
+
+#ifdef __linux__
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace Threads
+{
+  namespace internal
+  {
+    namespace
+    {
+      // the index of the current thread in the pool, see
+      // ThreadPool::current_thread_index()
+      thread_local unsigned int this_thread_index = 0;
+
+      // the pool, created upon the first call to ThreadPool::instance(),
+      // and the settings to use for it
+      std::mutex                  pool_mutex;
+      std::unique_ptr<ThreadPool> pool;
+      unsigned int                pool_n_threads   = 0;
+      bool                        pool_pin_threads = false;
+
+      // the cores the process may run on, e.g., as restricted by the
+      // binding of an MPI launcher or by taskset. they are read once,
+      // before any thread of the pool is pinned, and the threads are only
+      // placed on these cores
+      std::vector<unsigned int> allowed_cores;
+
+
+
+      // fill allowed_cores with the cores the calling thread may run on, if
+      // this has not happened yet. must be called with pool_mutex held
+      void
+      read_allowed_cores()
+      {
+#ifdef __linux__
+        if (allowed_cores.size() > 0)
+          return;
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+          for (unsigned int core = 0; core < CPU_SETSIZE; ++core)
+            if (CPU_ISSET(core, &cpu_set))
+              allowed_cores.push_back(core);
+#endif
+      }
+
+
+
+      // pin the calling thread to the allowed core with the given index,
+      // wrapping around if there are more threads than allowed cores
+      void
+      pin_to_core(const unsigned int index)
+      {
+#ifdef __linux__
+        if (allowed_cores.size() == 0)
+          return;
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(allowed_cores[index % allowed_cores.size()], &cpu_set);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#else
+        (void)index;
+#endif
+      }
+
+
+
+      // let the calling thread run on all allowed cores again
+      void
+      unpin()
+      {
+#ifdef __linux__
+        if (allowed_cores.size() == 0)
+          return;
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (const unsigned int core : allowed_cores)
+          CPU_SET(core, &cpu_set);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#endif
+      }
+    } // namespace
+
+
+
+    ThreadPool::ThreadPool()
+      : queues(1)
+      , n_queued_jobs(0)
+      , n_unfinished_jobs(0)
+      , n_sleeping_threads(0)
+      , stop(false)
+      , pin_threads(pool_pin_threads)
+    {
+      queues[0].reset(new Queue());
+      start_workers(
+        (pool_n_threads > 0 ? pool_n_threads : MultithreadInfo::n_threads()) -
+        1);
+    }
+
+
+
+    ThreadPool::~ThreadPool()
+    {
+      stop_workers();
+    }
+
+
+
+    ThreadPool &
+    ThreadPool::instance()
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      if (pool == nullptr)
+        pool.reset(new ThreadPool());
+      return *pool;
+    }
+
+
+
+    void
+    ThreadPool::set_n_threads(const unsigned int n_threads)
+    {
+      Assert(n_threads > 0, ExcMessage("The pool needs at least one thread."));
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      pool_n_threads = n_threads;
+      if (pool != nullptr && pool->n_workers() + 1 != n_threads)
+        {
+          // take_job() and submit() access the queues without a lock on the
+          // vector holding them, so the queues may only be resized while no
+          // job is around
+          Assert(pool->n_unfinished_jobs == 0,
+                 ExcMessage("The number of threads of the thread pool can "
+                            "not be changed while it is running jobs."));
+          pool->stop_workers();
+          pool->start_workers(n_threads - 1);
+        }
+    }
+
+
+
+    void
+    ThreadPool::set_thread_affinity(const bool pin_threads)
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex);
+      if (pin_threads)
+        read_allowed_cores();
+      pool_pin_threads = pin_threads;
+      if (pool != nullptr && pool->pin_threads != pin_threads)
+        {
+          Assert(pool->n_unfinished_jobs == 0,
+                 ExcMessage("The thread affinity of the thread pool can not "
+                            "be changed while it is running jobs."));
+          const unsigned int n_workers = pool->n_workers();
+          pool->stop_workers();
+          pool->pin_threads = pin_threads;
+          pool->start_workers(n_workers);
+        }
+      if (pin_threads)
+        pin_to_core(0);
+      else
+        unpin();
+    }
+
+
+
+    void
+    ThreadPool::start_workers(const unsigned int n_workers)
+    {
+      stop = false;
+      queues.resize(n_workers + 1);
+      for (unsigned int i = 1; i <= n_workers; ++i)
+        queues[i].reset(new Queue());
+
+      workers.reserve(n_workers);
+      for (unsigned int i = 1; i <= n_workers; ++i)
+        workers.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+
+
+
+    void
+    ThreadPool::stop_workers()
+    {
+      {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stop = true;
+      }
+      wake_up.notify_all();
+      for (std::thread &worker : workers)
+        worker.join();
+      workers.clear();
+
+      // keep the jobs that have not been started yet
+      for (unsigned int i = 1; i < queues.size(); ++i)
+        for (const std::shared_ptr<Job> &job : queues[i]->jobs)
+          queues[0]->jobs.push_back(job);
+      queues.resize(1);
+    }
+
+
+
+    void
+    ThreadPool::worker_loop(const unsigned int index)
+    {
+      this_thread_index = index;
+      if (pin_threads)
+        pin_to_core(index);
+
+      while (true)
+        {
+          if (const std::shared_ptr<Job> job = take_job(index))
+            {
+              run_job(*job);
+              continue;
+            }
+
+          std::unique_lock<std::mutex> lock(sleep_mutex);
+          ++n_sleeping_threads;
+          wake_up.wait(lock, [this]() { return stop || n_queued_jobs > 0; });
+          --n_sleeping_threads;
+          if (stop)
+            return;
+        }
+    }
+
+
+
+    std::shared_ptr<ThreadPool::Job>
+    ThreadPool::take_job(const unsigned int index)
+    {
+      if (n_queued_jobs == 0)
+        return nullptr;
+
+      // first look at the own queue, from the back
+      if (index < queues.size())
+        {
+          std::lock_guard<std::mutex> lock(queues[index]->mutex);
+          if (queues[index]->jobs.size() > 0)
+            {
+              const std::shared_ptr<Job> job = queues[index]->jobs.back();
+              queues[index]->jobs.pop_back();
+              --n_queued_jobs;
+              return job;
+            }
+        }
+
+      // then at the shared queue and the queues of the other workers, in a
+      // round-robin fashion starting after the own one to spread the
+      // stealing over the workers, taking the oldest job
+      for (unsigned int i = 1; i <= queues.size(); ++i)
+        {
+          Queue &queue = *queues[(index + i) % queues.size()];
+          std::lock_guard<std::mutex> lock(queue.mutex);
+          if (queue.jobs.size() > 0)
+            {
+              const std::shared_ptr<Job> job = queue.jobs.front();
+              queue.jobs.pop_front();
+              --n_queued_jobs;
+              return job;
+            }
+        }
+
+      return nullptr;
+    }
+
+
+
+    void
+    ThreadPool::run_job(Job &job)
+    {
+      job.function();
+      --n_unfinished_jobs;
+      job.done = true;
+      notify_sleeping_threads();
+    }
+
+
+
+    void
+    ThreadPool::notify_sleeping_threads()
+    {
+      if (n_sleeping_threads > 0)
+        {
+          // acquire the lock to make sure that a thread that has just
+          // checked its wake-up condition is already waiting
+          std::lock_guard<std::mutex> lock(sleep_mutex);
+          wake_up.notify_all();
+        }
+    }
+
+
+
+    std::shared_ptr<ThreadPool::Job>
+    ThreadPool::submit(const std::function<void()> &function)
+    {
+      std::shared_ptr<Job> job = std::make_shared<Job>(function);
+      ++n_unfinished_jobs;
+      if (workers.size() == 0)
+        {
+          run_job(*job);
+          return job;
+        }
+
+      const unsigned int index =
+        (this_thread_index < queues.size()) ? this_thread_index : 0;
+      {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(job);
+        ++n_queued_jobs;
+      }
+      notify_sleeping_threads();
+
+      return job;
+    }
+
+
+
+    void
+    ThreadPool::wait(const Job &job)
+    {
+      const unsigned int index = this_thread_index;
+      while (job.is_done() == false)
+        {
+          if (const std::shared_ptr<Job> other_job = take_job(index))
+            {
+              run_job(*other_job);
+              continue;
+            }
+
+          // nothing to do: sleep until either the job has finished or new
+          // jobs have been queued
+          std::unique_lock<std::mutex> lock(sleep_mutex);
+          ++n_sleeping_threads;
+          wake_up.wait(lock, [this, &job]() {
+            return job.is_done() || n_queued_jobs > 0;
+          });
+          --n_sleeping_threads;
+        }
+    }
+
+
+
+    unsigned int
+    ThreadPool::n_chunks(const std::size_t n,
+                         const std::size_t grain_size) const
+    {
+      // create a few chunks per thread to balance the load
+      const std::size_t max_chunks = 4 * (workers.size() + 1);
+      const std::size_t n_grains   = n / std::max<std::size_t>(grain_size, 1);
+      return std::max<std::size_t>(std::min(n_grains, max_chunks), 1);
+    }
+
+
+
+    void
+    ThreadPool::run_chunks(
+      const unsigned int                             n_chunks,
+      const std::function<void(const unsigned int)> &chunk_function)
+    {
+      if (n_chunks == 0)
+        return;
+
+      std::vector<std::shared_ptr<Job>> jobs;
+      jobs.reserve(n_chunks - 1);
+      for (unsigned int chunk = n_chunks - 1; chunk > 0; --chunk)
+        jobs.push_back(submit([&chunk_function, chunk]() {
+          try
+            {
+              chunk_function(chunk);
+            }
+          catch (const std::exception &exc)
+            {
+              handle_std_exception(exc);
+            }
+          catch (...)
+            {
+              handle_unknown_exception();
+            }
+        }));
+
+      // work on the first chunk ourselves. the other jobs refer to
+      // chunk_function, so we have to wait for them before passing on an
+      // exception
+      std::exception_ptr exception;
+      try
+        {
+          chunk_function(0);
+        }
+      catch (...)
+        {
+          exception = std::current_exception();
+        }
+
+      for (const std::shared_ptr<Job> &job : jobs)
+        wait(*job);
+
+      if (exception)
+        std::rethrow_exception(exception);
+    }
+
+
+
+    unsigned int
+    ThreadPool::current_thread_index()
+    {
+      return this_thread_index;
+    }
+  } // namespace internal
+} // namespace Threads
+
+DEAL_II_NAMESPACE_CLOSE
@@ -321,6 +321,9 @@ TimerOutput::TimerOutput(std::ostream &        stream,
   , out_stream(stream, true)
   , output_is_enabled(true)
   , mpi_communicator(MPI_COMM_SELF)
+  , trace_is_enabled(false)
+  , trace_start_time(std::chrono::steady_clock::now())
+  , n_trace_threads(0)
 {}
 
 
@@ -333,6 +336,9 @@ TimerOutput::TimerOutput(ConditionalOStream &  stream,
   , out_stream(stream)
   , output_is_enabled(true)
   , mpi_communicator(MPI_COMM_SELF)
+  , trace_is_enabled(false)
+  , trace_start_time(std::chrono::steady_clock::now())
+  , n_trace_threads(0)
 {}
 
 
@@ -346,6 +352,9 @@ TimerOutput::TimerOutput(MPI_Comm              mpi_communicator,
   , out_stream(stream, true)
   , output_is_enabled(true)
   , mpi_communicator(mpi_communicator)
+  , trace_is_enabled(false)
+  , trace_start_time(std::chrono::steady_clock::now())
+  , n_trace_threads(0)
 {}
 
 
@@ -359,6 +368,9 @@ TimerOutput::TimerOutput(MPI_Comm              mpi_communicator,
   , out_stream(stream)
   , output_is_enabled(true)
   , mpi_communicator(mpi_communicator)
+  , trace_is_enabled(false)
+  , trace_start_time(std::chrono::steady_clock::now())
+  , n_trace_threads(0)
 {}
 
 
@@ -447,6 +459,17 @@ TimerOutput::enter_subsection(const std::string &section_name)
   sections[section_name].n_calls++;
 
   active_sections.push_back(section_name);
+
+  // the events refer to the names stored in trace_section_names, which are
+  // neither moved around nor deleted by reset()
+  if (trace_is_enabled)
+    {
+      ThreadTrace *      trace = nullptr;
+      const unsigned int event_index = begin_trace_event(
+        trace_section_names.insert(section_name).first->c_str(), trace);
+      if (trace != nullptr)
+        active_trace_events[section_name] = std::make_pair(trace, event_index);
+    }
 }
 
 
@@ -506,6 +529,13 @@ TimerOutput::leave_subsection(const std::string &section_name)
       out_stream << actual_section_name << output_time << std::endl;
     }
 
+  const auto trace_event = active_trace_events.find(actual_section_name);
+  if (trace_event != active_trace_events.end())
+    {
+      end_trace_event(trace_event->second.second, *trace_event->second.first);
+      active_trace_events.erase(trace_event);
+    }
+
   // delete the index from the list of
   // active ones
   active_sections.erase(std::find(active_sections.begin(),
@@ -878,6 +908,207 @@ TimerOutput::reset()
   sections.clear();
   active_sections.clear();
   timer_all.restart();
+
+  clear_trace();
+}
+
+
+
+TimerOutput::ThreadTrace::ThreadTrace()
+  : thread_index(numbers::invalid_unsigned_int)
+  , current_event(-1)
+  , n_open_events(0)
+{}
+
+
+
+void
+TimerOutput::clear_trace()
+{
+  // other threads may still hold pointers to their buffers, so only empty
+  // the buffers rather than destroying them
+  const auto clear = [](ThreadTrace &trace) {
+    Assert(trace.n_open_events == 0,
+           ExcMessage("The trace can not be discarded while a recorded "
+                      "section or TraceScope is active."));
+    trace.thread_index  = numbers::invalid_unsigned_int;
+    trace.current_event = -1;
+    trace.events.clear();
+  };
+#if defined(DEAL_II_WITH_THREADS) || defined(DEAL_II_USE_THREAD_POOL)
+  for (ThreadTrace &trace : thread_traces.get_implementation())
+    clear(trace);
+#else
+  clear(thread_traces.get_implementation());
+#endif
+
+  n_trace_threads = 0;
+  active_trace_events.clear();
+}
+
+
+
+void
+TimerOutput::enable_trace_recording()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  clear_trace();
+
+  // let all processes start the clock at the same time
+#ifdef DEAL_II_WITH_MPI
+  if (mpi_communicator != MPI_COMM_SELF)
+    {
+      const int ierr = MPI_Barrier(mpi_communicator);
+      AssertThrowMPI(ierr);
+    }
+#endif
+
+  trace_start_time = std::chrono::steady_clock::now();
+  trace_is_enabled = true;
+}
+
+
+
+void
+TimerOutput::disable_trace_recording()
+{
+  trace_is_enabled = false;
+}
+
+
+
+namespace
+{
+  // Call the given function for the events recorded on each thread.
+  template <typename ThreadTraces, typename Function>
+  void
+  for_each_thread_trace(ThreadTraces &thread_traces, const Function &function)
+  {
+#if defined(DEAL_II_WITH_THREADS) || defined(DEAL_II_USE_THREAD_POOL)
+    for (const auto &trace : thread_traces.get_implementation())
+      if (trace.thread_index != numbers::invalid_unsigned_int)
+        function(trace);
+#else
+    const auto &trace = thread_traces.get_implementation();
+    if (trace.thread_index != numbers::invalid_unsigned_int)
+      function(trace);
+#endif
+  }
+
+
+
+  // Escape the characters of a name that are not allowed in a JSON string.
+  std::string
+  json_escape(const char *name)
+  {
+    std::string result;
+    for (const char *c = name; *c != '\0'; ++c)
+      if (*c == '"' || *c == '\\')
+        {
+          result += '\\';
+          result += *c;
+        }
+      else if (static_cast<unsigned char>(*c) < 0x20)
+        result += ' ';
+      else
+        result += *c;
+    return result;
+  }
+} // namespace
+
+
+
+void
+TimerOutput::write_trace(std::ostream &stream) const
+{
+  const unsigned int my_rank =
+    (mpi_communicator == MPI_COMM_SELF ?
+       0 :
+       Utilities::MPI::this_mpi_process(mpi_communicator));
+
+  // collect the events of this process in a string, with time stamps in
+  // microseconds as required by the trace event format
+  std::ostringstream events;
+  events << std::fixed << std::setprecision(3);
+  events << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << my_rank
+         << ",\"args\":{\"name\":\"MPI rank " << my_rank << "\"}}";
+  for_each_thread_trace(thread_traces, [&](const ThreadTrace &trace) {
+    events << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << my_rank
+           << ",\"tid\":" << trace.thread_index
+           << ",\"args\":{\"name\":\"thread " << trace.thread_index << "\"}}";
+    for (const TraceEvent &event : trace.events)
+      events << ",\n{\"name\":\"" << json_escape(event.name)
+             << "\",\"ph\":\"X\",\"pid\":" << my_rank
+             << ",\"tid\":" << trace.thread_index
+             << ",\"ts\":" << event.start * 1e-3
+             << ",\"dur\":" << (event.end - event.start) * 1e-3 << "}";
+  });
+
+  std::vector<std::string> all_events;
+  if (mpi_communicator == MPI_COMM_SELF)
+    all_events.push_back(events.str());
+  else
+    all_events = Utilities::MPI::gather(mpi_communicator, events.str());
+
+  if (my_rank == 0)
+    {
+      stream << "{\"traceEvents\":[\n";
+      for (unsigned int p = 0; p < all_events.size(); ++p)
+        stream << (p > 0 ? ",\n" : "") << all_events[p];
+      stream << "\n]}" << std::endl;
+    }
+}
+
+
+
+void
+TimerOutput::print_hierarchical_summary() const
+{
+  // accumulate the number of calls and the wall time of each section, which
+  // is identified by the names of all the sections it is nested in
+  std::map<std::vector<std::string>, std::pair<unsigned int, double>> data;
+  for_each_thread_trace(thread_traces, [&](const ThreadTrace &trace) {
+    for (const TraceEvent &event : trace.events)
+      {
+        std::vector<std::string> path;
+        int                      e = &event - trace.events.data();
+        while (e >= 0)
+          {
+            path.insert(path.begin(), trace.events[e].name);
+            e = trace.events[e].parent;
+          }
+
+        std::pair<unsigned int, double> &entry = data[path];
+        ++entry.first;
+        entry.second += (event.end - event.start) * 1e-9;
+      }
+  });
+
+  // the lexicographic ordering of the map puts each section right before the
+  // sections nested in it
+  std::size_t name_width = 32;
+  for (const auto &entry : data)
+    name_width = std::max(name_width,
+                          2 * (entry.first.size() - 1) +
+                            entry.first.back().size() + 1);
+
+  const std::istream::fmtflags old_flags = out_stream.get_stream().flags();
+  const std::streamsize old_precision    = out_stream.get_stream().precision();
+
+  out_stream << std::left << std::setw(name_width) << "Section" << std::right
+             << std::setw(12) << "no. calls" << std::setw(13) << "wall time"
+             << std::endl;
+  for (const auto &entry : data)
+    out_stream << std::left << std::setw(name_width)
+               << (std::string(2 * (entry.first.size() - 1), ' ') +
+                   entry.first.back())
+               << std::right << std::setw(12) << entry.second.first
+               << std::setw(12) << std::setprecision(3) << std::fixed
+               << entry.second.second << "s" << std::endl;
+
+  out_stream.get_stream().flags(old_flags);
+  out_stream.get_stream().precision(old_precision);
 }
 
 TimerOutput::Scope::~Scope()
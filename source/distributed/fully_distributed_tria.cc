@@ -0,0 +1,493 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <algorithm>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  namespace fullydistributed
+  {
+    namespace
+    {
+      // set the manifold ids of the quads of a cell, which are only separate
+      // objects in 3D
+      template <int dim, int spacedim>
+      void
+      set_quad_manifold_ids(const TriaIterator<CellAccessor<dim, spacedim>> &,
+                            const CellData<dim> &)
+      {}
+
+
+
+      template <int spacedim>
+      void
+      set_quad_manifold_ids(const TriaIterator<CellAccessor<3, spacedim>> &cell,
+                            const CellData<3> &cell_info)
+      {
+        for (unsigned int quad = 0; quad < GeometryInfo<3>::quads_per_cell;
+             ++quad)
+          cell->quad(quad)->set_manifold_id(cell_info.manifold_quad_ids[quad]);
+      }
+
+
+
+      // compute the ConstructionData of the process with rank @p my_rank
+      template <int dim, int spacedim>
+      ConstructionData<dim, spacedim>
+      create_construction_data(const dealii::Triangulation<dim, spacedim> &tria,
+                               const types::subdomain_id my_rank)
+      {
+        // the cells we need are the locally owned cells, all cells that share
+        // a vertex with them, and all ancestors of these cells
+        std::vector<bool> vertex_of_own_cell(tria.n_vertices(), false);
+        for (const auto &cell : tria.active_cell_iterators())
+          if (cell->subdomain_id() == my_rank)
+            for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+                 ++v)
+              vertex_of_own_cell[cell->vertex_index(v)] = true;
+
+        std::vector<std::vector<bool>> cell_is_needed(tria.n_levels());
+        for (unsigned int l = 0; l < tria.n_levels(); ++l)
+          cell_is_needed[l].resize(tria.n_raw_cells(l), false);
+        for (const auto &cell : tria.active_cell_iterators())
+          for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+               ++v)
+            if (vertex_of_own_cell[cell->vertex_index(v)])
+              {
+                typename dealii::Triangulation<dim, spacedim>::cell_iterator
+                  ancestor = cell;
+                while (!cell_is_needed[ancestor->level()][ancestor->index()])
+                  {
+                    cell_is_needed[ancestor->level()][ancestor->index()] =
+                      true;
+                    if (ancestor->level() == 0)
+                      break;
+                    ancestor = ancestor->parent();
+                  }
+                break;
+              }
+
+        ConstructionData<dim, spacedim> construction_data;
+
+        // the coarse cells with a local numbering of their vertices. the
+        // coarse cells are visited in the order of their index, so the
+        // coarse cell ids come out sorted
+        std::vector<unsigned int> local_vertex_index(
+          tria.n_vertices(), numbers::invalid_unsigned_int);
+        for (const auto &cell : tria.cell_iterators_on_level(0))
+          if (cell_is_needed[0][cell->index()])
+            {
+              dealii::CellData<dim> coarse_cell;
+              for (unsigned int v = 0;
+                   v < GeometryInfo<dim>::vertices_per_cell;
+                   ++v)
+                {
+                  unsigned int &index =
+                    local_vertex_index[cell->vertex_index(v)];
+                  if (index == numbers::invalid_unsigned_int)
+                    {
+                      index = construction_data.coarse_cell_vertices.size();
+                      construction_data.coarse_cell_vertices.push_back(
+                        cell->vertex(v));
+                    }
+                  coarse_cell.vertices[v] = index;
+                }
+              coarse_cell.material_id = cell->material_id();
+              construction_data.coarse_cells.push_back(coarse_cell);
+              construction_data.coarse_cell_index_to_coarse_cell_id.push_back(
+                cell->id().get_coarse_cell_id());
+            }
+
+        // the cells on all levels, together with their indicators
+        construction_data.cell_infos.resize(tria.n_levels());
+        for (unsigned int l = 0; l < tria.n_levels(); ++l)
+          for (const auto &cell : tria.cell_iterators_on_level(l))
+            if (cell_is_needed[l][cell->index()])
+              {
+                CellData<dim> cell_info;
+                cell_info.id = cell->id();
+                if (cell->active())
+                  cell_info.subdomain_id = cell->subdomain_id();
+                cell_info.manifold_id = cell->manifold_id();
+                if (dim > 1)
+                  for (unsigned int line = 0;
+                       line < GeometryInfo<dim>::lines_per_cell;
+                       ++line)
+                    cell_info.manifold_line_ids[line] =
+                      cell->line(line)->manifold_id();
+                if (dim == 3)
+                  for (unsigned int quad = 0;
+                       quad < GeometryInfo<dim>::quads_per_cell;
+                       ++quad)
+                    cell_info.manifold_quad_ids[quad] =
+                      cell->quad(quad)->manifold_id();
+                for (unsigned int f = 0;
+                     f < GeometryInfo<dim>::faces_per_cell;
+                     ++f)
+                  if (cell->face(f)->at_boundary())
+                    cell_info.boundary_ids.emplace_back(
+                      f, cell->face(f)->boundary_id());
+                construction_data.cell_infos[l].push_back(cell_info);
+              }
+
+        return construction_data;
+      }
+    } // namespace
+
+
+
+    template <int dim>
+    CellData<dim>::CellData()
+      : subdomain_id(numbers::artificial_subdomain_id)
+      , manifold_id(numbers::flat_manifold_id)
+    {
+      manifold_line_ids.fill(numbers::flat_manifold_id);
+      manifold_quad_ids.fill(numbers::flat_manifold_id);
+    }
+
+
+
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data_from_triangulation(
+      const dealii::Triangulation<dim, spacedim> &tria,
+      const MPI_Comm                              comm)
+    {
+      Assert((dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+                &tria) == nullptr),
+             ExcMessage("The triangulation must be a serial triangulation."));
+
+      return create_construction_data(tria,
+                                      Utilities::MPI::this_mpi_process(comm));
+    }
+
+
+
+    template <int dim, int spacedim>
+    ConstructionData<dim, spacedim>
+    create_construction_data_in_groups(
+      const std::function<void(dealii::Triangulation<dim, spacedim> &)>
+        &serial_grid_generator,
+      const std::function<void(dealii::Triangulation<dim, spacedim> &,
+                               const unsigned int)> &serial_grid_partitioner,
+      const MPI_Comm                                 comm,
+      const unsigned int                             group_size)
+    {
+      Assert(group_size > 0, ExcMessage("The group size must be positive."));
+
+      const unsigned int my_rank = Utilities::MPI::this_mpi_process(comm);
+      const unsigned int n_procs = Utilities::MPI::n_mpi_processes(comm);
+
+#ifdef DEAL_II_WITH_MPI
+      // split the processes into groups
+      MPI_Comm group_comm;
+      int      ierr;
+      if (group_size == numbers::invalid_unsigned_int)
+        {
+#  if DEAL_II_MPI_VERSION_GTE(3, 0)
+          ierr = MPI_Comm_split_type(
+            comm, MPI_COMM_TYPE_SHARED, my_rank, MPI_INFO_NULL, &group_comm);
+#  else
+          ierr = MPI_Comm_split(comm, my_rank, my_rank, &group_comm);
+#  endif
+        }
+      else
+        ierr = MPI_Comm_split(comm, my_rank / group_size, my_rank, &group_comm);
+      AssertThrowMPI(ierr);
+
+      const unsigned int my_group_rank =
+        Utilities::MPI::this_mpi_process(group_comm);
+      const unsigned int n_group_procs =
+        Utilities::MPI::n_mpi_processes(group_comm);
+
+      // the ranks within comm of the processes of the group, to know which
+      // part of the mesh they need
+      std::vector<unsigned int> group_ranks(n_group_procs);
+      ierr = MPI_Allgather(DEAL_II_MPI_CONST_CAST(&my_rank),
+                           1,
+                           MPI_UNSIGNED,
+                           group_ranks.data(),
+                           1,
+                           MPI_UNSIGNED,
+                           group_comm);
+      AssertThrowMPI(ierr);
+
+      const int                       mpi_tag = 14;
+      ConstructionData<dim, spacedim> construction_data;
+      if (my_group_rank == 0)
+        {
+          dealii::Triangulation<dim, spacedim> serial_tria;
+          serial_grid_generator(serial_tria);
+          serial_grid_partitioner(serial_tria, n_procs);
+
+          // send the descriptions one after the other, such that only one of
+          // them is held in addition to the serial mesh
+          for (unsigned int p = 1; p < n_group_procs; ++p)
+            {
+              const std::vector<char> buffer = Utilities::pack(
+                create_construction_data(serial_tria, group_ranks[p]));
+              ierr = MPI_Send(DEAL_II_MPI_CONST_CAST(buffer.data()),
+                              buffer.size(),
+                              MPI_CHAR,
+                              p,
+                              mpi_tag,
+                              group_comm);
+              AssertThrowMPI(ierr);
+            }
+
+          construction_data = create_construction_data(serial_tria, my_rank);
+        }
+      else
+        {
+          MPI_Status status;
+          ierr = MPI_Probe(0, mpi_tag, group_comm, &status);
+          AssertThrowMPI(ierr);
+
+          int buffer_size;
+          ierr = MPI_Get_count(&status, MPI_CHAR, &buffer_size);
+          AssertThrowMPI(ierr);
+
+          std::vector<char> buffer(buffer_size);
+          ierr = MPI_Recv(buffer.data(),
+                          buffer_size,
+                          MPI_CHAR,
+                          0,
+                          mpi_tag,
+                          group_comm,
+                          MPI_STATUS_IGNORE);
+          AssertThrowMPI(ierr);
+
+          construction_data =
+            Utilities::unpack<ConstructionData<dim, spacedim>>(buffer);
+        }
+
+      ierr = MPI_Comm_free(&group_comm);
+      AssertThrowMPI(ierr);
+
+      return construction_data;
+#else
+      (void)group_size;
+
+      dealii::Triangulation<dim, spacedim> serial_tria;
+      serial_grid_generator(serial_tria);
+      serial_grid_partitioner(serial_tria, n_procs);
+      return create_construction_data(serial_tria, my_rank);
+#endif
+    }
+
+
+
+    template <int dim, int spacedim>
+    Triangulation<dim, spacedim>::Triangulation(MPI_Comm mpi_communicator)
+      : parallel::Triangulation<dim, spacedim>(mpi_communicator)
+    {}
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::create_triangulation(
+      const ConstructionData<dim, spacedim> &construction_data)
+    {
+      AssertDimension(
+        construction_data.coarse_cells.size(),
+        construction_data.coarse_cell_index_to_coarse_cell_id.size());
+      Assert(construction_data.coarse_cells.size() > 0,
+             ExcMessage("Every process must own at least one cell."));
+      Assert(std::is_sorted(
+               construction_data.coarse_cell_index_to_coarse_cell_id.begin(),
+               construction_data.coarse_cell_index_to_coarse_cell_id.end()),
+             ExcMessage("The coarse cell ids must be sorted."));
+
+      coarse_cell_ids = construction_data.coarse_cell_index_to_coarse_cell_id;
+
+      dealii::Triangulation<dim, spacedim>::create_triangulation(
+        construction_data.coarse_cell_vertices,
+        construction_data.coarse_cells,
+        SubCellData());
+
+      // create the finer levels by refining the parents of the cells
+      // listed on each level, and set the indicators of the cells
+      for (unsigned int l = 0; l < construction_data.cell_infos.size(); ++l)
+        {
+          if (l > 0)
+            {
+              for (const auto &cell_info : construction_data.cell_infos[l])
+                cell_info.id.parent_cell_id()
+                  .template to_cell<dim, spacedim>(*this)
+                  ->set_refine_flag();
+              dealii::Triangulation<dim, spacedim>::
+                execute_coarsening_and_refinement();
+            }
+
+          for (const auto &cell_info : construction_data.cell_infos[l])
+            {
+              const auto cell =
+                cell_info.id.template to_cell<dim, spacedim>(*this);
+              cell->set_manifold_id(cell_info.manifold_id);
+              if (dim > 1)
+                for (unsigned int line = 0;
+                     line < GeometryInfo<dim>::lines_per_cell;
+                     ++line)
+                  cell->line(line)->set_manifold_id(
+                    cell_info.manifold_line_ids[line]);
+              set_quad_manifold_ids(cell, cell_info);
+              for (const auto &boundary_id : cell_info.boundary_ids)
+                cell->face(boundary_id.first)
+                  ->set_boundary_id(boundary_id.second);
+            }
+        }
+
+      // all cells not listed are artificial
+      for (const auto &cell : this->active_cell_iterators())
+        cell->set_subdomain_id(numbers::artificial_subdomain_id);
+      for (const auto &cell_infos : construction_data.cell_infos)
+        for (const auto &cell_info : cell_infos)
+          {
+            const auto cell =
+              cell_info.id.template to_cell<dim, spacedim>(*this);
+            if (cell->active())
+              cell->set_subdomain_id(cell_info.subdomain_id);
+          }
+
+      this->update_number_cache();
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::create_triangulation(
+      const std::vector<Point<spacedim>> &,
+      const std::vector<dealii::CellData<dim>> &,
+      const SubCellData &)
+    {
+      Assert(false,
+             ExcMessage("A parallel::fullydistributed::Triangulation can only "
+                        "be created from a ConstructionData object."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::copy_triangulation(
+      const dealii::Triangulation<dim, spacedim> &other_tria)
+    {
+      Assert(
+        (dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+           &other_tria) == nullptr),
+        ExcMessage(
+          "A parallel::fullydistributed::Triangulation can only be copied "
+          "from a serial triangulation."));
+
+      // copy the manifolds, which are not part of the description
+      for (const auto manifold_id : other_tria.get_manifold_ids())
+        if (manifold_id != numbers::flat_manifold_id)
+          this->set_manifold(manifold_id, other_tria.get_manifold(manifold_id));
+
+      create_triangulation(
+        create_construction_data_from_triangulation(other_tria,
+                                                    this->mpi_communicator));
+    }
+
+
+
+    template <int dim, int spacedim>
+    void
+    Triangulation<dim, spacedim>::execute_coarsening_and_refinement()
+    {
+      Assert(false,
+             ExcMessage("A parallel::fullydistributed::Triangulation can not "
+                        "be refined or coarsened."));
+    }
+
+
+
+    template <int dim, int spacedim>
+    bool
+    Triangulation<dim, spacedim>::has_hanging_nodes() const
+    {
+      // the artificial cells may have hanging nodes that do not exist in the
+      // global mesh, so only look at the faces of locally owned cells
+      unsigned int have_coarser_neighbor = 0;
+      for (const auto &cell : this->active_cell_iterators())
+        if (cell->is_locally_owned())
+          for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+            if (!cell->at_boundary(f) && cell->neighbor_is_coarser(f))
+              have_coarser_neighbor = 1;
+
+      return Utilities::MPI::max(have_coarser_neighbor,
+                                 this->mpi_communicator) == 1;
+    }
+
+
+
+    template <int dim, int spacedim>
+    types::coarse_cell_id
+    Triangulation<dim, spacedim>::coarse_cell_index_to_coarse_cell_id(
+      const unsigned int coarse_cell_index) const
+    {
+      AssertIndexRange(coarse_cell_index, coarse_cell_ids.size());
+      return coarse_cell_ids[coarse_cell_index];
+    }
+
+
+
+    template <int dim, int spacedim>
+    unsigned int
+    Triangulation<dim, spacedim>::coarse_cell_id_to_coarse_cell_index(
+      const types::coarse_cell_id coarse_cell_id) const
+    {
+      const auto it = std::lower_bound(coarse_cell_ids.begin(),
+                                       coarse_cell_ids.end(),
+                                       coarse_cell_id);
+      if (it == coarse_cell_ids.end() || *it != coarse_cell_id)
+        return numbers::invalid_unsigned_int;
+      return it - coarse_cell_ids.begin();
+    }
+
+
+
+    template <int dim, int spacedim>
+    std::size_t
+    Triangulation<dim, spacedim>::memory_consumption() const
+    {
+      return parallel::Triangulation<dim, spacedim>::memory_consumption() +
+             MemoryConsumption::memory_consumption(coarse_cell_ids);
+    }
+
+  } // namespace fullydistributed
+} // namespace parallel
+
+
+
+/*-------------- Explicit Instantiations -------------------------------*/
+#include "fully_distributed_tria.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,188 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/measured_cell_weights.h>
+
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include <algorithm>
+#include <cmath>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+namespace parallel
+{
+  template <int dim, int spacedim>
+  MeasuredCellWeights<dim, spacedim>::MeasuredCellWeights(
+    const parallel::Triangulation<dim, spacedim> &triangulation,
+    const double                                  smoothing_factor,
+    const unsigned int                            weight_factor)
+    : triangulation(&triangulation, typeid(*this).name())
+    , smoothing_factor(smoothing_factor)
+    , weight_factor(weight_factor)
+  {
+    Assert(smoothing_factor > 0 && smoothing_factor <= 1,
+           ExcMessage("The smoothing factor must be in the interval (0,1]."));
+
+    reset();
+
+    tria_listeners.push_back(triangulation.signals.cell_weight.connect(
+      std::bind(&MeasuredCellWeights<dim, spacedim>::weight_callback,
+                std::cref(*this),
+                std::placeholders::_1,
+                std::placeholders::_2)));
+    tria_listeners.push_back(triangulation.signals.any_change.connect(
+      std::bind(&MeasuredCellWeights<dim, spacedim>::reset, std::ref(*this))));
+    tria_listeners.push_back(
+      triangulation.signals.post_distributed_refinement.connect(std::bind(
+        &MeasuredCellWeights<dim, spacedim>::reset, std::ref(*this))));
+  }
+
+
+
+  template <int dim, int spacedim>
+  MeasuredCellWeights<dim, spacedim>::~MeasuredCellWeights()
+  {
+    for (auto &connection : tria_listeners)
+      connection.disconnect();
+    tria_listeners.clear();
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  MeasuredCellWeights<dim, spacedim>::finish_step()
+  {
+    Assert(current_costs.size() == triangulation->n_active_cells(),
+           ExcInternalError());
+
+    double local_work = 0;
+    for (const auto &cell : triangulation->active_cell_iterators())
+      if (cell->is_locally_owned())
+        {
+          const unsigned int index = cell->active_cell_index();
+          if (n_steps == 0)
+            smoothed_costs[index] = current_costs[index];
+          else
+            smoothed_costs[index] =
+              smoothing_factor * current_costs[index] +
+              (1. - smoothing_factor) * smoothed_costs[index];
+          local_work += smoothed_costs[index];
+        }
+    std::fill(current_costs.begin(), current_costs.end(), 0.);
+    ++n_steps;
+
+    const Utilities::MPI::MinMaxAvg work =
+      Utilities::MPI::min_max_avg(local_work,
+                                  triangulation->get_communicator());
+    average_cost = work.sum / triangulation->n_global_active_cells();
+    imbalance    = (work.avg > 0) ? work.max / work.avg : 1.;
+  }
+
+
+
+  template <int dim, int spacedim>
+  double
+  MeasuredCellWeights<dim, spacedim>::get_imbalance() const
+  {
+    return imbalance;
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  MeasuredCellWeights<dim, spacedim>::n_finished_steps() const
+  {
+    return n_steps;
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  MeasuredCellWeights<dim, spacedim>::reset()
+  {
+    current_costs.assign(triangulation->n_active_cells(), 0.);
+    smoothed_costs.assign(triangulation->n_active_cells(), 0.);
+    average_cost = 0;
+    imbalance    = 1;
+    n_steps      = 0;
+  }
+
+
+
+  template <int dim, int spacedim>
+  unsigned int
+  MeasuredCellWeights<dim, spacedim>::weight_callback(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+    const typename Triangulation<dim, spacedim>::CellStatus     status) const
+  {
+    // without measurements, leave the balancing to the number of cells
+    if (n_steps == 0 || average_cost == 0.)
+      return 0;
+
+    // the weight of a cell of the current mesh, limited such that the sum
+    // over several cells does not overflow
+    const auto weight = [&](const typename Triangulation<dim, spacedim>::
+                              cell_iterator &active_cell) -> double {
+      AssertIndexRange(active_cell->active_cell_index(),
+                       smoothed_costs.size());
+      return std::min(weight_factor *
+                        smoothed_costs[active_cell->active_cell_index()] /
+                        average_cost,
+                      1e8);
+    };
+
+    switch (status)
+      {
+        case Triangulation<dim, spacedim>::CELL_PERSIST:
+          return static_cast<unsigned int>(std::round(weight(cell)));
+
+        // the weight is given to each of the children, so split the cost of
+        // the cell among them
+        case Triangulation<dim, spacedim>::CELL_REFINE:
+        case Triangulation<dim, spacedim>::CELL_INVALID:
+          return static_cast<unsigned int>(std::round(
+            weight(cell) / GeometryInfo<dim>::max_children_per_cell));
+
+        // the cell is the future parent, which gets the cost of all of its
+        // children
+        case Triangulation<dim, spacedim>::CELL_COARSEN:
+          {
+            double parent_weight = 0;
+            for (unsigned int child = 0; child < cell->n_children(); ++child)
+              parent_weight += weight(cell->child(child));
+            return static_cast<unsigned int>(std::round(parent_weight));
+          }
+
+        default:
+          Assert(false, ExcInternalError());
+          return 0;
+      }
+  }
+} // namespace parallel
+
+
+// explicit instantiations
+#include "measured_cell_weights.inst"
+
+DEAL_II_NAMESPACE_CLOSE
@@ -50,14 +50,15 @@ namespace parallel
     {
       const auto partition_settings =
         (partition_zoltan | partition_metis | partition_zorder |
-         partition_custom_signal) &
+         partition_custom_signal | partition_hilbert) &
         settings;
       (void)partition_settings;
       Assert(partition_settings == partition_auto ||
                partition_settings == partition_metis ||
                partition_settings == partition_zoltan ||
                partition_settings == partition_zorder ||
-               partition_settings == partition_custom_signal,
+               partition_settings == partition_custom_signal ||
+               partition_settings == partition_hilbert,
              ExcMessage("Settings must contain exactly one type of the active "
                         "cell partitioning scheme."));
 
@@ -86,9 +87,10 @@ namespace parallel
           "agree on the number of active cells."));
 #  endif
 
-      auto partition_settings = (partition_zoltan | partition_metis |
-                                 partition_zorder | partition_custom_signal) &
-                                settings;
+      auto partition_settings =
+        (partition_zoltan | partition_metis | partition_zorder |
+         partition_custom_signal | partition_hilbert) &
+        settings;
       if (partition_settings == partition_auto)
 #  ifdef DEAL_II_TRILINOS_WITH_ZOLTAN
         partition_settings = partition_zoltan;
@@ -133,6 +135,11 @@ namespace parallel
         {
           GridTools::partition_triangulation_zorder(this->n_subdomains, *this);
         }
+      else if (partition_settings == partition_hilbert)
+        {
+          GridTools::partition_triangulation_hilbert(this->n_subdomains,
+                                                     *this);
+        }
       else if (partition_settings == partition_custom_signal)
         {
           // User partitions mesh manually
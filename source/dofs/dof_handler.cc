@@ -17,6 +17,7 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
+#include <deal.II/distributed/fully_distributed_tria.h>
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
 
@@ -854,8 +855,7 @@ DoFHandler<dim, spacedim>::DoFHandler(const Triangulation<dim, spacedim> &tria)
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
                                ParallelShared<DoFHandler<dim, spacedim>>>(
         *this);
-  else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(
+  else if (dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
              &tria) == nullptr)
     policy =
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
@@ -906,8 +906,7 @@ DoFHandler<dim, spacedim>::initialize(const Triangulation<dim, spacedim> &t,
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
                                ParallelShared<DoFHandler<dim, spacedim>>>(
         *this);
-  else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(&t) !=
+  else if (dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(&t) !=
            nullptr)
     policy =
       std_cxx14::make_unique<internal::DoFHandlerImplementation::Policy::
@@ -1242,6 +1241,9 @@ DoFHandler<dim, spacedim>::distribute_dofs(
   // triangulation. it doesn't work
   // correctly yet if it is parallel
   if (dynamic_cast<const parallel::distributed::Triangulation<dim, spacedim> *>(
+        &*tria) == nullptr &&
+      dynamic_cast<
+        const parallel::fullydistributed::Triangulation<dim, spacedim> *>(
         &*tria) == nullptr)
     block_info_object.initialize(*this, false, true);
 }
@@ -1342,8 +1344,7 @@ DoFHandler<dim, spacedim>::renumber_dofs(
                new_numbers.size() == n_locally_owned_dofs(),
              ExcMessage("Incorrect size of the input array."));
     }
-  else if (dynamic_cast<
-             const parallel::distributed::Triangulation<dim, spacedim> *>(
+  else if (dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
              &*tria) != nullptr)
     {
       AssertDimension(new_numbers.size(), n_locally_owned_dofs());
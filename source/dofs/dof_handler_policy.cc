@@ -21,6 +21,7 @@
 #include <deal.II/base/utilities.h>
 #include <deal.II/base/work_stream.h>
 
+#include <deal.II/distributed/fully_distributed_tria.h>
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
 
@@ -4772,6 +4773,16 @@ namespace internal
 
 
 
+      } // namespace
+
+#endif // DEAL_II_WITH_P4EST
+
+
+
+#ifdef DEAL_II_WITH_MPI
+
+      namespace
+      {
         /**
          * A function that communicates the DoF indices from that subset of
          * locally owned cells that have their user indices set to the
@@ -4793,10 +4804,7 @@ namespace internal
         template <int spacedim>
         void
         communicate_dof_indices_on_marked_cells(
-          const DoFHandler<1, spacedim> &,
-          const std::map<unsigned int, std::set<dealii::types::subdomain_id>> &,
-          const std::vector<dealii::types::global_dof_index> &,
-          const std::vector<dealii::types::global_dof_index> &)
+          const DoFHandler<1, spacedim> &)
         {
           Assert(false, ExcNotImplemented());
         }
@@ -4806,10 +4814,7 @@ namespace internal
         template <int spacedim>
         void
         communicate_dof_indices_on_marked_cells(
-          const hp::DoFHandler<1, spacedim> &,
-          const std::map<unsigned int, std::set<dealii::types::subdomain_id>> &,
-          const std::vector<dealii::types::global_dof_index> &,
-          const std::vector<dealii::types::global_dof_index> &)
+          const hp::DoFHandler<1, spacedim> &)
         {
           Assert(false, ExcNotImplemented());
         }
@@ -4819,15 +4824,8 @@ namespace internal
         template <class DoFHandlerType>
         void
         communicate_dof_indices_on_marked_cells(
-          const DoFHandlerType &dof_handler,
-          const std::map<unsigned int, std::set<dealii::types::subdomain_id>> &,
-          const std::vector<dealii::types::global_dof_index> &,
-          const std::vector<dealii::types::global_dof_index> &)
+          const DoFHandlerType &dof_handler)
         {
-#  ifndef DEAL_II_WITH_MPI
-          (void)vertices_with_ghost_neighbors;
-          Assert(false, ExcNotImplemented());
-#  else
           const unsigned int dim = DoFHandlerType::dimension;
           const unsigned int spacedim = DoFHandlerType::space_dimension;
 
@@ -4875,7 +4873,7 @@ namespace internal
                 // nothing we need to send that hasn't been sent so far.
                 // so return an empty array, but also verify that indeed
                 // the cell is complete
-#    ifdef DEBUG
+#  ifdef DEBUG
                 std::vector<types::global_dof_index> local_dof_indices(
                   cell->get_fe().dofs_per_cell);
                 cell->get_dof_indices(local_dof_indices);
@@ -4886,7 +4884,7 @@ namespace internal
                              numbers::invalid_dof_index) ==
                    local_dof_indices.end());
                 Assert(is_complete, ExcInternalError());
-#    endif
+#  endif
                 return boost::optional<std::vector<types::global_dof_index>>();
               }
           };
@@ -4970,9 +4968,9 @@ namespace internal
           // different tags for phase 1 and 2, but the cost of a
           // barrier is negligible compared to everything else we do
           // here
-          if (const auto *triangulation = dynamic_cast<
-                const parallel::distributed::Triangulation<dim, spacedim> *>(
-                &dof_handler.get_triangulation()))
+          if (const auto *triangulation =
+                dynamic_cast<const parallel::Triangulation<dim, spacedim> *>(
+                  &dof_handler.get_triangulation()))
             {
               const int ierr = MPI_Barrier(triangulation->get_communicator());
               AssertThrowMPI(ierr);
@@ -4984,14 +4982,13 @@ namespace internal
                        "The function communicate_dof_indices_on_marked_cells() "
                        "only works with parallel distributed triangulations."));
             }
-#  endif
         }
 
 
 
       } // namespace
 
-#endif // DEAL_II_WITH_P4EST
+#endif // DEAL_II_WITH_MPI
 
 
 
@@ -5007,15 +5004,15 @@ namespace internal
       NumberCache
       ParallelDistributed<DoFHandlerType>::distribute_dofs() const
       {
-#ifndef DEAL_II_WITH_P4EST
+#ifndef DEAL_II_WITH_MPI
         Assert(false, ExcNotImplemented());
         return NumberCache();
 #else
         const unsigned int dim      = DoFHandlerType::dimension;
         const unsigned int spacedim = DoFHandlerType::space_dimension;
 
-        parallel::distributed::Triangulation<dim, spacedim> *triangulation =
-          (dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+        parallel::Triangulation<dim, spacedim> *triangulation =
+          (dynamic_cast<parallel::Triangulation<dim, spacedim> *>(
             const_cast<dealii::Triangulation<dim, spacedim> *>(
               &dof_handler->get_triangulation())));
         Assert(triangulation != nullptr, ExcInternalError());
@@ -5204,11 +5201,7 @@ namespace internal
           //
           // as explained in the 'distributed' paper, this has to be
           // done twice
-          communicate_dof_indices_on_marked_cells(
-            *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+          communicate_dof_indices_on_marked_cells(*dof_handler);
 
           // in case of hp::DoFHandlers, we may have received valid
           // indices of degrees of freedom that are dominated by a fe
@@ -5222,11 +5215,7 @@ namespace internal
           //                    DoF indices set. however, some ghost cells
           //                    may still have invalid ones. thus, exchange
           //                    one more time.
-          communicate_dof_indices_on_marked_cells(
-            *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+          communicate_dof_indices_on_marked_cells(*dof_handler);
 
           // at this point, we must have taken care of the data transfer
           // on all cells we had previously marked. verify this
@@ -5275,7 +5264,7 @@ namespace internal
         }
 #  endif // DEBUG
         return number_cache;
-#endif   // DEAL_II_WITH_P4EST
+#endif   // DEAL_II_WITH_MPI
       }
 
 
@@ -5284,6 +5273,13 @@ namespace internal
       std::vector<NumberCache>
       ParallelDistributed<DoFHandlerType>::distribute_mg_dofs() const
       {
+        Assert((dynamic_cast<const parallel::fullydistributed::Triangulation<
+                  DoFHandlerType::dimension,
+                  DoFHandlerType::space_dimension> *>(
+                  &dof_handler->get_triangulation()) == nullptr),
+               ExcMessage("Multigrid levels are not supported on a "
+                          "parallel::fullydistributed::Triangulation."));
+
 #ifndef DEAL_II_WITH_P4EST
         Assert(false, ExcNotImplemented());
         return std::vector<NumberCache>();
@@ -5567,15 +5563,15 @@ namespace internal
         Assert(new_numbers.size() == dof_handler->n_locally_owned_dofs(),
                ExcInternalError());
 
-#ifndef DEAL_II_WITH_P4EST
+#ifndef DEAL_II_WITH_MPI
         Assert(false, ExcNotImplemented());
         return NumberCache();
 #else
         const unsigned int dim      = DoFHandlerType::dimension;
         const unsigned int spacedim = DoFHandlerType::space_dimension;
 
-        parallel::distributed::Triangulation<dim, spacedim> *triangulation =
-          (dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+        parallel::Triangulation<dim, spacedim> *triangulation =
+          (dynamic_cast<parallel::Triangulation<dim, spacedim> *>(
             const_cast<dealii::Triangulation<dim, spacedim> *>(
               &dof_handler->get_triangulation())));
         Assert(triangulation != nullptr, ExcInternalError());
@@ -5675,11 +5671,7 @@ namespace internal
           //
           // as explained in the 'distributed' paper, this has to be
           // done twice
-          communicate_dof_indices_on_marked_cells(
-            *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+          communicate_dof_indices_on_marked_cells(*dof_handler);
 
           // in case of hp::DoFHandlers, we may have received valid
           // indices of degrees of freedom that are dominated by a fe
@@ -5689,11 +5681,7 @@ namespace internal
           Implementation::merge_invalid_dof_indices_on_ghost_interfaces(
             *dof_handler);
 
-          communicate_dof_indices_on_marked_cells(
-            *dof_handler,
-            vertices_with_ghost_neighbors,
-            triangulation->coarse_cell_to_p4est_tree_permutation,
-            triangulation->p4est_tree_to_coarse_cell_permutation);
+          communicate_dof_indices_on_marked_cells(*dof_handler);
 
           triangulation->load_user_flags(user_flags);
         }
@@ -5807,6 +5795,13 @@ namespace internal
         const unsigned int                          level,
         const std::vector<types::global_dof_index> &new_numbers) const
       {
+        Assert((dynamic_cast<const parallel::fullydistributed::Triangulation<
+                  DoFHandlerType::dimension,
+                  DoFHandlerType::space_dimension> *>(
+                  &dof_handler->get_triangulation()) == nullptr),
+               ExcMessage("Multigrid levels are not supported on a "
+                          "parallel::fullydistributed::Triangulation."));
+
         // we only implement the case where the multigrid numbers are
         // renumbered within the processor's partition, rather than the most
         // general case
@@ -45,6 +45,7 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <limits>
 #include <memory>
 #include <numeric>
 
@@ -1511,6 +1512,200 @@ namespace internal
         return p_unit;
       }
 
+
+
+      /**
+       * Vectorized Newton iteration for transform_points_real_to_unit_cell()
+       * in case dim==spacedim. The points are processed in batches of the
+       * width of VectorizedArray, evaluating the mapping through the tensor
+       * product of the one-dimensional Lagrange polynomials with the given
+       * @p nodes, defined by the @p support_points in lexicographic order.
+       * On entry, @p unit_points contains the initial guesses. Points for
+       * which the iteration did not converge get <tt>converged[i]=false</tt>,
+       * and the corresponding entry of @p unit_points is left unchanged.
+       */
+      template <int dim>
+      void
+      do_transform_points_real_to_unit_cell(
+        const std::vector<Point<dim>> &    support_points,
+        const std::vector<double> &        nodes,
+        const ArrayView<const Point<dim>> &real_points,
+        const ArrayView<Point<dim>> &      unit_points,
+        std::vector<bool> &                converged)
+      {
+        using VectorType                   = VectorizedArray<double>;
+        const unsigned int n_lanes         = VectorType::n_array_elements;
+        const unsigned int n               = nodes.size();
+        const unsigned int n_shapes        = support_points.size();
+        const double       eps             = 1.e-11;
+        const unsigned int iteration_limit = 20;
+        AssertDimension(n_shapes, Utilities::fixed_power<dim>(n));
+
+        // the denominators of the Lagrange polynomials and the index of each
+        // shape function in the tensor product
+        std::vector<double> inverse_differences(n * n);
+        for (unsigned int i = 0; i < n; ++i)
+          for (unsigned int j = 0; j < n; ++j)
+            if (i != j)
+              inverse_differences[i * n + j] = 1. / (nodes[i] - nodes[j]);
+        std::vector<std::array<unsigned int, dim>> indices(n_shapes);
+        for (unsigned int i = 0; i < n_shapes; ++i)
+          for (unsigned int d = 0, index = i; d < dim; ++d, index /= n)
+            indices[i][d] = index % n;
+
+        std::vector<VectorType> values(dim * n), derivatives(dim * n);
+
+        converged.resize(real_points.size());
+        for (unsigned int begin = 0; begin < real_points.size();
+             begin += n_lanes)
+          {
+            // fill up the last batch by repeating its last point
+            const unsigned int n_points =
+              std::min<unsigned int>(n_lanes, real_points.size() - begin);
+            Point<dim, VectorType> p_target, p_unit;
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              for (unsigned int d = 0; d < dim; ++d)
+                {
+                  const unsigned int i = begin + std::min(v, n_points - 1);
+                  p_target[d][v]       = real_points[i][d];
+                  p_unit[d][v]         = unit_points[i][d];
+                }
+
+            // lanes that have converged and lanes for which the iteration
+            // failed
+            std::array<bool, n_lanes> done, failed;
+            done.fill(false);
+            failed.fill(false);
+            std::array<double, n_lanes> last_residual;
+            last_residual.fill(std::numeric_limits<double>::max());
+
+            for (unsigned int iteration = 0; iteration < iteration_limit;
+                 ++iteration)
+              {
+                // the values and derivatives of the 1d Lagrange polynomials
+                // in all directions
+                for (unsigned int d = 0; d < dim; ++d)
+                  for (unsigned int i = 0; i < n; ++i)
+                    {
+                      VectorType value, derivative;
+                      value      = 1.;
+                      derivative = 0.;
+                      for (unsigned int j = 0; j < n; ++j)
+                        if (j != i)
+                          {
+                            const double inverse =
+                              inverse_differences[i * n + j];
+                            const VectorType factor =
+                              (p_unit[d] - nodes[j]) * inverse;
+                            derivative = derivative * factor + value * inverse;
+                            value *= factor;
+                          }
+                      values[d * n + i]      = value;
+                      derivatives[d * n + i] = derivative;
+                    }
+
+                // evaluate the position and the Jacobian of the mapping
+                Tensor<1, dim, VectorType> f;
+                Tensor<2, dim, VectorType> jacobian;
+                for (unsigned int i = 0; i < n_shapes; ++i)
+                  {
+                    VectorType value;
+                    value = 1.;
+                    Tensor<1, dim, VectorType> gradient;
+                    for (unsigned int e = 0; e < dim; ++e)
+                      gradient[e] = derivatives[e * n + indices[i][e]];
+                    for (unsigned int d = 0; d < dim; ++d)
+                      {
+                        const VectorType v = values[d * n + indices[i][d]];
+                        value *= v;
+                        for (unsigned int e = 0; e < dim; ++e)
+                          if (e != d)
+                            gradient[e] *= v;
+                      }
+                    for (unsigned int c = 0; c < dim; ++c)
+                      {
+                        f[c] += support_points[i][c] * value;
+                        for (unsigned int e = 0; e < dim; ++e)
+                          jacobian[c][e] += support_points[i][c] * gradient[e];
+                      }
+                  }
+                f -= p_target;
+
+                // lanes with a degenerate Jacobian can not continue. replace
+                // their Jacobian by the identity to keep the inverse finite
+                const VectorType det = determinant(jacobian);
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  if (!(det[v] > 0.))
+                    {
+                      failed[v] = true;
+                      for (unsigned int c = 0; c < dim; ++c)
+                        for (unsigned int e = 0; e < dim; ++e)
+                          jacobian[c][e][v] = (c == e) ? 1. : 0.;
+                    }
+                Tensor<1, dim, VectorType> delta = invert(jacobian) * f;
+
+                // check convergence in the norm induced by the Jacobian as
+                // the scalar iteration does. since there is no line search
+                // here, lanes whose residual does not decrease are handed
+                // to the scalar iteration
+                bool all_done = true;
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  {
+                    if (!done[v] && !failed[v])
+                      {
+                        double residual = 0, delta_norm = 0;
+                        for (unsigned int d = 0; d < dim; ++d)
+                          {
+                            residual += f[d][v] * f[d][v];
+                            delta_norm += delta[d][v] * delta[d][v];
+                          }
+                        if (std::sqrt(delta_norm) < eps)
+                          done[v] = true;
+                        else if (residual >= last_residual[v])
+                          failed[v] = true;
+                        last_residual[v] = residual;
+                      }
+                    if (done[v] || failed[v])
+                      for (unsigned int d = 0; d < dim; ++d)
+                        delta[d][v] = 0.;
+                    else
+                      all_done = false;
+                  }
+                if (all_done)
+                  break;
+
+                for (unsigned int d = 0; d < dim; ++d)
+                  p_unit[d] -= delta[d];
+              }
+
+            for (unsigned int v = 0; v < n_points; ++v)
+              {
+                converged[begin + v] = done[v];
+                if (done[v])
+                  for (unsigned int d = 0; d < dim; ++d)
+                    unit_points[begin + v][d] = p_unit[d][v];
+              }
+          }
+      }
+
+
+
+      /**
+       * For dim!=spacedim, the vectorized iteration is not implemented and
+       * all points are handed to the scalar iteration.
+       */
+      template <int dim, int spacedim>
+      void
+      do_transform_points_real_to_unit_cell(
+        const std::vector<Point<spacedim>> &,
+        const std::vector<double> &,
+        const ArrayView<const Point<spacedim>> &real_points,
+        const ArrayView<Point<dim>> &,
+        std::vector<bool> &converged)
+      {
+        converged.assign(real_points.size(), false);
+      }
+
       /**
        * In case the quadrature formula is a tensor product, this is a
        * replacement for maybe_compute_q_points(), maybe_update_Jacobians() and
@@ -2662,6 +2857,112 @@ MappingQGeneric<dim, spacedim>::transform_real_to_unit_cell(
 
 
 
+template <int dim, int spacedim>
+void
+MappingQGeneric<dim, spacedim>::transform_points_real_to_unit_cell(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const ArrayView<const Point<spacedim>> &                    real_points,
+  const ArrayView<Point<dim>> &                               unit_points) const
+{
+  AssertDimension(real_points.size(), unit_points.size());
+
+  // there is nothing to share between the points if there is only one, and
+  // the vectorized iteration is only implemented for dim==spacedim
+  if (real_points.size() < 2 || dim != spacedim)
+    {
+      Mapping<dim, spacedim>::transform_points_real_to_unit_cell(cell,
+                                                                 real_points,
+                                                                 unit_points);
+      return;
+    }
+
+  const std::vector<Point<spacedim>> support_points =
+    this->compute_mapping_support_points(cell);
+
+  // the initial guesses are the same as in transform_real_to_unit_cell(),
+  // i.e., the affine approximation of the cell. since it is an affine
+  // function of the real point, evaluate it once at a vertex and for a step
+  // in each coordinate direction and then apply it to all points. for the
+  // MappingQEulerian type classes, we create a dummy triangulation with the
+  // vertices as explained in transform_real_to_unit_cell()
+  Triangulation<dim, spacedim>                         tria;
+  typename Triangulation<dim, spacedim>::cell_iterator affine_cell = cell;
+  if (this->preserves_vertex_locations() == false)
+    {
+      std::vector<Point<spacedim>> vertices(
+        support_points.begin(),
+        support_points.begin() + GeometryInfo<dim>::vertices_per_cell);
+      std::vector<CellData<dim>> cells(1);
+      for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell; ++i)
+        cells[0].vertices[i] = i;
+      tria.create_triangulation(vertices, cells, SubCellData());
+      affine_cell = tria.begin_active();
+    }
+  const double          h      = affine_cell->diameter();
+  const Point<spacedim> origin = support_points[0];
+  const Point<dim>      p0_unit =
+    affine_cell->real_to_unit_cell_affine_approximation(origin);
+  std::array<Tensor<1, dim>, spacedim> columns;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    {
+      Point<spacedim> step = origin;
+      step[d] += h;
+      columns[d] =
+        (affine_cell->real_to_unit_cell_affine_approximation(step) - p0_unit) /
+        h;
+    }
+  for (unsigned int i = 0; i < real_points.size(); ++i)
+    {
+      Point<dim> p_unit = p0_unit;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        p_unit += (real_points[i][d] - origin[d]) * columns[d];
+      unit_points[i] = GeometryInfo<dim>::project_to_unit_cell(p_unit);
+    }
+
+  // bring the support points into lexicographic order for the tensor
+  // product evaluation
+  const std::vector<unsigned int> renumber(
+    FETools::lexicographic_to_hierarchic_numbering(FiniteElementData<dim>(
+      internal::MappingQGenericImplementation::get_dpo_vector<dim>(
+        polynomial_degree),
+      1,
+      polynomial_degree)));
+  std::vector<Point<spacedim>> lexicographic_support_points(
+    support_points.size());
+  for (unsigned int i = 0; i < support_points.size(); ++i)
+    lexicographic_support_points[i] = support_points[renumber[i]];
+  std::vector<double> nodes(line_support_points.size());
+  for (unsigned int i = 0; i < nodes.size(); ++i)
+    nodes[i] = line_support_points.point(i)[0];
+
+  std::vector<bool> converged;
+  internal::MappingQGenericImplementation::
+    do_transform_points_real_to_unit_cell(lexicographic_support_points,
+                                          nodes,
+                                          real_points,
+                                          unit_points,
+                                          converged);
+
+  // points for which the vectorized iteration did not converge go through
+  // the scalar iteration with its line search
+  for (unsigned int i = 0; i < real_points.size(); ++i)
+    if (converged[i] == false)
+      {
+        try
+          {
+            unit_points[i] =
+              this->transform_real_to_unit_cell(cell, real_points[i]);
+          }
+        catch (typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+          {
+            unit_points[i]    = Point<dim>();
+            unit_points[i][0] = std::numeric_limits<double>::infinity();
+          }
+      }
+}
+
+
+
 template <int dim, int spacedim>
 UpdateFlags
 MappingQGeneric<dim, spacedim>::requires_update_flags(
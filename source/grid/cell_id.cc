@@ -158,9 +158,14 @@ template <int dim, int spacedim>
 typename Triangulation<dim, spacedim>::cell_iterator
 CellId::to_cell(const Triangulation<dim, spacedim> &tria) const
 {
+  const unsigned int coarse_cell_index =
+    tria.coarse_cell_id_to_coarse_cell_index(coarse_cell_id);
+  Assert(coarse_cell_index != numbers::invalid_unsigned_int,
+         ExcMessage("The coarse cell of this CellId is not stored in the "
+                    "given triangulation."));
   typename Triangulation<dim, spacedim>::cell_iterator cell(&tria,
                                                             0,
-                                                            coarse_cell_id);
+                                                            coarse_cell_index);
 
   for (unsigned int i = 0; i < n_child_indices; ++i)
     cell = cell->child(static_cast<unsigned int>(child_indices[i]));
@@ -27,6 +27,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <map>
@@ -91,6 +92,25 @@ namespace
     // vertices except in 1d
     Assert(dim != 1, ExcInternalError());
   }
+
+
+
+  /**
+   * Read a single value of type @p T from a Gmsh file, either as text or, for
+   * binary files, as the bytes of the value in the native representation.
+   */
+  template <typename T>
+  T
+  read_msh_value(std::istream &in, const bool binary)
+  {
+    T value;
+    if (binary)
+      in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    else
+      in >> value;
+    AssertThrow(in, ExcIO());
+    return value;
+  }
 } // namespace
 
 template <int dim, int spacedim>
@@ -1417,6 +1437,7 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
 
   // first determine file format
   unsigned int gmsh_file_format = 0;
+  bool         binary           = false;
   if (line == "$NOD")
     gmsh_file_format = 1;
   else if (line == "$MeshFormat")
@@ -1435,9 +1456,23 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
 
       Assert((version >= 2.0) && (version <= 4.0), ExcNotImplemented());
       gmsh_file_format = static_cast<unsigned int>(version);
-      Assert(file_type == 0, ExcNotImplemented());
+      AssertThrow(file_type == 0 || (file_type == 1 && gmsh_file_format == 4),
+                  ExcMessage("Only the ASCII variant of Gmsh files of "
+                             "versions 1 and 2 and the ASCII and binary "
+                             "variants of version 4 are supported."));
+      binary = (file_type == 1);
       Assert(data_size == sizeof(double), ExcNotImplemented());
 
+      // binary files contain the integer one after the header line, which
+      // allows to check that the file was written with the same endianness
+      if (binary)
+        {
+          std::getline(in, line);
+          AssertThrow(read_msh_value<int>(in, binary) == 1,
+                      ExcMessage("The binary Gmsh file was written on a "
+                                 "machine with a different endianness."));
+        }
+
       // read the end of the header and the first line of the nodes description
       // to synch ourselves with the format 1 handling above
       in >> line;
@@ -1458,105 +1493,46 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       // if the next block is of kind $Entities, parse it
       if (line == "$Entities")
         {
-          unsigned long n_points, n_curves, n_surfaces, n_volumes;
-
-          in >> n_points >> n_curves >> n_surfaces >> n_volumes;
-          for (unsigned int i = 0; i < n_points; ++i)
-            {
-              // parse point ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[0]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              int physical_tag;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              // if there is no physical tag, use 0 as default
-              tag_maps[0][tag] = (n_physicals == 0) ? 0 : physical_tag;
-            }
-          for (unsigned int i = 0; i < n_curves; ++i)
-            {
-              // parse curve ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[1]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              int physical_tag;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              // if there is no physical tag, use 0 as default
-              tag_maps[1][tag] = (n_physicals == 0) ? 0 : physical_tag;
-              // we don't care about the points associated to a curve, but have
-              // to parse them anyway because their format is unstructured
-              in >> n_points;
-              for (unsigned int j = 0; j < n_points; ++j)
-                in >> tag;
-            }
-
-          for (unsigned int i = 0; i < n_surfaces; ++i)
-            {
-              // parse surface ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[2]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              int physical_tag;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              // if there is no physical tag, use 0 as default
-              tag_maps[2][tag] = (n_physicals == 0) ? 0 : physical_tag;
-              // we don't care about the curves associated to a surface, but
-              // have to parse them anyway because their format is unstructured
-              in >> n_curves;
-              for (unsigned int j = 0; j < n_curves; ++j)
-                in >> tag;
-            }
-          for (unsigned int i = 0; i < n_volumes; ++i)
-            {
-              // parse volume ids
-              int          tag;
-              unsigned int n_physicals;
-              double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
-                box_max_z;
-
-              // we only care for 'tag' as key for tag_maps[3]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
-              // if there is a physical tag, we will use it as boundary id below
-              AssertThrow(n_physicals < 2,
-                          ExcMessage("More than one tag is not supported!"));
-              int physical_tag;
-              for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
-              // if there is no physical tag, use 0 as default
-              tag_maps[3][tag] = (n_physicals == 0) ? 0 : physical_tag;
-              // we don't care about the surfaces associated to a volume, but
-              // have to parse them anyway because their format is unstructured
-              in >> n_surfaces;
-              for (unsigned int j = 0; j < n_surfaces; ++j)
-                in >> tag;
-            }
+          if (binary)
+            std::getline(in, line);
+
+          // the entities are given in the order points, curves, surfaces,
+          // and volumes. we only care for the 'tag' of each entity and its
+          // physical tag, if any, but have to parse the rest anyway since
+          // the format is unstructured
+          std::array<unsigned long, 4> n_entities;
+          for (unsigned int d = 0; d < 4; ++d)
+            n_entities[d] = read_msh_value<unsigned long>(in, binary);
+          for (unsigned int d = 0; d < 4; ++d)
+            for (unsigned long i = 0; i < n_entities[d]; ++i)
+              {
+                const int tag = read_msh_value<int>(in, binary);
+                // skip the bounding box
+                for (unsigned int j = 0; j < 6; ++j)
+                  read_msh_value<double>(in, binary);
+
+                // if there is a physical tag, we will use it as boundary id
+                // below
+                const unsigned long n_physicals =
+                  read_msh_value<unsigned long>(in, binary);
+                AssertThrow(n_physicals < 2,
+                            ExcMessage("More than one tag is not supported!"));
+                int physical_tag = 0;
+                for (unsigned long j = 0; j < n_physicals; ++j)
+                  physical_tag = read_msh_value<int>(in, binary);
+                // if there is no physical tag, use 0 as default
+                tag_maps[d][tag] = physical_tag;
+
+                // skip the bounding entities of curves, surfaces, and
+                // volumes
+                if (d > 0)
+                  {
+                    const unsigned long n_bounding_entities =
+                      read_msh_value<unsigned long>(in, binary);
+                    for (unsigned long j = 0; j < n_bounding_entities; ++j)
+                      read_msh_value<int>(in, binary);
+                  }
+              }
           in >> line;
           AssertThrow(line == "$EndEntities", ExcInvalidGMSHInput(line));
           in >> line;
@@ -1577,28 +1553,39 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       // in any case, be the list of
       // nodes:
       AssertThrow(line == "$Nodes", ExcInvalidGMSHInput(line));
+      if (binary)
+        std::getline(in, line);
     }
 
   // now read the nodes list
-  int n_entity_blocks = 1;
+  unsigned long n_entity_blocks = 1;
   if (gmsh_file_format >= 4)
     {
-      in >> n_entity_blocks >> n_vertices;
+      n_entity_blocks = read_msh_value<unsigned long>(in, binary);
+      n_vertices      = read_msh_value<unsigned long>(in, binary);
     }
   else
     in >> n_vertices;
   std::vector<Point<spacedim>> vertices(n_vertices);
-  // set up mapping between numbering
-  // in msh-file (nod) and in the
-  // vertices vector
-  std::map<int, int> vertex_indices;
+  // set up mapping between numbering in msh-file (nod) and in the vertices
+  // vector. rather than a map, which would allocate memory for each vertex,
+  // we store pairs of the number in the file and the index, sorted by the
+  // former, and look up vertices by a binary search. the vertices are usually
+  // numbered consecutively, in which case no sorting is necessary
+  std::vector<std::pair<int, unsigned int>> vertex_indices;
+  vertex_indices.reserve(n_vertices);
+
+  // the buffer used to read blocks of binary data
+  std::vector<char> buffer;
 
   {
     unsigned int global_vertex = 0;
-    for (int entity_block = 0; entity_block < n_entity_blocks; ++entity_block)
+    for (unsigned long entity_block = 0; entity_block < n_entity_blocks;
+         ++entity_block)
       {
         int           parametric;
         unsigned long numNodes;
+        unsigned int  n_parametric_coordinates = 0;
 
         if (gmsh_file_format < 4)
           {
@@ -1607,9 +1594,45 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
           }
         else
           {
-            int tagEntity, dimEntity;
-            in >> tagEntity >> dimEntity >> parametric >> numNodes;
+            read_msh_value<int>(in, binary); // tagEntity
+            const int dimEntity = read_msh_value<int>(in, binary);
+            parametric          = read_msh_value<int>(in, binary);
+            numNodes            = read_msh_value<unsigned long>(in, binary);
+            if (parametric != 0)
+              n_parametric_coordinates =
+                binary ? std::min(dimEntity, 2) : 2;
           }
+
+        AssertThrow(global_vertex + numNodes <= n_vertices,
+                    ExcInvalidGMSHInput("$Nodes"));
+
+        if (binary)
+          {
+            // read the whole block at once: each node consists of its tag,
+            // its coordinates, and possibly parametric coordinates
+            const std::size_t node_size =
+              sizeof(int) + (3 + n_parametric_coordinates) * sizeof(double);
+            buffer.resize(numNodes * node_size);
+            in.read(buffer.data(), buffer.size());
+            AssertThrow(in, ExcIO());
+
+            const char *node = buffer.data();
+            for (unsigned long vertex_per_entity = 0;
+                 vertex_per_entity < numNodes;
+                 ++vertex_per_entity, ++global_vertex, node += node_size)
+              {
+                int    vertex_number;
+                double x[3];
+                std::memcpy(&vertex_number, node, sizeof(int));
+                std::memcpy(x, node + sizeof(int), 3 * sizeof(double));
+
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  vertices[global_vertex](d) = x[d];
+                vertex_indices.emplace_back(vertex_number, global_vertex);
+              }
+            continue;
+          }
+
         for (unsigned long vertex_per_entity = 0; vertex_per_entity < numNodes;
              ++vertex_per_entity, ++global_vertex)
           {
@@ -1622,22 +1645,44 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             for (unsigned int d = 0; d < spacedim; ++d)
               vertices[global_vertex](d) = x[d];
             // store mapping
-            vertex_indices[vertex_number] = global_vertex;
+            vertex_indices.emplace_back(vertex_number, global_vertex);
 
             // ignore parametric coordinates
-            if (parametric != 0)
+            for (unsigned int i = 0; i < n_parametric_coordinates; ++i)
               {
                 double u = 0.;
-                double v = 0.;
-                in >> u >> v;
+                in >> u;
                 (void)u;
-                (void)v;
               }
           }
       }
     AssertDimension(global_vertex, n_vertices);
   }
 
+  // sort the vertex numbers, keeping the vertex that was read last in case a
+  // number appears more than once
+  if (!std::is_sorted(vertex_indices.begin(), vertex_indices.end()))
+    std::stable_sort(vertex_indices.begin(),
+                     vertex_indices.end(),
+                     [](const std::pair<int, unsigned int> &a,
+                        const std::pair<int, unsigned int> &b) {
+                       return a.first < b.first;
+                     });
+  // return the index of the vertex with the given number in the file, or
+  // numbers::invalid_unsigned_int if there is no such vertex
+  const auto find_vertex = [&vertex_indices](const int vertex_number) {
+    auto it = std::upper_bound(vertex_indices.begin(),
+                               vertex_indices.end(),
+                               vertex_number,
+                               [](const int                            number,
+                                  const std::pair<int, unsigned int> &entry) {
+                                 return number < entry.first;
+                               });
+    if (it == vertex_indices.begin() || (--it)->first != vertex_number)
+      return numbers::invalid_unsigned_int;
+    return it->second;
+  };
+
   // Assert we reached the end of the block
   in >> line;
   static const std::string end_nodes_marker[] = {"$ENDNOD", "$EndNodes"};
@@ -1649,11 +1694,14 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   static const std::string begin_elements_marker[] = {"$ELM", "$Elements"};
   AssertThrow(line == begin_elements_marker[gmsh_file_format == 1 ? 0 : 1],
               ExcInvalidGMSHInput(line));
+  if (binary)
+    std::getline(in, line);
 
   // now read the nodes list
   if (gmsh_file_format >= 4)
     {
-      in >> n_entity_blocks >> n_cells;
+      n_entity_blocks = read_msh_value<unsigned long>(in, binary);
+      n_cells         = read_msh_value<unsigned long>(in, binary);
     }
   else
     {
@@ -1668,9 +1716,172 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   SubCellData                                subcelldata;
   std::map<unsigned int, types::boundary_id> boundary_ids_1d;
 
+  /*       `ELM-TYPE'
+           defines the geometrical type of the N-th element:
+           `1'
+           Line (2 nodes, 1 edge).
+
+           `3'
+           Quadrangle (4 nodes, 4 edges).
+
+           `5'
+           Hexahedron (8 nodes, 12 edges, 6 faces).
+
+           `15'
+           Point (1 node).
+  */
+  const auto n_nodes_of_element = [](const int cell_type) -> unsigned int {
+    switch (cell_type)
+      {
+        case 1:
+          return 2;
+        case 3:
+          return 4;
+        case 5:
+          return 8;
+        case 15:
+          return 1;
+        default:
+          return 0;
+      }
+  };
+
+  // add the element of type @p cell_type with the given material id (or
+  // boundary id, for faces) and the vertex numbers @p nodes to the list of
+  // cells or subcells
+  const auto add_element = [&](const int           cell_type,
+                               const unsigned int  material_id,
+                               const int *         nodes,
+                               const unsigned long cell_per_entity,
+                               const unsigned int  elm_number) {
+    if (((cell_type == 1) && (dim == 1)) || ((cell_type == 3) && (dim == 2)) ||
+        ((cell_type == 5) && (dim == 3)))
+      // found a cell
+      {
+        // to make sure that the cast won't fail
+        Assert(material_id <= std::numeric_limits<types::material_id>::max(),
+               ExcIndexRange(material_id,
+                             0,
+                             std::numeric_limits<types::material_id>::max()));
+        // we use only material_ids in the range from 0 to
+        // numbers::invalid_material_id-1
+        Assert(material_id < numbers::invalid_material_id,
+               ExcIndexRange(material_id, 0, numbers::invalid_material_id));
+
+        cells.emplace_back();
+        cells.back().material_id = static_cast<types::material_id>(material_id);
+
+        // transform from ucd to
+        // consecutive numbering
+        for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell; ++i)
+          {
+            cells.back().vertices[i] = find_vertex(nodes[i]);
+            AssertThrow(cells.back().vertices[i] !=
+                          numbers::invalid_unsigned_int,
+                        ExcInvalidVertexIndexGmsh(cell_per_entity,
+                                                  elm_number,
+                                                  nodes[i]));
+          }
+      }
+    else if ((cell_type == 1) && ((dim == 2) || (dim == 3)))
+      // boundary info
+      {
+        subcelldata.boundary_lines.emplace_back();
+
+        // to make sure that the cast won't fail
+        Assert(material_id <= std::numeric_limits<types::boundary_id>::max(),
+               ExcIndexRange(material_id,
+                             0,
+                             std::numeric_limits<types::boundary_id>::max()));
+        // we use only boundary_ids in the range from 0 to
+        // numbers::internal_face_boundary_id-1
+        Assert(material_id < numbers::internal_face_boundary_id,
+               ExcIndexRange(material_id,
+                             0,
+                             numbers::internal_face_boundary_id));
+
+        subcelldata.boundary_lines.back().boundary_id =
+          static_cast<types::boundary_id>(material_id);
+
+        // transform from ucd to
+        // consecutive numbering
+        for (unsigned int i = 0; i < 2; ++i)
+          {
+            unsigned int &vertex =
+              subcelldata.boundary_lines.back().vertices[i];
+            vertex = find_vertex(nodes[i]);
+            // no such vertex index
+            AssertThrow(vertex != numbers::invalid_unsigned_int,
+                        ExcInvalidVertexIndex(cell_per_entity, nodes[i]));
+          }
+      }
+    else if ((cell_type == 3) && (dim == 3))
+      // boundary info
+      {
+        subcelldata.boundary_quads.emplace_back();
+
+        // to make sure that the cast won't fail
+        Assert(material_id <= std::numeric_limits<types::boundary_id>::max(),
+               ExcIndexRange(material_id,
+                             0,
+                             std::numeric_limits<types::boundary_id>::max()));
+        // we use only boundary_ids in the range from 0 to
+        // numbers::internal_face_boundary_id-1
+        Assert(material_id < numbers::internal_face_boundary_id,
+               ExcIndexRange(material_id,
+                             0,
+                             numbers::internal_face_boundary_id));
+
+        subcelldata.boundary_quads.back().boundary_id =
+          static_cast<types::boundary_id>(material_id);
+
+        // transform from gmsh to
+        // consecutive numbering
+        for (unsigned int i = 0; i < 4; ++i)
+          {
+            unsigned int &vertex =
+              subcelldata.boundary_quads.back().vertices[i];
+            vertex = find_vertex(nodes[i]);
+            // no such vertex index
+            Assert(vertex != numbers::invalid_unsigned_int,
+                   ExcInvalidVertexIndex(cell_per_entity, nodes[i]));
+          }
+      }
+    else if (cell_type == 15)
+      {
+        // we only care about boundary indicators assigned to individual
+        // vertices in 1d (because otherwise the vertices are not faces)
+        if (dim == 1)
+          boundary_ids_1d[find_vertex(nodes[0])] = material_id;
+      }
+    else
+      // cannot read this, so throw
+      // an exception. treat
+      // triangles and tetrahedra
+      // specially since this
+      // deserves a more explicit
+      // error message
+      {
+        AssertThrow(cell_type != 2,
+                    ExcMessage("Found triangles while reading a file "
+                               "in gmsh format. deal.II does not "
+                               "support triangles"));
+        AssertThrow(cell_type != 11,
+                    ExcMessage("Found tetrahedra while reading a file "
+                               "in gmsh format. deal.II does not "
+                               "support tetrahedra"));
+
+        AssertThrow(false, ExcGmshUnsupportedGeometry(cell_type));
+      }
+  };
+
   {
     unsigned int global_cell = 0;
-    for (int entity_block = 0; entity_block < n_entity_blocks; ++entity_block)
+    // the vertex numbers of an element, or of all elements of a block for
+    // binary files
+    std::vector<int> nodes;
+    for (unsigned long entity_block = 0; entity_block < n_entity_blocks;
+         ++entity_block)
       {
         unsigned int  material_id;
         unsigned long numElements;
@@ -1684,11 +1895,37 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
           }
         else
           {
-            int tagEntity, dimEntity;
-            in >> tagEntity >> dimEntity >> cell_type >> numElements;
+            const int tagEntity = read_msh_value<int>(in, binary);
+            const int dimEntity = read_msh_value<int>(in, binary);
+            cell_type           = read_msh_value<int>(in, binary);
+            numElements         = read_msh_value<unsigned long>(in, binary);
+            AssertIndexRange(dimEntity, 4);
             material_id = tag_maps[dimEntity][tagEntity];
           }
-        for (unsigned int cell_per_entity = 0; cell_per_entity < numElements;
+
+        if (binary)
+          {
+            // read the whole block at once: each element consists of its
+            // tag and the numbers of its vertices
+            const unsigned int n_nodes = n_nodes_of_element(cell_type);
+            AssertThrow(n_nodes > 0, ExcGmshUnsupportedGeometry(cell_type));
+            nodes.resize(numElements * (1 + n_nodes));
+            in.read(reinterpret_cast<char *>(nodes.data()),
+                    nodes.size() * sizeof(int));
+            AssertThrow(in, ExcIO());
+
+            for (unsigned long cell_per_entity = 0;
+                 cell_per_entity < numElements;
+                 ++cell_per_entity, ++global_cell)
+              add_element(cell_type,
+                          material_id,
+                          &nodes[cell_per_entity * (1 + n_nodes) + 1],
+                          cell_per_entity,
+                          nodes[cell_per_entity * (1 + n_nodes)]);
+            continue;
+          }
+
+        for (unsigned long cell_per_entity = 0; cell_per_entity < numElements;
              ++cell_per_entity, ++global_cell)
           {
             // note that since in the input
@@ -1750,7 +1987,7 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                     for (unsigned int i = 1; i < n_tags; ++i)
                       in >> dummy;
 
-                    nod_num = GeometryInfo<dim>::vertices_per_cell;
+                    nod_num = n_nodes_of_element(cell_type);
 
                     break;
                   }
@@ -1760,7 +1997,7 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                     // ignore tag
                     int tag;
                     in >> tag;
-                    nod_num = GeometryInfo<dim>::vertices_per_cell;
+                    nod_num = n_nodes_of_element(cell_type);
                     break;
                   }
 
@@ -1769,201 +2006,30 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                   AssertThrow(false, ExcNotImplemented());
               }
 
-
-            /*       `ELM-TYPE'
-                     defines the geometrical type of the N-th element:
-                     `1'
-                     Line (2 nodes, 1 edge).
-
-                     `3'
-                     Quadrangle (4 nodes, 4 edges).
-
-                     `5'
-                     Hexahedron (8 nodes, 12 edges, 6 faces).
-
-                     `15'
-                     Point (1 node).
-            */
-
             if (((cell_type == 1) && (dim == 1)) ||
                 ((cell_type == 3) && (dim == 2)) ||
                 ((cell_type == 5) && (dim == 3)))
-              // found a cell
-              {
-                AssertThrow(nod_num == GeometryInfo<dim>::vertices_per_cell,
-                            ExcMessage(
-                              "Number of nodes does not coincide with the "
-                              "number required for this object"));
-
-                // allocate and read indices
-                cells.emplace_back();
-                for (unsigned int i = 0;
-                     i < GeometryInfo<dim>::vertices_per_cell;
-                     ++i)
-                  in >> cells.back().vertices[i];
-
-                // to make sure that the cast won't fail
-                Assert(material_id <=
-                         std::numeric_limits<types::material_id>::max(),
-                       ExcIndexRange(
-                         material_id,
-                         0,
-                         std::numeric_limits<types::material_id>::max()));
-                // we use only material_ids in the range from 0 to
-                // numbers::invalid_material_id-1
-                Assert(material_id < numbers::invalid_material_id,
-                       ExcIndexRange(material_id,
-                                     0,
-                                     numbers::invalid_material_id));
-
-                cells.back().material_id =
-                  static_cast<types::material_id>(material_id);
-
-                // transform from ucd to
-                // consecutive numbering
-                for (unsigned int i = 0;
-                     i < GeometryInfo<dim>::vertices_per_cell;
-                     ++i)
-                  {
-                    AssertThrow(
-                      vertex_indices.find(cells.back().vertices[i]) !=
-                        vertex_indices.end(),
-                      ExcInvalidVertexIndexGmsh(cell_per_entity,
-                                                elm_number,
-                                                cells.back().vertices[i]));
-
-                    // vertex with this index exists
-                    cells.back().vertices[i] =
-                      vertex_indices[cells.back().vertices[i]];
-                  }
-              }
-            else if ((cell_type == 1) && ((dim == 2) || (dim == 3)))
-              // boundary info
-              {
-                subcelldata.boundary_lines.emplace_back();
-                in >> subcelldata.boundary_lines.back().vertices[0] >>
-                  subcelldata.boundary_lines.back().vertices[1];
-
-                // to make sure that the cast won't fail
-                Assert(material_id <=
-                         std::numeric_limits<types::boundary_id>::max(),
-                       ExcIndexRange(
-                         material_id,
-                         0,
-                         std::numeric_limits<types::boundary_id>::max()));
-                // we use only boundary_ids in the range from 0 to
-                // numbers::internal_face_boundary_id-1
-                Assert(material_id < numbers::internal_face_boundary_id,
-                       ExcIndexRange(material_id,
-                                     0,
-                                     numbers::internal_face_boundary_id));
-
-                subcelldata.boundary_lines.back().boundary_id =
-                  static_cast<types::boundary_id>(material_id);
-
-                // transform from ucd to
-                // consecutive numbering
-                for (unsigned int &vertex :
-                     subcelldata.boundary_lines.back().vertices)
-                  if (vertex_indices.find(vertex) != vertex_indices.end())
-                    // vertex with this index exists
-                    vertex = vertex_indices[vertex];
-                  else
-                    {
-                      // no such vertex index
-                      AssertThrow(false,
-                                  ExcInvalidVertexIndex(cell_per_entity,
-                                                        vertex));
-                      vertex = numbers::invalid_unsigned_int;
-                    }
-              }
-            else if ((cell_type == 3) && (dim == 3))
-              // boundary info
-              {
-                subcelldata.boundary_quads.emplace_back();
-                in >> subcelldata.boundary_quads.back().vertices[0] >>
-                  subcelldata.boundary_quads.back().vertices[1] >>
-                  subcelldata.boundary_quads.back().vertices[2] >>
-                  subcelldata.boundary_quads.back().vertices[3];
-
-                // to make sure that the cast won't fail
-                Assert(material_id <=
-                         std::numeric_limits<types::boundary_id>::max(),
-                       ExcIndexRange(
-                         material_id,
-                         0,
-                         std::numeric_limits<types::boundary_id>::max()));
-                // we use only boundary_ids in the range from 0 to
-                // numbers::internal_face_boundary_id-1
-                Assert(material_id < numbers::internal_face_boundary_id,
-                       ExcIndexRange(material_id,
-                                     0,
-                                     numbers::internal_face_boundary_id));
-
-                subcelldata.boundary_quads.back().boundary_id =
-                  static_cast<types::boundary_id>(material_id);
-
-                // transform from gmsh to
-                // consecutive numbering
-                for (unsigned int &vertex :
-                     subcelldata.boundary_quads.back().vertices)
-                  if (vertex_indices.find(vertex) != vertex_indices.end())
-                    // vertex with this index exists
-                    vertex = vertex_indices[vertex];
-                  else
-                    {
-                      // no such vertex index
-                      Assert(false,
-                             ExcInvalidVertexIndex(cell_per_entity, vertex));
-                      vertex = numbers::invalid_unsigned_int;
-                    }
-              }
-            else if (cell_type == 15)
-              {
-                // read the indices of nodes given
-                unsigned int node_index = 0;
-                switch (gmsh_file_format)
-                  {
-                    case 1:
-                      {
-                        for (unsigned int i = 0; i < nod_num; ++i)
-                          in >> node_index;
-                        break;
-                      }
-                    case 2:
-                    case 4:
-                      {
-                        in >> node_index;
-                        break;
-                      }
-                    default:
-                      Assert(false, ExcInternalError());
-                  }
-
-                // we only care about boundary indicators assigned to individual
-                // vertices in 1d (because otherwise the vertices are not faces)
-                if (dim == 1)
-                  boundary_ids_1d[vertex_indices[node_index]] = material_id;
-              }
-            else
-              // cannot read this, so throw
-              // an exception. treat
-              // triangles and tetrahedra
-              // specially since this
-              // deserves a more explicit
-              // error message
-              {
-                AssertThrow(cell_type != 2,
-                            ExcMessage("Found triangles while reading a file "
-                                       "in gmsh format. deal.II does not "
-                                       "support triangles"));
-                AssertThrow(cell_type != 11,
-                            ExcMessage("Found tetrahedra while reading a file "
-                                       "in gmsh format. deal.II does not "
-                                       "support tetrahedra"));
-
-                AssertThrow(false, ExcGmshUnsupportedGeometry(cell_type));
-              }
+              AssertThrow(nod_num == GeometryInfo<dim>::vertices_per_cell,
+                          ExcMessage(
+                            "Number of nodes does not coincide with the "
+                            "number required for this object"));
+
+            // read the vertex numbers, unless the element is of a type we
+            // can not handle anyway. for points in version 1, the vertex is
+            // the last one of the list
+            unsigned int n_nodes = n_nodes_of_element(cell_type);
+            if (cell_type == 15 && gmsh_file_format == 1)
+              n_nodes = nod_num;
+            nodes.resize(std::max(n_nodes, 1U));
+            for (unsigned int i = 0; i < n_nodes; ++i)
+              in >> nodes[i];
+
+            add_element(cell_type,
+                        material_id,
+                        (cell_type == 15) ? &nodes[nodes.size() - 1] :
+                                            nodes.data(),
+                        cell_per_entity,
+                        elm_number);
           }
       }
     AssertDimension(global_cell, n_cells);
@@ -15,8 +15,10 @@
 
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi.templates.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/thread_management.h>
+#include <deal.II/base/utilities.h>
 
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
@@ -2943,6 +2945,146 @@ namespace GridTools
   }
 
 
+
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_hilbert(const unsigned int            n_partitions,
+                                  Triangulation<dim, spacedim> &triangulation)
+  {
+    std::vector<unsigned int> cell_weights;
+
+    // Get cell weighting if a signal has been attached to the triangulation,
+    // on top of the same base weight per cell as used by p4est
+    if (!triangulation.signals.cell_weight.empty())
+      {
+        cell_weights.resize(triangulation.n_active_cells());
+        for (const auto &cell : triangulation.active_cell_iterators())
+          cell_weights[cell->active_cell_index()] =
+            1000 + triangulation.signals.cell_weight(
+                     cell,
+                     Triangulation<dim, spacedim>::CellStatus::CELL_PERSIST);
+      }
+
+    // Call the other more general function
+    partition_triangulation_hilbert(n_partitions, cell_weights, triangulation);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  partition_triangulation_hilbert(const unsigned int               n_partitions,
+                                  const std::vector<unsigned int> &cell_weights,
+                                  Triangulation<dim, spacedim> &triangulation)
+  {
+    Assert((dynamic_cast<parallel::distributed::Triangulation<dim, spacedim> *>(
+              &triangulation) == nullptr),
+           ExcMessage("Objects of type parallel::distributed::Triangulation "
+                      "are already partitioned implicitly and can not be "
+                      "partitioned again explicitly."));
+    Assert(n_partitions > 0, ExcInvalidNumberOfPartitions(n_partitions));
+    Assert(cell_weights.empty() ||
+             cell_weights.size() == triangulation.n_active_cells(),
+           ExcDimensionMismatch(cell_weights.size(),
+                                triangulation.n_active_cells()));
+
+    // check for an easy return
+    if (n_partitions == 1)
+      {
+        for (const auto &cell : triangulation.active_cell_iterators())
+          cell->set_subdomain_id(0);
+        return;
+      }
+
+    const unsigned int n_active_cells = triangulation.n_active_cells();
+    std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>
+      cells(n_active_cells);
+    for (const auto &cell : triangulation.active_cell_iterators())
+      cells[cell->active_cell_index()] = cell;
+
+    // compute the cell centers in parallel, and then the bounding box of
+    // all of them
+    std::vector<Point<spacedim>> centers(n_active_cells);
+    parallel::apply_to_subranges(
+      0U,
+      n_active_cells,
+      [&](const unsigned int begin, const unsigned int end) {
+        for (unsigned int i = begin; i < end; ++i)
+          centers[i] = cells[i]->center();
+      },
+      /* grainsize = */ 256);
+
+    Point<spacedim> lower_left = centers[0], upper_right = centers[0];
+    for (const auto &center : centers)
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          lower_left[d]  = std::min(lower_left[d], center[d]);
+          upper_right[d] = std::max(upper_right[d], center[d]);
+        }
+
+    // map the centers to integer coordinates in the bounding box and compute
+    // their indices on the Hilbert curve, again in parallel. 32 bits per
+    // direction resolve the cells of any mesh that fits into memory. We do
+    // not use the version of inverse_Hilbert_space_filling_curve() for
+    // points, because the bounding box may be flat, e.g., for the centers
+    // of a single layer of cells
+    const int    bits_per_dim = 32;
+    const double max_int      = static_cast<double>((1ULL << bits_per_dim) - 1);
+
+    std::vector<std::pair<std::array<std::uint64_t, spacedim>, unsigned int>>
+      curve_indices(n_active_cells);
+    parallel::apply_to_subranges(
+      0U,
+      n_active_cells,
+      [&](const unsigned int begin, const unsigned int end) {
+        std::vector<std::array<std::uint64_t, spacedim>> int_points(end -
+                                                                     begin);
+        for (unsigned int i = begin; i < end; ++i)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              const double extent = upper_right[d] - lower_left[d];
+              int_points[i - begin][d] =
+                (extent > 0 ? static_cast<std::uint64_t>(
+                                (centers[i][d] - lower_left[d]) / extent *
+                                max_int) :
+                              0);
+            }
+
+        const std::vector<std::array<std::uint64_t, spacedim>> indices =
+          Utilities::inverse_Hilbert_space_filling_curve<spacedim>(
+            int_points, bits_per_dim);
+        for (unsigned int i = begin; i < end; ++i)
+          curve_indices[i] = std::make_pair(indices[i - begin], i);
+      },
+      /* grainsize = */ 1024);
+
+    // sort the cells along the curve. cells with the same index are ordered
+    // by their active cell index, so the order is the same on all processes
+    std::sort(curve_indices.begin(), curve_indices.end());
+
+    std::uint64_t total_weight = 0;
+    for (const unsigned int weight : cell_weights)
+      total_weight += weight;
+    const bool use_weights = (total_weight > 0);
+    if (!use_weights)
+      total_weight = n_active_cells;
+
+    // finally cut the curve into pieces of equal weight: each cell goes to the
+    // partition that contains the midpoint of its interval on the curve
+    std::uint64_t weight_before = 0;
+    for (const auto &curve_index : curve_indices)
+      {
+        const std::uint64_t weight =
+          (use_weights ? cell_weights[curve_index.second] : 1);
+        const unsigned int partition = static_cast<unsigned int>(
+          (weight_before + 0.5 * weight) * n_partitions / total_weight);
+        cells[curve_index.second]->set_subdomain_id(
+          std::min(partition, n_partitions - 1));
+        weight_before += weight;
+      }
+  }
+
+
   template <int dim, int spacedim>
   void
   partition_multigrid_levels(Triangulation<dim, spacedim> &triangulation)
@@ -5058,14 +5200,124 @@ namespace GridTools
       cache.get_vertex_to_cell_centers_directions();
     const auto &used_vertices_rtree = cache.get_used_vertices_rtree();
 
-    return find_active_cell_around_point(mapping,
-                                         mesh,
-                                         p,
-                                         vertex_to_cells,
-                                         vertex_to_cell_centers,
-                                         cell_hint,
-                                         marked_vertices,
-                                         used_vertices_rtree);
+    try
+      {
+        return find_active_cell_around_point(mapping,
+                                             mesh,
+                                             p,
+                                             vertex_to_cells,
+                                             vertex_to_cell_centers,
+                                             cell_hint,
+                                             marked_vertices,
+                                             used_vertices_rtree);
+      }
+    catch (const ExcPointNotFound<spacedim> &)
+      {
+        // the cells around the closest vertices do not necessarily contain
+        // the point, so check all cells whose bounding box contains it
+        // before giving up. building the bucket grid is expensive, so only
+        // do this if the caller has already asked for it
+        if (!marked_vertices.empty() || !cache.has_cell_bucket_grid())
+          throw;
+
+        const auto cell_and_position =
+          find_active_cells_around_points(cache,
+                                          std::vector<Point<spacedim>>(1, p))
+            .front();
+        if (cell_and_position.first.state() != IteratorState::valid)
+          throw;
+        return cell_and_position;
+      }
+  }
+
+
+
+  template <int dim, int spacedim>
+  std::vector<
+    std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+              Point<dim>>>
+  find_active_cells_around_points(const Cache<dim, spacedim> &        cache,
+                                  const std::vector<Point<spacedim>> &points)
+  {
+    const auto &mapping = cache.get_mapping();
+    const auto &buckets = cache.get_cell_bucket_grid();
+
+    std::vector<
+      std::pair<typename Triangulation<dim, spacedim>::active_cell_iterator,
+                Point<dim>>>
+      cells_and_positions(points.size());
+
+    // sort the points by the buckets they lie in. points outside of the grid
+    // of buckets get an invalid bucket index and come last
+    std::vector<std::pair<unsigned int, unsigned int>> sorted_points(
+      points.size());
+    for (unsigned int i = 0; i < points.size(); ++i)
+      sorted_points[i] = std::make_pair(buckets.bucket_index(points[i]), i);
+    std::sort(sorted_points.begin(), sorted_points.end());
+
+    unsigned int previous_cell = numbers::invalid_unsigned_int;
+    for (const auto &bucket_and_point : sorted_points)
+      {
+        const Point<spacedim> &p = points[bucket_and_point.second];
+        auto &cell_and_position  = cells_and_positions[bucket_and_point.second];
+
+        // as in find_active_cell_around_point(), keep the closest cell
+        // within a tolerance as a backup for points on the boundary of cells
+        double       best_distance = 1e-10;
+        unsigned int best_cell     = numbers::invalid_unsigned_int;
+        Point<dim>   best_position;
+
+        // transform the point to the reference coordinates of the given cell
+        // and return whether it lies inside
+        const auto point_in_cell = [&](const unsigned int cell_index) -> bool {
+          try
+            {
+              const Point<dim> p_unit =
+                mapping.transform_real_to_unit_cell(buckets.get_cell(
+                                                      cell_index),
+                                                    p);
+              if (GeometryInfo<dim>::is_inside_unit_cell(p_unit))
+                {
+                  best_cell     = cell_index;
+                  best_position = p_unit;
+                  return true;
+                }
+              const double dist =
+                GeometryInfo<dim>::distance_to_unit_cell(p_unit);
+              if (dist < best_distance)
+                {
+                  best_distance = dist;
+                  best_cell     = cell_index;
+                  best_position = p_unit;
+                }
+            }
+          catch (typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+            {}
+          return false;
+        };
+
+        // first test the cell of the previous point, then all cells of the
+        // bucket whose bounding box contains the point
+        bool found = (previous_cell != numbers::invalid_unsigned_int &&
+                      buckets.point_inside_cell_box(p, previous_cell) &&
+                      point_in_cell(previous_cell));
+        if (!found && bucket_and_point.first != numbers::invalid_unsigned_int)
+          for (const unsigned int cell_index :
+               buckets.get_cells_in_bucket(bucket_and_point.first))
+            if (cell_index != previous_cell &&
+                buckets.point_inside_cell_box(p, cell_index) &&
+                point_in_cell(cell_index))
+              break;
+
+        if (best_cell != numbers::invalid_unsigned_int)
+          {
+            cell_and_position.first  = buckets.get_cell(best_cell);
+            cell_and_position.second = best_position;
+            previous_cell            = best_cell;
+          }
+      }
+
+    return cells_and_positions;
   }
 
   template <int spacedim>
@@ -15,6 +15,7 @@
 
 #include <deal.II/base/bounding_box.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
 
 #include <deal.II/grid/filtered_iterator.h>
 #include <deal.II/grid/grid_tools.h>
@@ -22,10 +23,176 @@
 
 #include <boost/geometry.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace GridTools
 {
+  template <int dim, int spacedim>
+  void
+  CellBucketGrid<dim, spacedim>::reinit(
+    const Triangulation<dim, spacedim> &tria,
+    const Mapping<dim, spacedim> &      mapping)
+  {
+    const unsigned int n_cells = tria.n_active_cells();
+    cells.resize(n_cells);
+    cell_boxes.resize(2 * spacedim * n_cells);
+    bucket_start.clear();
+    bucket_cells.clear();
+    if (n_cells == 0)
+      return;
+
+    // compute the bounding boxes of the cells from the vertices seen by the
+    // mapping and the bounding box of the whole mesh. the mapping may curve
+    // the cells beyond the bounding box of their vertices, so we also map a
+    // lattice of points including the midpoints of the edges and faces, and
+    // enlarge the boxes by twice the amount by which these points stick out
+    // of the box of the vertices. finally, add a small tolerance to catch
+    // points on the faces of the cells
+    std::vector<Point<dim>> unit_points;
+    {
+      const unsigned int n_points_1d = 3;
+      for (unsigned int i = 0; i < Utilities::fixed_power<dim>(n_points_1d);
+           ++i)
+        {
+          Point<dim>   unit_point;
+          unsigned int index = i;
+          for (unsigned int d = 0; d < dim; ++d, index /= n_points_1d)
+            unit_point[d] = 0.5 * (index % n_points_1d);
+          unit_points.push_back(unit_point);
+        }
+    }
+
+    Point<spacedim> upper_corner;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        lower_corner[d] = std::numeric_limits<double>::max();
+        upper_corner[d] = -std::numeric_limits<double>::max();
+      }
+    for (const auto &cell : tria.active_cell_iterators())
+      {
+        const unsigned int index = cell->active_cell_index();
+        cells[index]             = cell;
+
+        const auto vertices = mapping.get_vertices(cell);
+        double *   box      = cell_boxes.data() + 2 * spacedim * index;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          box[d] = box[spacedim + d] = vertices[0][d];
+        for (unsigned int v = 1; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              box[d]            = std::min(box[d], vertices[v][d]);
+              box[spacedim + d] = std::max(box[spacedim + d], vertices[v][d]);
+            }
+
+        double curvature = 0.;
+        for (const Point<dim> &unit_point : unit_points)
+          {
+            const Point<spacedim> point =
+              mapping.transform_unit_to_real_cell(cell, unit_point);
+            for (unsigned int d = 0; d < spacedim; ++d)
+              curvature = std::max(curvature,
+                                   std::max(box[d] - point[d],
+                                            point[d] - box[spacedim + d]));
+          }
+
+        double extent = 0.;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          extent = std::max(extent, box[spacedim + d] - box[d]);
+        const double enlargement = 2. * curvature + 1e-10 * extent;
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            box[d] -= enlargement;
+            box[spacedim + d] += enlargement;
+            lower_corner[d] = std::min(lower_corner[d], box[d]);
+            upper_corner[d] = std::max(upper_corner[d], box[spacedim + d]);
+          }
+      }
+
+    // choose the size of the buckets such that there is about one cell per
+    // bucket. directions in which the mesh has no extent, like the normal
+    // direction of a flat mesh in codimension one, get a single bucket
+    double max_extent = 0.;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      max_extent = std::max(max_extent, upper_corner[d] - lower_corner[d]);
+    double       volume       = 1.;
+    unsigned int n_directions = 0;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      if (upper_corner[d] - lower_corner[d] > 1e-6 * max_extent)
+        {
+          volume *= upper_corner[d] - lower_corner[d];
+          ++n_directions;
+        }
+    const double bucket_size =
+      (n_directions > 0) ? std::pow(volume / n_cells, 1. / n_directions) : 1.;
+
+    std::array<unsigned int, 3> n_buckets_3d = {{1, 1, 1}};
+    unsigned int                n_buckets    = 1;
+    for (unsigned int d = 0; d < spacedim; ++d)
+      {
+        const double extent = upper_corner[d] - lower_corner[d];
+        n_buckets_per_direction[d] =
+          (extent > 1e-6 * max_extent) ?
+            std::max(1U,
+                     static_cast<unsigned int>(
+                       std::round(extent / bucket_size))) :
+            1U;
+        inverse_bucket_size[d] =
+          (extent > 0.) ? n_buckets_per_direction[d] / extent : 0.;
+        n_buckets_3d[d] = n_buckets_per_direction[d];
+        n_buckets *= n_buckets_per_direction[d];
+      }
+
+    // call the given function with the index of every bucket intersected by
+    // the bounding box of the cell with the given index
+    const auto for_each_bucket =
+      [&](const unsigned int                             index,
+          const std::function<void(const unsigned int)> &function) {
+        const double *box = cell_boxes.data() + 2 * spacedim * index;
+        std::array<unsigned int, 3> begin = {{0, 0, 0}};
+        std::array<unsigned int, 3> end   = {{1, 1, 1}};
+        for (unsigned int d = 0; d < spacedim; ++d)
+          {
+            const auto coordinate = [&](const double x) -> unsigned int {
+              const double position =
+                (x - lower_corner[d]) * inverse_bucket_size[d];
+              return std::min(static_cast<unsigned int>(std::max(0., position)),
+                              n_buckets_per_direction[d] - 1);
+            };
+            begin[d] = coordinate(box[d]);
+            end[d]   = coordinate(box[spacedim + d]) + 1;
+          }
+        for (unsigned int k = begin[2]; k < end[2]; ++k)
+          for (unsigned int j = begin[1]; j < end[1]; ++j)
+            for (unsigned int i = begin[0]; i < end[0]; ++i)
+              function(i + n_buckets_3d[0] * (j + n_buckets_3d[1] * k));
+      };
+
+    // count the cells in each bucket and then fill the buckets, in compressed
+    // row storage
+    bucket_start.resize(n_buckets + 1, 0);
+    for (unsigned int index = 0; index < n_cells; ++index)
+      for_each_bucket(index, [&](const unsigned int bucket) {
+        ++bucket_start[bucket + 1];
+      });
+    for (unsigned int bucket = 0; bucket < n_buckets; ++bucket)
+      bucket_start[bucket + 1] += bucket_start[bucket];
+
+    bucket_cells.resize(bucket_start.back());
+    std::vector<unsigned int> next_entry(bucket_start.begin(),
+                                         bucket_start.end() - 1);
+    for (unsigned int index = 0; index < n_cells; ++index)
+      for_each_bucket(index, [&](const unsigned int bucket) {
+        bucket_cells[next_entry[bucket]++] = index;
+      });
+  }
+
+
+
   template <int dim, int spacedim>
   Cache<dim, spacedim>::Cache(const Triangulation<dim, spacedim> &tria,
                               const Mapping<dim, spacedim> &      mapping)
@@ -142,6 +309,29 @@ namespace GridTools
 
 
 
+  template <int dim, int spacedim>
+  const CellBucketGrid<dim, spacedim> &
+  Cache<dim, spacedim>::get_cell_bucket_grid() const
+  {
+    if (update_flags & update_cell_bucket_grid)
+      {
+        cell_bucket_grid.reinit(*tria, *mapping);
+        update_flags = update_flags & ~update_cell_bucket_grid;
+      }
+    return cell_bucket_grid;
+  }
+
+
+
+  template <int dim, int spacedim>
+  bool
+  Cache<dim, spacedim>::has_cell_bucket_grid() const
+  {
+    return !(update_flags & update_cell_bucket_grid);
+  }
+
+
+
 #ifdef DEAL_II_WITH_NANOFLANN
   template <int dim, int spacedim>
   const KDTree<spacedim> &
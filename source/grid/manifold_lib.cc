@@ -1559,6 +1559,7 @@ TransfiniteInterpolationManifold<dim,
                                  spacedim>::TransfiniteInterpolationManifold()
   : triangulation(nullptr)
   , level_coarse(-1)
+  , chart_point_cache_enabled(false)
 {
   AssertThrow(dim > 1, ExcNotImplemented());
 }
@@ -1571,6 +1572,8 @@ TransfiniteInterpolationManifold<dim,
 {
   if (clear_signal.connected())
     clear_signal.disconnect();
+  if (change_signal.connected())
+    change_signal.disconnect();
 }
 
 
@@ -1580,6 +1583,7 @@ std::unique_ptr<Manifold<dim, spacedim>>
 TransfiniteInterpolationManifold<dim, spacedim>::clone() const
 {
   auto ptr = new TransfiniteInterpolationManifold<dim, spacedim>();
+  ptr->use_chart_point_cache(chart_point_cache_enabled);
   if (triangulation)
     ptr->initialize(*triangulation);
   return std::unique_ptr<Manifold<dim, spacedim>>(ptr);
@@ -1598,6 +1602,18 @@ TransfiniteInterpolationManifold<dim, spacedim>::initialize(
     this->triangulation = nullptr;
     this->level_coarse  = -1;
   });
+  // the chart coordinates of points depend on the coarse cells, so we have
+  // to forget about them when the mesh changes
+  if (change_signal.connected())
+    change_signal.disconnect();
+  change_signal = triangulation.signals.any_change.connect([&]() -> void {
+    std::lock_guard<std::mutex> lock(chart_point_cache_mutex);
+    chart_point_cache.clear();
+  });
+  {
+    std::lock_guard<std::mutex> lock(chart_point_cache_mutex);
+    chart_point_cache.clear();
+  }
   level_coarse = triangulation.last()->level();
   coarse_cell_is_flat.resize(triangulation.n_cells(level_coarse), false);
   typename Triangulation<dim, spacedim>::active_cell_iterator
@@ -2117,6 +2133,49 @@ TransfiniteInterpolationManifold<dim, spacedim>::pull_back(
 
 
 
+template <int dim, int spacedim>
+void
+TransfiniteInterpolationManifold<dim, spacedim>::use_chart_point_cache(
+  const bool use_cache)
+{
+  std::lock_guard<std::mutex> lock(chart_point_cache_mutex);
+  chart_point_cache_enabled = use_cache;
+  chart_point_cache.clear();
+}
+
+
+
+template <int dim, int spacedim>
+Point<dim>
+TransfiniteInterpolationManifold<dim, spacedim>::cached_pull_back(
+  const typename Triangulation<dim, spacedim>::cell_iterator &cell,
+  const Point<spacedim> &                                     point) const
+{
+  std::pair<unsigned int, std::array<double, spacedim>> key;
+  key.first = cell->index();
+  for (unsigned int d = 0; d < spacedim; ++d)
+    key.second[d] = point[d];
+
+  {
+    std::lock_guard<std::mutex> lock(chart_point_cache_mutex);
+    const auto entry = chart_point_cache.find(key);
+    if (entry != chart_point_cache.end())
+      return entry->second;
+  }
+
+  // do not hold the lock during the expensive Newton iteration. if another
+  // thread computes the same point concurrently, both get the same result
+  // since the initial guess only depends on the cell and the point
+  const Point<dim> chart_point =
+    pull_back(cell, point, cell->real_to_unit_cell_affine_approximation(point));
+
+  std::lock_guard<std::mutex> lock(chart_point_cache_mutex);
+  chart_point_cache.emplace(key, chart_point);
+  return chart_point;
+}
+
+
+
 template <int dim, int spacedim>
 std::array<unsigned int, 20>
 TransfiniteInterpolationManifold<dim, spacedim>::
@@ -2339,6 +2398,18 @@ TransfiniteInterpolationManifold<dim, spacedim>::compute_chart_points(
       bool inside_unit_cell = true;
       for (unsigned int i = 0; i < surrounding_points.size(); ++i)
         {
+          if (chart_point_cache_enabled)
+            {
+              chart_points[i] = cached_pull_back(cell, surrounding_points[i]);
+              if (GeometryInfo<dim>::is_inside_unit_cell(chart_points[i],
+                                                         1e-6) == false)
+                {
+                  inside_unit_cell = false;
+                  break;
+                }
+              continue;
+            }
+
           Point<dim> guess;
           // an optimization: keep track of whether or not we used the affine
           // approximation so that we don't call pull_back with the same
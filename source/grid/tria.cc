@@ -16,6 +16,7 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/std_cxx14/memory.h>
 
 #include <deal.II/fe/mapping_q1.h>
@@ -4632,6 +4633,37 @@ namespace internal
 
 
 
+      /**
+       * Compute the coordinates of the new vertices with the indices given
+       * in @p vertex_indices, where the coordinates of the vertex
+       * <tt>vertex_indices[i]</tt> are given by <tt>new_point(i)</tt>.
+       *
+       * Computing a new point on a curved manifold can be expensive, so
+       * the refinement functions below first enumerate all new vertices of
+       * a kind of objects, along with the children of these objects, and
+       * then compute the coordinates of all of them through this function,
+       * in parallel. The new points only depend on vertices that already
+       * exist, and each of them is written to its own slot of the vertices
+       * array, so the result does not depend on the number of threads.
+       */
+      template <int dim, int spacedim, typename Function>
+      static void
+      compute_new_vertices(Triangulation<dim, spacedim> &   triangulation,
+                           const std::vector<unsigned int> &vertex_indices,
+                           const Function &                 new_point)
+      {
+        parallel::apply_to_subranges(
+          0U,
+          static_cast<unsigned int>(vertex_indices.size()),
+          [&](const unsigned int begin, const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              triangulation.vertices[vertex_indices[i]] = new_point(i);
+          },
+          /* grainsize = */ 64);
+      }
+
+
+
       /**
        * A function that performs the
        * refinement of a triangulation in 1d.
@@ -5083,6 +5115,15 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // the lines that are refined, the manifolds on which their new
+          // midpoints are placed, and the indices of these vertices. the
+          // coordinates of the vertices are computed in parallel once all
+          // lines are refined
+          std::vector<typename Triangulation<dim, spacedim>::line_iterator>
+                                                      refined_lines;
+          std::vector<const Manifold<dim, spacedim> *> line_manifolds;
+          std::vector<unsigned int>                   new_line_vertices;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5098,6 +5139,8 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
+                refined_lines.push_back(line);
+                new_line_vertices.push_back(next_unused_vertex);
                 if (spacedim == dim)
                   {
                     // for the case of a domain in an
@@ -5105,8 +5148,7 @@ namespace internal
                     // boundary lines differently; for interior
                     // lines we can compute the midpoint as the mean
                     // of the two vertices: if (line->at_boundary())
-                    triangulation.vertices[next_unused_vertex] =
-                      line->center(true);
+                    line_manifolds.push_back(&line->get_manifold());
                   }
                 else
                   // however, if spacedim>dim, we always have to ask
@@ -5115,16 +5157,13 @@ namespace internal
                   // line->user_index() before) unless a manifold_id
                   // has been set on this very line.
                   if (line->manifold_id() == numbers::flat_manifold_id)
-                  triangulation.vertices[next_unused_vertex] =
-                    triangulation.get_manifold(line->user_index())
-                      .get_new_point_on_line(line);
+                  line_manifolds.push_back(
+                    &triangulation.get_manifold(line->user_index()));
                 else
-                  triangulation.vertices[next_unused_vertex] =
-                    line->center(true);
+                  line_manifolds.push_back(&line->get_manifold());
 
-                // now that we created the right point, make up the
-                // two child lines.  To this end, find a pair of
-                // unused lines
+                // make up the two child lines.  To this end, find a
+                // pair of unused lines
                 bool pair_found = false;
                 (void)pair_found;
                 for (; next_unused_line != endl; ++next_unused_line)
@@ -5185,6 +5224,13 @@ namespace internal
                 // refinement
                 line->clear_user_flag();
               }
+
+          compute_new_vertices(triangulation,
+                               new_line_vertices,
+                               [&](const unsigned int i) {
+                                 return line_manifolds[i]
+                                   ->get_new_point_on_line(refined_lines[i]);
+                               });
         }
 
 
@@ -5587,6 +5633,13 @@ namespace internal
           typename Triangulation<dim, spacedim>::raw_line_iterator
             next_unused_line = triangulation.begin_raw_line();
 
+          // the lines that are refined and the indices of their new
+          // midpoints, whose coordinates are computed in parallel once all
+          // lines are refined
+          std::vector<typename Triangulation<dim, spacedim>::line_iterator>
+                                    refined_lines;
+          std::vector<unsigned int> new_line_vertices;
+
           for (; line != endl; ++line)
             if (line->user_flag_set())
               {
@@ -5602,11 +5655,11 @@ namespace internal
                     "Internal error: During refinement, the triangulation wants to access an element of the 'vertices' array but it turns out that the array is not large enough."));
                 triangulation.vertices_used[next_unused_vertex] = true;
 
-                triangulation.vertices[next_unused_vertex] = line->center(true);
+                refined_lines.push_back(line);
+                new_line_vertices.push_back(next_unused_vertex);
 
-                // now that we created the right point, make up the
-                // two child lines (++ takes care of the end of the
-                // vector)
+                // make up the two child lines (++ takes care of the
+                // end of the vector)
                 next_unused_line =
                   triangulation.faces->lines.next_free_pair_object(
                     triangulation);
@@ -5660,6 +5713,12 @@ namespace internal
                 // for refinement
                 line->clear_user_flag();
               }
+
+          compute_new_vertices(triangulation,
+                               new_line_vertices,
+                               [&](const unsigned int i) {
+                                 return refined_lines[i]->center(true);
+                               });
         }
 
 
@@ -5701,6 +5760,13 @@ namespace internal
             typename Triangulation<dim, spacedim>::raw_quad_iterator
               next_unused_quad = triangulation.begin_raw_quad();
 
+            // the quads that are refined isotropically and the indices of
+            // their new midpoints, whose coordinates are computed in
+            // parallel at the end of each pass
+            std::vector<typename Triangulation<dim, spacedim>::quad_iterator>
+                                      refined_quads;
+            std::vector<unsigned int> new_quad_vertices;
+
             for (; quad != endq; ++quad)
               {
                 if (quad->user_index())
@@ -6368,13 +6434,12 @@ namespace internal
                     // optimal shape. their description uses the formulas
                     // underlying the TransfiniteInterpolationManifold
                     // implementation
-                    triangulation.vertices[next_unused_vertex] =
-                      quad->center(true, true);
+                    refined_quads.push_back(quad);
+                    new_quad_vertices.push_back(next_unused_vertex);
                     triangulation.vertices_used[next_unused_vertex] = true;
 
-                    // now that we created the right point, make up
-                    // the four lines interior to the quad (++ takes
-                    // care of the end of the vector)
+                    // now make up the four lines interior to the quad
+                    // (++ takes care of the end of the vector)
                     typename Triangulation<dim, spacedim>::raw_line_iterator
                       new_lines[4];
 
@@ -6614,7 +6679,13 @@ namespace internal
                     quad->clear_user_flag();
                   } // if (isotropic refinement)
               }     // for all quads
-          }         // looped two times over all quads, all quads refined now
+
+            compute_new_vertices(triangulation,
+                                 new_quad_vertices,
+                                 [&](const unsigned int i) {
+                                   return refined_quads[i]->center(true, true);
+                                 });
+          } // looped two times over all quads, all quads refined now
 
         ///////////////////////////////////
         // Now, finally, set up the new
@@ -13260,6 +13331,28 @@ Triangulation<dim, spacedim>::locally_owned_subdomain() const
 
 
 
+template <int dim, int spacedim>
+types::coarse_cell_id
+Triangulation<dim, spacedim>::coarse_cell_index_to_coarse_cell_id(
+  const unsigned int coarse_cell_index) const
+{
+  AssertIndexRange(coarse_cell_index, n_cells(0));
+  return coarse_cell_index;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+Triangulation<dim, spacedim>::coarse_cell_id_to_coarse_cell_index(
+  const types::coarse_cell_id coarse_cell_id) const
+{
+  AssertIndexRange(coarse_cell_id, n_cells(0));
+  return coarse_cell_id;
+}
+
+
+
 template <int dim, int spacedim>
 Triangulation<dim, spacedim> &
 Triangulation<dim, spacedim>::get_triangulation()
@@ -15109,19 +15202,30 @@ std::size_t
 Triangulation<dim, spacedim>::memory_consumption() const
 {
   std::size_t mem = 0;
-  mem += MemoryConsumption::memory_consumption(levels);
+  for (const auto &field : memory_consumption_per_field())
+    mem += field.second;
+
+  return mem;
+}
+
+
+
+template <int dim, int spacedim>
+std::map<std::string, std::size_t>
+Triangulation<dim, spacedim>::memory_consumption_per_field() const
+{
+  std::map<std::string, std::size_t> fields;
+  fields["levels"] = MemoryConsumption::memory_consumption(levels);
   for (unsigned int i = 0; i < levels.size(); ++i)
-    mem += MemoryConsumption::memory_consumption(*levels[i]);
-  mem += MemoryConsumption::memory_consumption(vertices);
-  mem += MemoryConsumption::memory_consumption(vertices_used);
-  mem += sizeof(manifold);
-  mem += sizeof(smooth_grid);
-  mem += MemoryConsumption::memory_consumption(number_cache);
-  mem += sizeof(faces);
+    levels[i]->add_memory_consumption(fields);
+  fields["vertices"]      = MemoryConsumption::memory_consumption(vertices);
+  fields["vertices_used"] = MemoryConsumption::memory_consumption(vertices_used);
+  fields["number_cache"]  = MemoryConsumption::memory_consumption(number_cache);
+  fields["other"] = sizeof(manifold) + sizeof(smooth_grid) + sizeof(faces);
   if (faces)
-    mem += MemoryConsumption::memory_consumption(*faces);
+    faces->add_memory_consumption(fields);
 
-  return mem;
+  return fields;
 }
 
 
@@ -2216,9 +2216,10 @@ CellAccessor<dim, spacedim>::id() const
     }
 
   Assert(ptr.level() == 0, ExcInternalError());
-  const unsigned int coarse_index = ptr.index();
+  const types::coarse_cell_id coarse_cell_id =
+    this->tria->coarse_cell_index_to_coarse_cell_id(ptr.index());
 
-  return {coarse_index, n_child_indices, id.data()};
+  return {coarse_cell_id, n_child_indices, id.data()};
 }
 
 
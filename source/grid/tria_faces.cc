@@ -32,6 +32,12 @@ namespace internal
     }
 
 
+    void
+    TriaFaces<1>::add_memory_consumption(
+      std::map<std::string, std::size_t> &) const
+    {}
+
+
     std::size_t
     TriaFaces<2>::memory_consumption() const
     {
@@ -39,12 +45,29 @@ namespace internal
     }
 
 
+    void
+    TriaFaces<2>::add_memory_consumption(
+      std::map<std::string, std::size_t> &fields) const
+    {
+      lines.add_memory_consumption(fields, "faces.lines");
+    }
+
+
     std::size_t
     TriaFaces<3>::memory_consumption() const
     {
       return (MemoryConsumption::memory_consumption(quads) +
               MemoryConsumption::memory_consumption(lines));
     }
+
+
+    void
+    TriaFaces<3>::add_memory_consumption(
+      std::map<std::string, std::size_t> &fields) const
+    {
+      quads.add_memory_consumption(fields, "faces.quads");
+      lines.add_memory_consumption(fields, "faces.lines");
+    }
   } // namespace TriangulationImplementation
 } // namespace internal
 
@@ -113,6 +113,30 @@ namespace internal
               MemoryConsumption::memory_consumption(cells));
     }
 
+
+    template <int dim>
+    void
+    TriaLevel<dim>::add_memory_consumption(
+      std::map<std::string, std::size_t> &fields) const
+    {
+      fields["level.refine_flags"] +=
+        MemoryConsumption::memory_consumption(refine_flags);
+      fields["level.coarsen_flags"] +=
+        MemoryConsumption::memory_consumption(coarsen_flags);
+      fields["level.active_cell_indices"] +=
+        MemoryConsumption::memory_consumption(active_cell_indices);
+      fields["level.neighbors"] +=
+        MemoryConsumption::memory_consumption(neighbors);
+      fields["level.subdomain_ids"] +=
+        MemoryConsumption::memory_consumption(subdomain_ids);
+      fields["level.level_subdomain_ids"] +=
+        MemoryConsumption::memory_consumption(level_subdomain_ids);
+      fields["level.parents"] += MemoryConsumption::memory_consumption(parents);
+      fields["level.direction_flags"] +=
+        MemoryConsumption::memory_consumption(direction_flags);
+      cells.add_memory_consumption(fields, "cells");
+    }
+
     // This specialization should be only temporary, until the TriaObjects
     // classes are straightened out.
 
@@ -197,10 +221,34 @@ namespace internal
               MemoryConsumption::memory_consumption(active_cell_indices) +
               MemoryConsumption::memory_consumption(neighbors) +
               MemoryConsumption::memory_consumption(subdomain_ids) +
+              MemoryConsumption::memory_consumption(level_subdomain_ids) +
               MemoryConsumption::memory_consumption(parents) +
               MemoryConsumption::memory_consumption(direction_flags) +
               MemoryConsumption::memory_consumption(cells));
     }
+
+
+    void
+    TriaLevel<3>::add_memory_consumption(
+      std::map<std::string, std::size_t> &fields) const
+    {
+      fields["level.refine_flags"] +=
+        MemoryConsumption::memory_consumption(refine_flags);
+      fields["level.coarsen_flags"] +=
+        MemoryConsumption::memory_consumption(coarsen_flags);
+      fields["level.active_cell_indices"] +=
+        MemoryConsumption::memory_consumption(active_cell_indices);
+      fields["level.neighbors"] +=
+        MemoryConsumption::memory_consumption(neighbors);
+      fields["level.subdomain_ids"] +=
+        MemoryConsumption::memory_consumption(subdomain_ids);
+      fields["level.level_subdomain_ids"] +=
+        MemoryConsumption::memory_consumption(level_subdomain_ids);
+      fields["level.parents"] += MemoryConsumption::memory_consumption(parents);
+      fields["level.direction_flags"] +=
+        MemoryConsumption::memory_consumption(direction_flags);
+      cells.add_memory_consumption(fields, "cells");
+    }
   } // namespace TriangulationImplementation
 } // namespace internal
 
@@ -118,13 +118,21 @@ namespace internal
           boundary_or_material_id.reserve(new_size);
           boundary_or_material_id.resize(new_size);
 
-          user_data.reserve(new_size);
-          user_data.resize(new_size);
+          // the user data and manifold ids are only stored once they are
+          // used, see the documentation of these fields
+          if (user_data.size() != 0)
+            {
+              user_data.reserve(new_size);
+              user_data.resize(new_size);
+            }
 
-          manifold_id.reserve(new_size);
-          manifold_id.insert(manifold_id.end(),
-                             new_size - manifold_id.size(),
-                             numbers::flat_manifold_id);
+          if (manifold_id.size() != 0)
+            {
+              manifold_id.reserve(new_size);
+              manifold_id.insert(manifold_id.end(),
+                                 new_size - manifold_id.size(),
+                                 numbers::flat_manifold_id);
+            }
         }
 
       if (n_unused_singles == 0)
@@ -200,13 +208,19 @@ namespace internal
           boundary_or_material_id.reserve(new_size);
           boundary_or_material_id.resize(new_size);
 
-          manifold_id.reserve(new_size);
-          manifold_id.insert(manifold_id.end(),
-                             new_size - manifold_id.size(),
-                             numbers::flat_manifold_id);
+          if (manifold_id.size() != 0)
+            {
+              manifold_id.reserve(new_size);
+              manifold_id.insert(manifold_id.end(),
+                                 new_size - manifold_id.size(),
+                                 numbers::flat_manifold_id);
+            }
 
-          user_data.reserve(new_size);
-          user_data.resize(new_size);
+          if (user_data.size() != 0)
+            {
+              user_data.reserve(new_size);
+              user_data.resize(new_size);
+            }
 
           face_orientations.reserve(new_size * GeometryInfo<3>::faces_per_cell);
           face_orientations.insert(face_orientations.end(),
@@ -317,9 +331,9 @@ namespace internal
              ExcMemoryInexact(cells.size(), children.size()));
       Assert(cells.size() == boundary_or_material_id.size(),
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
-      Assert(cells.size() == manifold_id.size(),
+      Assert(manifold_id.size() == 0 || cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.size() == 0 || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
     }
 
@@ -338,9 +352,9 @@ namespace internal
              ExcMemoryInexact(cells.size(), refinement_cases.size()));
       Assert(cells.size() == boundary_or_material_id.size(),
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
-      Assert(cells.size() == manifold_id.size(),
+      Assert(manifold_id.size() == 0 || cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.size() == 0 || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
     }
 
@@ -356,9 +370,9 @@ namespace internal
              ExcMemoryInexact(cells.size(), children.size()));
       Assert(cells.size() == boundary_or_material_id.size(),
              ExcMemoryInexact(cells.size(), boundary_or_material_id.size()));
-      Assert(cells.size() == manifold_id.size(),
+      Assert(manifold_id.size() == 0 || cells.size() == manifold_id.size(),
              ExcMemoryInexact(cells.size(), manifold_id.size()));
-      Assert(cells.size() == user_data.size(),
+      Assert(user_data.size() == 0 || cells.size() == user_data.size(),
              ExcMemoryInexact(cells.size(), user_data.size()));
       Assert(cells.size() * GeometryInfo<3>::faces_per_cell ==
                face_orientations.size(),
@@ -401,7 +415,8 @@ namespace internal
       boundary_or_material_id.clear();
       manifold_id.clear();
       user_data.clear();
-      user_data_type = data_unknown;
+      user_data_type               = data_unknown;
+      user_data_is_allocated.value = false;
     }
 
 
@@ -438,6 +453,29 @@ namespace internal
     }
 
 
+    template <typename G>
+    void
+    TriaObjects<G>::add_memory_consumption(
+      std::map<std::string, std::size_t> &fields,
+      const std::string &                 prefix) const
+    {
+      fields[prefix + ".cells"] += MemoryConsumption::memory_consumption(cells);
+      fields[prefix + ".children"] +=
+        MemoryConsumption::memory_consumption(children);
+      fields[prefix + ".refinement_cases"] +=
+        MemoryConsumption::memory_consumption(refinement_cases);
+      fields[prefix + ".used"] += MemoryConsumption::memory_consumption(used);
+      fields[prefix + ".user_flags"] +=
+        MemoryConsumption::memory_consumption(user_flags);
+      fields[prefix + ".boundary_or_material_id"] +=
+        MemoryConsumption::memory_consumption(boundary_or_material_id);
+      fields[prefix + ".manifold_id"] +=
+        MemoryConsumption::memory_consumption(manifold_id);
+      fields[prefix + ".user_data"] +=
+        user_data.capacity() * sizeof(UserData) + sizeof(user_data);
+    }
+
+
     std::size_t
     TriaObjectsHex::memory_consumption() const
     {
@@ -448,6 +486,19 @@ namespace internal
     }
 
 
+    void
+    TriaObjectsHex::add_memory_consumption(
+      std::map<std::string, std::size_t> &fields,
+      const std::string &                 prefix) const
+    {
+      TriaObjects<TriaObject<3>>::add_memory_consumption(fields, prefix);
+      fields[prefix + ".face_orientations"] +=
+        MemoryConsumption::memory_consumption(face_orientations) +
+        MemoryConsumption::memory_consumption(face_flips) +
+        MemoryConsumption::memory_consumption(face_rotations);
+    }
+
+
     std::size_t
     TriaObjectsQuad3D::memory_consumption() const
     {
@@ -456,6 +507,17 @@ namespace internal
     }
 
 
+    void
+    TriaObjectsQuad3D::add_memory_consumption(
+      std::map<std::string, std::size_t> &fields,
+      const std::string &                 prefix) const
+    {
+      TriaObjects<TriaObject<2>>::add_memory_consumption(fields, prefix);
+      fields[prefix + ".line_orientations"] +=
+        MemoryConsumption::memory_consumption(line_orientations);
+    }
+
+
 
     // explicit instantiations
     template class TriaObjects<TriaObject<1>>;
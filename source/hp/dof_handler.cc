@@ -18,6 +18,7 @@
 #include <deal.II/base/std_cxx14/memory.h>
 #include <deal.II/base/thread_management.h>
 
+#include <deal.II/distributed/fully_distributed_tria.h>
 #include <deal.II/distributed/shared_tria.h>
 #include <deal.II/distributed/tria.h>
 
@@ -991,10 +992,9 @@ namespace internal
                     cell->index(),
                     active_fe_indices[cell->active_cell_index()]);
             }
-          else if (const parallel::distributed::Triangulation<dim, spacedim>
-                     *tr = dynamic_cast<
-                       const parallel::distributed::Triangulation<dim, spacedim>
-                         *>(&dof_handler.get_triangulation()))
+          else if (dynamic_cast<
+                     const parallel::Triangulation<dim, spacedim> *>(
+                     &dof_handler.get_triangulation()) != nullptr)
             {
               // For completely distributed meshes, use the function that is
               // able to move data from locally owned cells on one processor to
@@ -1556,6 +1556,16 @@ namespace hp
                           spacedim>::post_distributed_active_fe_index_transfer,
               std::ref(*this))));
       }
+    else if (dynamic_cast<
+               const parallel::fullydistributed::Triangulation<dim, spacedim> *>(
+               &this->get_triangulation()) != nullptr)
+      {
+        // the triangulation can not be refined, so there is no need to
+        // transfer the active_fe_indices
+        policy = std_cxx14::make_unique<
+          internal::DoFHandlerImplementation::Policy::ParallelDistributed<
+            DoFHandler<dim, spacedim>>>(*this);
+      }
     else if (dynamic_cast<const parallel::shared::Triangulation<dim, spacedim>
                             *>(&this->get_triangulation()) != nullptr)
       {
@@ -782,13 +782,6 @@ namespace Particles
       std::vector<typename Triangulation<dim, spacedim>::active_cell_iterator>>
       &send_cells)
   {
-    // Determine the communication pattern
-    const std::set<types::subdomain_id> ghost_owners =
-      triangulation->ghost_owners();
-    const std::vector<types::subdomain_id> neighbors(ghost_owners.begin(),
-                                                     ghost_owners.end());
-    const unsigned int                     n_neighbors = neighbors.size();
-
     if (send_cells.size() != 0)
       Assert(particles_to_send.size() == send_cells.size(), ExcInternalError());
 
@@ -798,191 +791,93 @@ namespace Particles
              particles_to_send.end(),
            ExcInternalError());
 
-    // TODO: Implement the shipping of particles to processes that are not ghost
-    // owners of the local domain
-    for (auto send_particles = particles_to_send.begin();
-         send_particles != particles_to_send.end();
-         ++send_particles)
-      Assert(ghost_owners.find(send_particles->first) != ghost_owners.end(),
-             ExcNotImplemented());
-
-    unsigned int n_send_particles = 0;
-    for (auto send_particles = particles_to_send.begin();
-         send_particles != particles_to_send.end();
-         ++send_particles)
-      n_send_particles += send_particles->second.size();
-
     const unsigned int cellid_size = sizeof(CellId::binary_type);
 
-    // Containers for the amount and offsets of data we will send
-    // to other processors and the data itself.
-    std::vector<unsigned int> n_send_data(n_neighbors, 0);
-    std::vector<unsigned int> send_offsets(n_neighbors, 0);
-    std::vector<char>         send_data;
-
-    // Only serialize things if there are particles to be send.
-    // We can not return early even if no particles
-    // are send, because we might receive particles from other processes
-    if (n_send_particles > 0)
+    // The data we will send to other processors, serialized separately for
+    // each receiving process. Processes we do not send particles to do not
+    // get a message at all, and the processes we will receive particles from
+    // are determined by Utilities::MPI::some_to_some(), so we neither need to
+    // exchange the amount of data with all neighbors beforehand nor restrict
+    // the receiving processes to the owners of ghost cells
+    std::map<unsigned int, std::vector<char>> send_data;
+    for (const auto &send_particles : particles_to_send)
       {
+        if (send_particles.second.size() == 0)
+          continue;
+
         // Allocate space for sending particle data
         const unsigned int particle_size =
           begin()->serialized_size_in_bytes() + cellid_size +
           (size_callback ? size_callback() : 0);
-        send_data.resize(n_send_particles * particle_size);
-        void *data = static_cast<void *>(&send_data.front());
+        std::vector<char> &buffer = send_data[send_particles.first];
+        buffer.resize(send_particles.second.size() * particle_size);
+        void *data = static_cast<void *>(buffer.data());
 
-        // Serialize the data sorted by receiving process
-        for (unsigned int i = 0; i < n_neighbors; ++i)
+        for (unsigned int j = 0; j < send_particles.second.size(); ++j)
           {
-            send_offsets[i] = reinterpret_cast<std::size_t>(data) -
-                              reinterpret_cast<std::size_t>(&send_data.front());
+            // If no target cells are given, use the iterator information
+            typename Triangulation<dim, spacedim>::active_cell_iterator cell;
+            if (send_cells.size() == 0)
+              cell =
+                send_particles.second[j]->get_surrounding_cell(*triangulation);
+            else
+              cell = send_cells.at(send_particles.first)[j];
 
-            for (unsigned int j = 0;
-                 j < particles_to_send.at(neighbors[i]).size();
-                 ++j)
-              {
-                // If no target cells are given, use the iterator information
-                typename Triangulation<dim, spacedim>::active_cell_iterator
-                  cell;
-                if (send_cells.size() == 0)
-                  cell =
-                    particles_to_send.at(neighbors[i])[j]->get_surrounding_cell(
-                      *triangulation);
-                else
-                  cell = send_cells.at(neighbors[i])[j];
-
-                const CellId::binary_type cellid =
-                  cell->id().template to_binary<dim>();
-                memcpy(data, &cellid, cellid_size);
-                data = static_cast<char *>(data) + cellid_size;
-
-                particles_to_send.at(neighbors[i])[j]->write_data(data);
-                if (store_callback)
-                  data =
-                    store_callback(particles_to_send.at(neighbors[i])[j], data);
-              }
-            n_send_data[i] = reinterpret_cast<std::size_t>(data) -
-                             send_offsets[i] -
-                             reinterpret_cast<std::size_t>(&send_data.front());
+            const CellId::binary_type cellid =
+              cell->id().template to_binary<dim>();
+            memcpy(data, &cellid, cellid_size);
+            data = static_cast<char *>(data) + cellid_size;
+
+            send_particles.second[j]->write_data(data);
+            if (store_callback)
+              data = store_callback(send_particles.second[j], data);
           }
+        buffer.resize(reinterpret_cast<std::size_t>(data) -
+                      reinterpret_cast<std::size_t>(buffer.data()));
       }
 
-    // Containers for the data we will receive from other processors
-    std::vector<unsigned int> n_recv_data(n_neighbors);
-    std::vector<unsigned int> recv_offsets(n_neighbors);
-
-    // Notify other processors how many particles we will send
-    {
-      std::vector<MPI_Request> n_requests(2 * n_neighbors);
-      for (unsigned int i = 0; i < n_neighbors; ++i)
-        {
-          const int ierr = MPI_Irecv(&(n_recv_data[i]),
-                                     1,
-                                     MPI_UNSIGNED,
-                                     neighbors[i],
-                                     0,
-                                     triangulation->get_communicator(),
-                                     &(n_requests[2 * i]));
-          AssertThrowMPI(ierr);
-        }
-      for (unsigned int i = 0; i < n_neighbors; ++i)
-        {
-          const int ierr = MPI_Isend(&(n_send_data[i]),
-                                     1,
-                                     MPI_UNSIGNED,
-                                     neighbors[i],
-                                     0,
-                                     triangulation->get_communicator(),
-                                     &(n_requests[2 * i + 1]));
-          AssertThrowMPI(ierr);
-        }
-      const int ierr =
-        MPI_Waitall(2 * n_neighbors, n_requests.data(), MPI_STATUSES_IGNORE);
-      AssertThrowMPI(ierr);
-    }
+    // Exchange the particle data between domains
+    const std::map<unsigned int, std::vector<char>> recv_data =
+      dealii::Utilities::MPI::some_to_some(triangulation->get_communicator(),
+                                           send_data);
 
-    // Determine how many particles and data we will receive
-    unsigned int total_recv_data = 0;
-    for (unsigned int neighbor_id = 0; neighbor_id < n_neighbors; ++neighbor_id)
+    // Put the received particles into the domain if they are in the
+    // triangulation
+    for (const auto &rank_data : recv_data)
       {
-        recv_offsets[neighbor_id] = total_recv_data;
-        total_recv_data += n_recv_data[neighbor_id];
-      }
+        const std::vector<char> &buffer       = rank_data.second;
+        const void *             recv_data_it = buffer.data();
 
-    // Set up the space for the received particle data
-    std::vector<char> recv_data(total_recv_data);
-
-    // Exchange the particle data between domains
-    {
-      std::vector<MPI_Request> requests(2 * n_neighbors);
-      unsigned int             send_ops = 0;
-      unsigned int             recv_ops = 0;
-
-      for (unsigned int i = 0; i < n_neighbors; ++i)
-        if (n_recv_data[i] > 0)
+        while (reinterpret_cast<std::size_t>(recv_data_it) -
+                 reinterpret_cast<std::size_t>(buffer.data()) <
+               buffer.size())
           {
-            const int ierr = MPI_Irecv(&(recv_data[recv_offsets[i]]),
-                                       n_recv_data[i],
-                                       MPI_CHAR,
-                                       neighbors[i],
-                                       1,
-                                       triangulation->get_communicator(),
-                                       &(requests[send_ops]));
-            AssertThrowMPI(ierr);
-            send_ops++;
-          }
+            CellId::binary_type binary_cellid;
+            memcpy(&binary_cellid, recv_data_it, cellid_size);
+            const CellId id(binary_cellid);
+            recv_data_it =
+              static_cast<const char *>(recv_data_it) + cellid_size;
 
-      for (unsigned int i = 0; i < n_neighbors; ++i)
-        if (n_send_data[i] > 0)
-          {
-            const int ierr = MPI_Isend(&(send_data[send_offsets[i]]),
-                                       n_send_data[i],
-                                       MPI_CHAR,
-                                       neighbors[i],
-                                       1,
-                                       triangulation->get_communicator(),
-                                       &(requests[send_ops + recv_ops]));
-            AssertThrowMPI(ierr);
-            recv_ops++;
-          }
-      const int ierr =
-        MPI_Waitall(send_ops + recv_ops, requests.data(), MPI_STATUSES_IGNORE);
-      AssertThrowMPI(ierr);
-    }
+            const typename Triangulation<dim, spacedim>::active_cell_iterator
+              cell = id.to_cell(*triangulation);
 
-    // Put the received particles into the domain if they are in the
-    // triangulation
-    const void *recv_data_it = static_cast<const void *>(recv_data.data());
+            typename std::multimap<internal::LevelInd,
+                                   Particle<dim, spacedim>>::iterator
+              recv_particle = received_particles.insert(std::make_pair(
+                internal::LevelInd(cell->level(), cell->index()),
+                Particle<dim, spacedim>(recv_data_it, property_pool.get())));
+
+            if (load_callback)
+              recv_data_it = load_callback(
+                particle_iterator(received_particles, recv_particle),
+                recv_data_it);
+          }
 
-    while (reinterpret_cast<std::size_t>(recv_data_it) -
-             reinterpret_cast<std::size_t>(recv_data.data()) <
-           total_recv_data)
-      {
-        CellId::binary_type binary_cellid;
-        memcpy(&binary_cellid, recv_data_it, cellid_size);
-        const CellId id(binary_cellid);
-        recv_data_it = static_cast<const char *>(recv_data_it) + cellid_size;
-
-        const typename Triangulation<dim, spacedim>::active_cell_iterator cell =
-          id.to_cell(*triangulation);
-
-        typename std::multimap<internal::LevelInd,
-                               Particle<dim, spacedim>>::iterator
-          recv_particle = received_particles.insert(std::make_pair(
-            internal::LevelInd(cell->level(), cell->index()),
-            Particle<dim, spacedim>(recv_data_it, property_pool.get())));
-
-        if (load_callback)
-          recv_data_it =
-            load_callback(particle_iterator(received_particles, recv_particle),
-                          recv_data_it);
+        AssertThrow(recv_data_it == buffer.data() + buffer.size(),
+                    ExcMessage(
+                      "The amount of data that was read into new particles "
+                      "does not match the amount of data sent around."));
       }
-
-    AssertThrow(recv_data_it == recv_data.data() + recv_data.size(),
-                ExcMessage(
-                  "The amount of data that was read into new particles "
-                  "does not match the amount of data sent around."));
   }
 #  endif
 
@@ -33,7 +33,7 @@
 #  endif
 #  include <deal.II/base/utilities.h>
 
-#  include <deal.II/sundials/copy.h>
+#  include <deal.II/sundials/n_vector.h>
 
 #  include <arkode/arkode_impl.h>
 #  include <sundials/sundials_config.h>
@@ -61,19 +61,13 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
-
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
 
-      typename VectorMemory<VectorType>::Pointer dst_yp(mem);
-      solver.reinit_vector(*dst_yp);
-
-      copy(*src_yy, yy);
+      NVectorView<VectorType> src_yy(yy, solver.reinit_vector);
+      NVectorView<VectorType> dst_yp(yp, solver.reinit_vector, false);
 
       int err = solver.explicit_function(tt, *src_yy, *dst_yp);
 
-      copy(yp, *dst_yp);
+      dst_yp.export_values();
 
       return err;
     }
@@ -89,19 +83,13 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(user_data);
-      GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src_yy(mem);
-      solver.reinit_vector(*src_yy);
-
-      typename VectorMemory<VectorType>::Pointer dst_yp(mem);
-      solver.reinit_vector(*dst_yp);
-
-      copy(*src_yy, yy);
+      NVectorView<VectorType> src_yy(yy, solver.reinit_vector);
+      NVectorView<VectorType> dst_yp(yp, solver.reinit_vector, false);
 
       int err = solver.implicit_function(tt, *src_yy, *dst_yp);
 
-      copy(yp, *dst_yp);
+      dst_yp.export_values();
 
       return err;
     }
@@ -121,16 +109,9 @@ namespace SUNDIALS
     {
       ARKode<VectorType> &solver =
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
-      GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src_ypred(mem);
-      solver.reinit_vector(*src_ypred);
-
-      typename VectorMemory<VectorType>::Pointer src_fpred(mem);
-      solver.reinit_vector(*src_fpred);
-
-      copy(*src_ypred, ypred);
-      copy(*src_fpred, fpred);
+      NVectorView<VectorType> src_ypred(ypred, solver.reinit_vector);
+      NVectorView<VectorType> src_fpred(fpred, solver.reinit_vector);
 
       // avoid reinterpret_cast
       bool jcurPtr_tmp = false;
@@ -165,29 +146,22 @@ namespace SUNDIALS
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
       GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
-
-      typename VectorMemory<VectorType>::Pointer src_ycur(mem);
-      solver.reinit_vector(*src_ycur);
-
-      typename VectorMemory<VectorType>::Pointer src_fcur(mem);
-      solver.reinit_vector(*src_fcur);
+      NVectorView<VectorType> src(b, solver.reinit_vector);
+      NVectorView<VectorType> src_ycur(ycur, solver.reinit_vector);
+      NVectorView<VectorType> src_fcur(fcur, solver.reinit_vector);
 
+      // b is both the right hand side and the result, so we need a separate
+      // vector for the solution of the linear system
       typename VectorMemory<VectorType>::Pointer dst(mem);
       solver.reinit_vector(*dst);
 
-      copy(*src, b);
-      copy(*src_ycur, ycur);
-      copy(*src_fcur, fcur);
-
       int err = solver.solve_jacobian_system(arkode_mem->ark_tn,
                                              arkode_mem->ark_gamma,
                                              *src_ycur,
                                              *src_fcur,
                                              *src,
                                              *dst);
-      copy(b, *dst);
+      copy_to_nvector(b, *dst);
 
       return err;
     }
@@ -221,16 +195,13 @@ namespace SUNDIALS
         *static_cast<ARKode<VectorType> *>(arkode_mem->ark_user_data);
       GrowingVectorMemory<VectorType> mem;
 
-      typename VectorMemory<VectorType>::Pointer src(mem);
-      solver.reinit_vector(*src);
+      NVectorView<VectorType> src(b, solver.reinit_vector);
 
       typename VectorMemory<VectorType>::Pointer dst(mem);
       solver.reinit_vector(*dst);
 
-      copy(*src, b);
-
       int err = solver.solve_mass_system(*src, *dst);
-      copy(b, *dst);
+      copy_to_nvector(b, *dst);
 
       return err;
     }
@@ -271,8 +242,6 @@ namespace SUNDIALS
   unsigned int
   ARKode<VectorType>::solve_ode(VectorType &solution)
   {
-    unsigned int system_size = solution.size();
-
     double       t           = data.initial_time;
     double       h           = data.initial_step_size;
     unsigned int step_number = 0;
@@ -280,29 +249,7 @@ namespace SUNDIALS
     int status;
     (void)status;
 
-    // The solution is stored in
-    // solution. Here we take only a
-    // view of it.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        Assert(is_serial_vector<VectorType>::value,
-               ExcInternalError(
-                 "Trying to use a serial code with a parallel vector."));
-        yy        = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
+    // The N_Vectors are created in reset().
     reset(data.initial_time, data.initial_step_size, solution);
 
     double next_time = data.initial_time;
@@ -321,7 +268,7 @@ namespace SUNDIALS
         status = ARKodeGetLastStep(arkode_mem, &h);
         AssertARKode(status);
 
-        copy(solution, yy);
+        copy_from_nvector(solution, yy);
 
         while (solver_should_restart(t, solution))
           reset(t, h, solution);
@@ -332,19 +279,11 @@ namespace SUNDIALS
           output_step(t, solution, step_number);
       }
 
-      // Free the vectors which are no longer used.
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        N_VDestroy_Parallel(yy);
-        N_VDestroy_Parallel(abs_tolls);
-      }
-    else
-#  endif
-      {
-        N_VDestroy_Serial(yy);
-        N_VDestroy_Serial(abs_tolls);
-      }
+    // Free the vectors which are no longer used.
+    N_VDestroy(yy);
+    N_VDestroy(abs_tolls);
+    yy        = nullptr;
+    abs_tolls = nullptr;
 
     return step_number;
   }
@@ -355,8 +294,6 @@ namespace SUNDIALS
                             const double      current_time_step,
                             const VectorType &solution)
   {
-    unsigned int system_size;
-
     if (arkode_mem)
       ARKodeFree(&arkode_mem);
 
@@ -365,42 +302,16 @@ namespace SUNDIALS
     // Free the vectors which are no longer used.
     if (yy)
       {
-#  ifdef DEAL_II_WITH_MPI
-        if (is_serial_vector<VectorType>::value == false)
-          {
-            N_VDestroy_Parallel(yy);
-            N_VDestroy_Parallel(abs_tolls);
-          }
-        else
-#  endif
-          {
-            N_VDestroy_Serial(yy);
-            N_VDestroy_Serial(abs_tolls);
-          }
+        N_VDestroy(yy);
+        N_VDestroy(abs_tolls);
       }
 
     int status;
     (void)status;
-    system_size = solution.size();
-#  ifdef DEAL_II_WITH_MPI
-    if (is_serial_vector<VectorType>::value == false)
-      {
-        const IndexSet    is                = solution.locally_owned_elements();
-        const std::size_t local_system_size = is.n_elements();
-
-        yy = N_VNew_Parallel(communicator, local_system_size, system_size);
-
-        abs_tolls =
-          N_VNew_Parallel(communicator, local_system_size, system_size);
-      }
-    else
-#  endif
-      {
-        yy        = N_VNew_Serial(system_size);
-        abs_tolls = N_VNew_Serial(system_size);
-      }
+    yy        = create_nvector(solution, communicator);
+    abs_tolls = create_nvector(solution, communicator);
 
-    copy(yy, solution);
+    copy_to_nvector(yy, solution);
 
     Assert(explicit_function || implicit_function,
            ExcFunctionNotProvided("explicit_function || implicit_function"));
@@ -415,7 +326,7 @@ namespace SUNDIALS
 
     if (get_local_tolerances)
       {
-        copy(abs_tolls, get_local_tolerances());
+        copy_to_nvector(abs_tolls, get_local_tolerances());
         status =
           ARKodeSVtolerances(arkode_mem, data.relative_tolerance, abs_tolls);
         AssertARKode(status);
@@ -505,6 +416,7 @@ namespace SUNDIALS
 
   template class ARKode<Vector<double>>;
   template class ARKode<BlockVector<double>>;
+  template class ARKode<LinearAlgebra::distributed::Vector<double>>;
 
 #  ifdef DEAL_II_WITH_MPI
 
@@ -0,0 +1,621 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2018 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#include <deal.II/sundials/n_vector.h>
+
+#ifdef DEAL_II_WITH_SUNDIALS
+
+#  include <deal.II/base/mpi.h>
+#  include <deal.II/base/parallel.h>
+
+#  include <sundials/sundials_types.h>
+
+#  include <algorithm>
+#  include <cmath>
+#  include <limits>
+
+DEAL_II_NAMESPACE_OPEN
+namespace SUNDIALS
+{
+  namespace internal
+  {
+    namespace
+    {
+#  if DEAL_II_SUNDIALS_VERSION_LT(3, 0, 0)
+      using IndexType = long int;
+#  else
+      using IndexType = sunindextype;
+#  endif
+
+      /**
+       * The content of a native N_Vector: a pointer to the deal.II vector
+       * and a flag whether the N_Vector is responsible for deleting it.
+       */
+      template <typename VectorType>
+      struct NVectorContent
+      {
+        VectorType *vector;
+        bool        owns_vector;
+      };
+
+
+
+      template <typename VectorType>
+      VectorType &
+      vector_of(N_Vector v)
+      {
+        Assert(v != nullptr && v->content != nullptr, ExcInternalError());
+        VectorType *vector =
+          static_cast<NVectorContent<VectorType> *>(v->content)->vector;
+        Assert(vector != nullptr, ExcInternalError());
+        return *vector;
+      }
+
+
+
+      /**
+       * The communicator over which reductions of a vector have to be
+       * performed.
+       */
+      MPI_Comm
+      get_communicator(const Vector<double> &)
+      {
+        return MPI_COMM_SELF;
+      }
+
+      MPI_Comm
+      get_communicator(const BlockVector<double> &)
+      {
+        return MPI_COMM_SELF;
+      }
+
+      MPI_Comm
+      get_communicator(const LinearAlgebra::distributed::Vector<double> &v)
+      {
+        return v.get_mpi_communicator();
+      }
+
+
+
+      using ::dealii::internal::VectorImplementation::
+        minimum_parallel_grain_size;
+
+
+
+      /**
+       * Split the locally stored entries of @p X into chunks and call
+       * @p function(begin, end) for the ranges of positions of the chunks in
+       * parallel, using the same grain size as the vector operations of
+       * deal.II.
+       */
+      template <typename VectorType, typename Function>
+      void
+      apply_to_local_ranges(const VectorType &X, const Function &function)
+      {
+        parallel::apply_to_subranges(
+          std::size_t(0),
+          static_cast<std::size_t>(X.end() - X.begin()),
+          function,
+          minimum_parallel_grain_size);
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      create_empty_nvector();
+
+
+
+      template <typename VectorType>
+      N_Vector
+      clone_empty(N_Vector w)
+      {
+        (void)w;
+        return create_empty_nvector<VectorType>();
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      clone(N_Vector w)
+      {
+        VectorType *vector = new VectorType();
+        vector->reinit(vector_of<VectorType>(w),
+                       /*omit_zeroing_entries = */ false);
+        return make_nvector(vector, true);
+      }
+
+
+
+      template <typename VectorType>
+      void
+      destroy(N_Vector v)
+      {
+        if (v == nullptr)
+          return;
+
+        auto *content = static_cast<NVectorContent<VectorType> *>(v->content);
+        if (content != nullptr && content->owns_vector)
+          delete content->vector;
+        delete content;
+        delete v->ops;
+        delete v;
+      }
+
+
+
+      template <typename VectorType>
+      void
+      space(N_Vector v, IndexType *lrw, IndexType *liw)
+      {
+        *lrw = vector_of<VectorType>(v).size();
+        *liw = 2;
+      }
+
+
+
+      realtype *
+      get_array_pointer(N_Vector)
+      {
+        return nullptr;
+      }
+
+
+
+      // z = a*x + b*y, where z may be the same vector as x and/or y
+      template <typename VectorType>
+      void
+      linear_sum(realtype a, N_Vector x, realtype b, N_Vector y, N_Vector z)
+      {
+        const VectorType &X = vector_of<VectorType>(x);
+        const VectorType &Y = vector_of<VectorType>(y);
+        VectorType &      Z = vector_of<VectorType>(z);
+
+        if (&X == &Z && &Y == &Z)
+          Z *= a + b;
+        else if (&X == &Z)
+          Z.sadd(a, b, Y);
+        else if (&Y == &Z)
+          Z.sadd(b, a, X);
+        else
+          {
+            Z.equ(a, X);
+            Z.add(b, Y);
+          }
+      }
+
+
+
+      template <typename VectorType>
+      void
+      set_constant(realtype c, N_Vector z)
+      {
+        vector_of<VectorType>(z) = c;
+      }
+
+
+
+      // z_i = x_i * y_i, where z may be the same vector as x and/or y
+      template <typename VectorType>
+      void
+      elementwise_product(N_Vector x, N_Vector y, N_Vector z)
+      {
+        const VectorType &X = vector_of<VectorType>(x);
+        const VectorType &Y = vector_of<VectorType>(y);
+        VectorType &      Z = vector_of<VectorType>(z);
+
+        if (&X == &Z)
+          Z.scale(Y);
+        else if (&Y == &Z)
+          Z.scale(X);
+        else
+          {
+            Z = X;
+            Z.scale(Y);
+          }
+      }
+
+
+
+      // z_i = x_i / y_i
+      template <typename VectorType>
+      void
+      elementwise_div(N_Vector x, N_Vector y, N_Vector z)
+      {
+        const VectorType &X = vector_of<VectorType>(x);
+        const VectorType &Y = vector_of<VectorType>(y);
+        VectorType &      Z = vector_of<VectorType>(z);
+
+        apply_to_local_ranges(
+          X, [&](const std::size_t begin, const std::size_t end) {
+            auto       xi    = X.begin() + begin;
+            auto       yi    = Y.begin() + begin;
+            const auto z_end = Z.begin() + end;
+            for (auto zi = Z.begin() + begin; zi != z_end; ++zi, ++xi, ++yi)
+              *zi = *xi / *yi;
+          });
+      }
+
+
+
+      // z = c*x
+      template <typename VectorType>
+      void
+      scale(realtype c, N_Vector x, N_Vector z)
+      {
+        VectorType &Z = vector_of<VectorType>(z);
+        if (x == z)
+          Z *= c;
+        else
+          Z.equ(c, vector_of<VectorType>(x));
+      }
+
+
+
+      // z_i = |x_i|
+      template <typename VectorType>
+      void
+      elementwise_abs(N_Vector x, N_Vector z)
+      {
+        const VectorType &X = vector_of<VectorType>(x);
+        VectorType &      Z = vector_of<VectorType>(z);
+
+        apply_to_local_ranges(
+          X, [&](const std::size_t begin, const std::size_t end) {
+            auto       xi    = X.begin() + begin;
+            const auto z_end = Z.begin() + end;
+            for (auto zi = Z.begin() + begin; zi != z_end; ++zi, ++xi)
+              *zi = std::abs(*xi);
+          });
+      }
+
+
+
+      // z_i = 1 / x_i
+      template <typename VectorType>
+      void
+      elementwise_inv(N_Vector x, N_Vector z)
+      {
+        const VectorType &X = vector_of<VectorType>(x);
+        VectorType &      Z = vector_of<VectorType>(z);
+
+        apply_to_local_ranges(
+          X, [&](const std::size_t begin, const std::size_t end) {
+            auto       xi    = X.begin() + begin;
+            const auto z_end = Z.begin() + end;
+            for (auto zi = Z.begin() + begin; zi != z_end; ++zi, ++xi)
+              *zi = 1. / *xi;
+          });
+      }
+
+
+
+      // z_i = x_i + b
+      template <typename VectorType>
+      void
+      add_constant(N_Vector x, realtype b, N_Vector z)
+      {
+        const VectorType &X = vector_of<VectorType>(x);
+        VectorType &      Z = vector_of<VectorType>(z);
+
+        apply_to_local_ranges(
+          X, [&](const std::size_t begin, const std::size_t end) {
+            auto       xi    = X.begin() + begin;
+            const auto z_end = Z.begin() + end;
+            for (auto zi = Z.begin() + begin; zi != z_end; ++zi, ++xi)
+              *zi = *xi + b;
+          });
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      dot_product(N_Vector x, N_Vector y)
+      {
+        return vector_of<VectorType>(x) * vector_of<VectorType>(y);
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      max_norm(N_Vector x)
+      {
+        return vector_of<VectorType>(x).linfty_norm();
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      l1_norm(N_Vector x)
+      {
+        return vector_of<VectorType>(x).l1_norm();
+      }
+
+
+
+      // Return the global sum of (x_i*w_i)^2 over all entries, or only over
+      // those with id_i > 0 if @p id is given.
+      template <typename VectorType>
+      double
+      weighted_squared_sum(N_Vector x, N_Vector w, N_Vector id)
+      {
+        const VectorType &X = vector_of<VectorType>(x);
+        const VectorType &W = vector_of<VectorType>(w);
+
+        const VectorType *ID =
+          (id == nullptr) ? nullptr : &vector_of<VectorType>(id);
+
+        const double sum = parallel::accumulate_from_subranges<double>(
+          [&](const std::size_t begin, const std::size_t end) {
+            double     local_sum = 0;
+            auto       wi        = W.begin() + begin;
+            const auto x_end     = X.begin() + end;
+            if (ID == nullptr)
+              for (auto xi = X.begin() + begin; xi != x_end; ++xi, ++wi)
+                local_sum += (*xi * *wi) * (*xi * *wi);
+            else
+              {
+                auto ii = ID->begin() + begin;
+                for (auto xi = X.begin() + begin; xi != x_end; ++xi, ++wi, ++ii)
+                  if (*ii > 0.)
+                    local_sum += (*xi * *wi) * (*xi * *wi);
+              }
+            return local_sum;
+          },
+          std::size_t(0),
+          static_cast<std::size_t>(X.end() - X.begin()),
+          minimum_parallel_grain_size);
+
+        return Utilities::MPI::sum(sum, get_communicator(X));
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      weighted_rms_norm(N_Vector x, N_Vector w)
+      {
+        return std::sqrt(weighted_squared_sum<VectorType>(x, w, nullptr) /
+                         vector_of<VectorType>(x).size());
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      weighted_rms_norm_mask(N_Vector x, N_Vector w, N_Vector id)
+      {
+        return std::sqrt(weighted_squared_sum<VectorType>(x, w, id) /
+                         vector_of<VectorType>(x).size());
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      weighted_l2_norm(N_Vector x, N_Vector w)
+      {
+        return std::sqrt(weighted_squared_sum<VectorType>(x, w, nullptr));
+      }
+
+
+
+      template <typename VectorType>
+      realtype
+      min_element(N_Vector x)
+      {
+        const VectorType &X = vector_of<VectorType>(x);
+
+        double local_min = std::numeric_limits<double>::max();
+        for (auto xi = X.begin(); xi != X.end(); ++xi)
+          local_min = std::min(local_min, *xi);
+
+        return Utilities::MPI::min(local_min, get_communicator(X));
+      }
+
+
+
+      // z_i = (|x_i| >= c) ? 1 : 0
+      template <typename VectorType>
+      void
+      compare(realtype c, N_Vector x, N_Vector z)
+      {
+        const VectorType &X = vector_of<VectorType>(x);
+        VectorType &      Z = vector_of<VectorType>(z);
+
+        auto xi = X.begin();
+        for (auto zi = Z.begin(); zi != Z.end(); ++zi, ++xi)
+          *zi = (std::abs(*xi) >= c) ? 1. : 0.;
+      }
+
+
+
+      // z_i = 1 / x_i, returning false if any of the x_i is zero
+      template <typename VectorType>
+      booleantype
+      inv_test(N_Vector x, N_Vector z)
+      {
+        const VectorType &X = vector_of<VectorType>(x);
+        VectorType &      Z = vector_of<VectorType>(z);
+
+        double no_zero_found = 1.;
+        auto   xi            = X.begin();
+        for (auto zi = Z.begin(); zi != Z.end(); ++zi, ++xi)
+          if (*xi == 0.)
+            no_zero_found = 0.;
+          else
+            *zi = 1. / *xi;
+
+        return static_cast<booleantype>(
+          Utilities::MPI::min(no_zero_found, get_communicator(X)) == 1.);
+      }
+
+
+
+      // Set m_i to one wherever x_i violates the constraint c_i and to zero
+      // elsewhere, returning false if any constraint is violated. The
+      // constraints are x_i > 0 for c_i = 2, x_i >= 0 for c_i = 1,
+      // x_i <= 0 for c_i = -1 and x_i < 0 for c_i = -2.
+      template <typename VectorType>
+      booleantype
+      constraint_mask(N_Vector c, N_Vector x, N_Vector m)
+      {
+        const VectorType &C = vector_of<VectorType>(c);
+        const VectorType &X = vector_of<VectorType>(x);
+        VectorType &      M = vector_of<VectorType>(m);
+
+        double all_satisfied = 1.;
+        auto   ci            = C.begin();
+        auto   xi            = X.begin();
+        for (auto mi = M.begin(); mi != M.end(); ++mi, ++ci, ++xi)
+          {
+            bool violated = false;
+            if (*ci == 2.)
+              violated = (*xi <= 0.);
+            else if (*ci == 1.)
+              violated = (*xi < 0.);
+            else if (*ci == -1.)
+              violated = (*xi > 0.);
+            else if (*ci == -2.)
+              violated = (*xi >= 0.);
+
+            *mi = violated ? 1. : 0.;
+            if (violated)
+              all_satisfied = 0.;
+          }
+
+        return static_cast<booleantype>(
+          Utilities::MPI::min(all_satisfied, get_communicator(X)) == 1.);
+      }
+
+
+
+      // Return the minimum of num_i / denom_i over all entries with a
+      // nonzero denominator
+      template <typename VectorType>
+      realtype
+      min_quotient(N_Vector num, N_Vector denom)
+      {
+        const VectorType &N = vector_of<VectorType>(num);
+        const VectorType &D = vector_of<VectorType>(denom);
+
+        double local_min = BIG_REAL;
+        auto   di        = D.begin();
+        for (auto ni = N.begin(); ni != N.end(); ++ni, ++di)
+          if (*di != 0.)
+            local_min = std::min(local_min, *ni / *di);
+
+        return Utilities::MPI::min(local_min, get_communicator(N));
+      }
+
+
+
+      template <typename VectorType>
+      N_Vector
+      create_empty_nvector()
+      {
+        N_Vector v = new _generic_N_Vector;
+
+        // value-initialize the operations so that all the optional
+        // operations we do not provide are set to nullptr
+        v->ops     = new _generic_N_Vector_Ops();
+        v->content = new NVectorContent<VectorType>{nullptr, false};
+
+#  if DEAL_II_SUNDIALS_VERSION_GTE(3, 0, 0)
+        v->ops->nvgetvectorid = [](N_Vector) -> N_Vector_ID {
+          return SUNDIALS_NVEC_CUSTOM;
+        };
+#  endif
+        v->ops->nvclone           = &clone<VectorType>;
+        v->ops->nvcloneempty      = &clone_empty<VectorType>;
+        v->ops->nvdestroy         = &destroy<VectorType>;
+        v->ops->nvspace           = &space<VectorType>;
+        v->ops->nvgetarraypointer = &get_array_pointer;
+        v->ops->nvlinearsum       = &linear_sum<VectorType>;
+        v->ops->nvconst           = &set_constant<VectorType>;
+        v->ops->nvprod            = &elementwise_product<VectorType>;
+        v->ops->nvdiv             = &elementwise_div<VectorType>;
+        v->ops->nvscale           = &scale<VectorType>;
+        v->ops->nvabs             = &elementwise_abs<VectorType>;
+        v->ops->nvinv             = &elementwise_inv<VectorType>;
+        v->ops->nvaddconst        = &add_constant<VectorType>;
+        v->ops->nvdotprod         = &dot_product<VectorType>;
+        v->ops->nvmaxnorm         = &max_norm<VectorType>;
+        v->ops->nvwrmsnorm        = &weighted_rms_norm<VectorType>;
+        v->ops->nvwrmsnormmask    = &weighted_rms_norm_mask<VectorType>;
+        v->ops->nvmin             = &min_element<VectorType>;
+        v->ops->nvwl2norm         = &weighted_l2_norm<VectorType>;
+        v->ops->nvl1norm          = &l1_norm<VectorType>;
+        v->ops->nvcompare         = &compare<VectorType>;
+        v->ops->nvinvtest         = &inv_test<VectorType>;
+        v->ops->nvconstrmask      = &constraint_mask<VectorType>;
+        v->ops->nvminquotient     = &min_quotient<VectorType>;
+
+        return v;
+      }
+    } // namespace
+
+
+
+    template <typename VectorType>
+    N_Vector
+    make_nvector(VectorType *vector, const bool take_ownership)
+    {
+      Assert(vector != nullptr, ExcInternalError());
+
+      N_Vector v    = create_empty_nvector<VectorType>();
+      auto *content = static_cast<NVectorContent<VectorType> *>(v->content);
+      content->vector      = vector;
+      content->owns_vector = take_ownership;
+      return v;
+    }
+
+
+
+    template <typename VectorType>
+    VectorType *
+    unwrap_nvector(N_Vector vector)
+    {
+      Assert(vector->ops->nvclone == &clone<VectorType>,
+             ExcMessage("The given N_Vector does not store a deal.II vector "
+                        "of the requested type."));
+      return &vector_of<VectorType>(vector);
+    }
+
+
+
+    template N_Vector
+    make_nvector(Vector<double> *, const bool);
+    template N_Vector
+    make_nvector(BlockVector<double> *, const bool);
+    template N_Vector
+    make_nvector(LinearAlgebra::distributed::Vector<double> *, const bool);
+
+    template Vector<double> *
+    unwrap_nvector<Vector<double>>(N_Vector);
+    template BlockVector<double> *
+    unwrap_nvector<BlockVector<double>>(N_Vector);
+    template LinearAlgebra::distributed::Vector<double> *
+    unwrap_nvector<LinearAlgebra::distributed::Vector<double>>(N_Vector);
+  } // namespace internal
+} // namespace SUNDIALS
+DEAL_II_NAMESPACE_CLOSE
+
+#endif // DEAL_II_WITH_SUNDIALS
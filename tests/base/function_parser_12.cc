@@ -0,0 +1,86 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check that the batch evaluation functions of FunctionParser, which use the
+// bulk mode of muparser for many points, give the same values as value() and
+// vector_value(), including for time dependent functions
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <map>
+
+#include "../tests.h"
+
+
+int
+main()
+{
+  initlog();
+
+  std::map<std::string, double> constants;
+  constants["pi"] = numbers::PI;
+
+  FunctionParser<2> function(2, 0.5);
+  function.initialize("x,y,t",
+                      "sin(pi*x)*y+t; if(x<y, x^2, exp(-t*y))",
+                      constants,
+                      true);
+
+  for (const unsigned int n_points : {5u, 100u, 1200u, 5000u})
+    {
+      std::vector<Point<2>> points(n_points);
+      for (unsigned int i = 0; i < n_points; ++i)
+        points[i] = Point<2>(std::sin(0.1 * i), std::cos(0.3 * i));
+
+      double error = 0;
+      for (unsigned int c = 0; c < 2; ++c)
+        {
+          std::vector<double> values(n_points);
+          function.value_list(points, values, c);
+          for (unsigned int i = 0; i < n_points; ++i)
+            error += std::abs(values[i] - function.value(points[i], c));
+        }
+
+      std::vector<Vector<double>> vector_values(n_points, Vector<double>(2));
+      function.vector_value_list(points, vector_values);
+      for (unsigned int i = 0; i < n_points; ++i)
+        {
+          Vector<double> value(2);
+          function.vector_value(points[i], value);
+          value -= vector_values[i];
+          error += value.l1_norm();
+        }
+      deallog << "Points: " << n_points << ", error: " << error << std::endl;
+    }
+
+  Point<2, VectorizedArray<double>> vectorized_point;
+  for (unsigned int v = 0; v < VectorizedArray<double>::n_array_elements; ++v)
+    {
+      vectorized_point[0][v] = 0.1 * v;
+      vectorized_point[1][v] = 0.2;
+    }
+  const VectorizedArray<double> vectorized_value =
+    function.vectorized_value(vectorized_point, 1);
+  double error = 0;
+  for (unsigned int v = 0; v < VectorizedArray<double>::n_array_elements; ++v)
+    error += std::abs(vectorized_value[v] -
+                      function.value(Point<2>(0.1 * v, 0.2), 1));
+  deallog << "Vectorized error: " << error << std::endl;
+}
@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test the lookup functions of fragmented index sets, which use a bitmap
+// internally, and the set operations on sets with many ranges, which are
+// split into pieces that are processed in parallel, against a plain vector
+// of flags
+
+#include <deal.II/base/index_set.h>
+
+#include <vector>
+
+#include "../tests.h"
+
+
+IndexSet
+make_set(const std::vector<bool> &flags)
+{
+  IndexSet set(flags.size());
+  for (unsigned int i = 0; i < flags.size(); ++i)
+    if (flags[i])
+      set.add_index(i);
+  set.compress();
+  return set;
+}
+
+
+
+void
+check_set(const IndexSet &set, const std::vector<bool> &flags)
+{
+  unsigned int n = 0;
+  for (unsigned int i = 0; i < flags.size(); ++i)
+    {
+      AssertThrow(set.is_element(i) == flags[i], ExcInternalError());
+      if (flags[i])
+        {
+          AssertThrow(set.index_within_set(i) == n, ExcInternalError());
+          // nth_index_in_set() checks its argument against n_elements(),
+          // which is expensive in debug mode, so only test every few
+          // elements
+          if (n % 101 == 0)
+            AssertThrow(set.nth_index_in_set(n) == i, ExcInternalError());
+          ++n;
+        }
+      else
+        {
+          AssertThrow(set.index_within_set(i) == numbers::invalid_dof_index,
+                      ExcInternalError());
+        }
+    }
+  AssertThrow(set.n_elements() == n, ExcInternalError());
+  deallog << "Elements: " << n << ", ranges: " << set.n_intervals()
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int size = 100000;
+
+  // a large contiguous range followed by many short ranges with small gaps,
+  // and one with longer ranges, shifted against the first one
+  std::vector<bool> flags_1(size), flags_2(size);
+  for (unsigned int i = 0; i < size; ++i)
+    {
+      flags_1[i] = (i < size / 4) || (i % 7 < 3) || (i % 11 == 0);
+      flags_2[i] = ((i + 5) % 13 < 8);
+    }
+
+  const IndexSet set_1 = make_set(flags_1);
+  const IndexSet set_2 = make_set(flags_2);
+  check_set(set_1, flags_1);
+  check_set(set_2, flags_2);
+
+  // the set operations
+  std::vector<bool> flags(size);
+  for (unsigned int i = 0; i < size; ++i)
+    flags[i] = flags_1[i] && flags_2[i];
+  check_set(set_1 & set_2, flags);
+
+  IndexSet set = set_1;
+  set.add_indices(set_2);
+  for (unsigned int i = 0; i < size; ++i)
+    flags[i] = flags_1[i] || flags_2[i];
+  check_set(set, flags);
+
+  set = set_1;
+  set.subtract_set(set_2);
+  for (unsigned int i = 0; i < size; ++i)
+    flags[i] = flags_1[i] && !flags_2[i];
+  check_set(set, flags);
+
+  // add_indices with an offset
+  set = IndexSet(size);
+  set.add_indices(set_2.get_view(0, size / 2), size / 4);
+  set.add_indices(set_1);
+  for (unsigned int i = 0; i < size; ++i)
+    flags[i] = flags_1[i] || (i >= size / 4 && i < 3 * size / 4 &&
+                              flags_2[i - size / 4]);
+  check_set(set, flags);
+
+  // add_indices with unsorted indices that interleave with the existing
+  // ones, as when adding ghost indices
+  set = set_2;
+  std::vector<types::global_dof_index> indices;
+  for (unsigned int i = size; i > 0; --i)
+    if (flags_1[i - 1] && !flags_2[i - 1])
+      indices.push_back(i - 1);
+  set.add_indices(indices.begin(), indices.end());
+  for (unsigned int i = 0; i < size; ++i)
+    flags[i] = flags_1[i] || flags_2[i];
+  check_set(set, flags);
+
+  // pop_back on a fragmented set
+  set = set_2;
+  const types::global_dof_index last = set.pop_back();
+  flags                               = flags_2;
+  flags[last]                         = false;
+  check_set(set, flags);
+}
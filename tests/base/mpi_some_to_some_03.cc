@@ -0,0 +1,68 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Test Utilities::MPI::some_to_some() for packed data, including messages
+// without content and to the own process. The function is called several
+// times in a row with different communication patterns to check that the
+// messages of subsequent calls do not get mixed up.
+
+#include <deal.II/base/mpi.h>
+
+#include <vector>
+
+#include "../tests.h"
+
+
+void
+test(const unsigned int round)
+{
+  const unsigned int my_proc = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  // send to the processes my_proc+round, my_proc+round+1, ..., where the
+  // message to process p consists of p+round copies of the character
+  // 'a'+my_proc
+  std::map<unsigned int, std::vector<char>> buffers_to_send;
+  for (unsigned int i = 0; i <= round; ++i)
+    {
+      const unsigned int rank = (my_proc + round + i) % n_procs;
+      buffers_to_send[rank]   = std::vector<char>(rank + round, 'a' + my_proc);
+    }
+
+  const std::map<unsigned int, std::vector<char>> received_buffers =
+    Utilities::MPI::some_to_some(MPI_COMM_WORLD, buffers_to_send);
+
+  deallog << "Round " << round << ", received from:";
+  for (const auto &rank_buffer : received_buffers)
+    {
+      AssertThrow(rank_buffer.second ==
+                    std::vector<char>(my_proc + round, 'a' + rank_buffer.first),
+                  ExcInternalError());
+      deallog << ' ' << rank_buffer.first;
+    }
+  deallog << std::endl;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log;
+
+  for (unsigned int round = 0; round < 3; ++round)
+    test(round);
+}
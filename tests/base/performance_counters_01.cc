@@ -0,0 +1,85 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test PerformanceCounters: the hardware counters may or may not be
+// available on the system running the test, so only print quantities that do
+// not depend on them
+
+#include <deal.II/base/performance_counters.h>
+
+#include <sstream>
+#include <vector>
+
+#include "../tests.h"
+
+int
+main()
+{
+  initlog();
+
+  PerformanceCounters counters;
+
+  std::vector<double> v(100000, 1.);
+  double              sum = 0;
+  for (unsigned int i = 0; i < 5; ++i)
+    {
+      PerformanceCounters::Scope outer(counters, "outer");
+      {
+        PerformanceCounters::Scope scope(counters, "sum", v.size());
+        for (const double x : v)
+          sum += x;
+      }
+    }
+  deallog << "Sum: " << sum << std::endl;
+
+  for (const auto &section : counters.get_summary_data())
+    {
+      const PerformanceCounters::SectionData &data = section.second;
+      deallog << section.first << ": " << data.n_calls << " calls, "
+              << data.n_flops << " flops" << std::endl;
+
+      AssertThrow(data.wall_time > 0., ExcInternalError());
+      if (counters.counters_available())
+        {
+          AssertThrow(data.counts[PerformanceCounters::instructions] > 0. &&
+                        data.instructions_per_cycle() > 0.,
+                      ExcInternalError());
+        }
+      else
+        {
+          AssertThrow(data.instructions_per_cycle() == 0.,
+                      ExcInternalError());
+        }
+    }
+
+  // the counts of the outer section include the ones of the inner section
+  const auto &data = counters.get_summary_data();
+  AssertThrow(data.at("outer").wall_time >= data.at("sum").wall_time,
+              ExcInternalError());
+  AssertThrow(data.at("outer").counts[PerformanceCounters::cycles] >=
+                data.at("sum").counts[PerformanceCounters::cycles],
+              ExcInternalError());
+
+  // check that the summary can be printed in either case
+  std::ostringstream summary;
+  counters.print_summary(summary);
+  AssertThrow(summary.str().find("GFLOP/s") != std::string::npos,
+              ExcInternalError());
+
+  counters.reset();
+  deallog << "Sections after reset: " << counters.get_summary_data().size()
+          << std::endl;
+}
@@ -0,0 +1,96 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test the thread pool that is used in place of the TBB: nested tasks, the
+// chunked loops, and the order of the copier calls of WorkStream::run()
+
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/work_stream.h>
+
+#include <vector>
+
+#include "../tests.h"
+
+
+unsigned int
+fibonacci(const unsigned int n)
+{
+  if (n < 2)
+    return n;
+
+  Threads::Task<unsigned int> t = Threads::new_task(&fibonacci, n - 1);
+  const unsigned int          b = fibonacci(n - 2);
+  return t.return_value() + b;
+}
+
+
+
+struct ScratchData
+{};
+
+struct CopyData
+{
+  unsigned int index;
+};
+
+
+
+int
+main()
+{
+  initlog();
+  MultithreadInfo::set_thread_limit(4);
+  deallog << "Threads: " << MultithreadInfo::n_threads() << std::endl;
+
+  deallog << "Fibonacci: " << fibonacci(15) << std::endl;
+
+  const double sum = parallel::accumulate_from_subranges<double>(
+    [](const unsigned int begin, const unsigned int end) {
+      double s = 0;
+      for (unsigned int i = begin; i < end; ++i)
+        s += i;
+      return s;
+    },
+    0U,
+    10000U,
+    10);
+  deallog << "Sum: " << sum << std::endl;
+
+  std::vector<unsigned int> order;
+  WorkStream::run(0U,
+                  1000U,
+                  [](const unsigned int &i, ScratchData &, CopyData &copy) {
+                    copy.index = i;
+                  },
+                  [&order](const CopyData &copy) {
+                    order.push_back(copy.index);
+                  },
+                  ScratchData(),
+                  CopyData(),
+                  8,
+                  4);
+  bool in_order = (order.size() == 1000);
+  for (unsigned int i = 0; i < order.size(); ++i)
+    if (order[i] != i)
+      in_order = false;
+  deallog << "Copier calls in order: " << (in_order ? "yes" : "no")
+          << std::endl;
+
+  MultithreadInfo::set_thread_affinity(true);
+  deallog << "Fibonacci with pinned threads: " << fibonacci(12) << std::endl;
+}
@@ -0,0 +1,97 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// like thread_pool_01, but use the thread pool directly rather than through
+// the functions in namespace parallel and WorkStream, such that the pool is
+// also tested in configurations that use the TBB: nested jobs, the chunked
+// loops, the indices of the threads, and pinning the threads
+
+#include <deal.II/base/thread_pool.h>
+
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "../tests.h"
+
+
+using Threads::internal::ThreadPool;
+
+
+unsigned int
+fibonacci(const unsigned int n)
+{
+  if (n < 2)
+    return n;
+
+  unsigned int a   = 0;
+  const auto   job = ThreadPool::instance().submit(
+    [&a, n]() { a = fibonacci(n - 1); });
+  const unsigned int b = fibonacci(n - 2);
+  ThreadPool::instance().wait(*job);
+  return a + b;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  ThreadPool::set_n_threads(4);
+  ThreadPool &pool = ThreadPool::instance();
+  deallog << "Workers: " << pool.n_workers() << std::endl;
+
+  deallog << "Fibonacci: " << fibonacci(15) << std::endl;
+
+  // sum up the numbers 0,...,9999 in chunks, and record the indices of the
+  // threads working on them
+  const std::size_t      n        = 10000;
+  const unsigned int     n_chunks = pool.n_chunks(n, 10);
+  std::vector<double>    sums(n_chunks, 0.);
+  std::set<unsigned int> thread_indices;
+  std::mutex             mutex;
+  pool.run_chunks(n_chunks, [&](const unsigned int chunk) {
+    for (std::size_t i = ThreadPool::chunk_begin(n, n_chunks, chunk);
+         i < ThreadPool::chunk_begin(n, n_chunks, chunk + 1);
+         ++i)
+      sums[chunk] += i;
+    std::lock_guard<std::mutex> lock(mutex);
+    thread_indices.insert(ThreadPool::current_thread_index());
+  });
+  double sum = 0;
+  for (const double s : sums)
+    sum += s;
+  deallog << "Sum: " << sum << std::endl;
+  deallog << "Chunk boundaries: " << ThreadPool::chunk_begin(n, n_chunks, 0)
+          << " " << ThreadPool::chunk_begin(n, n_chunks, n_chunks)
+          << std::endl;
+  deallog << "Thread indices valid: "
+          << (*thread_indices.rbegin() <= pool.n_workers() ? "yes" : "no")
+          << std::endl;
+  deallog << "Index of the main thread: "
+          << ThreadPool::current_thread_index() << std::endl;
+
+  ThreadPool::set_thread_affinity(true);
+  deallog << "Fibonacci with pinned threads: " << fibonacci(12) << std::endl;
+  ThreadPool::set_thread_affinity(false);
+
+  ThreadPool::set_n_threads(1);
+  deallog << "Workers: " << ThreadPool::instance().n_workers() << std::endl;
+  deallog << "Fibonacci without workers: " << fibonacci(10) << std::endl;
+}
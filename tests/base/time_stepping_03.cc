@@ -0,0 +1,100 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test the convergence of the low-storage Runge-Kutta methods for y' = -y
+// and check that the fused stage update gives the same result
+
+#include <deal.II/base/time_stepping.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+Vector<double>
+f(const double, const Vector<double> &y)
+{
+  Vector<double> values(y);
+  values *= -1.;
+  return values;
+}
+
+
+void
+stage_update(const double,
+             const Vector<double> &y,
+             const double          factor,
+             Vector<double> &      k)
+{
+  if (factor == 0.)
+    k.equ(-1., y);
+  else
+    k.sadd(factor, -1., y);
+}
+
+
+double
+integrate(TimeStepping::LowStorageRungeKutta<Vector<double>> &method,
+          const unsigned int                                  n_steps,
+          const bool                                          fused)
+{
+  Vector<double> y(1), k(1);
+  y[0]                 = 1.;
+  const double delta_t = 1. / n_steps;
+  double       time    = 0.;
+  for (unsigned int step = 0; step < n_steps; ++step)
+    time = fused ?
+             method.evolve_one_time_step_fused(
+               stage_update, time, delta_t, y, k) :
+             method.evolve_one_time_step(f, time, delta_t, y, k);
+  AssertThrow(std::abs(time - 1.) < 1e-12, ExcInternalError());
+  return std::abs(y[0] - std::exp(-1.));
+}
+
+
+void
+test(const TimeStepping::runge_kutta_method method_type,
+     const std::string &                    name)
+{
+  deallog << name << std::endl;
+  TimeStepping::LowStorageRungeKutta<Vector<double>> method(method_type);
+  AssertThrow(method.get_status().method == method_type, ExcInternalError());
+
+  double old_error = 0.;
+  for (unsigned int n_steps = 4; n_steps <= 32; n_steps *= 2)
+    {
+      const double error = integrate(method, n_steps, false);
+      AssertThrow(error == integrate(method, n_steps, true),
+                  ExcInternalError());
+      deallog << "steps " << n_steps << " error " << error;
+      if (old_error > 0.)
+        deallog << " rate " << std::log2(old_error / error);
+      deallog << std::endl;
+      old_error = error;
+    }
+}
+
+
+int
+main()
+{
+  initlog();
+  deallog << std::setprecision(3);
+
+  test(TimeStepping::LOW_STORAGE_RK_STAGE3_ORDER3, "LSRK stage 3 order 3");
+  test(TimeStepping::LOW_STORAGE_RK_STAGE5_ORDER4, "LSRK stage 5 order 4");
+  test(TimeStepping::LOW_STORAGE_RK_STAGE6_ORDER4, "LSRK stage 6 order 4");
+}
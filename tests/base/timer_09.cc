@@ -0,0 +1,80 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test the trace recording of TimerOutput: nested sections and events
+// recorded by TimerOutput::TraceScope on several threads
+
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/timer.h>
+
+#include <sstream>
+
+#include "../tests.h"
+
+int
+main()
+{
+  initlog();
+
+  std::stringstream summary;
+  TimerOutput       timer(summary, TimerOutput::never, TimerOutput::wall_times);
+
+  // nothing is recorded before the trace recording is enabled
+  {
+    TimerOutput::Scope scope(timer, "ignored");
+  }
+
+  timer.enable_trace_recording();
+  for (unsigned int i = 0; i < 2; ++i)
+    {
+      TimerOutput::Scope outer(timer, "outer");
+      {
+        TimerOutput::Scope inner(timer, "inner");
+        TimerOutput::TraceScope event(timer, "event");
+      }
+      TimerOutput::TraceScope event(timer, "event");
+    }
+
+  Threads::TaskGroup<void> tasks;
+  for (unsigned int t = 0; t < 4; ++t)
+    tasks += Threads::new_task([&timer]() {
+      for (unsigned int i = 0; i < 10; ++i)
+        TimerOutput::TraceScope event(timer, "task");
+    });
+  tasks.join_all();
+
+  timer.disable_trace_recording();
+  {
+    TimerOutput::Scope scope(timer, "ignored");
+  }
+
+  // strip the wall times from the summary
+  timer.print_hierarchical_summary();
+  std::string line;
+  while (std::getline(summary, line))
+    deallog << line.substr(0, line.size() - 13) << std::endl;
+
+  std::ostringstream trace;
+  timer.write_trace(trace);
+  const std::string trace_string = trace.str();
+  deallog << "Trace starts with: " << trace_string.substr(0, 15) << std::endl;
+  unsigned int n_events = 0;
+  for (std::size_t pos = trace_string.find("\"ph\":\"X\"");
+       pos != std::string::npos;
+       pos = trace_string.find("\"ph\":\"X\"", pos + 1))
+    ++n_events;
+  deallog << "Number of events: " << n_events << std::endl;
+}
@@ -0,0 +1,92 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// test that reset() and enable_trace_recording() discard the events recorded
+// so far, and that the threads can record new events afterwards
+
+#include <deal.II/base/thread_management.h>
+#include <deal.II/base/timer.h>
+
+#include <sstream>
+
+#include "../tests.h"
+
+
+void
+record(TimerOutput &timer, const unsigned int n_tasks)
+{
+  {
+    TimerOutput::Scope scope(timer, "section");
+    TimerOutput::TraceScope event(timer, "event");
+  }
+
+  Threads::TaskGroup<void> tasks;
+  for (unsigned int t = 0; t < n_tasks; ++t)
+    tasks += Threads::new_task([&timer]() {
+      for (unsigned int i = 0; i < 10; ++i)
+        TimerOutput::TraceScope event(timer, "task");
+    });
+  tasks.join_all();
+}
+
+
+
+void
+print_n_events(const TimerOutput &timer)
+{
+  std::ostringstream trace;
+  timer.write_trace(trace);
+  const std::string trace_string = trace.str();
+  unsigned int      n_events     = 0;
+  for (std::size_t pos = trace_string.find("\"ph\":\"X\"");
+       pos != std::string::npos;
+       pos = trace_string.find("\"ph\":\"X\"", pos + 1))
+    ++n_events;
+  deallog << "Number of events: " << n_events << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  std::stringstream summary;
+  TimerOutput       timer(summary, TimerOutput::never, TimerOutput::wall_times);
+
+  timer.enable_trace_recording();
+  record(timer, 4);
+  print_n_events(timer);
+
+  // the names of the sections stay valid, and the buffers of the threads
+  // remain usable after the trace has been discarded
+  timer.reset();
+  print_n_events(timer);
+  record(timer, 2);
+  print_n_events(timer);
+
+  timer.enable_trace_recording();
+  print_n_events(timer);
+  record(timer, 3);
+  print_n_events(timer);
+
+  timer.print_hierarchical_summary();
+  std::string line;
+  while (std::getline(summary, line))
+    deallog << line.substr(0, line.size() - 13) << std::endl;
+}
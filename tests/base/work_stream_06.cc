@@ -0,0 +1,139 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2008 - 2017 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// test WorkStream::run_with_thread_local_reduction, where conflicting
+// entries of a global vector are written into thread-local copies that are
+// reduced at the end, and check the statistics returned by WorkStream::run
+
+#include <deal.II/base/work_stream.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+struct ScratchData
+{};
+
+
+struct CopyData
+{
+  unsigned int computed;
+};
+
+
+void
+worker(const std::vector<unsigned int>::iterator &i,
+       ScratchData &,
+       CopyData &ad)
+{
+  ad.computed = *i * 2;
+}
+
+void
+copier(const CopyData &ad, Vector<double> &result)
+{
+  // write into the five elements of 'result' starting at
+  // ad.computed%result.size()
+  for (unsigned int j = 0; j < 5; ++j)
+    result((ad.computed + j) % result.size()) += ad.computed;
+}
+
+void
+reducer(const Vector<double> &local_result, Vector<double> &result)
+{
+  result += local_result;
+}
+
+
+
+void
+test()
+{
+  std::vector<unsigned int> v;
+  for (unsigned int i = 0; i < 200; ++i)
+    v.push_back(i);
+
+  // start from a nonzero vector to check that the result is added to the
+  // target
+  Vector<double> result(100);
+  result = 1.;
+
+  WorkStream::Statistics statistics;
+  WorkStream::run_with_thread_local_reduction(v.begin(),
+                                              v.end(),
+                                              &worker,
+                                              &copier,
+                                              &reducer,
+                                              ScratchData(),
+                                              CopyData(),
+                                              Vector<double>(result.size()),
+                                              result,
+                                              8,
+                                              &statistics);
+  deallog << "Items: " << statistics.n_items << std::endl;
+  AssertThrow(statistics.n_chunks > 0 &&
+                statistics.n_chunks <= statistics.n_items,
+              ExcInternalError());
+  AssertThrow(statistics.worker_time >= 0. && statistics.copier_time >= 0. &&
+                statistics.wall_time > 0.,
+              ExcInternalError());
+
+  // now simulate what we should have gotten. since all numbers are
+  // integers, the result does not depend on the order of the additions
+  Vector<double> comp(result.size());
+  comp = 1.;
+  for (unsigned int i = 0; i < v.size(); ++i)
+    {
+      const unsigned int ad_computed = v[i] * 2;
+      for (unsigned int j = 0; j < 5; ++j)
+        comp((ad_computed + j) % result.size()) += ad_computed;
+    }
+
+  // and compare
+  for (unsigned int i = 0; i < result.size(); ++i)
+    AssertThrow(result(i) == comp(i), ExcInternalError());
+
+  for (unsigned int i = 0; i < result.size(); ++i)
+    deallog << result(i) << std::endl;
+
+  // collect statistics for the regular pipeline as well
+  Vector<double> pipeline_result(result.size());
+  pipeline_result = 1.;
+  WorkStream::run(
+    v.begin(),
+    v.end(),
+    &worker,
+    [&pipeline_result](const CopyData &ad) { copier(ad, pipeline_result); },
+    ScratchData(),
+    CopyData(),
+    2 * MultithreadInfo::n_threads(),
+    8,
+    &statistics);
+  deallog << "Items: " << statistics.n_items << std::endl;
+  AssertThrow(statistics.reduction_time == 0., ExcInternalError());
+  AssertThrow(pipeline_result == result, ExcInternalError());
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test();
+}
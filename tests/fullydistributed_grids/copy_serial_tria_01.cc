@@ -0,0 +1,127 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Create a parallel::fullydistributed::Triangulation from a partitioned
+// serial triangulation with hanging nodes and check that the locally owned
+// and ghost cells agree with the ones of the serial triangulation, and that
+// only the coarse cells around them are stored
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test(const unsigned int n_refinements)
+{
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+
+  Triangulation<dim> basetria;
+  GridGenerator::subdivided_hyper_cube(basetria, 4);
+  for (const auto &cell : basetria.active_cell_iterators())
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      if (cell->face(f)->at_boundary())
+        cell->face(f)->set_boundary_id(f);
+  basetria.refine_global(n_refinements);
+  for (const auto &cell : basetria.active_cell_iterators())
+    if (cell->center()[0] < 0.25)
+      cell->set_refine_flag();
+  basetria.execute_coarsening_and_refinement();
+  GridTools::partition_triangulation_zorder(n_procs, basetria);
+
+  parallel::fullydistributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  tria.copy_triangulation(basetria);
+
+  deallog << "dim=" << dim << ", n_refinements=" << n_refinements << std::endl;
+  deallog << "Global active cells: " << tria.n_global_active_cells() << " of "
+          << basetria.n_active_cells() << std::endl;
+  deallog << "Locally owned cells: " << tria.n_locally_owned_active_cells()
+          << std::endl;
+  deallog << "Stored coarse cells: " << tria.n_cells(0) << " of "
+          << basetria.n_cells(0) << std::endl;
+  deallog << "Has hanging nodes: " << tria.has_hanging_nodes() << std::endl;
+
+  // every locally owned or ghost cell must be an active cell of the serial
+  // triangulation at the same place, with the same owner and boundary ids
+  bool cells_agree = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (!cell->is_artificial())
+      {
+        const auto base_cell = cell->id().to_cell(basetria);
+        cells_agree &= base_cell->active() &&
+                       base_cell->subdomain_id() == cell->subdomain_id() &&
+                       base_cell->center().distance(cell->center()) < 1e-12;
+        for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+          if (base_cell->face(f)->at_boundary())
+            cells_agree &=
+              cell->face(f)->boundary_id() == base_cell->face(f)->boundary_id();
+          else if (cell->is_locally_owned())
+            cells_agree &= !cell->face(f)->at_boundary();
+      }
+
+  // and the other way around, every cell of the serial triangulation that is
+  // owned by the current process or is a neighbor of such a cell must be
+  // stored as a locally owned or ghost cell
+  std::vector<bool> vertex_of_own_cell(basetria.n_vertices(), false);
+  for (const auto &cell : basetria.active_cell_iterators())
+    if (cell->subdomain_id() == my_rank)
+      for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+        vertex_of_own_cell[cell->vertex_index(v)] = true;
+  unsigned int n_ghost_cells = 0;
+  for (const auto &cell : basetria.active_cell_iterators())
+    for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell; ++v)
+      if (vertex_of_own_cell[cell->vertex_index(v)])
+        {
+          const auto local_cell = cell->id().to_cell(tria);
+          cells_agree &= local_cell->active() && !local_cell->is_artificial();
+          if (cell->subdomain_id() != my_rank)
+            ++n_ghost_cells;
+          break;
+        }
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_ghost())
+      --n_ghost_cells;
+  deallog << "Cells agree: " << (cells_agree && n_ghost_cells == 0)
+          << std::endl;
+
+  deallog << "Ghost owners:";
+  for (const auto owner : tria.ghost_owners())
+    deallog << ' ' << owner;
+  deallog << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log_all;
+
+  test<2>(0);
+  test<2>(2);
+  test<3>(1);
+}
@@ -0,0 +1,116 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Create a parallel::fullydistributed::Triangulation with
+// create_construction_data_in_groups() for different group sizes and check
+// that it is the same as the one created from the serial triangulation on
+// every process
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+create_serial_grid(Triangulation<dim> &tria)
+{
+  GridGenerator::subdivided_hyper_cube(tria, 4);
+  for (const auto &cell : tria.active_cell_iterators())
+    for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+      if (cell->face(f)->at_boundary())
+        cell->face(f)->set_boundary_id(f);
+  tria.refine_global(1);
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->center()[0] < 0.25)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim>
+std::map<CellId, types::subdomain_id>
+get_cells(const Triangulation<dim> &tria)
+{
+  std::map<CellId, types::subdomain_id> cells;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (!cell->is_artificial())
+      cells[cell->id()] = cell->subdomain_id();
+  return cells;
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int group_size)
+{
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  Triangulation<dim> basetria;
+  create_serial_grid(basetria);
+  GridTools::partition_triangulation_zorder(n_procs, basetria);
+  parallel::fullydistributed::Triangulation<dim> reference(MPI_COMM_WORLD);
+  reference.copy_triangulation(basetria);
+
+  parallel::fullydistributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  tria.create_triangulation(
+    parallel::fullydistributed::create_construction_data_in_groups<dim, dim>(
+      [](Triangulation<dim> &serial_tria) { create_serial_grid(serial_tria); },
+      [](Triangulation<dim> &serial_tria, const unsigned int n_partitions) {
+        GridTools::partition_triangulation_zorder(n_partitions, serial_tria);
+      },
+      MPI_COMM_WORLD,
+      group_size));
+
+  deallog << "dim=" << dim << ", group size="
+          << (group_size == numbers::invalid_unsigned_int ?
+                std::string("node") :
+                std::to_string(group_size))
+          << std::endl;
+  deallog << "Global active cells: " << tria.n_global_active_cells()
+          << std::endl;
+  deallog << "Locally owned cells: " << tria.n_locally_owned_active_cells()
+          << std::endl;
+  deallog << "Stored coarse cells: " << tria.n_cells(0) << std::endl;
+  deallog << "Same as copy_triangulation: "
+          << (get_cells(tria) == get_cells(reference) &&
+              tria.n_cells(0) == reference.n_cells(0))
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log_all;
+
+  test<2>(1);
+  test<2>(2);
+  test<2>(numbers::invalid_unsigned_int);
+  test<3>(numbers::invalid_unsigned_int);
+}
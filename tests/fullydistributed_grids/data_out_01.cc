@@ -0,0 +1,126 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Write a solution on a parallel::fullydistributed::Triangulation with
+// DataOut::write_vtu_in_parallel() and check that the file contains one piece
+// per process with the locally owned cells of that process, which together
+// make up the cells of the serial mesh
+
+#include <deal.II/base/function_lib.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test()
+{
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  Triangulation<dim> basetria;
+  GridGenerator::subdivided_hyper_cube(basetria, 4);
+  basetria.refine_global(1);
+  for (const auto &cell : basetria.active_cell_iterators())
+    if (cell->center()[0] < 0.25)
+      cell->set_refine_flag();
+  basetria.execute_coarsening_and_refinement();
+  GridTools::partition_triangulation_zorder(n_procs, basetria);
+
+  parallel::fullydistributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  tria.copy_triangulation(basetria);
+
+  const FE_Q<dim> fe(1);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  LinearAlgebra::distributed::Vector<double> vector(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, MPI_COMM_WORLD);
+  VectorTools::interpolate(dof_handler,
+                           Functions::SquareFunction<dim>(),
+                           vector);
+  vector.update_ghost_values();
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(vector, "solution");
+  data_out.build_patches();
+
+  const std::string filename =
+    "output_" + Utilities::int_to_string(dim) + "d.vtu";
+  data_out.write_vtu_in_parallel(filename.c_str(), MPI_COMM_WORLD);
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  const std::vector<unsigned int> owned_cells_per_process =
+    Utilities::MPI::gather(MPI_COMM_WORLD,
+                           tria.n_locally_owned_active_cells());
+
+  deallog << "dim=" << dim << std::endl;
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      // read the number of cells of each piece back from the file
+      std::ifstream             in(filename);
+      std::string               line;
+      std::vector<unsigned int> cells_per_piece;
+      const std::string         tag = "NumberOfCells=\"";
+      while (std::getline(in, line))
+        if (line.find("<Piece ") != std::string::npos)
+          {
+            const std::size_t pos = line.find(tag) + tag.size();
+            cells_per_piece.push_back(std::stoi(line.substr(pos)));
+          }
+
+      unsigned int n_cells = 0;
+      for (const unsigned int n : cells_per_piece)
+        n_cells += n;
+      deallog << "Pieces: " << cells_per_piece.size() << ", cells: " << n_cells
+              << ", serial mesh: " << basetria.n_active_cells() << std::endl;
+      deallog << "Pieces match locally owned cells: "
+              << (cells_per_piece == owned_cells_per_process ? "yes" : "no")
+              << std::endl;
+    }
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log_all;
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,187 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Distribute degrees of freedom on a parallel::fullydistributed::Triangulation
+// with hanging nodes, check that the values of an interpolated function are
+// consistent on the ghost cells, integrate the function with MatrixFree, and
+// create the output patches of the locally owned cells with DataOut
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/data_out.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+class LinearFunction : public Function<dim>
+{
+public:
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    double value = 0;
+    for (unsigned int d = 0; d < dim; ++d)
+      value += (d + 1) * p[d];
+    return value;
+  }
+};
+
+
+
+template <int dim>
+void
+test()
+{
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  Triangulation<dim> basetria;
+  GridGenerator::subdivided_hyper_cube(basetria, 4);
+  basetria.refine_global(1);
+  for (const auto &cell : basetria.active_cell_iterators())
+    if (cell->center()[0] < 0.25)
+      cell->set_refine_flag();
+  basetria.execute_coarsening_and_refinement();
+  GridTools::partition_triangulation_zorder(n_procs, basetria);
+
+  parallel::fullydistributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  tria.copy_triangulation(basetria);
+
+  const FE_Q<dim> fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  DoFHandler<dim> serial_dof_handler(basetria);
+  serial_dof_handler.distribute_dofs(fe);
+
+  deallog << "dim=" << dim << std::endl;
+  deallog << "Number of DoFs: " << dof_handler.n_dofs() << " serial: "
+          << serial_dof_handler.n_dofs() << std::endl;
+  deallog << "Sum of locally owned DoFs: "
+          << Utilities::MPI::sum(dof_handler.n_locally_owned_dofs(),
+                                 MPI_COMM_WORLD)
+          << std::endl;
+
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  AffineConstraints<double> constraints(locally_relevant_dofs);
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  // a linear function is represented exactly, so the interpolated values on
+  // all locally owned and ghost cells must match the function values at the
+  // support points if the DoF indices on the ghost cells are consistent
+  const LinearFunction<dim> function;
+
+  LinearAlgebra::distributed::Vector<double> vector(
+    dof_handler.locally_owned_dofs(), locally_relevant_dofs, MPI_COMM_WORLD);
+  VectorTools::interpolate(dof_handler, function, vector);
+  vector.update_ghost_values();
+
+  FEValues<dim>  fe_values(fe,
+                          Quadrature<dim>(fe.get_unit_support_points()),
+                          update_quadrature_points);
+  Vector<double> cell_values(fe.dofs_per_cell);
+  double         max_error = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    if (!cell->is_artificial())
+      {
+        fe_values.reinit(cell);
+        cell->get_dof_values(vector, cell_values);
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+          max_error =
+            std::max(max_error,
+                     std::abs(cell_values[i] -
+                              function.value(fe_values.quadrature_point(i))));
+      }
+  deallog << "Values on locally owned and ghost cells correct: "
+          << (Utilities::MPI::max(max_error, MPI_COMM_WORLD) < 1e-12)
+          << std::endl;
+
+  // integrate the function with MatrixFree
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(dof_handler, constraints, QGauss<1>(3));
+  LinearAlgebra::distributed::Vector<double> mf_vector;
+  matrix_free.initialize_dof_vector(mf_vector);
+  mf_vector.copy_locally_owned_data_from(vector);
+  mf_vector.update_ghost_values();
+
+  FEEvaluation<dim, 2> phi(matrix_free);
+  double               integral = 0;
+  for (unsigned int cell = 0; cell < matrix_free.n_macro_cells(); ++cell)
+    {
+      phi.reinit(cell);
+      phi.read_dof_values(mf_vector);
+      phi.evaluate(true, false);
+      VectorizedArray<double> cell_integral;
+      cell_integral = 0.;
+      for (unsigned int q = 0; q < phi.n_q_points; ++q)
+        cell_integral += phi.get_value(q) * phi.JxW(q);
+      for (unsigned int v = 0; v < matrix_free.n_components_filled(cell); ++v)
+        integral += cell_integral[v];
+    }
+  deallog << "Integral with MatrixFree: "
+          << Utilities::MPI::sum(integral, MPI_COMM_WORLD) << std::endl;
+
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(vector, "solution");
+  data_out.build_patches();
+  std::ostringstream vtk;
+  data_out.write_vtk(vtk);
+  std::istringstream vtk_in(vtk.str());
+  std::string        line;
+  unsigned int       n_output_cells = 0;
+  while (std::getline(vtk_in, line))
+    if (line.compare(0, 6, "CELLS ") == 0)
+      n_output_cells = std::stoi(line.substr(6));
+  deallog << "Output cells equal locally owned cells: "
+          << (n_output_cells == tria.n_locally_owned_active_cells())
+          << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log_all;
+
+  test<2>();
+  test<3>();
+}
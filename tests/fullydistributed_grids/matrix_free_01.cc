@@ -0,0 +1,262 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Apply operators through MatrixFree::cell_loop() with continuous elements
+// and hanging nodes, and through MatrixFree::loop() with face integrals for
+// discontinuous elements, on a parallel::fullydistributed::Triangulation, and
+// compare with the results on the serial mesh it was created from
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/matrix_free/fe_evaluation.h>
+#include <deal.II/matrix_free/matrix_free.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+typedef LinearAlgebra::distributed::Vector<double> VectorType;
+
+
+
+template <int dim>
+class TestFunction : public Function<dim>
+{
+public:
+  virtual double
+  value(const Point<dim> &p, const unsigned int = 0) const override
+  {
+    double value = 1;
+    for (unsigned int d = 0; d < dim; ++d)
+      value *= std::sin((d + 1) * p[d] + 0.3);
+    return value;
+  }
+};
+
+
+
+// a mass operator on the cells, and for the discontinuous elements also on
+// the faces, where the sum of the values on both sides is tested with the
+// test functions on both sides
+template <int dim, int fe_degree>
+class MassOperator
+{
+public:
+  MassOperator(const MatrixFree<dim, double> &data)
+    : data(data)
+  {}
+
+  void
+  vmult_cells(VectorType &dst, const VectorType &src) const
+  {
+    data.cell_loop(&MassOperator::local_cell, this, dst, src, true);
+  }
+
+  void
+  vmult_faces(VectorType &dst, const VectorType &src) const
+  {
+    data.loop(&MassOperator::local_cell,
+              &MassOperator::local_face,
+              &MassOperator::local_boundary,
+              this,
+              dst,
+              src,
+              true,
+              MatrixFree<dim, double>::DataAccessOnFaces::values,
+              MatrixFree<dim, double>::DataAccessOnFaces::values);
+  }
+
+private:
+  void
+  local_cell(const MatrixFree<dim, double> &              data,
+             VectorType &                                 dst,
+             const VectorType &                           src,
+             const std::pair<unsigned int, unsigned int> &cell_range) const
+  {
+    FEEvaluation<dim, fe_degree> phi(data);
+    for (unsigned int cell = cell_range.first; cell < cell_range.second;
+         ++cell)
+      {
+        phi.reinit(cell);
+        phi.gather_evaluate(src, true, false);
+        for (unsigned int q = 0; q < phi.n_q_points; ++q)
+          phi.submit_value(phi.get_value(q), q);
+        phi.integrate_scatter(true, false, dst);
+      }
+  }
+
+  void
+  local_face(const MatrixFree<dim, double> &              data,
+             VectorType &                                 dst,
+             const VectorType &                           src,
+             const std::pair<unsigned int, unsigned int> &face_range) const
+  {
+    FEFaceEvaluation<dim, fe_degree> phi_m(data, true);
+    FEFaceEvaluation<dim, fe_degree> phi_p(data, false);
+    for (unsigned int face = face_range.first; face < face_range.second;
+         ++face)
+      {
+        phi_m.reinit(face);
+        phi_p.reinit(face);
+        phi_m.gather_evaluate(src, true, false);
+        phi_p.gather_evaluate(src, true, false);
+        for (unsigned int q = 0; q < phi_m.n_q_points; ++q)
+          {
+            const VectorizedArray<double> sum =
+              phi_m.get_value(q) + phi_p.get_value(q);
+            phi_m.submit_value(sum, q);
+            phi_p.submit_value(sum, q);
+          }
+        phi_m.integrate_scatter(true, false, dst);
+        phi_p.integrate_scatter(true, false, dst);
+      }
+  }
+
+  void
+  local_boundary(const MatrixFree<dim, double> &              data,
+                 VectorType &                                 dst,
+                 const VectorType &                           src,
+                 const std::pair<unsigned int, unsigned int> &face_range) const
+  {
+    FEFaceEvaluation<dim, fe_degree> phi(data, true);
+    for (unsigned int face = face_range.first; face < face_range.second;
+         ++face)
+      {
+        phi.reinit(face);
+        phi.gather_evaluate(src, true, false);
+        for (unsigned int q = 0; q < phi.n_q_points; ++q)
+          phi.submit_value(phi.get_value(q), q);
+        phi.integrate_scatter(true, false, dst);
+      }
+  }
+
+  const MatrixFree<dim, double> &data;
+};
+
+
+
+// interpolate the test function on the mesh of the given DoFHandler, apply
+// the operator through the cell loop, or the loop with faces for
+// discontinuous elements, and return the norm of the result
+template <int dim, int fe_degree>
+double
+apply_operator(const DoFHandler<dim> &dof_handler)
+{
+  IndexSet locally_relevant_dofs;
+  DoFTools::extract_locally_relevant_dofs(dof_handler, locally_relevant_dofs);
+  AffineConstraints<double> constraints(locally_relevant_dofs);
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags_inner_faces =
+    update_values | update_JxW_values;
+  additional_data.mapping_update_flags_boundary_faces =
+    update_values | update_JxW_values;
+  MatrixFree<dim, double> matrix_free;
+  matrix_free.reinit(dof_handler,
+                     constraints,
+                     QGauss<1>(fe_degree + 1),
+                     additional_data);
+
+  VectorType src, dst;
+  matrix_free.initialize_dof_vector(src);
+  matrix_free.initialize_dof_vector(dst);
+  VectorTools::interpolate(dof_handler, TestFunction<dim>(), src);
+
+  const MassOperator<dim, fe_degree> mass_operator(matrix_free);
+  if (dof_handler.get_fe().dofs_per_vertex > 0)
+    mass_operator.vmult_cells(dst, src);
+  else
+    mass_operator.vmult_faces(dst, src);
+
+  return dst.l2_norm();
+}
+
+
+
+template <int dim, int fe_degree>
+void
+compare(const Triangulation<dim> &basetria,
+        const Triangulation<dim> &tria,
+        const FiniteElement<dim> &fe)
+{
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  DoFHandler<dim> serial_dof_handler(basetria);
+  serial_dof_handler.distribute_dofs(fe);
+
+  const double norm        = apply_operator<dim, fe_degree>(dof_handler);
+  const double serial_norm = apply_operator<dim, fe_degree>(serial_dof_handler);
+  const bool   same        = std::abs(norm - serial_norm) < 1e-12 * serial_norm;
+  deallog << fe.get_name() << ": norm " << norm << ", serial " << serial_norm
+          << ", same: " << (same ? "yes" : "no") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  const unsigned int n_procs = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  Triangulation<dim> basetria;
+  GridGenerator::subdivided_hyper_cube(basetria, 4);
+  basetria.refine_global(1);
+  for (const auto &cell : basetria.active_cell_iterators())
+    if (cell->center()[0] < 0.25)
+      cell->set_refine_flag();
+  basetria.execute_coarsening_and_refinement();
+  GridTools::partition_triangulation_zorder(n_procs, basetria);
+
+  parallel::fullydistributed::Triangulation<dim> tria(MPI_COMM_WORLD);
+  tria.copy_triangulation(basetria);
+
+  deallog << "dim=" << dim << std::endl;
+  compare<dim, 2>(basetria, tria, FE_Q<dim>(2));
+  compare<dim, 1>(basetria, tria, FE_DGQ<dim>(1));
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log_all;
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,115 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that GridTools::find_active_cells_around_points() finds the same
+// cells as GridTools::find_active_cell_around_point() on a curved mesh with
+// adaptive refinement, including points outside of the mesh
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1., dim == 2 ? 8 : 6);
+  tria.set_all_manifold_ids(0);
+  tria.set_manifold(0, SphericalManifold<dim>());
+  tria.refine_global(1);
+  unsigned int index = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (index++ % 3 == 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  MappingQ<dim>         mapping(3);
+  GridTools::Cache<dim> cache(tria, mapping);
+  const auto &          buckets = cache.get_cell_bucket_grid();
+  deallog << "Number of buckets: " << buckets.n_buckets() << std::endl;
+
+  std::vector<Point<dim>> points(1000);
+  for (Point<dim> &p : points)
+    for (unsigned int d = 0; d < dim; ++d)
+      p[d] = 2.4 * random_value<double>() - 1.2;
+  // add a vertex and a point in a curved part of a boundary cell
+  points.push_back(tria.begin_active()->vertex(0));
+  points.push_back(Point<dim>::unit_vector(0) * 0.9999);
+
+  const auto cells_and_positions =
+    GridTools::find_active_cells_around_points(cache, points);
+
+  unsigned int n_found = 0, n_same = 0;
+  double       max_error = 0.;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      bool found_single = true;
+      std::pair<typename Triangulation<dim>::active_cell_iterator, Point<dim>>
+        single;
+      try
+        {
+          single = GridTools::find_active_cell_around_point(cache, points[i]);
+        }
+      catch (const GridTools::ExcPointNotFound<dim> &)
+        {
+          found_single = false;
+        }
+
+      const auto &batch = cells_and_positions[i];
+      const bool  found_batch =
+        (batch.first.state() == IteratorState::valid);
+      AssertThrow(found_single == found_batch, ExcInternalError());
+      if (found_batch)
+        {
+          ++n_found;
+          n_same += (batch.first == single.first);
+          max_error = std::max(max_error,
+                               mapping
+                                 .transform_unit_to_real_cell(batch.first,
+                                                              batch.second)
+                                 .distance(points[i]));
+        }
+    }
+  deallog << "Points found: " << n_found << " of " << points.size()
+          << std::endl;
+  deallog << "Points in the same cell: " << n_same << std::endl;
+  deallog << "Positions correct: " << (max_error < 1e-10) << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,96 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// check that reading the binary variant of the GMSH-4 format gives the same
+// results as reading the ASCII variant
+
+#include <deal.II/grid/grid_in.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+gmsh_grid(const char *name_ascii, const char *name_binary)
+{
+  Triangulation<dim> tria_ascii;
+  {
+    GridIn<dim> grid_in;
+    grid_in.attach_triangulation(tria_ascii);
+    std::ifstream input_file(name_ascii);
+    grid_in.read_msh(input_file);
+  }
+
+  Triangulation<dim> tria_binary;
+  {
+    GridIn<dim> grid_in;
+    grid_in.attach_triangulation(tria_binary);
+    std::ifstream input_file(name_binary, std::ios::binary);
+    grid_in.read_msh(input_file);
+  }
+
+  AssertThrow(tria_ascii.n_active_cells() == tria_binary.n_active_cells(),
+              ExcInternalError());
+  AssertThrow(tria_ascii.n_vertices() == tria_binary.n_vertices(),
+              ExcInternalError());
+  deallog << "  " << tria_binary.n_active_cells() << " active cells"
+          << std::endl;
+
+  // the two meshes have to be identical, including the vertex numbering
+  for (unsigned int v = 0; v < tria_ascii.n_vertices(); ++v)
+    AssertThrow(tria_ascii.get_vertices()[v] == tria_binary.get_vertices()[v],
+                ExcInternalError());
+
+  auto       cell_ascii  = tria_ascii.begin_active();
+  auto       cell_binary = tria_binary.begin_active();
+  const auto end_ascii   = tria_ascii.end();
+  for (; cell_ascii != end_ascii; ++cell_ascii, ++cell_binary)
+    {
+      AssertThrow(cell_ascii->material_id() == cell_binary->material_id(),
+                  ExcInternalError());
+      for (unsigned int i = 0; i < GeometryInfo<dim>::vertices_per_cell; ++i)
+        AssertThrow(cell_ascii->vertex_index(i) == cell_binary->vertex_index(i),
+                    ExcInternalError());
+      for (unsigned int i = 0; i < GeometryInfo<dim>::faces_per_cell; ++i)
+        AssertThrow(cell_ascii->face(i)->boundary_id() ==
+                      cell_binary->face(i)->boundary_id(),
+                    ExcInternalError());
+      for (unsigned int i = 0; i < GeometryInfo<dim>::lines_per_cell; ++i)
+        AssertThrow(cell_ascii->line(i)->boundary_id() ==
+                      cell_binary->line(i)->boundary_id(),
+                    ExcInternalError());
+    }
+  deallog << "  OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  deallog << "hole81" << std::endl;
+  gmsh_grid<2>(SOURCE_DIR "/grid_in_msh_version_4/hole81.msh",
+               SOURCE_DIR "/grid_in_msh_version_4_binary/hole81.msh");
+  deallog << "grid_in_msh_01.3d" << std::endl;
+  gmsh_grid<3>(SOURCE_DIR "/grids/grid_in_msh_01.3d.v4.msh",
+               SOURCE_DIR "/grid_in_msh_version_4_binary/grid_in_msh_01.3d.msh");
+}
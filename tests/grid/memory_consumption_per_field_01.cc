@@ -0,0 +1,130 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check Triangulation::memory_consumption_per_field() and that the user data
+// and manifold ids of the objects of a triangulation are only stored once
+// they are used
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+check_sum(const Triangulation<dim> &tria)
+{
+  std::size_t sum = 0;
+  for (const auto &field : tria.memory_consumption_per_field())
+    sum += field.second;
+  deallog << "Sum of fields matches total: "
+          << (sum == tria.memory_consumption() ? "true" : "false")
+          << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+
+  const std::size_t empty_vector_size = sizeof(std::vector<int>);
+
+  std::map<std::string, std::size_t> fields =
+    tria.memory_consumption_per_field();
+  for (const auto &field : fields)
+    deallog << field.first << std::endl;
+  check_sum(tria);
+  deallog << "cells.user_data stored: "
+          << (fields["cells.user_data"] > tria.n_levels() * empty_vector_size)
+          << std::endl;
+  deallog << "cells.manifold_id stored: "
+          << (fields["cells.manifold_id"] > tria.n_levels() * empty_vector_size)
+          << std::endl;
+
+  // reading the user data and manifold ids must not allocate them
+  unsigned int sum = 0;
+  for (const auto &cell : tria.cell_iterators())
+    sum += cell->user_index() +
+           (cell->manifold_id() != numbers::flat_manifold_id);
+  deallog << "Sum of user indices and manifold ids: " << sum << std::endl;
+  fields = tria.memory_consumption_per_field();
+  deallog << "cells.user_data stored: "
+          << (fields["cells.user_data"] > tria.n_levels() * empty_vector_size)
+          << std::endl;
+
+  // now set them
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      cell->set_user_index(cell->active_cell_index() + 1);
+      cell->set_manifold_id(cell->active_cell_index() % 2);
+    }
+  fields = tria.memory_consumption_per_field();
+  check_sum(tria);
+  deallog << "cells.user_data stored: "
+          << (fields["cells.user_data"] > tria.n_levels() * empty_vector_size)
+          << std::endl;
+  deallog << "cells.manifold_id stored: "
+          << (fields["cells.manifold_id"] > tria.n_levels() * empty_vector_size)
+          << std::endl;
+
+  bool ok = true;
+  for (const auto &cell : tria.cell_iterators())
+    if (cell->active())
+      ok &= (cell->user_index() == cell->active_cell_index() + 1 &&
+             cell->manifold_id() == cell->active_cell_index() % 2);
+    else
+      ok &= (cell->user_index() == 0 &&
+             cell->manifold_id() == numbers::flat_manifold_id);
+  deallog << "Values correct: " << ok << std::endl;
+
+  // the data also has to survive refinement
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  unsigned int n_set = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    n_set += (cell->user_index() != 0);
+  deallog << "Cells with user index after refinement: " << n_set << std::endl;
+
+  // and clear_user_data() releases the memory again
+  tria.clear_user_data();
+  fields = tria.memory_consumption_per_field();
+  deallog << "cells.user_data stored: "
+          << (fields["cells.user_data"] > tria.n_levels() * empty_vector_size)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,127 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check GridTools::partition_triangulation_hilbert: the partitions of
+// uniform meshes are the blocks of the Hilbert curve, cells with larger
+// weights are put into smaller partitions, and flat bounding boxes of the
+// cell centers are handled
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+print_partitions(const Triangulation<dim> &tria, const unsigned int n_partitions)
+{
+  for (unsigned int p = 0; p < n_partitions; ++p)
+    {
+      unsigned int n_cells = 0;
+      Point<dim>   lower, upper;
+      bool         first = true;
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->subdomain_id() == p)
+          {
+            ++n_cells;
+            for (unsigned int v = 0; v < GeometryInfo<dim>::vertices_per_cell;
+                 ++v)
+              {
+                for (unsigned int d = 0; d < dim; ++d)
+                  {
+                    lower[d] = first ? cell->vertex(v)[d] :
+                                       std::min(lower[d], cell->vertex(v)[d]);
+                    upper[d] = first ? cell->vertex(v)[d] :
+                                       std::max(upper[d], cell->vertex(v)[d]);
+                  }
+                first = false;
+              }
+          }
+      deallog << "Partition " << p << ": " << n_cells << " cells in ["
+              << lower << "], [" << upper << "]" << std::endl;
+    }
+}
+
+
+
+template <int dim>
+void
+test_uniform()
+{
+  // the curve visits the quadrants (octants in 3d) one after the other, so
+  // each partition is one of them
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  GridTools::partition_triangulation_hilbert(
+    GeometryInfo<dim>::max_children_per_cell, tria);
+  deallog << "dim=" << dim << std::endl;
+  print_partitions(tria, GeometryInfo<dim>::max_children_per_cell);
+}
+
+
+
+void
+test_weighted()
+{
+  // the cells in the left half are three times as expensive, so the left
+  // half is split into three partitions and the right half forms the fourth
+  Triangulation<2> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 4);
+  std::vector<unsigned int> cell_weights(tria.n_active_cells());
+  for (const auto &cell : tria.active_cell_iterators())
+    cell_weights[cell->active_cell_index()] =
+      (cell->center()[0] < 0.5 ? 3 : 1);
+  GridTools::partition_triangulation_hilbert(4, cell_weights, tria);
+  deallog << "weighted" << std::endl;
+  print_partitions(tria, 4);
+}
+
+
+
+void
+test_flat()
+{
+  // all cell centers are on a line
+  Triangulation<2> tria;
+  GridGenerator::subdivided_hyper_rectangle(tria,
+                                            std::vector<unsigned int>{6, 1},
+                                            Point<2>(),
+                                            Point<2>(1, 1));
+  GridTools::partition_triangulation_hilbert(3, tria);
+  deallog << "flat" << std::endl;
+  print_partitions(tria, 3);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_uniform<1>();
+  test_uniform<2>();
+  test_uniform<3>();
+  test_weighted();
+  test_flat();
+}
@@ -0,0 +1,103 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// The new vertices created during refinement are computed in parallel. Check
+// that the mesh obtained with several threads is identical to the one
+// obtained with a single thread, and that the new vertices are placed on
+// the manifold
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+refine(Triangulation<dim> &tria, const unsigned int n_threads)
+{
+  MultithreadInfo::set_thread_limit(n_threads);
+
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.set_all_manifold_ids(0);
+  tria.set_manifold(0, SphericalManifold<dim>());
+  tria.refine_global(2);
+
+  // refine adaptively, including anisotropic refinement in 3d
+  unsigned int index = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (index++ % 3 == 0)
+      cell->set_refine_flag(
+        (dim == 3 && index % 2 == 0) ? RefinementCase<dim>::cut_x :
+                                       RefinementCase<dim>::isotropic_refinement);
+  tria.execute_coarsening_and_refinement();
+
+  MultithreadInfo::set_thread_limit();
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria_serial, tria_parallel;
+  refine(tria_serial, 1);
+  refine(tria_parallel, 4);
+
+  deallog << "dim=" << dim << ", " << tria_parallel.n_active_cells()
+          << " cells, " << tria_parallel.n_used_vertices() << " vertices"
+          << std::endl;
+
+  // the vertices have to be bitwise identical
+  const std::vector<Point<dim>> &vertices_serial = tria_serial.get_vertices();
+  const std::vector<Point<dim>> &vertices_parallel =
+    tria_parallel.get_vertices();
+  bool identical = (vertices_serial.size() == vertices_parallel.size());
+  for (unsigned int v = 0; identical && v < vertices_serial.size(); ++v)
+    identical = (vertices_serial[v] == vertices_parallel[v]);
+  deallog << "Identical vertices: " << identical << std::endl;
+
+  // the vertices have to lie on the spheres between the ones of the coarse
+  // mesh, i.e., their radius is a multiple of 1/32
+  double max_deviation = 0;
+  for (unsigned int v = 0; v < vertices_parallel.size(); ++v)
+    if (tria_parallel.get_used_vertices()[v])
+      {
+        const double r = 32. * vertices_parallel[v].norm();
+        max_deviation  = std::max(max_deviation, std::abs(r - std::round(r)));
+      }
+  deallog << "Vertices on the manifold: " << (max_deviation < 1e-10)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,108 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check the fused LinearAlgebra::distributed::Vector::sadd() and
+// sadd_and_dot() functions against the separate vector operations
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <limits>
+
+#include "../tests.h"
+
+
+
+template <typename number>
+void
+check()
+{
+  using VectorType = LinearAlgebra::distributed::Vector<number>;
+  const number tolerance =
+    std::is_same<number, double>::value ? 1e-12 : 1e-5;
+
+  for (unsigned int test = 0; test < 5; ++test)
+    {
+      const unsigned int size         = 17 + test * 1101;
+      const IndexSet     complete_set = complete_index_set(size);
+      VectorType         u(complete_set, MPI_COMM_SELF),
+        v1(complete_set, MPI_COMM_SELF), v2(complete_set, MPI_COMM_SELF),
+        v3(complete_set, MPI_COMM_SELF), w(complete_set, MPI_COMM_SELF);
+      for (unsigned int i = 0; i < size; ++i)
+        {
+          u(i)  = 0.1 + 0.005 * i;
+          v1(i) = -5.2 + 0.18 * i;
+          v2(i) = 3.14159 + 2.7183 / (1. + i);
+          v3(i) = std::sin(0.1 * i);
+          w(i)  = 1. / (1. + i);
+        }
+
+      // linear combination of three vectors
+      VectorType check(u), fused(u);
+      check *= 0.5;
+      check.add(0.25, v1);
+      check.add(-1.5, v2);
+      check.add(2., v3);
+      fused.template sadd<3>(0.5, {{0.25, -1.5, 2.}}, {{&v1, &v2, &v3}});
+      fused -= check;
+      AssertThrow(fused.linfty_norm() <= tolerance * check.linfty_norm(),
+                  ExcInternalError());
+
+      // a zero factor overwrites the vector, even if it contains NaNs
+      fused = std::numeric_limits<number>::quiet_NaN();
+      fused.template sadd<2>(0., {{1., 3.}}, {{&v1, &v2}});
+      check.equ(1., v1);
+      check.add(3., v2);
+      fused -= check;
+      AssertThrow(fused.linfty_norm() <= tolerance * check.linfty_norm(),
+                  ExcInternalError());
+
+      // linear combination combined with an inner product and the norm
+      check = u;
+      fused = u;
+      check.sadd(2., 0.125, v1);
+      check.add(-0.5, v2);
+      const number prod = check * w;
+      const number norm = check.norm_sqr();
+      const std::array<number, 2> dots =
+        fused.template sadd_and_dot<2, 2>(2.,
+                                          {{0.125, -0.5}},
+                                          {{&v1, &v2}},
+                                          {{&w, &fused}});
+      AssertThrow(std::abs(dots[0] - prod) <= tolerance * std::abs(prod),
+                  ExcInternalError());
+      AssertThrow(std::abs(dots[1] - norm) <= tolerance * norm,
+                  ExcInternalError());
+      fused -= check;
+      AssertThrow(fused.linfty_norm() <= tolerance * check.linfty_norm(),
+                  ExcInternalError());
+
+      deallog << "size " << size << ": " << prod / static_cast<number>(size)
+              << " " << norm / static_cast<number>(size) << std::endl;
+    }
+}
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  initlog();
+  deallog << std::setprecision(5);
+  check<float>();
+  check<double>();
+  deallog << "OK" << std::endl;
+}
@@ -0,0 +1,104 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that the chart point cache of TransfiniteInterpolationManifold gives
+// the same mesh as the computation without the cache, also when the cache is
+// used over several refinement steps and with a higher order mapping
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_nothing.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+create_mesh(Triangulation<dim> &                    tria,
+            TransfiniteInterpolationManifold<dim> &inner_manifold)
+{
+  GridGenerator::hyper_ball(tria);
+  tria.set_all_manifold_ids(1);
+  tria.set_all_manifold_ids_on_boundary(0);
+  tria.set_manifold(0, SphericalManifold<dim>());
+  inner_manifold.initialize(tria);
+  tria.set_manifold(1, inner_manifold);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim>                    tria, tria_cached;
+  TransfiniteInterpolationManifold<dim> manifold, manifold_cached;
+  manifold_cached.use_chart_point_cache(true);
+  create_mesh(tria, manifold);
+  create_mesh(tria_cached, manifold_cached);
+
+  double max_difference = 0;
+  for (unsigned int v = 0; v < tria.n_vertices(); ++v)
+    max_difference =
+      std::max(max_difference,
+               tria.get_vertices()[v].distance(tria_cached.get_vertices()[v]));
+  deallog << "dim=" << dim << ", " << tria.n_active_cells() << " cells"
+          << std::endl;
+  deallog << "Vertices agree: " << (max_difference < 1e-10) << std::endl;
+
+  // compare the quadrature points of a high order mapping
+  MappingQGeneric<dim> mapping(4);
+  FE_Nothing<dim>      fe;
+  QGauss<dim>          quad(3);
+  FEValues<dim>        fe_values(mapping, fe, quad, update_quadrature_points);
+  FEValues<dim> fe_values_cached(mapping, fe, quad, update_quadrature_points);
+  max_difference = 0;
+  for (auto cell = tria.begin_active(), cell_cached = tria_cached.begin_active();
+       cell != tria.end();
+       ++cell, ++cell_cached)
+    {
+      fe_values.reinit(cell);
+      fe_values_cached.reinit(cell_cached);
+      for (unsigned int q = 0; q < quad.size(); ++q)
+        max_difference =
+          std::max(max_difference,
+                   fe_values.quadrature_point(q).distance(
+                     fe_values_cached.quadrature_point(q)));
+    }
+  deallog << "Quadrature points agree: " << (max_difference < 1e-10)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>();
+  test<3>();
+}
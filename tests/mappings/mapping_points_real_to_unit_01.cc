@@ -0,0 +1,152 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check that Mapping::transform_points_real_to_unit_cell() gives the same
+// result as transform_real_to_unit_cell() called for each point, for points
+// inside and outside of the cells of a curved mesh, and that it flags the
+// points it can not transform
+
+#include <deal.II/base/bounding_box.h>
+
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q1.h>
+#include <deal.II/fe/mapping_q_generic.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim, int spacedim>
+void
+test(const Triangulation<dim, spacedim> &tria,
+     const Mapping<dim, spacedim> &      mapping)
+{
+  unsigned int n_points = 0, n_inside = 0, n_failed = 0, n_flagged = 0,
+               n_mismatch = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    {
+      // a lattice of points in the bounding box of the cell, enlarged by a
+      // factor of two so that some of the points are outside of the cell
+      const BoundingBox<spacedim>  box  = cell->bounding_box();
+      const unsigned int           n_1d = 5;
+      std::vector<Point<spacedim>> real_points;
+      for (unsigned int i = 0; i < Utilities::fixed_power<spacedim>(n_1d); ++i)
+        {
+          Point<spacedim> p;
+          for (unsigned int d = 0, index = i; d < spacedim; ++d, index /= n_1d)
+            {
+              const double x0 = box.get_boundary_points().first[d];
+              const double x1 = box.get_boundary_points().second[d];
+              const double t  = -0.5 + 2. * (index % n_1d) / (n_1d - 1);
+              p[d]            = x0 + (x1 - x0) * t;
+            }
+          real_points.push_back(p);
+        }
+
+      std::vector<Point<dim>> unit_points(real_points.size());
+      mapping.transform_points_real_to_unit_cell(
+        cell,
+        make_array_view(real_points),
+        make_array_view(unit_points));
+
+      for (unsigned int i = 0; i < real_points.size(); ++i)
+        {
+          ++n_points;
+          if (unit_points[i][0] == std::numeric_limits<double>::infinity())
+            ++n_flagged;
+          bool       failed = false;
+          Point<dim> p_unit;
+          try
+            {
+              p_unit =
+                mapping.transform_real_to_unit_cell(cell, real_points[i]);
+            }
+          catch (typename Mapping<dim, spacedim>::ExcTransformationFailed &)
+            {
+              failed = true;
+            }
+
+          // the batched iteration may find the inverse also for points
+          // outside of the cell for which the scalar one fails. check that
+          // these are correct
+          if (failed)
+            {
+              ++n_failed;
+              const bool flagged =
+                unit_points[i][0] == std::numeric_limits<double>::infinity();
+              if (!flagged &&
+                  mapping.transform_unit_to_real_cell(cell, unit_points[i])
+                      .distance(real_points[i]) > 1e-8 * cell->diameter())
+                ++n_mismatch;
+            }
+          else
+            {
+              if (GeometryInfo<dim>::is_inside_unit_cell(p_unit, 1e-10))
+                ++n_inside;
+              if (unit_points[i].distance(p_unit) > 1e-8)
+                ++n_mismatch;
+            }
+        }
+    }
+
+  deallog << "Points: " << n_points << ", inside: " << n_inside
+          << ", failed: " << n_failed << ", flagged: " << n_flagged
+          << ", mismatch: " << n_mismatch << std::endl;
+}
+
+
+
+template <int dim>
+void
+test_dim()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.set_all_manifold_ids(0);
+  tria.set_manifold(0, SphericalManifold<dim>());
+  tria.refine_global(1);
+
+  test(tria, MappingQ1<dim>());
+  test(tria, MappingQGeneric<dim>(2));
+  test(tria, MappingQGeneric<dim>(4));
+  test(tria, MappingQ<dim>(3));
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test_dim<2>();
+  test_dim<3>();
+
+  deallog << "dim=2, spacedim=3" << std::endl;
+  Triangulation<2, 3> tria;
+  GridGenerator::hyper_sphere(tria);
+  tria.refine_global(1);
+  test(tria, MappingQGeneric<2, 3>(3));
+}
@@ -0,0 +1,91 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check Utilities::MPI::consensus_exchange() and
+// Utilities::MPI::compute_index_owner() for an index space where each
+// processor owns several blocks of indices
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/utilities.h>
+
+#include "../tests.h"
+
+
+void
+test()
+{
+  const unsigned int myid    = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int numproc = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  // send the own rank to the next two processors
+  std::map<unsigned int, std::vector<unsigned int>> data_to_send;
+  data_to_send[(myid + 1) % numproc].push_back(myid);
+  data_to_send[(myid + 2) % numproc].push_back(myid);
+  const auto received =
+    Utilities::MPI::consensus_exchange(MPI_COMM_WORLD, data_to_send);
+  for (const auto &rank_data : received)
+    {
+      AssertDimension(rank_data.second.size(), 1);
+      AssertThrow(rank_data.first == rank_data.second[0], ExcInternalError());
+      if (myid == 0)
+        deallog << "Processor 0 received data from " << rank_data.first
+                << std::endl;
+    }
+
+  // blocks of three indices are owned round-robin by the processors
+  const unsigned int size = 10 * numproc;
+  IndexSet           owned(size);
+  for (unsigned int i = 0; i < size; ++i)
+    if ((i / 3) % numproc == myid)
+      owned.add_index(i);
+
+  IndexSet to_look_up(size);
+  for (unsigned int i = myid; i < size; i += 4)
+    to_look_up.add_index(i);
+
+  const std::vector<unsigned int> owners =
+    Utilities::MPI::compute_index_owner(owned, to_look_up, MPI_COMM_WORLD);
+  AssertDimension(owners.size(), to_look_up.n_elements());
+  for (unsigned int i = 0; i < owners.size(); ++i)
+    {
+      const types::global_dof_index index = to_look_up.nth_index_in_set(i);
+      AssertThrow(owners[i] == (index / 3) % numproc, ExcInternalError());
+      if (myid == 0)
+        deallog << "Owner of index " << index << ": " << owners[i]
+                << std::endl;
+    }
+
+  if (myid == 0)
+    deallog << "OK" << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, testing_max_num_threads());
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      initlog();
+      test();
+    }
+  else
+    test();
+}
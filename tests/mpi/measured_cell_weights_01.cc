@@ -0,0 +1,133 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check parallel::MeasuredCellWeights: the imbalance computed from recorded
+// costs, the smoothing over steps, the scaling of the cell weights, the
+// reset upon mesh refinement, and the timing of WorkStream workers
+
+#include <deal.II/base/work_stream.h>
+
+#include <deal.II/distributed/measured_cell_weights.h>
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/filtered_iterator.h>
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+template <int dim>
+void
+test()
+{
+  using active_cell_iterator =
+    typename Triangulation<dim>::active_cell_iterator;
+
+  parallel::shared::Triangulation<dim> tria(
+    MPI_COMM_WORLD,
+    Triangulation<dim>::none,
+    false,
+    parallel::shared::Triangulation<dim>::partition_zorder);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(3);
+
+  parallel::MeasuredCellWeights<dim> cell_weights(tria);
+
+  // cells in a strip at the left are ten times as expensive as the others
+  for (unsigned int step = 0; step < 3; ++step)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->is_locally_owned())
+          cell_weights.add_cost(cell,
+                                (step + 1) *
+                                  (cell->center()[0] < 0.25 ? 10. : 1.));
+      cell_weights.finish_step();
+      deallog << "Step " << cell_weights.n_finished_steps()
+              << ", imbalance: " << cell_weights.get_imbalance() << std::endl;
+    }
+
+  // the costs are smoothed with the default factor of one half
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        deallog << "Cost of first cell: " << cell_weights.get_cost(cell)
+                << std::endl;
+        break;
+      }
+
+  // on average, the cells get the weight factor as additional weight
+  unsigned int weight_sum = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      weight_sum += tria.signals.cell_weight(
+        cell, Triangulation<dim>::CellStatus::CELL_PERSIST);
+  deallog << "Average weight: "
+          << Utilities::MPI::sum(weight_sum, MPI_COMM_WORLD) /
+               tria.n_global_active_cells()
+          << std::endl;
+
+  // the costs are discarded when the mesh changes
+  tria.refine_global(1);
+  deallog << "After refinement: steps " << cell_weights.n_finished_steps()
+          << ", imbalance: " << cell_weights.get_imbalance() << std::endl;
+
+  // record the time of a WorkStream worker on the new mesh
+  struct ScratchData
+  {};
+  struct CopyData
+  {
+    double value;
+  };
+  double sum = 0;
+  WorkStream::run(
+    FilteredIterator<active_cell_iterator>(IteratorFilters::LocallyOwnedCell(),
+                                           tria.begin_active()),
+    FilteredIterator<active_cell_iterator>(IteratorFilters::LocallyOwnedCell(),
+                                           tria.end()),
+    cell_weights.timed_worker(
+      [](const FilteredIterator<active_cell_iterator> &cell,
+         ScratchData &,
+         CopyData &copy_data) {
+        copy_data.value = 0;
+        for (unsigned int i = 0; i < 1000; ++i)
+          copy_data.value += std::sin(cell->center()[0] + i);
+      }),
+    [&sum](const CopyData &copy_data) { sum += copy_data.value; },
+    ScratchData(),
+    CopyData());
+  cell_weights.finish_step();
+  bool all_measured = true;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      all_measured &= (cell_weights.get_cost(cell) > 0);
+  deallog << "All cells measured: " << all_measured << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log_all;
+
+  test<2>();
+}
@@ -0,0 +1,140 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check update_ghost_values() and compress() for a vector whose partitioner
+// exchanges the data between processes on the same node through shared
+// memory, similar to parallel_vector_07 and parallel_vector_08
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <iostream>
+#include <vector>
+
+#include "../tests.h"
+
+
+void
+test()
+{
+  unsigned int myid    = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  unsigned int numproc = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  if (myid == 0)
+    deallog << "numproc=" << numproc << std::endl;
+
+  const unsigned int set = 200;
+  AssertIndexRange(numproc, set - 2);
+  const unsigned int local_size  = set - myid;
+  unsigned int       global_size = 0;
+  unsigned int       my_start    = 0;
+  for (unsigned int i = 0; i < numproc; ++i)
+    {
+      global_size += set - i;
+      if (i < myid)
+        my_start += set - i;
+    }
+  // each processor owns some indices and all are ghosting elements from
+  // three processors (the second). some entries are right around the border
+  // between two processors
+  IndexSet local_owned(global_size);
+  local_owned.add_range(my_start, my_start + local_size);
+  IndexSet local_relevant(global_size);
+  local_relevant                 = local_owned;
+  unsigned int ghost_indices[10] = {1,
+                                    2,
+                                    13,
+                                    set - 2,
+                                    set - 1,
+                                    set,
+                                    set + 1,
+                                    2 * set,
+                                    2 * set + 1,
+                                    2 * set + 3};
+  local_relevant.add_indices(&ghost_indices[0], &ghost_indices[0] + 10);
+
+  auto partitioner =
+    std::make_shared<Utilities::MPI::Partitioner>(local_owned, MPI_COMM_WORLD);
+  partitioner->enable_shared_memory_communication();
+  partitioner->set_ghost_indices(local_relevant);
+
+  // all processes of this test run on the same node
+  unsigned int n_shared_targets = 0;
+  for (const unsigned int rank :
+       partitioner->ghost_targets_shared_memory_ranks())
+    if (rank != numbers::invalid_unsigned_int)
+      ++n_shared_targets;
+  AssertDimension(n_shared_targets, partitioner->ghost_targets().size());
+
+  LinearAlgebra::distributed::Vector<double> v(partitioner);
+
+  for (unsigned i = 0; i < local_size; ++i)
+    v.local_element(i) = 2.0 * (i + my_start);
+
+  v.update_ghost_values();
+
+  for (unsigned int i = 0; i < local_size; ++i)
+    AssertThrow(v.local_element(i) == 2.0 * (i + my_start), ExcInternalError());
+  for (unsigned int i = 0; i < 10; ++i)
+    AssertThrow(v(ghost_indices[i]) == 2. * ghost_indices[i],
+                ExcInternalError());
+
+  // now add into ghost entries and accumulate on the owners
+  v.zero_out_ghosts();
+  v = 0.;
+  for (unsigned int i = 0; i < 10; ++i)
+    v(ghost_indices[i]) += 1.;
+  v.compress(VectorOperation::add);
+
+  for (unsigned int i = 0; i < 10; ++i)
+    if (local_owned.is_element(ghost_indices[i]))
+      deallog << "value at " << ghost_indices[i] << ": "
+              << v(ghost_indices[i]) << std::endl;
+
+  // the same with a copy of the vector, which allocates its own window
+  LinearAlgebra::distributed::Vector<double> w(v);
+  w.update_ghost_values();
+  for (unsigned int i = 0; i < 10; ++i)
+    AssertThrow(w(ghost_indices[i]) == numproc, ExcInternalError());
+
+  if (myid == 0)
+    deallog << "OK" << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, testing_max_num_threads());
+
+  unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  deallog.push(Utilities::int_to_string(myid));
+
+  if (myid == 0)
+    {
+      initlog();
+      deallog << std::setprecision(4);
+
+      test();
+    }
+  else
+    test();
+}
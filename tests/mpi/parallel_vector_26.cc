@@ -0,0 +1,112 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check repeated calls to update_ghost_values() and compress(), which reuse
+// the persistent MPI requests of the vector, also after changing the
+// communication channel and after swapping two vectors
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <iostream>
+#include <vector>
+
+#include "../tests.h"
+
+
+void
+test()
+{
+  const unsigned int myid    = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int numproc = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  if (myid == 0)
+    deallog << "numproc=" << numproc << std::endl;
+
+  // each processor owns 2 indices and all are ghosting element 1 (the
+  // second) and the first element of the next processor
+  IndexSet local_owned(numproc * 2);
+  local_owned.add_range(myid * 2, myid * 2 + 2);
+  IndexSet local_relevant(numproc * 2);
+  local_relevant = local_owned;
+  local_relevant.add_index(1);
+  local_relevant.add_index((2 * myid + 2) % (2 * numproc));
+
+  LinearAlgebra::distributed::Vector<double> v(local_owned,
+                                               local_relevant,
+                                               MPI_COMM_WORLD);
+  LinearAlgebra::distributed::Vector<double> w(v);
+
+  for (unsigned int step = 0; step < 4; ++step)
+    {
+      v.local_element(0) = myid * 2 + step;
+      v.local_element(1) = myid * 2 + 1 + step;
+
+      // use a different channel in one of the steps
+      if (step == 2)
+        {
+          v.update_ghost_values_start(5);
+          v.update_ghost_values_finish();
+        }
+      else
+        v.update_ghost_values();
+
+      AssertThrow(v(1) == 1 + step, ExcInternalError());
+      AssertThrow(v((2 * myid + 2) % (2 * numproc)) ==
+                    (2 * myid + 2) % (2 * numproc) + step,
+                  ExcInternalError());
+
+      // accumulate into the first element of the next processor and into
+      // element 1
+      v.zero_out_ghosts();
+      v(1) += 1.;
+      v((2 * myid + 2) % (2 * numproc)) += 1.;
+      v.compress(VectorOperation::add);
+
+      if (myid == 0)
+        deallog << "step " << step << ": " << v(0) << " " << v(1)
+                << std::endl;
+
+      v.swap(w);
+    }
+
+  if (myid == 0)
+    deallog << "OK" << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, testing_max_num_threads());
+
+  unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  deallog.push(Utilities::int_to_string(myid));
+
+  if (myid == 0)
+    {
+      initlog();
+      deallog << std::setprecision(4);
+
+      test();
+    }
+  else
+    test();
+}
@@ -0,0 +1,123 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2019 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// check update_ghost_values() with the ghost values transmitted in reduced
+// precision, selected per vector through
+// set_reduced_precision_ghost_exchange()
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <iostream>
+#include <vector>
+
+#include "../tests.h"
+
+
+void
+test()
+{
+  const unsigned int myid    = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int numproc = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  if (myid == 0)
+    deallog << "numproc=" << numproc << std::endl;
+
+  // each processor owns 3 indices and ghosts the first two elements of the
+  // next processor
+  const unsigned int next = (3 * myid + 3) % (3 * numproc);
+  IndexSet           local_owned(numproc * 3);
+  local_owned.add_range(myid * 3, myid * 3 + 3);
+  IndexSet local_relevant(numproc * 3);
+  local_relevant = local_owned;
+  local_relevant.add_range(next, next + 2);
+
+  LinearAlgebra::distributed::Vector<double> v(local_owned,
+                                               local_relevant,
+                                               MPI_COMM_WORLD);
+  for (unsigned int i = 0; i < 3; ++i)
+    v.local_element(i) = 1. / (myid * 3 + i + 3);
+
+  // the copy keeps full precision
+  LinearAlgebra::distributed::Vector<double> w(v);
+  v.set_reduced_precision_ghost_exchange(true);
+  LinearAlgebra::distributed::Vector<double> u(v);
+  AssertThrow(v.has_reduced_precision_ghost_exchange(), ExcInternalError());
+  AssertThrow(u.has_reduced_precision_ghost_exchange(), ExcInternalError());
+  AssertThrow(!w.has_reduced_precision_ghost_exchange(), ExcInternalError());
+
+  v.update_ghost_values();
+  u.update_ghost_values_start(1);
+  w.update_ghost_values_start(2);
+  u.update_ghost_values_finish();
+  w.update_ghost_values_finish();
+  for (unsigned int i = next; i < next + 2; ++i)
+    {
+      const double exact = 1. / (i + 3);
+      AssertThrow(v(i) == static_cast<double>(static_cast<float>(exact)),
+                  ExcInternalError());
+      AssertThrow(u(i) == v(i), ExcInternalError());
+      AssertThrow(w(i) == exact, ExcInternalError());
+    }
+  if (myid == 0)
+    deallog << "reduced: " << v(next) << " " << v(next + 1) << std::endl
+            << "full:    " << w(next) << " " << w(next + 1) << std::endl;
+
+  // switch back to full precision
+  v.zero_out_ghosts();
+  v.set_reduced_precision_ghost_exchange(false);
+  v.update_ghost_values();
+  for (unsigned int i = next; i < next + 2; ++i)
+    AssertThrow(v(i) == w(i), ExcInternalError());
+
+  // the setting has no effect on float vectors
+  LinearAlgebra::distributed::Vector<float> f(local_owned,
+                                              local_relevant,
+                                              MPI_COMM_WORLD);
+  for (unsigned int i = 0; i < 3; ++i)
+    f.local_element(i) = 1.f / (myid * 3 + i + 3);
+  f.set_reduced_precision_ghost_exchange(true);
+  f.update_ghost_values();
+  for (unsigned int i = next; i < next + 2; ++i)
+    AssertThrow(f(i) == 1.f / (i + 3), ExcInternalError());
+
+  if (myid == 0)
+    deallog << "OK" << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, testing_max_num_threads());
+
+  unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  deallog.push(Utilities::int_to_string(myid));
+
+  if (myid == 0)
+    {
+      initlog();
+      deallog << std::setprecision(12);
+
+      test();
+    }
+  else
+    test();
+}
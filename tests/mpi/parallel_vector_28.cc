@@ -0,0 +1,155 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// for vectors allocated in a shared-memory window, check that reinit() with
+// an unchanged layout does not communicate, such that the processes can
+// reinitialize different numbers of vectors, and that two exchanges on
+// different communication channels can be finished in any order
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/partitioner.h>
+#include <deal.II/base/utilities.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <iostream>
+#include <vector>
+
+#include "../tests.h"
+
+
+void
+test()
+{
+  const unsigned int myid    = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  const unsigned int numproc = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+
+  if (myid == 0)
+    deallog << "numproc=" << numproc << std::endl;
+
+  // each process owns 10 entries and ghosts the first two entries of the
+  // next process
+  const unsigned int local_size = 10;
+  const unsigned int my_start   = myid * local_size;
+  IndexSet           local_owned(numproc * local_size);
+  local_owned.add_range(my_start, my_start + local_size);
+  IndexSet           local_relevant(local_owned);
+  const unsigned int next = ((myid + 1) % numproc) * local_size;
+  local_relevant.add_range(next, next + 2);
+
+  auto partitioner =
+    std::make_shared<Utilities::MPI::Partitioner>(local_owned, MPI_COMM_WORLD);
+  partitioner->enable_shared_memory_communication();
+  partitioner->set_ghost_indices(local_relevant);
+
+  // creating the vectors allocates the windows, which is collective
+  std::vector<LinearAlgebra::distributed::Vector<double>> vectors(numproc);
+  for (auto &v : vectors)
+    v.reinit(partitioner);
+
+  // now only some of the processes reinitialize some of the vectors, with
+  // process i doing so for the first i vectors. Since the layout does not
+  // change, the windows are kept and no process waits for the others
+  for (unsigned int i = 0; i < myid; ++i)
+    {
+      vectors[i].reinit(partitioner);
+      vectors[i].reinit(partitioner);
+    }
+
+  for (unsigned int v = 0; v < vectors.size(); ++v)
+    for (unsigned int i = 0; i < local_size; ++i)
+      vectors[v].local_element(i) = 100. * v + my_start + i;
+
+  // start the exchanges of the first two vectors on different channels and
+  // finish them in the reverse order
+  vectors[0].update_ghost_values_start(0);
+  vectors[1].update_ghost_values_start(1);
+  vectors[1].update_ghost_values_finish();
+  vectors[0].update_ghost_values_finish();
+  for (unsigned int v = 2; v < vectors.size(); ++v)
+    vectors[v].update_ghost_values();
+
+  for (unsigned int v = 0; v < vectors.size(); ++v)
+    for (unsigned int i = next; i < next + 2; ++i)
+      AssertThrow(vectors[v](i) == 100. * v + i, ExcInternalError());
+
+  // the same for compress(), adding one from the ghost entries
+  for (unsigned int v = 0; v < vectors.size(); ++v)
+    {
+      vectors[v].zero_out_ghosts();
+      vectors[v](next) += 1.;
+    }
+  vectors[0].compress_start(0, VectorOperation::add);
+  vectors[1].compress_start(1, VectorOperation::add);
+  vectors[1].compress_finish(VectorOperation::add);
+  vectors[0].compress_finish(VectorOperation::add);
+  for (unsigned int v = 2; v < vectors.size(); ++v)
+    vectors[v].compress(VectorOperation::add);
+
+  for (unsigned int v = 0; v < vectors.size(); ++v)
+    {
+      AssertThrow(vectors[v].local_element(0) == 100. * v + my_start + 1.,
+                  ExcInternalError());
+      AssertThrow(vectors[v].local_element(1) == 100. * v + my_start + 1.,
+                  ExcInternalError());
+    }
+
+  if (myid == 0)
+    for (unsigned int v = 0; v < vectors.size(); ++v)
+      deallog << "vector " << v << ": " << vectors[v].local_element(0) << " "
+              << vectors[v].local_element(1) << std::endl;
+
+  // reinitializing with a vector of a different partitioner object with the
+  // same layout keeps the window as well, as long as all processes switch
+  // to the new partitioner
+  auto partitioner_2 =
+    std::make_shared<Utilities::MPI::Partitioner>(local_owned, MPI_COMM_WORLD);
+  partitioner_2->enable_shared_memory_communication();
+  partitioner_2->set_ghost_indices(local_relevant);
+  LinearAlgebra::distributed::Vector<double> w(partitioner_2);
+  vectors[0].reinit(w);
+  for (unsigned int i = 0; i < local_size; ++i)
+    vectors[0].local_element(i) = my_start + i;
+  vectors[0].update_ghost_values();
+  for (unsigned int i = next; i < next + 2; ++i)
+    AssertThrow(vectors[0](i) == i, ExcInternalError());
+
+  if (myid == 0)
+    deallog << "OK" << std::endl;
+}
+
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, testing_max_num_threads());
+
+  unsigned int myid = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  deallog.push(Utilities::int_to_string(myid));
+
+  if (myid == 0)
+    {
+      initlog();
+      deallog << std::setprecision(4);
+
+      test();
+    }
+  else
+    test();
+}
@@ -0,0 +1,184 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check Utilities::MPI::RemotePointEvaluation::evaluate_and_process() by
+// evaluating the position of the points on the cells they were found in and
+// sending it to the processes that own the points, and check the relocation
+// of moving points with RemotePointEvaluation::update()
+
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+
+// points on a circle through the shell, with every fourth point outside. the
+// points differ between the processes
+template <int dim>
+std::vector<Point<dim>>
+create_points(const double angle, const bool with_outside_points)
+{
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 16; ++i)
+    if (with_outside_points || i % 4 != 3)
+      {
+        const double phi =
+          angle + 2. * numbers::PI * (i + 0.3 * my_rank) / 16;
+        const double radius = (i % 4 == 3) ? 1.2 : 0.55 + 0.1 * (i % 4);
+        Point<dim>   p;
+        p[0] = radius * std::cos(phi);
+        p[1] = radius * std::sin(phi);
+        if (dim == 3)
+          p[2] = 0.1 * (i % 3);
+        points.push_back(p);
+      }
+  return points;
+}
+
+
+
+template <int dim>
+struct Result
+{
+  double       location[dim];
+  unsigned int rank;
+};
+
+
+
+template <int dim>
+void
+check(const Utilities::MPI::RemotePointEvaluation<dim> &evaluation,
+      const std::vector<Point<dim>> &                   points)
+{
+  // evaluate the location of the points and the rank of the process that
+  // evaluates them
+  std::vector<Result<dim>> values;
+  evaluation.template evaluate_and_process<Result<dim>>(
+    values,
+    [&](const ArrayView<Result<dim>> &values,
+        const typename Utilities::MPI::RemotePointEvaluation<dim>::CellData
+          &cell_data) {
+      for (unsigned int c = 0; c < cell_data.cells.size(); ++c)
+        {
+          const typename Triangulation<dim>::active_cell_iterator cell(
+            &evaluation.get_triangulation(),
+            cell_data.cells[c].first,
+            cell_data.cells[c].second);
+          for (unsigned int q = cell_data.reference_point_ptrs[c];
+               q < cell_data.reference_point_ptrs[c + 1];
+               ++q)
+            {
+              const Point<dim> p =
+                evaluation.get_mapping().transform_unit_to_real_cell(
+                  cell, cell_data.reference_point_values[q]);
+              for (unsigned int d = 0; d < dim; ++d)
+                values[q].location[d] = p[d];
+              values[q].rank = cell->subdomain_id();
+            }
+        }
+    });
+
+  const std::vector<unsigned int> &point_ptrs = evaluation.get_point_ptrs();
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  unsigned int n_found = 0, n_remote = 0;
+  double       error = 0;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    {
+      n_found += evaluation.point_found(i);
+      for (unsigned int j = point_ptrs[i]; j < point_ptrs[i + 1]; ++j)
+        {
+          n_remote += (values[j].rank != my_rank);
+          for (unsigned int d = 0; d < dim; ++d)
+            error = std::max(error, std::abs(values[j].location[d] - points[i][d]));
+        }
+    }
+  deallog << "Points found: " << n_found << " of " << points.size()
+          << ", all found: " << evaluation.all_points_found()
+          << ", unique: " << evaluation.is_map_unique()
+          << ", values from other processes: " << (n_remote > 0)
+          << ", error: " << (error < 1e-10 ? "ok" : "wrong") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.set_all_manifold_ids(0);
+  tria.set_manifold(0, SphericalManifold<dim>());
+  tria.refine_global(dim == 2 ? 3 : 1);
+
+  MappingQ<dim>                              mapping(3);
+  Utilities::MPI::RemotePointEvaluation<dim> evaluation;
+
+  // with points outside of the mesh, update() has to fall back to the
+  // global search
+  std::vector<Point<dim>> points = create_points<dim>(0., true);
+  evaluation.reinit(points, tria, mapping);
+  check(evaluation, points);
+  points = create_points<dim>(0.01, true);
+  deallog << "Cheap update: " << evaluation.update(points) << std::endl;
+  check(evaluation, points);
+
+  // points inside the mesh that move a little are relocated cheaply
+  points = create_points<dim>(0., false);
+  evaluation.reinit(points, tria, mapping);
+  check(evaluation, points);
+  for (auto &p : points)
+    p *= 1.01;
+  deallog << "Cheap update: " << evaluation.update(points) << std::endl;
+  check(evaluation, points);
+
+  // moving the points by a lot also works, through the global search
+  for (auto &p : points)
+    {
+      const double x = p[0];
+      p[0]           = -p[1];
+      p[1]           = x;
+    }
+  evaluation.update(points);
+  check(evaluation, points);
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log_all;
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,176 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check Utilities::MPI::RemotePointEvaluation and VectorTools::point_values()
+// for points that are located on other processes, and the relocation of
+// moving points with RemotePointEvaluation::update()
+
+#include <deal.II/base/mpi_remote_point_evaluation.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q1.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/manifold_lib.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+#include <deal.II/numerics/vector_tools_evaluate.h>
+
+#include "../tests.h"
+
+
+
+// points on a circle through the shell, with some points outside. the
+// points differ between the processes
+template <int dim>
+std::vector<Point<dim>>
+create_points(const double angle)
+{
+  const unsigned int my_rank = Utilities::MPI::this_mpi_process(MPI_COMM_WORLD);
+  std::vector<Point<dim>> points;
+  for (unsigned int i = 0; i < 12; ++i)
+    {
+      const double phi    = angle + 2. * numbers::PI * (i + 0.3 * my_rank) / 12;
+      const double radius = (i % 4 == 3) ? 1.2 : 0.55 + 0.1 * (i % 4);
+      Point<dim>   p;
+      p[0] = radius * std::cos(phi);
+      p[1] = radius * std::sin(phi);
+      if (dim == 3)
+        p[2] = 0.1 * (i % 3);
+      points.push_back(p);
+    }
+  return points;
+}
+
+
+
+template <int dim>
+void
+check(const Utilities::MPI::RemotePointEvaluation<dim> &evaluation,
+      const DoFHandler<dim> &                           dof_handler,
+      const Vector<double> &                            vector,
+      const std::vector<Point<dim>> &                   points)
+{
+  const std::vector<double> values =
+    VectorTools::point_values(evaluation, dof_handler, vector);
+
+  // the field is linear, so it is represented exactly
+  unsigned int n_found = 0;
+  double       error   = 0;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    if (evaluation.point_found(i))
+      {
+        ++n_found;
+        double exact = 0;
+        for (unsigned int d = 0; d < dim; ++d)
+          exact += (d + 1) * points[i][d];
+        error = std::max(error, std::abs(values[i] - exact));
+      }
+  deallog << "Points found: " << n_found << " of " << points.size()
+          << ", all found: " << evaluation.all_points_found()
+          << ", error: " << (error < 1e-10 ? "ok" : "wrong") << std::endl;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  deallog << "dim=" << dim << std::endl;
+
+  parallel::shared::Triangulation<dim> tria(MPI_COMM_WORLD);
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.set_all_manifold_ids(0);
+  tria.set_manifold(0, SphericalManifold<dim>());
+  tria.refine_global(dim == 2 ? 3 : 1);
+
+  // interpolate a linear function on the locally owned cells
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  Vector<double> vector(dof_handler.n_dofs());
+  std::vector<types::global_dof_index> dof_indices(fe.dofs_per_cell);
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        cell->get_dof_indices(dof_indices);
+        for (unsigned int i = 0; i < fe.dofs_per_cell; ++i)
+          {
+            const Point<dim> p = fe.get_unit_support_points()[i];
+            const Point<dim> x =
+              MappingQ1<dim>().transform_unit_to_real_cell(cell, p);
+            double value = 0;
+            for (unsigned int d = 0; d < dim; ++d)
+              value += (d + 1) * x[d];
+            vector(dof_indices[i]) = value;
+          }
+      }
+
+  MappingQ1<dim>                            mapping;
+  Utilities::MPI::RemotePointEvaluation<dim> evaluation;
+  std::vector<Point<dim>>                   points = create_points<dim>(0.);
+  evaluation.reinit(points, tria, mapping);
+  check(evaluation, dof_handler, vector, points);
+
+  // move the points a bit. the points outside of the shell are not found,
+  // so the relocation falls back to the global search
+  points = create_points<dim>(0.01);
+  deallog << "Cheap update: " << evaluation.update(points) << std::endl;
+  check(evaluation, dof_handler, vector, points);
+
+  // now only move the points that are inside
+  std::vector<Point<dim>> inside_points;
+  for (unsigned int i = 0; i < points.size(); ++i)
+    if (evaluation.point_found(i))
+      inside_points.push_back(points[i]);
+  evaluation.reinit(inside_points, tria, mapping);
+  check(evaluation, dof_handler, vector, inside_points);
+  for (auto &p : inside_points)
+    p *= 1.01;
+  deallog << "Cheap update: " << evaluation.update(inside_points) << std::endl;
+  check(evaluation, dof_handler, vector, inside_points);
+
+  // moving them by a lot also works, through the global search
+  for (auto &p : inside_points)
+    {
+      const double x = p[0];
+      p[0]           = -p[1];
+      p[1]           = x;
+    }
+  evaluation.update(inside_points);
+  check(evaluation, dof_handler, vector, inside_points);
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    log_all;
+
+  test<2>();
+  test<3>();
+}
@@ -0,0 +1,113 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2018 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// create a shared tria mesh and distribute it with the Hilbert curve
+// partitioner, both with equal cell weights and with the weights given by
+// the cell_weight signal
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_accessor.h>
+#include <deal.II/grid/tria_iterator.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+unsigned int
+cell_weight(const typename Triangulation<dim>::cell_iterator &cell,
+            const typename Triangulation<dim>::CellStatus)
+{
+  // together with the base weight of 1000, cells in the left half are four
+  // times as expensive as the others
+  return (cell->center()[0] < 0 ? 3000 : 0);
+}
+
+
+
+template <int dim>
+void
+test(const bool weighted)
+{
+  parallel::shared::Triangulation<dim> shared_tria(
+    MPI_COMM_WORLD,
+    typename Triangulation<dim>::MeshSmoothing(
+      Triangulation<dim>::limit_level_difference_at_vertices),
+    true,
+    typename parallel::shared::Triangulation<dim>::Settings(
+      parallel::shared::Triangulation<dim>::partition_hilbert));
+  if (weighted)
+    shared_tria.signals.cell_weight.connect(&cell_weight<dim>);
+
+  GridGenerator::subdivided_hyper_cube(shared_tria, 2, -1, 1);
+  shared_tria.refine_global(2);
+  for (const auto &cell : shared_tria.active_cell_iterators())
+    if (cell->center().norm() < 0.55)
+      cell->set_refine_flag();
+  shared_tria.execute_coarsening_and_refinement();
+
+  unsigned int n_owned_cells = 0, owned_weight = 0;
+  for (const auto &cell : shared_tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      {
+        ++n_owned_cells;
+        owned_weight +=
+          1000 + (weighted ? cell_weight<dim>(
+                               cell, Triangulation<dim>::CELL_PERSIST) :
+                             0);
+      }
+
+  // the partitions are compact, so (almost) all locally owned cells have a
+  // locally owned neighbor of the same or a coarser level
+  unsigned int n_cells_with_owned_neighbor = 0;
+  for (const auto &cell : shared_tria.active_cell_iterators())
+    if (cell->is_locally_owned())
+      for (unsigned int f = 0; f < GeometryInfo<dim>::faces_per_cell; ++f)
+        if (!cell->at_boundary(f) && cell->neighbor(f)->active() &&
+            cell->neighbor(f)->is_locally_owned())
+          {
+            ++n_cells_with_owned_neighbor;
+            break;
+          }
+
+  deallog << "dim=" << dim << (weighted ? ", weighted" : "") << std::endl;
+  deallog << "Global active cells: " << shared_tria.n_global_active_cells()
+          << std::endl;
+  deallog << "Locally owned cells: " << n_owned_cells << std::endl;
+  deallog << "Weight of locally owned cells: " << owned_weight << std::endl;
+  deallog << "Cells with locally owned neighbor: "
+          << n_cells_with_owned_neighbor << std::endl;
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  test<1>(false);
+  test<2>(false);
+  test<3>(false);
+  test<2>(true);
+  test<3>(true);
+
+  deallog << "OK" << std::endl;
+}
@@ -0,0 +1,143 @@
+//-----------------------------------------------------------
+//
+//    Copyright (C) 2018 by the deal.II authors
+//
+//    This file is part of the deal.II library.
+//
+//    The deal.II library is free software; you can use it, redistribute
+//    it, and/or modify it under the terms of the GNU Lesser General
+//    Public License as published by the Free Software Foundation; either
+//    version 2.1 of the License, or (at your option) any later version.
+//    The full text of the license can be found in the file LICENSE.md at
+//    the top level directory of deal.II.
+//
+//-----------------------------------------------------------
+
+#include <deal.II/base/parameter_handler.h>
+
+#include <deal.II/lac/la_parallel_vector.h>
+
+#include <deal.II/sundials/ida.h>
+
+#include "../tests.h"
+
+
+/**
+ * Same problem as harmonic_oscillator_01, but with
+ * LinearAlgebra::distributed::Vector, which is handed to SUNDIALS through
+ * the native N_Vector interface instead of being copied.
+ *
+ * y[0]' -     y[1]  = 0
+ * y[1]' + k^2 y[0]  = 0
+ *
+ * The exact solution is
+ *
+ * y[0](t) = sin(k t)
+ * y[1](t) = k cos(k t)
+ *
+ * Rather than the solution at each output time, which depends on the steps
+ * chosen by IDA, the test prints whether the error with respect to the
+ * exact solution stays below a bound that the tolerances of
+ * harmonic_oscillator_01.prm guarantee.
+ */
+class HarmonicOscillator
+{
+public:
+  typedef LinearAlgebra::distributed::Vector<double> VectorType;
+
+  HarmonicOscillator(
+    double                                                    _kappa,
+    const typename SUNDIALS::IDA<VectorType>::AdditionalData &data)
+    : time_stepper(data)
+    , y(2)
+    , y_dot(2)
+    , alpha(0)
+    , kappa(_kappa)
+    , max_error(0)
+    , final_time(0)
+  {
+    time_stepper.reinit_vector = [&](VectorType &v) { v.reinit(2); };
+
+    time_stepper.residual = [&](const double,
+                                const VectorType &y,
+                                const VectorType &y_dot,
+                                VectorType &      res) -> int {
+      res[0] = y_dot[0] - y[1];
+      res[1] = y_dot[1] + kappa * kappa * y[0];
+      return 0;
+    };
+
+    time_stepper.setup_jacobian = [&](const double,
+                                      const VectorType &,
+                                      const VectorType &,
+                                      const double a) -> int {
+      alpha = a;
+      return 0;
+    };
+
+    // J = [alpha, -1; k^2, alpha]
+    time_stepper.solve_jacobian_system = [&](const VectorType &src,
+                                             VectorType &      dst) -> int {
+      const double det = alpha * alpha + kappa * kappa;
+      dst[0]           = (alpha * src[0] + src[1]) / det;
+      dst[1]           = (-kappa * kappa * src[0] + alpha * src[1]) / det;
+      return 0;
+    };
+
+    time_stepper.output_step = [&](const double       t,
+                                   const VectorType & sol,
+                                   const VectorType & sol_dot,
+                                   const unsigned int) -> int {
+      const double exact[4] = {std::sin(kappa * t),
+                               kappa * std::cos(kappa * t),
+                               kappa * std::cos(kappa * t),
+                               -kappa * kappa * std::sin(kappa * t)};
+      const double computed[4] = {sol[0], sol[1], sol_dot[0], sol_dot[1]};
+      for (unsigned int i = 0; i < 4; ++i)
+        max_error = std::max(max_error, std::abs(computed[i] - exact[i]));
+      final_time = t;
+      return 0;
+    };
+  }
+
+  void
+  run()
+  {
+    y[1]     = kappa;
+    y_dot[0] = kappa;
+    time_stepper.solve_dae(y, y_dot);
+
+    deallog << "Final time: " << final_time << std::endl;
+    deallog << "Error below 1e-3: " << (max_error < 1e-3 ? "yes" : "no")
+            << std::endl;
+  }
+  SUNDIALS::IDA<VectorType> time_stepper;
+
+private:
+  VectorType y;
+  VectorType y_dot;
+  double     alpha;
+  double     kappa;
+  double     max_error;
+  double     final_time;
+};
+
+
+int
+main(int argc, char **argv)
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(
+    argc, argv, numbers::invalid_unsigned_int);
+  initlog();
+
+  SUNDIALS::IDA<HarmonicOscillator::VectorType>::AdditionalData data;
+  ParameterHandler                                              prm;
+  data.add_parameters(prm);
+
+  std::ifstream ifile(SOURCE_DIR "/harmonic_oscillator_01.prm");
+  prm.parse_input(ifile);
+
+  HarmonicOscillator ode(1.0, data);
+  ode.run();
+  return 0;
+}